@@ -0,0 +1,182 @@
+// AdcDecimator.h
+// ================================================================
+// Decimation + calibration for the continuous ADC stream
+// ================================================================
+//  - CicDecimator<ORDER, R>: integer CIC filter (differential delay 1).
+//    ORDER = 1 is a plain boxcar average of R samples; higher orders
+//    trade a longer settling time (ORDER outputs) for better alias
+//    rejection. Gain R^ORDER is removed so the output is in ADC counts.
+//  - AdcCalibration: raw counts -> engineering units, same transfer
+//    functions as the former analogRead() path in Sensor.cpp.
+//  - AdcFramePipeline: feeds interleaved (channel, raw) samples through
+//    one decimator per channel and assembles a calibrated AdcFrame
+//    each time both channels have produced a new output.
+// ================================================================
+#ifndef ADC_DECIMATOR_H
+#define ADC_DECIMATOR_H
+
+#include <cstddef>
+#include <cstdint>
+
+static constexpr uint16_t ADC_RAW_MAX       = 4095;     // 12-bit
+static constexpr float    ADC_FULL_SCALE_V  = 3.3f;
+
+// ================================================================
+// CIC decimator
+// ================================================================
+template<uint8_t ORDER, uint32_t R>
+class CicDecimator {
+    static_assert(ORDER >= 1 && ORDER <= 4, "CIC order must be 1..4");
+    static_assert(R >= 2, "Decimation ratio must be at least 2");
+
+    static constexpr uint64_t ipow(uint64_t b, uint8_t e) {
+        return e == 0 ? 1 : b * ipow(b, e - 1);
+    }
+
+public:
+    // Integrators wrap modulo 2^32; the result is exact as long as the
+    // true (gain-scaled) output fits in 32 bits.
+    static constexpr uint64_t GAIN = ipow(R, ORDER);
+    static_assert(GAIN * ADC_RAW_MAX < (1ull << 32),
+                  "CIC register width exceeded: lower ORDER or R");
+
+    CicDecimator() { reset(); }
+
+    void reset() {
+        for (uint8_t k = 0; k < ORDER; k++) { integ[k] = 0; combPrev[k] = 0; }
+        phase = 0;
+        outputs = 0;
+    }
+
+    // Returns true every R-th input, with the decimated value in 'out'
+    bool push(uint16_t x, float& out) {
+        uint32_t acc = x;
+        for (uint8_t k = 0; k < ORDER; k++) {
+            integ[k] += acc;
+            acc = integ[k];
+        }
+        if (++phase < R) return false;
+        phase = 0;
+
+        for (uint8_t k = 0; k < ORDER; k++) {
+            uint32_t t = acc;
+            acc -= combPrev[k];
+            combPrev[k] = t;
+        }
+        out = static_cast<float>(acc) / static_cast<float>(GAIN);
+        if (outputs < ORDER) outputs++;
+        return true;
+    }
+
+    // The first ORDER-1 outputs still include the all-zero start state
+    bool settled() const { return outputs >= ORDER; }
+
+    static constexpr uint32_t ratio() { return R; }
+    static constexpr uint8_t  order() { return ORDER; }
+
+private:
+    uint32_t integ[ORDER];
+    uint32_t combPrev[ORDER];
+    uint32_t phase;
+    uint8_t  outputs;
+};
+
+// ================================================================
+// Calibration: units = (V - zeroVolts) * unitsPerVolt  [|.| if rectify]
+// ================================================================
+struct AdcCalibration {
+    float zeroVolts;
+    float unitsPerVolt;
+    bool  rectify;
+
+    float voltsFromCounts(float counts) const {
+        return (counts / ADC_RAW_MAX) * ADC_FULL_SCALE_V;
+    }
+
+    float toUnits(float counts) const {
+        float u = (voltsFromCounts(counts) - zeroVolts) * unitsPerVolt;
+        return (rectify && u < 0.0f) ? -u : u;
+    }
+};
+
+// 0-3.3 V -> 0-200 kPa
+static constexpr AdcCalibration ADC_CAL_PRESSURE = { 0.0f, 200.0f / 3.3f, false };
+// ACS712-30A: 1.65 V = 0 A, 66 mV/A, direction ignored
+static constexpr AdcCalibration ADC_CAL_CURRENT  = { 1.65f, 1.0f / 0.066f, true };
+
+// ================================================================
+// Calibrated frame (offsets from Sensor.cpp are applied by readers)
+// ================================================================
+struct AdcFrame {
+    float    pressure;        // kPa
+    float    current;         // A
+    float    rawPressure;     // decimated ADC counts
+    float    rawCurrent;
+    uint32_t seq;             // frames published since start
+    uint32_t timestampUs;     // time of the last contributing sample
+};
+
+enum AdcStreamChannel : uint8_t {
+    ADC_STREAM_CH_PRESSURE = 0,
+    ADC_STREAM_CH_CURRENT  = 1,
+    ADC_STREAM_CH_COUNT
+};
+
+template<uint8_t ORDER, uint32_t R>
+class AdcFramePipeline {
+public:
+    AdcFramePipeline(const AdcCalibration& pressureCal = ADC_CAL_PRESSURE,
+                     const AdcCalibration& currentCal  = ADC_CAL_CURRENT)
+        : cal{pressureCal, currentCal} { reset(); }
+
+    void reset() {
+        for (uint8_t c = 0; c < ADC_STREAM_CH_COUNT; c++) {
+            dec[c].reset();
+            fresh[c] = false;
+            level[c] = 0.0f;
+        }
+        latest = AdcFrame{};
+        samples = 0;
+        rejected = 0;
+    }
+
+    // Feed one conversion. Returns true when a new frame is ready.
+    bool push(uint8_t channel, uint16_t raw, uint32_t nowUs) {
+        if (channel >= ADC_STREAM_CH_COUNT || raw > ADC_RAW_MAX) {
+            rejected++;
+            return false;
+        }
+        samples++;
+
+        float out;
+        if (!dec[channel].push(raw, out)) return false;
+        level[channel] = out;
+        fresh[channel] = dec[channel].settled();
+
+        if (!fresh[ADC_STREAM_CH_PRESSURE] || !fresh[ADC_STREAM_CH_CURRENT]) return false;
+        fresh[ADC_STREAM_CH_PRESSURE] = fresh[ADC_STREAM_CH_CURRENT] = false;
+
+        latest.rawPressure = level[ADC_STREAM_CH_PRESSURE];
+        latest.rawCurrent  = level[ADC_STREAM_CH_CURRENT];
+        latest.pressure    = cal[ADC_STREAM_CH_PRESSURE].toUnits(latest.rawPressure);
+        latest.current     = cal[ADC_STREAM_CH_CURRENT].toUnits(latest.rawCurrent);
+        latest.seq++;
+        latest.timestampUs = nowUs;
+        return true;
+    }
+
+    const AdcFrame& frame() const  { return latest; }
+    uint32_t samplesIn() const     { return samples; }
+    uint32_t rejectedCount() const { return rejected; }
+
+private:
+    CicDecimator<ORDER, R> dec[ADC_STREAM_CH_COUNT];
+    AdcCalibration         cal[ADC_STREAM_CH_COUNT];
+    float                  level[ADC_STREAM_CH_COUNT];
+    bool                   fresh[ADC_STREAM_CH_COUNT];
+    AdcFrame               latest;
+    uint32_t               samples;
+    uint32_t               rejected;
+};
+
+#endif // ADC_DECIMATOR_H
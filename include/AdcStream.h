@@ -0,0 +1,45 @@
+// AdcStream.h
+// ================================================================
+// Continuous DMA acquisition for pressure + current
+// ================================================================
+//  - The IDF adc_continuous driver scans both ADC1 channels into a DMA
+//    ring at ADC_STREAM_SAMPLE_RATE_HZ. The conversion-done callback
+//    only wakes the "AdcStream" task, which decimates the samples
+//    (AdcFramePipeline, CIC) and publishes the latest calibrated frame.
+//  - Readers copy the published frame lock-free; they never trigger a
+//    conversion and never wait on the ADC mutex.
+//  - While the stream runs it owns ADC1. Every other conversion goes
+//    through adcOneShotRead(), which never touches ADC1 then.
+// ================================================================
+#ifndef ADC_STREAM_H
+#define ADC_STREAM_H
+
+#include <Arduino.h>
+#include "AdcDecimator.h"
+
+struct AdcStreamStats {
+    uint32_t samples;         // conversions consumed
+    uint32_t frames;          // frames published
+    uint32_t rejected;        // unknown channel / out-of-range results
+    uint32_t poolOverflows;   // driver ring overflowed (task too slow)
+    uint32_t readErrors;
+};
+
+bool adcStreamBegin(uint8_t pressurePin, uint8_t currentPin);
+void adcStreamStop();
+bool adcStreamRunning();
+
+// Latest frame; false if the stream is stopped or older than ADC_STREAM_STALE_MS
+bool adcStreamLatest(AdcFrame& out);
+
+// One-shot conversion (analogRead) for any ADC pin, serialised with
+// stream start / stop. While the stream runs, a streamed pin returns
+// its last decimated raw value and any other ADC1 pin returns -1.
+// ADC_ONESHOT_BUSY if the ADC mutex was not free within wait.
+static constexpr int ADC_ONESHOT_BUSY = -2;
+int adcOneShotRead(uint8_t pin, TickType_t wait = portMAX_DELAY);
+
+AdcStreamStats adcStreamGetStats();
+void printAdcStreamStatus();
+
+#endif // ADC_STREAM_H
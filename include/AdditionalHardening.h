@@ -87,6 +87,20 @@
 #define ADC_OVERSAMPLE_COUNT   4  //   
 #define ADC_REJECT_THRESHOLD   0.15f  // 15%    
 
+// Continuous (DMA) acquisition for pressure/current - see AdcStream.h
+// Both channels are interleaved, so each gets half the sample rate.
+// 20 kS/s total, CIC order 2, R = 50  ->  200 frames/s (= PID_LOOP_RATE_HZ).
+#define ADC_STREAM_SAMPLE_RATE_HZ  20000
+#define ADC_STREAM_CIC_ORDER       2
+#define ADC_STREAM_DECIMATION      50
+#define ADC_STREAM_FRAME_BYTES     256    // DMA conversion frame (4 B/result)
+#define ADC_STREAM_POOL_BYTES      1024   // driver ring between callbacks
+#define ADC_STREAM_TASK_STACK      3072
+#define ADC_STREAM_TASK_PRIORITY   3
+#define ADC_STREAM_STALE_MS        50     // fall back to adcOneShotRead after this
+#define ADC_STREAM_STOP_TIMEOUT_MS 100    // wait for the task to leave the driver
+#define ADC_CONTROL_WAIT_TICKS     1      // readPressure/readCurrent: max wait on the ADC mutex
+
 //  [I] DFPlayer   
 //  /  play()  
 // DFPlayer UART  
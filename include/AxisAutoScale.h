@@ -0,0 +1,114 @@
+// AxisAutoScale.h
+// ================================================================
+// Y-axis autoscale with hysteresis for the trend graph
+// ================================================================
+//  update() takes the data min / max of the visible window (from
+//  MinMaxPyramid::range(), no rescan) and decides whether the axis
+//  moves:
+//    - data outside the axis      -> refit at once (never clip)
+//    - data using < SHRINK_FILL   -> refit only after holdMs of it
+//    - anything else              -> keep the axis
+//  Refits add the margin and snap both ends outward to a 1-2-5 step of
+//  a fifth of the span (the graph has five grid rows), so small drifts
+//  land on the same limits and the labels stay round.
+// ================================================================
+#ifndef AXIS_AUTO_SCALE_H
+#define AXIS_AUTO_SCALE_H
+
+#include <cmath>
+#include <cstdint>
+
+struct AxisLimits {
+    float margin;     // fraction of the data span on each side
+    float minSpan;    // flat data is shown this tall
+    float floor;      // lower limit never goes below (NAN = none)
+};
+
+class AxisScaler {
+public:
+    static constexpr float SHRINK_FILL = 0.5f;     // data / axis span that counts as "too loose"
+
+    void begin(const AxisLimits& lim, uint32_t holdMs) {
+        lim_ = lim;
+        holdMs_ = holdMs;
+        reset();
+    }
+
+    // Next update() refits unconditionally (window switch, SCALE on)
+    void reset() { fitted_ = false; shrinking_ = false; }
+
+    // Returns true when lo() / hi() changed
+    bool update(float dataMin, float dataMax, uint32_t nowMs) {
+        if (!(dataMin <= dataMax)) return false;
+        if (!fitted_ || dataMin < lo_ || dataMax > hi_) return refit(dataMin, dataMax);
+
+        float tLo, tHi;
+        target(dataMin, dataMax, tLo, tHi);
+        if (tHi - tLo >= (hi_ - lo_) * SHRINK_FILL) {
+            shrinking_ = false;
+            return false;
+        }
+        if (!shrinking_) {
+            shrinking_ = true;
+            shrinkSince_ = nowMs;
+            return false;
+        }
+        if (nowMs - shrinkSince_ < holdMs_) return false;
+        return refit(dataMin, dataMax);
+    }
+
+    float lo() const { return lo_; }
+    float hi() const { return hi_; }
+
+    // 1, 2 or 5 x 10^k, the smallest >= x
+    static float niceStep(float x) {
+        if (!(x > 0.0f)) return 1.0f;
+        float p = powf(10.0f, floorf(log10f(x)));
+        float m = x / p;
+        float n = m <= 1.0f ? 1.0f : m <= 2.0f ? 2.0f : m <= 5.0f ? 5.0f : 10.0f;
+        return n * p;
+    }
+
+    // Margin, minimum span and floor, snapped outward to the grid step
+    void target(float dMin, float dMax, float& lo, float& hi) const {
+        bool  aboveFloor = !std::isnan(lim_.floor) && dMin >= lim_.floor;
+        float span = dMax - dMin;
+        if (span < lim_.minSpan) {
+            float mid = (dMin + dMax) * 0.5f;
+            dMin = mid - lim_.minSpan * 0.5f;
+            dMax = mid + lim_.minSpan * 0.5f;
+            span = lim_.minSpan;
+        }
+        lo = dMin - span * lim_.margin;
+        hi = dMax + span * lim_.margin;
+        if (aboveFloor && lo < lim_.floor) {
+            lo = lim_.floor;
+            if (hi < lo + lim_.minSpan) hi = lo + lim_.minSpan;
+        }
+        float step = niceStep((hi - lo) / 5.0f);
+        lo = floorf(lo / step) * step;
+        hi = ceilf(hi / step) * step;
+    }
+
+private:
+    bool refit(float dMin, float dMax) {
+        float lo, hi;
+        target(dMin, dMax, lo, hi);
+        bool changed = !fitted_ || lo != lo_ || hi != hi_;
+        lo_ = lo;
+        hi_ = hi;
+        fitted_ = true;
+        shrinking_ = false;
+        return changed;
+    }
+
+    AxisLimits lim_ = { 0.1f, 1.0f, NAN };
+    uint32_t   holdMs_ = 0;
+    uint32_t   shrinkSince_ = 0;
+    float      lo_ = 0.0f;
+    float      hi_ = 1.0f;
+    bool       fitted_ = false;
+    bool       shrinking_ = false;
+};
+
+#endif // AXIS_AUTO_SCALE_H
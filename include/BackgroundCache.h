@@ -0,0 +1,126 @@
+// BackgroundCache.h
+// ================================================================
+// Per-screen static background layers (TFT_GFX bgRestore / bgCapture)
+// ================================================================
+//  The parts of a screen that never change between frames - card
+//  frames, nav bar, state-diagram arrows - are rendered once into a
+//  full-frame PSRAM bitmap and copied back with memcpy on later draws;
+//  only the dynamic content is rasterized each time.
+//
+//  A layer is identified by a key (screen id, plus a variant such as
+//  the diagram page). SLOTS layers are kept; a new key takes a free
+//  slot or the least recently used one. Buffers are allocated lazily
+//  by the caller's allocator and reused on eviction. invalidateAll()
+//  (language change) bumps a generation so every layer re-renders on
+//  its next use.
+// ================================================================
+#ifndef BACKGROUND_CACHE_H
+#define BACKGROUND_CACHE_H
+
+#include <cstdint>
+#include <cstring>
+
+// Layer key: screen id plus a variant (page, mode) of its static layer
+constexpr uint16_t bgKey(uint8_t screen, uint8_t variant = 0) {
+    return (uint16_t)(screen << 4 | (variant & 0x0F));
+}
+
+struct BgCacheStats {
+    uint32_t hits;
+    uint32_t misses;
+    uint32_t evictions;
+    uint32_t allocFails;
+};
+
+template <uint8_t SLOTS = 4>
+class BackgroundCache {
+public:
+    static constexpr uint16_t NO_KEY = 0xFFFF;
+
+    BackgroundCache() {
+        for (uint8_t i = 0; i < SLOTS; i++) s_[i] = { nullptr, NO_KEY, 0, 0 };
+        memset(&stats_, 0, sizeof(stats_));
+    }
+
+    // Pixels of a current layer for key, or nullptr (render it)
+    const uint16_t* find(uint16_t key) {
+        int8_t i = slotOf(key);
+        if (i < 0 || s_[i].gen != gen_) {
+            stats_.misses++;
+            return nullptr;
+        }
+        s_[i].lastUse = ++tick_;
+        stats_.hits++;
+        return s_[i].px;
+    }
+
+    // Buffer to capture key into: its own slot, a free one or the LRU
+    // one. alloc(bytes) is only called for a slot without a buffer.
+    // Returns nullptr when no buffer can be had (no cache, draw as before).
+    template <typename Alloc>
+    uint16_t* claim(uint16_t key, uint32_t bytes, Alloc&& alloc) {
+        int8_t i = slotOf(key);
+        if (i < 0) {
+            i = 0;
+            for (uint8_t j = 0; j < SLOTS; j++) {
+                if (s_[j].key == NO_KEY) { i = j; break; }
+                if (s_[j].lastUse < s_[i].lastUse) i = j;
+            }
+            if (s_[i].key != NO_KEY) stats_.evictions++;
+            s_[i].key = NO_KEY;
+        }
+        if (!s_[i].px) {
+            s_[i].px = (uint16_t*)alloc(bytes);
+            if (!s_[i].px) {
+                stats_.allocFails++;
+                return nullptr;
+            }
+        }
+        s_[i].key = key;
+        s_[i].gen = gen_ - 1;          // not valid until commit()
+        s_[i].lastUse = ++tick_;
+        return s_[i].px;
+    }
+
+    // The claimed buffer now holds key's layer
+    void commit(uint16_t key) {
+        int8_t i = slotOf(key);
+        if (i >= 0 && s_[i].px) s_[i].gen = gen_;
+    }
+
+    void invalidate(uint16_t key) {
+        int8_t i = slotOf(key);
+        if (i >= 0) s_[i].gen = gen_ - 1;
+    }
+    void invalidateAll() { gen_++; }
+
+    uint8_t used() const {
+        uint8_t n = 0;
+        for (uint8_t i = 0; i < SLOTS; i++) n += s_[i].px != nullptr;
+        return n;
+    }
+    const BgCacheStats& stats() const { return stats_; }
+    void resetStats() { memset(&stats_, 0, sizeof(stats_)); }
+
+private:
+    struct Slot {
+        uint16_t* px;
+        uint16_t  key;
+        uint32_t  gen;
+        uint32_t  lastUse;
+    };
+
+    int8_t slotOf(uint16_t key) const {
+        for (uint8_t i = 0; i < SLOTS; i++) {
+            if (s_[i].key == key) return (int8_t)i;
+        }
+        return -1;
+    }
+
+    Slot         s_[SLOTS];
+    uint32_t     gen_ = 1;
+    uint32_t     tick_ = 0;
+    BgCacheStats stats_;
+};
+
+#endif // BACKGROUND_CACHE_H
@@ -0,0 +1,16 @@
+#pragma once
+// ================================================================
+// Buzzer.h    Non-blocking buzzer annunciator
+// ================================================================
+//  buzzerPlay() queues nothing and never waits: it starts the pattern
+//  (BuzzerPattern.h) on an esp_timer and returns. Higher-priority
+//  patterns preempt lower ones; a lower one is refused.
+// ================================================================
+
+#include "BuzzerPattern.h"
+
+void initBuzzer();                       // pin + timer (once)
+bool buzzerPlay(BuzzerPatternId id);     // any task; false if refused
+void buzzerStop();                       // silence whatever is playing
+bool buzzerBusy();
+BuzzerPatternId buzzerCurrent();
@@ -0,0 +1,160 @@
+// BuzzerPattern.h
+// ================================================================
+// Buzzer pattern bytecode and sequencer
+// ================================================================
+//  - A pattern is a short uint16_t program: BZ_ON(ms) / BZ_OFF(ms)
+//    hold the output for ms, BZ_REPEAT(n) jumps back to the start
+//    until the body has run n times (0 = until stopped), BZ_END stops.
+//  - Each pattern has a priority. play() preempts the current pattern
+//    when the new one has the same or a higher priority; a lower one
+//    is refused, so an E-stop alarm is never cut short by a warning.
+//  - update(nowMs) advances by due steps and returns the output level.
+//    Step deadlines accumulate from the previous deadline, so a late
+//    update does not stretch the pattern. nextDeadline() tells the
+//    caller when to call again (Buzzer.cpp arms an esp_timer with it).
+// ================================================================
+#ifndef BUZZER_PATTERN_H
+#define BUZZER_PATTERN_H
+
+#include <cstddef>
+#include <cstdint>
+
+// ---- Bytecode: 2-bit op, 14-bit argument ----
+enum : uint16_t {
+    BZ_OP_ON     = 0u << 14,
+    BZ_OP_OFF    = 1u << 14,
+    BZ_OP_REPEAT = 2u << 14,
+    BZ_OP_END    = 3u << 14,
+    BZ_OP_MASK   = 3u << 14,
+    BZ_ARG_MASK  = 0x3FFF,
+};
+
+#define BZ_ON(ms)      ((uint16_t)(BZ_OP_ON     | ((ms) & BZ_ARG_MASK)))
+#define BZ_OFF(ms)     ((uint16_t)(BZ_OP_OFF    | ((ms) & BZ_ARG_MASK)))
+#define BZ_REPEAT(n)   ((uint16_t)(BZ_OP_REPEAT | ((n) & BZ_ARG_MASK)))
+#define BZ_END         ((uint16_t)BZ_OP_END)
+
+enum BuzzerPatternId : uint8_t {
+    BZ_PAT_NONE = 0,
+    BZ_PAT_SHORT,            // hold extension, cycle complete
+    BZ_PAT_SUCCESS,          // SD export done
+    BZ_PAT_FAIL,             // SD export failed
+    BZ_PAT_MAINT_REQUIRED,   // SmartAlert: 2 short
+    BZ_PAT_MAINT_URGENT,     // SmartAlert: 3 long
+    BZ_PAT_TEMP_WARNING,     // double beep
+    BZ_PAT_ERROR,            // state ERROR
+    BZ_PAT_ALERT_ERROR,      // SmartAlert error alert
+    BZ_PAT_ESTOP,            // state EMERGENCY_STOP
+    BZ_PAT_COUNT
+};
+
+enum BuzzerPriority : uint8_t {
+    BZ_PRIO_INFO = 1,
+    BZ_PRIO_WARNING,
+    BZ_PRIO_ERROR,
+    BZ_PRIO_ESTOP,
+};
+
+struct BuzzerPattern {
+    const uint16_t* code;
+    uint8_t         priority;
+};
+
+namespace bz_code {
+    static constexpr uint16_t SHORT[]          = { BZ_ON(100), BZ_END };
+    static constexpr uint16_t SUCCESS[]        = { BZ_ON(80), BZ_OFF(40), BZ_ON(80), BZ_END };
+    static constexpr uint16_t FAIL[]           = { BZ_ON(200), BZ_END };
+    static constexpr uint16_t MAINT_REQUIRED[] = { BZ_ON(100), BZ_OFF(100), BZ_ON(100), BZ_END };
+    static constexpr uint16_t MAINT_URGENT[]   = { BZ_ON(300), BZ_OFF(200), BZ_REPEAT(3), BZ_END };
+    static constexpr uint16_t TEMP_WARNING[]   = { BZ_ON(200), BZ_OFF(100), BZ_ON(200), BZ_END };
+    static constexpr uint16_t ERR[]            = { BZ_ON(500), BZ_END };
+    static constexpr uint16_t ALERT_ERR[]      = { BZ_ON(1000), BZ_END };
+    static constexpr uint16_t ESTOP[]          = { BZ_ON(1000), BZ_END };
+}
+
+static constexpr BuzzerPattern BUZZER_PATTERNS[BZ_PAT_COUNT] = {
+    { nullptr,                    0 },
+    { bz_code::SHORT,             BZ_PRIO_INFO },
+    { bz_code::SUCCESS,           BZ_PRIO_INFO },
+    { bz_code::FAIL,              BZ_PRIO_INFO },
+    { bz_code::MAINT_REQUIRED,    BZ_PRIO_WARNING },
+    { bz_code::MAINT_URGENT,      BZ_PRIO_WARNING },
+    { bz_code::TEMP_WARNING,      BZ_PRIO_WARNING },
+    { bz_code::ERR,               BZ_PRIO_ERROR },
+    { bz_code::ALERT_ERR,         BZ_PRIO_ERROR },
+    { bz_code::ESTOP,             BZ_PRIO_ESTOP },
+};
+
+class BuzzerSequencer {
+public:
+    BuzzerSequencer() { stop(); }
+
+    // false if a higher-priority pattern is playing (or id is invalid)
+    bool play(BuzzerPatternId id, uint32_t nowMs) {
+        if (id == BZ_PAT_NONE || id >= BZ_PAT_COUNT) return false;
+        const BuzzerPattern& p = BUZZER_PATTERNS[id];
+        if (cur != BZ_PAT_NONE && p.priority < BUZZER_PATTERNS[cur].priority) return false;
+        cur = id;
+        code = p.code;
+        pc = 0;
+        loops = 0;
+        deadline = nowMs;
+        advance();
+        return true;
+    }
+
+    void stop() {
+        cur = BZ_PAT_NONE;
+        code = nullptr;
+        pc = 0;
+        loops = 0;
+        level = false;
+        deadline = 0;
+    }
+
+    // Runs every step that is due; returns the output level
+    bool update(uint32_t nowMs) {
+        while (cur != BZ_PAT_NONE && (int32_t)(nowMs - deadline) >= 0) advance();
+        return level;
+    }
+
+    bool            playing() const       { return cur != BZ_PAT_NONE; }
+    BuzzerPatternId current() const       { return cur; }
+    bool            output() const        { return level; }
+    uint32_t        nextDeadline() const  { return deadline; }   // valid while playing()
+
+private:
+    // Execute ops from pc until a timed step (or the end)
+    void advance() {
+        for (uint8_t guard = 0; guard < 64; guard++) {
+            uint16_t op = code[pc];
+            uint16_t arg = op & BZ_ARG_MASK;
+            switch (op & BZ_OP_MASK) {
+                case BZ_OP_ON:
+                case BZ_OP_OFF:
+                    level = (op & BZ_OP_MASK) == BZ_OP_ON;
+                    deadline += arg;
+                    pc++;
+                    return;
+                case BZ_OP_REPEAT:
+                    loops++;
+                    if (arg == 0 || loops < arg) { pc = 0; continue; }
+                    pc++;
+                    continue;
+                default:            // BZ_END
+                    stop();
+                    return;
+            }
+        }
+        stop();                     // malformed: no timed step in the loop
+    }
+
+    BuzzerPatternId  cur;
+    const uint16_t*  code;
+    uint8_t          pc;
+    uint16_t         loops;
+    bool             level;
+    uint32_t         deadline;
+};
+
+#endif // BUZZER_PATTERN_H
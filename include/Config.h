@@ -98,6 +98,11 @@
 #define PIN_LED_GREEN       37
 #define PIN_LED_RED         36
 
+// AXS15231B touch INT (active low); -1 polls the controller instead
+#ifndef PIN_TOUCH_INT
+#define PIN_TOUCH_INT       21
+#endif
+
 //    
 
 // ================================================================
@@ -126,6 +131,22 @@
 #define PID_OUTPUT_MIN          0.0f
 #define PID_OUTPUT_MAX        100.0f
 #define INTEGRAL_LIMIT         50.0f
+#define PID_LOOP_RATE_HZ       200      // esp_timer-driven control law (PID_Control.cpp)
+#define PID_DERIV_FILTER_HZ     20.0f   // derivative-on-measurement low-pass cutoff
+#define PID_ARM_TIMEOUT_MS     300      // loop disarms if updatePID() stops being called
+
+// Relay auto-tune (PID_Control.cpp, RelayAutotune.h)
+#define AUTOTUNE_RELAY_BIAS       50.0f   // % output, relay centre
+#define AUTOTUNE_RELAY_AMPLITUDE  25.0f   // % output, relay step
+#define AUTOTUNE_HYSTERESIS        1.0f   // kPa, noise band around target
+#define AUTOTUNE_MAX_DEVIATION    30.0f   // kPa from target before abort
+#define AUTOTUNE_WARMUP_CYCLES     2
+#define AUTOTUNE_MEASURE_CYCLES    4
+#define AUTOTUNE_TIMEOUT_MS   120000
+
+// E-stop / input interrupt fast path (SafetyIsr.cpp)
+#define SAFETY_ESTOP_CONFIRM_MS      50   // post-trip debounce check, logging only
+#define SAFETY_INPUT_DEBOUNCE_US   5000   // limit / photo edge lockout
 
 // ================================================================
 //   (v3.9.5  )
@@ -169,7 +190,6 @@
 // 
 // ================================================================
 #define UPDATE_INTERVAL       100      // ms    
-#define PID_UPDATE_INTERVAL    50      // ms  PID  
 #define DEBOUNCE_TIME          50      // ms
 #define WDT_TIMEOUT            10      // 
 #define IDLE_TIMEOUT  (60UL * 60 * 1000) // 1시간 // 2
@@ -189,24 +209,8 @@
 #define SCREEN_WIDTH   320
 #define SCREEN_HEIGHT  480
 
-//   
-enum SystemState {
-  STATE_IDLE,
-  STATE_VACUUM_ON,
-  STATE_VACUUM_HOLD,
-  STATE_VACUUM_BREAK,
-  STATE_WAIT_REMOVAL,
-  STATE_COMPLETE,
-  STATE_ERROR,
-  STATE_EMERGENCY_STOP,
-  STATE_STANDBY 
-};
-
-enum ControlMode {
-  MODE_MANUAL,
-  MODE_AUTO,
-  MODE_PID
-};
+//   /   (SystemState.h: shared with VacuumStateTable.h)
+#include "SystemState.h"
 
 enum ErrorCode {
   ERROR_NONE,
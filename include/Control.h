@@ -6,6 +6,7 @@
 #pragma once
 
 #include <Arduino.h>
+#include "RampProfile.h"
 // ================================================================
 //    (extern)
 // ================================================================
@@ -20,6 +21,7 @@ extern uint8_t pumpPWM;
 
 //   (PWM)
 void controlPump(bool enable, uint8_t pwm = 200);
+void setPumpDuty(uint8_t pwm);   // running pump: duty change only (PID loop)
 
 //  
 void controlValve(bool enable);
@@ -55,8 +57,26 @@ void initControl();
 // PWM  
 // ================================================================
 
-// PWM  ( /)
-void setPumpPWM(uint8_t targetPWM, uint16_t rampTimeMs = 0);
+// PWM  ( /). Non-blocking: the ramp is advanced by pumpControlTick().
+void setPumpPWM(uint8_t targetPWM, uint16_t rampTimeMs = 0, RampShape shape = RAMP_LINEAR);
+
+// Control tick: cuts the pump within one tick on E-stop, advances the ramp.
+// Returns false while E-stop is asserted (callers must not drive the pump).
+bool pumpControlTick();
+
+struct PumpRampStatus {
+  bool      active;
+  RampShape shape;
+  uint8_t   fromPWM;
+  uint8_t   targetPWM;
+  uint8_t   currentPWM;
+  uint32_t  elapsedMs;
+  uint32_t  durationMs;
+  float     progress;     // 0..1 (1 when idle)
+};
+
+PumpRampStatus getPumpRampStatus();
+bool isPumpRamping();
 
 // ================================================================
 //    ()
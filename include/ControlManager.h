@@ -5,6 +5,17 @@
 #pragma once
 
 #include <Arduino.h>
+#include "PidController.h"
+
+// Manual/legacy loop: derivative on error, integral clamped to +/-100 %
+struct ManagerPidOptions {
+    static constexpr PidAntiWindup antiWindup    = PidAntiWindup::Clamp;
+    static constexpr PidDerivative derivative    = PidDerivative::OnError;
+    static constexpr float         derivFilterHz = 0.0f;
+    static constexpr float         outputMin     = 0.0f;
+    static constexpr float         outputMax     = 100.0f;
+    static constexpr float         integralLimit = 100.0f;
+};
 
 // ================================================================
 //   
@@ -34,7 +45,7 @@ public:
     void setPIDGains(float kp, float ki, float kd);
     
     //  
-    float getPIDOutput() const { return pidOutput; }
+    float getPIDOutput() const { return pid.output(); }
     void printStatus();
     
 private:
@@ -46,16 +57,7 @@ private:
     bool valveActive;
     
     // PID 
-    float pidError;
-    float pidIntegral;
-    float pidDerivative;
-    float pidLastError;
-    float pidOutput;
-    
-    // PID 
-    float pidKp;
-    float pidKi;
-    float pidKd;
+    PidController<float, ManagerPidOptions> pid;
     
     uint32_t lastPIDUpdate;
     
@@ -26,8 +26,8 @@ struct TrendStatistics {
     float avg_24h;                // 24 
     float avg_7d;                 // 7 
     float avg_30d;                // 30 
-    float trend;                  //  (=, =)
-    float volatility;             // 
+    float trend;                  //  (=, =), points/day
+    float volatility;             // , stddev over the window
     uint32_t lastUpdate;          //   
 };
 
@@ -55,7 +55,8 @@ public:
     TrendStatistics getMonthlyTrend();               // 30 
     
     //  
-    bool getWeeklyHealthHistory(float* values, int& count);
+    bool getWeeklyHealthHistory(float* values, int& count);   // values[7], daily means, NAN = no data
+    bool getHourlyHealthHistory(float* values, int& count);   // values[24], hourly means, NAN = no data
     bool readHealthHistory(HealthLogEntry* buffer, uint16_t maxCount, uint16_t& actualCount);
     bool readMaintenanceHistory(char* buffer, uint16_t maxSize);
     
@@ -64,7 +65,7 @@ public:
     bool exportMaintenanceToCSV(const char* filename);
     
     //  
-    float predictHealthScore(uint8_t hoursAhead);   // N   
+    float predictHealthScore(uint16_t hoursAhead);  // N   
     uint32_t estimateDaysToMaintenance();           //   
     
     //  
@@ -0,0 +1,191 @@
+// DirtyRegion.h
+// ================================================================
+// Damage tracking for the TFT_GFX canvas (what flush() pushes)
+// ================================================================
+//  Every primitive adds its clipped bounding box. A box is merged into
+//  an existing rectangle when pushing the union costs no more than
+//  pushing both (pixels + DIRTY_RECT_COST_PX per window set-up), which
+//  also joins boxes a few pixels apart; merges cascade. When all
+//  MAX_RECTS slots are taken the cheapest pair is merged. Once the
+//  damage covers DIRTY_FULL_PCT of the screen it collapses into one
+//  full-frame rectangle.
+//
+//  A full frame (fillScreen() and redraw-everything screens) is then
+//  narrowed by row hashes in the wrapper: dirty::changedRuns() turns
+//  the per-row "changed" flags into full-width bands, merged under the
+//  same cost rule.
+// ================================================================
+#ifndef DIRTY_REGION_H
+#define DIRTY_REGION_H
+
+#include <cstddef>
+#include <cstdint>
+
+constexpr uint32_t DIRTY_RECT_COST_PX = 1024;   // ~window set-up + command bytes, in pixels
+constexpr uint8_t  DIRTY_FULL_PCT     = 85;     // damage share that becomes a full push
+
+struct DirtyRect {
+    int16_t x, y, w, h;
+
+    uint32_t area() const { return (uint32_t)w * h; }
+    int16_t  right() const { return x + w; }      // exclusive
+    int16_t  bottom() const { return y + h; }
+
+    DirtyRect unite(const DirtyRect& o) const {
+        int16_t x0 = x < o.x ? x : o.x;
+        int16_t y0 = y < o.y ? y : o.y;
+        int16_t x1 = right() > o.right() ? right() : o.right();
+        int16_t y1 = bottom() > o.bottom() ? bottom() : o.bottom();
+        return { x0, y0, (int16_t)(x1 - x0), (int16_t)(y1 - y0) };
+    }
+    bool contains(int16_t px, int16_t py) const {
+        return px >= x && px < right() && py >= y && py < bottom();
+    }
+};
+
+template <uint8_t MAX_RECTS = 8>
+class DirtyRegion {
+public:
+    DirtyRegion(int16_t width = 320, int16_t height = 480) : w_(width), h_(height) { clear(); }
+
+    void clear() { n_ = 0; full_ = false; }
+
+    void addFull() {
+        r_[0] = { 0, 0, w_, h_ };
+        n_ = 1;
+        full_ = true;
+    }
+
+    void add(int32_t x, int32_t y, int32_t w, int32_t h) {
+        if (full_ || w <= 0 || h <= 0) return;
+        int32_t x1 = x + w, y1 = y + h;
+        if (x < 0) x = 0;
+        if (y < 0) y = 0;
+        if (x1 > w_) x1 = w_;
+        if (y1 > h_) y1 = h_;
+        if (x >= x1 || y >= y1) return;
+        DirtyRect d = { (int16_t)x, (int16_t)y, (int16_t)(x1 - x), (int16_t)(y1 - y) };
+
+        // Swallow into / merge with existing rects while it pays, cascading
+        for (bool merged = true; merged;) {
+            merged = false;
+            for (uint8_t i = 0; i < n_; i++) {
+                DirtyRect u = r_[i].unite(d);
+                if (cost(u) <= cost(r_[i]) + cost(d)) {
+                    d = u;
+                    r_[i] = r_[--n_];
+                    merged = true;
+                    break;
+                }
+            }
+        }
+
+        if (n_ == MAX_RECTS) {
+            // Full: merge whichever pair (the new box included) grows least
+            uint8_t bi = 0, bj = MAX_RECTS;
+            int64_t best = INT64_MAX;
+            for (uint8_t i = 0; i < n_; i++) {
+                for (uint8_t j = i + 1; j <= n_; j++) {
+                    const DirtyRect& b = j == n_ ? d : r_[j];
+                    int64_t g = (int64_t)r_[i].unite(b).area() - r_[i].area() - b.area();
+                    if (g < best) { best = g; bi = i; bj = j; }
+                }
+            }
+            if (bj == n_) {
+                d = r_[bi].unite(d);
+                r_[bi] = r_[--n_];
+            } else {
+                r_[bi] = r_[bi].unite(r_[bj]);
+                r_[bj] = d;
+                return promoteIfLarge();
+            }
+            return add(d.x, d.y, d.w, d.h);   // the union may now merge further
+        }
+        r_[n_++] = d;
+        promoteIfLarge();
+    }
+
+    bool     empty() const { return n_ == 0; }
+    bool     full() const { return full_; }
+    uint8_t  count() const { return n_; }
+    const DirtyRect& rect(uint8_t i) const { return r_[i]; }
+
+    uint32_t pixels() const {
+        uint32_t p = 0;
+        for (uint8_t i = 0; i < n_; i++) p += r_[i].area();
+        return p;
+    }
+
+    static uint32_t cost(const DirtyRect& r) { return r.area() + DIRTY_RECT_COST_PX; }
+
+private:
+    void promoteIfLarge() {
+        if (pixels() * 100ULL >= (uint64_t)w_ * h_ * DIRTY_FULL_PCT) addFull();
+    }
+
+    DirtyRect r_[MAX_RECTS];
+    uint8_t   n_;
+    bool      full_;
+    int16_t   w_, h_;
+};
+
+// Fixed list of rects handed to the present task. Past N a rect widens
+// the last entry (pushes a little more, never drops damage).
+template <uint8_t N>
+struct DirtyList {
+    DirtyRect r[N];
+    uint8_t   n = 0;
+
+    void clear() { n = 0; }
+    void add(const DirtyRect& d) {
+        if (n < N) r[n++] = d;
+        else r[N - 1] = r[N - 1].unite(d);
+    }
+    uint32_t pixels() const {
+        uint32_t p = 0;
+        for (uint8_t i = 0; i < n; i++) p += r[i].area();
+        return p;
+    }
+};
+
+namespace dirty {
+
+// FNV-1a over the row as 32-bit words; 0 is kept free for "unknown"
+inline uint32_t rowHash(const uint16_t* px, size_t n) {
+    uint32_t h = 2166136261u;
+    const uint16_t* end = px + (n & ~(size_t)1);
+    for (; px < end; px += 2) {
+        h ^= (uint32_t)px[0] | ((uint32_t)px[1] << 16);
+        h *= 16777619u;
+    }
+    if (n & 1) { h ^= *px; h *= 16777619u; }
+    return h ? h : 1;
+}
+
+// Runs of changed rows as [y, y + h) bands; unchanged gaps shorter than
+// the set-up cost are pushed along. Returns the number of bands.
+template <typename Fn>
+uint16_t changedRuns(const bool* changed, int16_t rows, int16_t rowPx, Fn&& band) {
+    int16_t gapRows = (int16_t)(DIRTY_RECT_COST_PX / (rowPx > 0 ? rowPx : 1));
+    uint16_t bands = 0;
+    int16_t start = -1, lastChanged = -1;
+    for (int16_t y = 0; y < rows; y++) {
+        if (!changed[y]) continue;
+        if (start >= 0 && y - lastChanged - 1 > gapRows) {
+            band(start, (int16_t)(lastChanged + 1 - start));
+            bands++;
+            start = -1;
+        }
+        if (start < 0) start = y;
+        lastChanged = y;
+    }
+    if (start >= 0) {
+        band(start, (int16_t)(lastChanged + 1 - start));
+        bands++;
+    }
+    return bands;
+}
+
+} // namespace dirty
+
+#endif // DIRTY_REGION_H
@@ -9,6 +9,14 @@
 #include <Arduino_GFX_Library.h>
 #include <Wire.h>
 #include <stdarg.h>
+#include <esp_heap_caps.h>
+#include <esp_timer.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <freertos/semphr.h>
+#include "DirtyRegion.h"
+#include "BackgroundCache.h"
+#include "GlyphAtlas.h"
 #include "hal/wdt_hal.h"
 #include "esp_freertos_hooks.h"
 
@@ -50,6 +58,30 @@ static IRAM_ATTR void feed_mwdt1_hook() {
 #  define I2C_SCL_PIN   8
 #endif
 
+// Push only the x-range of dirty rects (0 = full-width row bands, for
+// panels that ignore the column window)
+#ifndef GFX_PARTIAL_COLUMNS
+#  define GFX_PARTIAL_COLUMNS  1
+#endif
+
+// Present from a second PSRAM frame on its own task (0 = push inline)
+#ifndef GFX_ASYNC_PRESENT
+#  define GFX_ASYNC_PRESENT    1
+#endif
+#define GFX_PRESENT_CORE       0       // UI, VacuumCtrl, SensorRead live on core 1
+#define GFX_PRESENT_PRIO       2
+#define GFX_PRESENT_STACK   3072
+#define GFX_PRESENT_RECTS     24
+
+// Static background layers kept in PSRAM (300 KB each)
+#ifndef GFX_BG_SLOTS
+#  define GFX_BG_SLOTS         4
+#endif
+
+#define GFX_W            320
+#define GFX_H            480
+#define GFX_BOUNCE_PX    (GFX_W * 16)    // internal DMA staging for narrow rects
+
 #define AXS15231B_TOUCH_ADDR  0x3B
 #define AXS15231B_TOUCH_REG   0x02
 
@@ -71,6 +103,27 @@ static IRAM_ATTR void feed_mwdt1_hook() {
 #define TFT_DARKCYAN 0x03EF
 #define TFT_TRANSPARENT 0xFFFF
 
+// flush() counters (bytes = pixels x 2 over QSPI). Render = UI time
+// between flushes, wait = flush() blocked on the previous transfer,
+// copy = canvas -> present frame, transfer = QSPI push (present task).
+struct GfxFlushStats {
+    uint32_t frames;        // flushes that pushed anything
+    uint32_t fullFrames;    // ... that pushed every row
+    uint32_t skipped;       // flushes with nothing dirty
+    uint32_t lastBytes;
+    uint16_t lastRects;
+    uint32_t lastRenderUs;
+    uint32_t lastWaitUs;
+    uint32_t lastCopyUs;
+    uint32_t lastTransferUs;
+    uint32_t maxTransferUs;
+    uint64_t totalBytes;
+    uint64_t totalRenderUs;
+    uint64_t totalWaitUs;
+    uint64_t totalCopyUs;
+    uint64_t totalTransferUs;
+};
+
 class TFT_GFX {
 public:
     TFT_GFX() {}
@@ -92,6 +145,18 @@ public:
             if (!_panel->begin()) { return false; }
         } else {
             Serial.println("GFX: canvas OK"); Serial.flush();
+            _bounce = (uint16_t*)heap_caps_malloc(GFX_BOUNCE_PX * 2, MALLOC_CAP_DMA | MALLOC_CAP_INTERNAL);
+            _dirty.addFull();
+#if GFX_ASYNC_PRESENT
+            _front = (uint16_t*)heap_caps_malloc(GFX_W * GFX_H * 2, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+            _idle  = xSemaphoreCreateBinary();
+            if (_front && _idle) {
+                xSemaphoreGive(_idle);
+                xTaskCreatePinnedToCore(_presentTaskFn, "GfxPresent", GFX_PRESENT_STACK, this,
+                                        GFX_PRESENT_PRIO, &_presentTask, GFX_PRESENT_CORE);
+            }
+            Serial.printf("GFX: %s present\n", _presentTask ? "async" : "inline"); Serial.flush();
+#endif
         }
         Serial.println("GFX: begin OK"); Serial.flush();
         pinMode(LCD_BL_PIN, OUTPUT);
@@ -99,61 +164,185 @@ public:
         return true;
     }
     void init() { this->begin(); }
+    // Push the damaged parts of the canvas. A full-frame damage (fillScreen)
+    // is narrowed to the rows whose hash changed since the last push.
+    //
+    // Async present: the damage is copied into a second PSRAM frame and
+    // pushed by the GfxPresent task (core 0) while the UI renders the next
+    // frame into the canvas. flush() blocks (yields) only if the previous
+    // push is still running; the present task gives _idle when done.
     void flush() {
-        if (!_canvas) return; uint16_t* fb=_canvas->getFramebuffer(); if(!fb)return;
-        Serial.println("FL1"); Serial.flush();
-        uint32_t t0=millis();
-        _panel->draw16bitRGBBitmap(0,0,fb,320,1); // just 1 line!
-        Serial.printf("FL1 %dms\n",millis()-t0); Serial.flush(); }
+        if (!_canvas) return;
+        uint16_t* fb = _canvas->getFramebuffer();
+        if (!fb) return;
+        if (_dirty.empty()) { _stats.skipped++; return; }
+
+        int64_t t0 = esp_timer_get_time();
+        uint32_t renderUs = _lastFlushUs ? (uint32_t)(t0 - _lastFlushUs) : 0;
+        if (_presentTask) xSemaphoreTake(_idle, portMAX_DELAY);   // previous frame's transfer
+        int64_t t1 = esp_timer_get_time();
+
+        _job.clear();
+        if (_dirty.full()) {
+            for (int16_t y = 0; y < GFX_H; y++) {
+                uint32_t h = dirty::rowHash(fb + y * GFX_W, GFX_W);
+                _rowChanged[y] = (h != _rowHash[y]);
+                _rowHash[y] = h;
+            }
+            dirty::changedRuns(_rowChanged, GFX_H, GFX_W, [&](int16_t y, int16_t h) {
+                _job.add({ 0, y, GFX_W, h });
+            });
+            if (_job.pixels() == (uint32_t)GFX_W * GFX_H) _stats.fullFrames++;
+        } else {
+            for (uint8_t i = 0; i < _dirty.count(); i++) {
+                const DirtyRect& d = _dirty.rect(i);
+                _job.add(GFX_PARTIAL_COLUMNS ? d : DirtyRect{ 0, d.y, GFX_W, d.h });
+                for (int16_t y = d.y; y < d.bottom(); y++) _rowHash[y] = 0;   // panel no longer matches the hash
+            }
+        }
+        _dirty.clear();
+
+        uint32_t px = _job.pixels();
+        _stats.frames++;
+        _stats.lastBytes = px * 2;
+        _stats.lastRects = _job.n;
+        _stats.totalBytes += (uint64_t)px * 2;
+        _stats.lastRenderUs = renderUs;
+        _stats.totalRenderUs += renderUs;
+        _stats.lastWaitUs = (uint32_t)(t1 - t0);
+        _stats.totalWaitUs += _stats.lastWaitUs;
+
+        if (_presentTask) {
+            for (uint8_t i = 0; i < _job.n; i++) _copyRect(fb, _front, _job.r[i]);
+            _stats.lastCopyUs = (uint32_t)(esp_timer_get_time() - t1);
+            _stats.totalCopyUs += _stats.lastCopyUs;
+            xTaskNotifyGive(_presentTask);
+        } else {
+            _present(fb);                                          // inline, from the canvas
+        }
+        _lastFlushUs = esp_timer_get_time();
+    }
+    // Block until the last pushed frame is on the panel (sleep, mode switch)
+    void flushWait() {
+        if (!_presentTask) return;
+        xSemaphoreTake(_idle, portMAX_DELAY);
+        xSemaphoreGive(_idle);
+    }
+    const GfxFlushStats& flushStats() const { return _stats; }
+    void resetFlushStats() { memset(&_stats, 0, sizeof(_stats)); _bg.resetStats(); }
+    void printFlushStats() {
+        const GfxFlushStats& s = _stats;
+        uint32_t n = s.frames ? s.frames : 1;
+        Serial.println("\n=== GFX flush ===");
+        Serial.printf("Present %s, frames %lu (full %lu, idle %lu)\n",
+                      _presentTask ? "async (core 0)" : "inline", s.frames, s.fullFrames, s.skipped);
+        Serial.printf("Last %lu B in %u rects; avg %lu B/frame vs %lu B full frame\n",
+                      s.lastBytes, s.lastRects, (uint32_t)(s.totalBytes / n), (uint32_t)GFX_W * GFX_H * 2);
+        Serial.printf("Avg render %lu us, wait %lu us, copy %lu us, transfer %lu us (max %lu us)\n",
+                      (uint32_t)(s.totalRenderUs / n), (uint32_t)(s.totalWaitUs / n),
+                      (uint32_t)(s.totalCopyUs / n), (uint32_t)(s.totalTransferUs / n), s.maxTransferUs);
+        // Share of transfer time the UI task spent rendering instead of waiting
+        uint64_t waitPct = s.totalTransferUs ? s.totalWaitUs * 100 / s.totalTransferUs : 100;
+        uint32_t overlap = waitPct >= 100 ? 0 : (uint32_t)(100 - waitPct);
+        Serial.printf("Overlap %lu %%\n", overlap);
+        printBgStats();
+        printGlyphStats();
+    }
+    // Static background layer of a screen: on a hit the canvas becomes
+    // the cached layer (one PSRAM memcpy, row hashes narrow the push);
+    // on a miss the caller draws the static parts and captures them.
+    bool bgRestore(uint16_t key) {
+        uint16_t* fb = _canvas ? _canvas->getFramebuffer() : nullptr;
+        const uint16_t* px = fb ? _bg.find(key) : nullptr;
+        if (!px) return false;
+        memcpy(fb, px, GFX_W * GFX_H * 2);
+        _dirty.addFull();
+        return true;
+    }
+    void bgCapture(uint16_t key) {
+        uint16_t* fb = _canvas ? _canvas->getFramebuffer() : nullptr;
+        if (!fb) return;
+        uint16_t* px = _bg.claim(key, GFX_W * GFX_H * 2, [](uint32_t bytes) {
+            return heap_caps_malloc(bytes, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+        });
+        if (!px) return;
+        memcpy(px, fb, GFX_W * GFX_H * 2);
+        _bg.commit(key);
+    }
+    // Language change: every layer re-renders on its next use
+    void bgInvalidateAll() { _bg.invalidateAll(); }
+    void printBgStats() {
+        const BgCacheStats& b = _bg.stats();
+        Serial.printf("Background cache: %u/%u layers, hits %lu, misses %lu, evictions %lu, alloc fails %lu\n",
+                      _bg.used(), GFX_BG_SLOTS, b.hits, b.misses, b.evictions, b.allocFails);
+    }
+    // Hangul text: non-ASCII strings are drawn from the glyph atlas
+    void setGlyphFont(const GlyphFont* font, HangulAtlas* atlas) { _glyphFont = font; _atlas = atlas; }
+    bool hasGlyphFont() const { return _glyphFont && _glyphFont->ready() && _atlas; }
+    void printGlyphStats() {
+        if (!hasGlyphFont()) { Serial.println("Glyph atlas: no font"); return; }
+        const GlyphAtlasStats& g = _atlas->stats();
+        Serial.printf("Glyph atlas: %u/%u glyphs, hits %lu, misses %lu, evictions %lu, load fails %lu\n",
+                      _atlas->used(), GLYPH_ATLAS_SLOTS, g.hits, g.misses, g.evictions, g.loadFails);
+    }
     void setBrightness(uint8_t val) { analogWrite(LCD_BL_PIN, val); }
 
     void drawPixel(int32_t x, int32_t y, uint16_t color) {
-        if (_canvas) { uint16_t* fb=_canvas->getFramebuffer(); int16_t cw=_canvas->width(); int16_t ch=_canvas->height(); if(fb&&x>=0&&x<cw&&y>=0&&y<ch) fb[y*cw+x]=color; return; }
+        if (_canvas) { uint16_t* fb=_canvas->getFramebuffer(); int16_t cw=_canvas->width(); int16_t ch=_canvas->height(); if(fb&&x>=0&&x<cw&&y>=0&&y<ch){ fb[y*cw+x]=color; _dirty.add(x, y, 1, 1); } return; }
         _gfx->drawPixel(x, y, color); }
-    void drawLine(int32_t x0, int32_t y0, int32_t x1, int32_t y1, uint16_t color) { _gfx->drawLine(x0, y0, x1, y1, color); }
+    void drawLine(int32_t x0, int32_t y0, int32_t x1, int32_t y1, uint16_t color) {
+        _mark(min(x0, x1), min(y0, y1), abs(x1 - x0) + 1, abs(y1 - y0) + 1);
+        _gfx->drawLine(x0, y0, x1, y1, color); }
     void drawFastHLine(int32_t x, int32_t y, int32_t w, uint16_t color) {
-        if (_canvas) { uint16_t* fb=_canvas->getFramebuffer(); int16_t cw=_canvas->width(); int16_t ch=_canvas->height(); if(fb&&y>=0&&y<ch){uint16_t* p=fb+y*cw+x; int16_t n=min((int32_t)w,cw-x); for(int i=0;i<n;i++) p[i]=color;} return; }
+        if (_canvas) { uint16_t* fb=_canvas->getFramebuffer(); int16_t cw=_canvas->width(); int16_t ch=_canvas->height(); if(x<0){w+=x;x=0;} if(fb&&y>=0&&y<ch&&x<cw&&w>0){uint16_t* p=fb+y*cw+x; int16_t n=min((int32_t)w,cw-x); for(int i=0;i<n;i++) p[i]=color; _dirty.add(x, y, n, 1);} return; }
         _gfx->drawFastHLine(x, y, w, color); }
     void drawFastVLine(int32_t x, int32_t y, int32_t h, uint16_t color) {
-        if (_canvas) { uint16_t* fb=_canvas->getFramebuffer(); int16_t cw=_canvas->width(); int16_t ch=_canvas->height(); if(fb&&x>=0&&x<cw){for(int16_t r=y;r<y+h&&r<ch;r++) fb[r*cw+x]=color;} return; }
+        if (_canvas) { uint16_t* fb=_canvas->getFramebuffer(); int16_t cw=_canvas->width(); int16_t ch=_canvas->height(); if(y<0){h+=y;y=0;} if(fb&&x>=0&&x<cw&&h>0){for(int16_t r=y;r<y+h&&r<ch;r++) fb[r*cw+x]=color; _dirty.add(x, y, 1, h);} return; }
         _gfx->drawFastVLine(x, y, h, color); }
-    void drawRect(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t color) { _gfx->drawRect(x, y, w, h, color); }
+    void drawRect(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t color) { _mark(x, y, w, h); _gfx->drawRect(x, y, w, h, color); }
+    void fillScreen(uint16_t color) { if (_canvas) _dirty.addFull(); _gfx->fillScreen(color); }
     void fillRect(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t color) {
+        _mark(x, y, w, h);
         uint32_t t0 = millis();
         _gfx->fillRect(x, y, w, h, color);
         uint32_t dt = millis() - t0;
         if (dt > 10) { Serial.printf("[fillRect] %ldms\n", dt); Serial.flush(); }
     }
-    void drawRoundRect(int32_t x, int32_t y, int32_t w, int32_t h, int32_t r, uint16_t color) { _gfx->drawRoundRect(x, y, w, h, r, color); }
-    void fillRoundRect(int32_t x, int32_t y, int32_t w, int32_t h, int32_t r, uint16_t color) { _gfx->fillRoundRect(x, y, w, h, r, color); }
-    void drawCircle(int32_t x, int32_t y, int32_t r, uint16_t color) { _gfx->drawCircle(x, y, r, color); }
-    void fillCircle(int32_t x, int32_t y, int32_t r, uint16_t color) { _gfx->fillCircle(x, y, r, color); }
-    void drawTriangle(int32_t x0, int32_t y0, int32_t x1, int32_t y1, int32_t x2, int32_t y2, uint16_t color) { _gfx->drawTriangle(x0, y0, x1, y1, x2, y2, color); }
-    void fillTriangle(int32_t x0, int32_t y0, int32_t x1, int32_t y1, int32_t x2, int32_t y2, uint16_t color) { _gfx->fillTriangle(x0, y0, x1, y1, x2, y2, color); }
+    void drawRoundRect(int32_t x, int32_t y, int32_t w, int32_t h, int32_t r, uint16_t color) { _mark(x, y, w, h); _gfx->drawRoundRect(x, y, w, h, r, color); }
+    void fillRoundRect(int32_t x, int32_t y, int32_t w, int32_t h, int32_t r, uint16_t color) { _mark(x, y, w, h); _gfx->fillRoundRect(x, y, w, h, r, color); }
+    void drawCircle(int32_t x, int32_t y, int32_t r, uint16_t color) { _mark(x - r, y - r, 2 * r + 1, 2 * r + 1); _gfx->drawCircle(x, y, r, color); }
+    void fillCircle(int32_t x, int32_t y, int32_t r, uint16_t color) { _mark(x - r, y - r, 2 * r + 1, 2 * r + 1); _gfx->fillCircle(x, y, r, color); }
+    void drawTriangle(int32_t x0, int32_t y0, int32_t x1, int32_t y1, int32_t x2, int32_t y2, uint16_t color) { _markTri(x0, y0, x1, y1, x2, y2); _gfx->drawTriangle(x0, y0, x1, y1, x2, y2, color); }
+    void fillTriangle(int32_t x0, int32_t y0, int32_t x1, int32_t y1, int32_t x2, int32_t y2, uint16_t color) { _markTri(x0, y0, x1, y1, x2, y2); _gfx->fillTriangle(x0, y0, x1, y1, x2, y2, color); }
     void setFont(const GFXfont* font = nullptr) { _gfx->setFont(font); _font = font; }
     void setTextSize(uint8_t s) { _gfx->setTextSize(s); _textSize = s; }
     void setTextColor(uint16_t fg) { _fgColor = fg; _bgColor = TFT_TRANSPARENT; _gfx->setTextColor(fg); }
     void setTextColor(uint16_t fg, uint16_t bg) { _fgColor = fg; _bgColor = bg; _gfx->setTextColor(fg, bg); }
     void setCursor(int32_t x, int32_t y) { _cursorX = x; _cursorY = y; _gfx->setCursor(x, y); }
-    template<typename T> void print(T val)   { _gfx->print(val); }
-    template<typename T> void println(T val) { _gfx->println(val); }
-    void print(const char* s)   { _gfx->print(s); }
-    void println(const char* s) { _gfx->println(s); }
+    template<typename T> void print(T val)   { print(String(val).c_str()); }
+    template<typename T> void println(T val) { println(String(val).c_str()); }
+    void print(const String& s)   { print(s.c_str()); }
+    void println(const String& s) { println(s.c_str()); }
+    void print(const char* s)   { if (_useGlyphs(s)) { _printGlyphs(s); return; } _markText(s); _gfx->print(s); }
+    void println(const char* s) {
+        if (_useGlyphs(s)) { _printGlyphs(s); _gfx->println(); return; }
+        _markText(s); _gfx->println(s);
+    }
     void println()              { _gfx->println(); }
     void printf(const char* fmt, ...) {
         char buf[256]; va_list args;
         va_start(args, fmt); vsnprintf(buf, sizeof(buf), fmt, args); va_end(args);
-        _gfx->print(buf);
+        print(buf);
     }
-    void drawString(const char* str, int32_t x, int32_t y) { _gfx->setCursor(x, y); _gfx->print(str); }
+    void drawString(const char* str, int32_t x, int32_t y) { _gfx->setCursor(x, y); print(str); }
     void drawString(const String& str, int32_t x, int32_t y) { drawString(str.c_str(), x, y); }
     void drawString(const char* str, int32_t x, int32_t y, uint8_t) { drawString(str, x, y); }
     void drawCentreString(const char* str, int32_t cx, int32_t y, uint8_t = 1) {
-        int16_t tw = _textWidth(str); _gfx->setCursor(cx - tw / 2, y); _gfx->print(str);
+        int16_t tw = _textWidth(str); _gfx->setCursor(cx - tw / 2, y); print(str);
     }
     void drawCentreString(const String& str, int32_t cx, int32_t y, uint8_t font = 1) { drawCentreString(str.c_str(), cx, y, font); }
     void drawRightString(const char* str, int32_t x, int32_t y, uint8_t = 1) {
-        int16_t tw = _textWidth(str); _gfx->setCursor(x - tw, y); _gfx->print(str);
+        int16_t tw = _textWidth(str); _gfx->setCursor(x - tw, y); print(str);
     }
     void drawRightString(const String& str, int32_t x, int32_t y, uint8_t font = 1) { drawRightString(str.c_str(), x, y, font); }
     int16_t textWidth(const char* str)   { return _textWidth(str); }
@@ -162,13 +351,13 @@ public:
         if (_font) return (int16_t)(_font->yAdvance * _textSize);
         return (int16_t)(8 * _textSize);
     }
-    void setRotation(uint8_t r) { _gfx->setRotation(r); }
+    void setRotation(uint8_t r) { _gfx->setRotation(r); if (_canvas) _dirty.addFull(); }
     int16_t width()  { return _gfx->width(); }
     int16_t height() { return _gfx->height(); }
     void startWrite() { _gfx->startWrite(); }
     void endWrite()   { _gfx->endWrite(); }
     void setSwapBytes(bool) {}
-    void pushColors(uint16_t* data, uint32_t len, bool = true) { _gfx->draw16bitRGBBitmap(_cursorX, _cursorY, data, len, 1); }
+    void pushColors(uint16_t* data, uint32_t len, bool = true) { _mark(_cursorX, _cursorY, len, 1); _gfx->draw16bitRGBBitmap(_cursorX, _cursorY, data, len, 1); }
     void pushColors(uint8_t* data, uint32_t len, bool swap = true) { pushColors(reinterpret_cast<uint16_t*>(data), len / 2, swap); }
     bool getTouch(uint16_t* x, uint16_t* y) {
         uint8_t buf[7] = {0};
@@ -198,7 +387,124 @@ private:
     uint16_t       _bgColor  = TFT_TRANSPARENT;
     int32_t        _cursorX  = 0;
     int32_t        _cursorY  = 0;
+
+    // Damage for flush(); row hashes of what the panel shows (0 = unknown)
+    DirtyRegion<8> _dirty;
+    uint32_t       _rowHash[GFX_H]    = {};
+    bool           _rowChanged[GFX_H] = {};
+    uint16_t*      _bounce            = nullptr;
+    GfxFlushStats  _stats             = {};
+    BackgroundCache<GFX_BG_SLOTS> _bg;
+    const GlyphFont* _glyphFont = nullptr;
+    HangulAtlas*     _atlas     = nullptr;
+
+    void _mark(int32_t x, int32_t y, int32_t w, int32_t h) { if (_canvas) _dirty.add(x, y, w, h); }
+    void _markTri(int32_t x0, int32_t y0, int32_t x1, int32_t y1, int32_t x2, int32_t y2) {
+        int32_t xl = min(x0, min(x1, x2)), yt = min(y0, min(y1, y2));
+        _mark(xl, yt, max(x0, max(x1, x2)) - xl + 1, max(y0, max(y1, y2)) - yt + 1);
+    }
+    // Text box from the cursor, padded by one text pixel (opaque background cells)
+    void _markText(const char* s) {
+        if (!_canvas || !s || !*s) return;
+        if (!_font && !strchr(s, '\n')) {                 // classic 6x8 cells, no wrap
+            int32_t w = (int32_t)strlen(s) * 6 * _textSize;
+            if (_gfx->getCursorX() + w <= GFX_W) {
+                _dirty.add(_gfx->getCursorX() - _textSize, _gfx->getCursorY() - _textSize,
+                           w + 2 * _textSize, 10 * _textSize);
+                return;
+            }
+        }
+        int16_t x1, y1; uint16_t w, h;
+        _gfx->getTextBounds(s, _gfx->getCursorX(), _gfx->getCursorY(), &x1, &y1, &w, &h);
+        _dirty.add(x1 - _textSize, y1 - _textSize, w + 2 * _textSize, h + 2 * _textSize);
+    }
+    // Job handed to the present task, and the frame it pushes from
+    DirtyList<GFX_PRESENT_RECTS> _job;
+    uint16_t*         _front       = nullptr;
+    TaskHandle_t      _presentTask = nullptr;
+    SemaphoreHandle_t _idle        = nullptr;
+    int64_t           _lastFlushUs = 0;
+
+    static void _presentTaskFn(void* arg) {
+        TFT_GFX* self = static_cast<TFT_GFX*>(arg);
+        for (;;) {
+            ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+            self->_present(self->_front);
+            xSemaphoreGive(self->_idle);
+        }
+    }
+    void _present(uint16_t* src) {
+        int64_t t0 = esp_timer_get_time();
+        for (uint8_t i = 0; i < _job.n; i++) _pushRect(src, _job.r[i]);
+        uint32_t us = (uint32_t)(esp_timer_get_time() - t0);
+        _stats.lastTransferUs = us;
+        _stats.totalTransferUs += us;
+        if (us > _stats.maxTransferUs) _stats.maxTransferUs = us;
+    }
+    static void _copyRect(const uint16_t* from, uint16_t* to, const DirtyRect& d) {
+        if (d.w == GFX_W) { memcpy(to + d.y * GFX_W, from + d.y * GFX_W, (size_t)d.area() * 2); return; }
+        for (int16_t y = d.y; y < d.bottom(); y++)
+            memcpy(to + y * GFX_W + d.x, from + y * GFX_W + d.x, (size_t)d.w * 2);
+    }
+    void _pushRows(uint16_t* fb, int16_t y, int16_t h) {
+        _panel->draw16bitRGBBitmap(0, y, fb + y * GFX_W, GFX_W, h);
+    }
+    // Narrow rects go through the bounce buffer in row chunks
+    void _pushRect(uint16_t* fb, const DirtyRect& d) {
+        if (d.w == GFX_W) { _pushRows(fb, d.y, d.h); return; }
+        if (!_bounce) {
+            for (int16_t y = d.y; y < d.bottom(); y++) _panel->draw16bitRGBBitmap(d.x, y, fb + y * GFX_W + d.x, d.w, 1);
+            return;
+        }
+        int16_t chunk = GFX_BOUNCE_PX / d.w;
+        for (int16_t y = d.y; y < d.bottom(); y += chunk) {
+            int16_t rows = min((int16_t)(d.bottom() - y), chunk);
+            for (int16_t r = 0; r < rows; r++) memcpy(_bounce + r * d.w, fb + (y + r) * GFX_W + d.x, d.w * 2);
+            _panel->draw16bitRGBBitmap(d.x, y, _bounce, d.w, rows);
+        }
+    }
+    // The 16 px glyph font stands in for text size 2
+    bool    _useGlyphs(const char* s) const { return s && hasGlyphFont() && !utf8::isAscii(s); }
+    uint8_t _glyphScale() const { return _textSize > 2 ? _textSize / 2 : 1; }
+
+    // Glyph run from the cursor: one atlas lookup per code point, the
+    // bitmap blitted with drawBitmap; missing glyphs draw as a box
+    void _printGlyphs(const char* s) {
+        const uint8_t sc = _glyphScale();
+        const int32_t lineH = (int32_t)_glyphFont->height() * sc;
+        int32_t x0 = _gfx->getCursorX(), x = x0, y = _gfx->getCursorY();
+        int32_t right = x;
+        for (uint32_t cp; (cp = utf8::next(s)) != 0;) {
+            if (cp == '\n') {
+                _mark(x0, y, right - x0, lineH);
+                x = x0; right = x0; y += lineH;
+                continue;
+            }
+            const GlyphEntry* e = _glyphFont->find(cp);
+            int32_t adv = (int32_t)(e ? e->advance : _glyphFont->advance(cp)) * sc;
+            if (_bgColor != TFT_TRANSPARENT) _gfx->fillRect(x, y, adv, lineH, _bgColor);
+            const uint8_t* bits = e ? _atlas->get(*_glyphFont, *e) : nullptr;
+            if (bits && sc == 1) {
+                _gfx->drawBitmap(x + e->xOff, y + e->yOff, bits, e->w, e->h, _fgColor);
+            } else if (bits) {
+                const uint16_t stride = (e->w + 7) / 8;
+                for (uint8_t r = 0; r < e->h; r++)
+                    for (uint8_t c = 0; c < e->w; c++)
+                        if (bits[r * stride + c / 8] & (0x80 >> (c & 7)))
+                            _gfx->fillRect(x + (e->xOff + c) * sc, y + (e->yOff + r) * sc, sc, sc, _fgColor);
+            } else if (cp != ' ') {
+                _gfx->drawRect(x + sc, y + 2 * sc, adv - 2 * sc, lineH - 4 * sc, _fgColor);
+            }
+            x += adv;
+            if (x > right) right = x;
+        }
+        _mark(x0, y, right - x0, lineH);
+        _gfx->setCursor(x, y);
+    }
+
     int16_t _textWidth(const char* str) {
+        if (_useGlyphs(str)) return (int16_t)(_glyphFont->textWidth(str) * _glyphScale());
+        if (!_font && !strchr(str, '\n')) return (int16_t)(strlen(str) * 6 * _textSize);
         int16_t x1, y1; uint16_t w, h;
         _gfx->getTextBounds(str, 0, 0, &x1, &y1, &w, &h);
         return (int16_t)w;
@@ -0,0 +1,218 @@
+// GestureRecognizer.h
+// ================================================================
+// Touch samples -> tap / long-press / drag / swipe
+// ================================================================
+//  The touch reader (TouchDispatcher.cpp) reads the AXS15231B only
+//  when its INT line fires and queues one timestamped TouchSample per
+//  change: finger down, moved, lifted. The UI task feeds the queue
+//  through this recognizer and dispatches the gestures it emits, so a
+//  held finger is one tap on release instead of a handler call every
+//  50 ms poll.
+//
+//    tap         down + up inside tapSlop, shorter than longPress
+//    long-press  held inside tapSlop for longPress (emitted by tick())
+//    drag        moved past tapSlop; one event per move with the
+//                delta since the previous one, then DRAG_END
+//    swipe       a drag released within swipeMaxMs after covering
+//                swipeMinPx; replaces DRAG_END
+//
+//  TouchChangeTracker is the reader's side: it decides which reads are
+//  changes and keeps a change that did not fit in the queue until it
+//  does.
+//
+//  A lift shorter than debounceMs followed by a new press is contact
+//  bounce and continues the same touch, so lifts are only committed
+//  by a later sample or tick() once the debounce window has passed.
+// ================================================================
+#ifndef GESTURE_RECOGNIZER_H
+#define GESTURE_RECOGNIZER_H
+
+#include <cstdint>
+#include <cstdlib>
+
+struct TouchSample {
+    uint32_t ms;
+    int16_t  x, y;
+    bool     down;          // false: finger lifted (x, y unused)
+};
+
+enum GestureType : uint8_t {
+    GESTURE_TAP,
+    GESTURE_LONG_PRESS,
+    GESTURE_DRAG,
+    GESTURE_DRAG_END,
+    GESTURE_SWIPE,
+};
+
+enum SwipeDir : uint8_t { SWIPE_NONE, SWIPE_LEFT, SWIPE_RIGHT, SWIPE_UP, SWIPE_DOWN };
+
+struct Gesture {
+    GestureType type;
+    SwipeDir    dir;        // SWIPE only
+    int16_t     x, y;       // where the touch started (TAP, LONG_PRESS: the point)
+    int16_t     dx, dy;     // DRAG: since the last DRAG; DRAG_END / SWIPE: whole touch
+    uint32_t    ms;         // sample time that produced it
+};
+
+struct GestureConfig {
+    uint16_t tapSlopPx   = 12;
+    uint16_t longPressMs = 600;
+    uint16_t swipeMinPx  = 60;
+    uint16_t swipeMaxMs  = 300;
+    uint16_t debounceMs  = 30;
+};
+
+// Reader side: the last state handed to the queue. A read is only
+// committed once the queue accepts it, so a change that finds the
+// queue full (a lift above all) is sent again on the next read instead
+// of being lost.
+struct TouchChangeTracker {
+    bool    down = false;
+    bool    pending = false;    // last change not queued yet: keep reading
+    int16_t x = 0, y = 0;
+
+    bool changed(bool nowDown, int16_t nx, int16_t ny) const {
+        return nowDown != down || (nowDown && (nx != x || ny != y));
+    }
+    void sent(const TouchSample& s) {
+        down = s.down;
+        x = s.x;
+        y = s.y;
+        pending = false;
+    }
+    void dropped() { pending = true; }
+};
+
+struct GestureStats {
+    uint32_t samples;
+    uint32_t bounces;       // lifts merged back into the touch
+    uint32_t taps, longPresses, drags, swipes;
+    uint32_t dropped;       // output queue full
+};
+
+class GestureRecognizer {
+public:
+    static constexpr uint8_t QUEUE = 8;
+
+    explicit GestureRecognizer(const GestureConfig& cfg = GestureConfig()) : cfg_(cfg) { reset(); }
+
+    void reset() {
+        state_ = IDLE;
+        upPending_ = false;
+        head_ = count_ = 0;
+        stats_ = {};
+    }
+
+    void feed(const TouchSample& s) {
+        stats_.samples++;
+        if (upPending_) {
+            if (s.down && s.ms - upMs_ < cfg_.debounceMs) {
+                upPending_ = false;                 // bounce: same touch
+                stats_.bounces++;
+            } else {
+                release();
+            }
+        }
+        if (!s.down) {
+            if (state_ != IDLE) { upPending_ = true; upMs_ = s.ms; }
+            return;
+        }
+        if (state_ == IDLE) {
+            state_ = PRESSED;
+            x0_ = lastX_ = s.x;
+            y0_ = lastY_ = s.y;
+            downMs_ = s.ms;
+            return;
+        }
+        move(s);
+    }
+
+    // Time-driven transitions: long-press and debounced lifts
+    void tick(uint32_t now) {
+        if (upPending_ && now - upMs_ >= cfg_.debounceMs) release();
+        if (state_ == PRESSED && !upPending_ && now - downMs_ >= cfg_.longPressMs) {
+            state_ = LONG;
+            emit(GESTURE_LONG_PRESS, SWIPE_NONE, 0, 0, now);
+            stats_.longPresses++;
+        }
+    }
+
+    bool next(Gesture& g) {
+        if (!count_) return false;
+        g = q_[head_];
+        head_ = (head_ + 1) % QUEUE;
+        count_--;
+        return true;
+    }
+
+    bool touching() const { return state_ != IDLE && !upPending_; }
+    const GestureStats& stats() const { return stats_; }
+    void resetStats() { stats_ = {}; }
+
+private:
+    enum State : uint8_t { IDLE, PRESSED, DRAGGING, LONG };
+
+    void move(const TouchSample& s) {
+        if (state_ == PRESSED) {
+            if (abs(s.x - x0_) <= cfg_.tapSlopPx && abs(s.y - y0_) <= cfg_.tapSlopPx) return;
+            if (s.ms - downMs_ >= cfg_.longPressMs) {       // long-press not ticked yet
+                tick(s.ms);
+                return;
+            }
+            state_ = DRAGGING;
+            stats_.drags++;
+        }
+        if (state_ != DRAGGING || (s.x == lastX_ && s.y == lastY_)) return;
+        emit(GESTURE_DRAG, SWIPE_NONE, s.x - lastX_, s.y - lastY_, s.ms);
+        lastX_ = s.x;
+        lastY_ = s.y;
+    }
+
+    void release() {
+        upPending_ = false;
+        if (state_ == PRESSED) {
+            emit(GESTURE_TAP, SWIPE_NONE, 0, 0, upMs_);
+            stats_.taps++;
+        } else if (state_ == DRAGGING) {
+            int16_t dx = lastX_ - x0_, dy = lastY_ - y0_;
+            bool horiz = abs(dx) >= abs(dy);
+            uint16_t dist = (uint16_t)(horiz ? abs(dx) : abs(dy));
+            if (upMs_ - downMs_ <= cfg_.swipeMaxMs && dist >= cfg_.swipeMinPx) {
+                SwipeDir d = horiz ? (dx < 0 ? SWIPE_LEFT : SWIPE_RIGHT) : (dy < 0 ? SWIPE_UP : SWIPE_DOWN);
+                emit(GESTURE_SWIPE, d, dx, dy, upMs_);
+                stats_.swipes++;
+            } else {
+                emit(GESTURE_DRAG_END, SWIPE_NONE, dx, dy, upMs_);
+            }
+        }
+        state_ = IDLE;
+    }
+
+    // Consecutive drag moves coalesce when the consumer lags, so the
+    // queue never fills during a long drag
+    void emit(GestureType t, SwipeDir d, int16_t dx, int16_t dy, uint32_t ms) {
+        if (t == GESTURE_DRAG && count_) {
+            Gesture& tail = q_[(head_ + count_ - 1) % QUEUE];
+            if (tail.type == GESTURE_DRAG) {
+                tail.dx += dx;
+                tail.dy += dy;
+                tail.ms = ms;
+                return;
+            }
+        }
+        if (count_ == QUEUE) { stats_.dropped++; return; }
+        q_[(head_ + count_) % QUEUE] = { t, d, x0_, y0_, dx, dy, ms };
+        count_++;
+    }
+
+    GestureConfig cfg_;
+    State         state_;
+    bool          upPending_;
+    uint32_t      downMs_ = 0, upMs_ = 0;
+    int16_t       x0_ = 0, y0_ = 0, lastX_ = 0, lastY_ = 0;
+    Gesture       q_[QUEUE];
+    uint8_t       head_, count_;
+    GestureStats  stats_;
+};
+
+#endif // GESTURE_RECOGNIZER_H
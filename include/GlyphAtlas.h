@@ -0,0 +1,297 @@
+// GlyphAtlas.h
+// ================================================================
+// Hangul-capable bitmap font: UTF-8 decoder, HGF font file, glyph LRU
+// ================================================================
+//  The built-in 6x8 GFX font has no Hangul, so Korean strings from
+//  Lang.cpp need their own glyphs. tools/hgf_build.py turns a TTF or
+//  BDF subset (ASCII, KS X 1001 Hangul, every character used in
+//  Lang.cpp) into an HGF file on SPIFFS:
+//
+//    header  16 B   "HGF1", height, ascent, flags(u16), count(u32),
+//                   index offset(u32)
+//    index   16 B x count, sorted by code point (GlyphEntry)
+//    bitmaps 1 bpp, MSB first, rows padded to whole bytes
+//
+//  GlyphFont keeps only the index in memory (PSRAM on the target), so
+//  measuring text is a sum of advances from the table; no raster.
+//  Bitmaps are read on demand into GlyphAtlas, a fixed set of slots
+//  with a code point hash and an LRU list: a hit is O(1), a miss
+//  reads one glyph and evicts the least recently drawn one. Boot
+//  prewarms the glyphs of every LangKey string.
+// ================================================================
+#ifndef GLYPH_ATLAS_H
+#define GLYPH_ATLAS_H
+
+#include <cstdint>
+#include <cstring>
+
+// ================================================================
+// UTF-8
+// ================================================================
+namespace utf8 {
+
+constexpr uint32_t REPLACEMENT = 0xFFFD;
+
+// Decode one code point and advance s. Malformed input (stray
+// continuation, overlong form, surrogate, > U+10FFFF, truncated
+// sequence) yields U+FFFD and skips one byte. Returns 0 at the end.
+inline uint32_t next(const char*& s) {
+    const uint8_t* p = (const uint8_t*)s;
+    uint8_t b = p[0];
+    if (b == 0) return 0;
+    if (b < 0x80) { s++; return b; }
+
+    uint8_t  n;
+    uint32_t cp, min;
+    if      ((b & 0xE0) == 0xC0) { n = 1; cp = b & 0x1F; min = 0x80; }
+    else if ((b & 0xF0) == 0xE0) { n = 2; cp = b & 0x0F; min = 0x800; }
+    else if ((b & 0xF8) == 0xF0) { n = 3; cp = b & 0x07; min = 0x10000; }
+    else { s++; return REPLACEMENT; }
+
+    for (uint8_t i = 1; i <= n; i++) {
+        if ((p[i] & 0xC0) != 0x80) { s++; return REPLACEMENT; }   // also stops at '\0'
+        cp = (cp << 6) | (p[i] & 0x3F);
+    }
+    if (cp < min || cp > 0x10FFFF || (cp >= 0xD800 && cp <= 0xDFFF)) { s++; return REPLACEMENT; }
+    s += n + 1;
+    return cp;
+}
+
+inline bool isAscii(const char* s) {
+    for (; *s; s++) {
+        if ((uint8_t)*s >= 0x80) return false;
+    }
+    return true;
+}
+
+} // namespace utf8
+
+// ================================================================
+// HGF font file
+// ================================================================
+constexpr uint32_t HGF_HEADER_BYTES = 16;
+
+struct GlyphEntry {
+    uint32_t cp;
+    uint32_t offset;        // of the bitmap, from the start of the file
+    uint8_t  w, h;          // bitmap size
+    int8_t   xOff, yOff;    // bitmap origin from the pen / the line top
+    uint8_t  advance;
+    uint8_t  reserved[3];
+
+    uint32_t bitmapBytes() const { return (uint32_t)((w + 7) / 8) * h; }
+};
+static_assert(sizeof(GlyphEntry) == 16, "HGF index entry is 16 bytes");
+
+class GlyphFont {
+public:
+    // Reads len bytes at offset of the font file
+    typedef bool (*ReadFn)(void* ctx, uint32_t offset, void* dst, uint32_t len);
+
+    // Parses the header and loads the index into alloc(bytes) memory
+    template <typename Alloc>
+    bool open(ReadFn read, void* ctx, Alloc&& alloc) {
+        read_ = read;
+        ctx_ = ctx;
+        count_ = 0;
+        uint8_t h[HGF_HEADER_BYTES];
+        if (!read_(ctx_, 0, h, sizeof(h)) || memcmp(h, "HGF1", 4) != 0) return false;
+        height_ = h[4];
+        ascent_ = h[5];
+        uint32_t count = le32(h + 8), indexOff = le32(h + 12);
+        if (count == 0 || count > 65535 || height_ == 0) return false;
+
+        index_ = (GlyphEntry*)alloc(count * sizeof(GlyphEntry));
+        if (!index_ || !read_(ctx_, indexOff, index_, count * sizeof(GlyphEntry))) return false;
+        for (uint32_t i = 1; i < count; i++) {
+            if (index_[i].cp <= index_[i - 1].cp) return false;   // must be sorted for find()
+        }
+        count_ = count;
+        for (uint8_t c = 0; c < 128; c++) ascii_[c] = NONE;
+        for (uint32_t i = 0; i < count_ && index_[i].cp < 128; i++) ascii_[index_[i].cp] = (uint16_t)i;
+        return true;
+    }
+
+    bool     ready() const { return count_ > 0; }
+    uint8_t  height() const { return height_; }
+    uint8_t  ascent() const { return ascent_; }
+    uint32_t count() const { return count_; }
+
+    const GlyphEntry* find(uint32_t cp) const {
+        if (cp < 128) return ascii_[cp] == NONE || !count_ ? nullptr : &index_[ascii_[cp]];
+        uint32_t lo = 0, hi = count_;
+        while (lo < hi) {
+            uint32_t mid = (lo + hi) / 2;
+            if (index_[mid].cp < cp) lo = mid + 1;
+            else hi = mid;
+        }
+        return lo < count_ && index_[lo].cp == cp ? &index_[lo] : nullptr;
+    }
+
+    // Missing glyphs are drawn as a half-em box
+    uint8_t advance(uint32_t cp) const {
+        const GlyphEntry* e = find(cp);
+        return e ? e->advance : (uint8_t)(height_ / 2);
+    }
+
+    int32_t textWidth(const char* s) const {
+        int32_t w = 0;
+        for (uint32_t cp; (cp = utf8::next(s)) != 0;) w += advance(cp);
+        return w;
+    }
+
+    bool readBitmap(const GlyphEntry& e, uint8_t* dst) const {
+        return read_(ctx_, e.offset, dst, e.bitmapBytes());
+    }
+
+private:
+    static constexpr uint16_t NONE = 0xFFFF;
+    static uint32_t le32(const uint8_t* p) {
+        return (uint32_t)p[0] | (uint32_t)p[1] << 8 | (uint32_t)p[2] << 16 | (uint32_t)p[3] << 24;
+    }
+
+    ReadFn      read_ = nullptr;
+    void*       ctx_ = nullptr;
+    GlyphEntry* index_ = nullptr;
+    uint32_t    count_ = 0;
+    uint8_t     height_ = 0;
+    uint8_t     ascent_ = 0;
+    uint16_t    ascii_[128];
+};
+
+// ================================================================
+// Glyph bitmap LRU
+// ================================================================
+struct GlyphAtlasStats {
+    uint32_t hits;
+    uint32_t misses;
+    uint32_t evictions;
+    uint32_t loadFails;     // read error or glyph larger than a slot
+};
+
+template <uint16_t SLOTS, uint16_t SLOT_BYTES>
+class GlyphAtlas {
+public:
+    static constexpr uint32_t BYTES = (uint32_t)SLOTS * SLOT_BYTES;
+
+    // mem: BYTES of bitmap storage (PSRAM on the target)
+    void begin(uint8_t* mem) {
+        mem_ = mem;
+        memset(table_, 0, sizeof(table_));
+        for (uint16_t i = 0; i < SLOTS; i++) {
+            cp_[i] = EMPTY;
+            prev_[i] = i == 0 ? NIL : (uint16_t)(i - 1);
+            next_[i] = i + 1 == SLOTS ? NIL : (uint16_t)(i + 1);
+        }
+        head_ = 0;
+        tail_ = SLOTS - 1;
+        memset(&stats_, 0, sizeof(stats_));
+    }
+
+    // Bitmap of e, loading it on a miss; nullptr if it cannot be loaded
+    const uint8_t* get(const GlyphFont& f, const GlyphEntry& e) {
+        if (!mem_) return nullptr;
+        uint16_t pos = lookup(e.cp);
+        if (pos != NIL) {
+            uint16_t s = table_[pos] - 1;
+            touch(s);
+            stats_.hits++;
+            return slot(s);
+        }
+        stats_.misses++;
+        if (e.bitmapBytes() > SLOT_BYTES) { stats_.loadFails++; return nullptr; }
+
+        uint16_t s = tail_;
+        if (cp_[s] != EMPTY) {
+            erase(cp_[s]);
+            cp_[s] = EMPTY;
+            stats_.evictions++;
+        }
+        if (!f.readBitmap(e, slot(s))) { stats_.loadFails++; return nullptr; }
+        cp_[s] = e.cp;
+        insert(e.cp, s);
+        touch(s);
+        return slot(s);
+    }
+
+    // Load every glyph of text; returns how many are resident
+    uint32_t prewarm(const GlyphFont& f, const char* text) {
+        uint32_t n = 0;
+        for (uint32_t cp; (cp = utf8::next(text)) != 0;) {
+            const GlyphEntry* e = f.find(cp);
+            if (e && get(f, *e)) n++;
+        }
+        return n;
+    }
+
+    bool contains(uint32_t cp) const { return lookup(cp) != NIL; }
+    uint16_t used() const {
+        uint16_t n = 0;
+        for (uint16_t i = 0; i < SLOTS; i++) n += cp_[i] != EMPTY;
+        return n;
+    }
+    const GlyphAtlasStats& stats() const { return stats_; }
+    void resetStats() { memset(&stats_, 0, sizeof(stats_)); }
+
+private:
+    static constexpr uint16_t NIL   = 0xFFFF;
+    static constexpr uint32_t EMPTY = 0xFFFFFFFF;
+    static constexpr uint8_t  BITS  = SLOTS <= 64 ? 7 : SLOTS <= 256 ? 9 : SLOTS <= 1024 ? 11 : 13;
+    static constexpr uint16_t HASH  = 1u << BITS;              // >= 2 x SLOTS, linear probing
+    static_assert(SLOTS * 2 <= HASH && SLOTS < NIL, "atlas too large");
+
+    uint8_t* slot(uint16_t s) const { return mem_ + (uint32_t)s * SLOT_BYTES; }
+    static uint16_t home(uint32_t cp) { return (uint16_t)((cp * 2654435761u) >> (32 - BITS)); }
+
+    uint16_t lookup(uint32_t cp) const {
+        for (uint16_t i = home(cp);; i = (i + 1) & (HASH - 1)) {
+            if (table_[i] == 0) return NIL;
+            if (cp_[table_[i] - 1] == cp) return i;
+        }
+    }
+    void insert(uint32_t cp, uint16_t s) {
+        uint16_t i = home(cp);
+        while (table_[i] != 0) i = (i + 1) & (HASH - 1);
+        table_[i] = s + 1;
+    }
+    // Backward-shift delete keeps every probe chain unbroken
+    void erase(uint32_t cp) {
+        uint16_t i = lookup(cp);
+        if (i == NIL) return;
+        table_[i] = 0;
+        for (uint16_t j = (i + 1) & (HASH - 1); table_[j] != 0; j = (j + 1) & (HASH - 1)) {
+            uint16_t k = home(cp_[table_[j] - 1]);
+            bool movable = i <= j ? (k <= i || k > j) : (k <= i && k > j);
+            if (movable) {
+                table_[i] = table_[j];
+                table_[j] = 0;
+                i = j;
+            }
+        }
+    }
+    // Move slot s to the MRU end
+    void touch(uint16_t s) {
+        if (s == head_) return;
+        next_[prev_[s]] = next_[s];
+        if (next_[s] != NIL) prev_[next_[s]] = prev_[s];
+        else tail_ = prev_[s];
+        prev_[s] = NIL;
+        next_[s] = head_;
+        prev_[head_] = s;
+        head_ = s;
+    }
+
+    uint8_t*        mem_ = nullptr;
+    uint32_t        cp_[SLOTS];
+    uint16_t        prev_[SLOTS], next_[SLOTS];
+    uint16_t        head_ = 0, tail_ = 0;
+    uint16_t        table_[HASH];
+    GlyphAtlasStats stats_ = {};
+};
+
+// Target sizes: 512 glyphs of up to 24 x 24 px (72 B) = 36 KB of PSRAM
+constexpr uint16_t GLYPH_ATLAS_SLOTS = 512;
+constexpr uint16_t GLYPH_SLOT_BYTES  = 72;
+typedef GlyphAtlas<GLYPH_ATLAS_SLOTS, GLYPH_SLOT_BYTES> HangulAtlas;
+
+#endif // GLYPH_ATLAS_H
@@ -73,6 +73,30 @@
 #define SD_MAX_RETRY_COUNT      3       // SD   
 #define SD_RETRY_DELAY_MS       200     //   (ms)
 
+// Write-behind logging (SdLogService.cpp, LogWriteBehind.h)
+#define SDLOG_BLOCK_SIZE         8192    // aligned write unit (16 sectors)
+#define SDLOG_MAX_WRITE_PER_TICK 16384   // bound on one stream per pass
+#define SDLOG_MAX_AGE_MS         10000   // oldest buffered record reaches the file
+#define SDLOG_MAX_AGE_ERROR_MS   1000    // error_log: short window
+#define SDLOG_SYNC_INTERVAL_MS   5000    // File.flush() while dirty
+#define SDLOG_REOPEN_RETRY_MS    2000
+#define SDLOG_TICK_MS            250
+#define SDLOG_TASK_STACK         4096
+
+// Binary trend history (TsLogger.cpp, TsLog.h)
+#define TSLOG_MAX_BLOCK_SPAN_MS  120000  // seal a 4 KB block after this even if not full
+
+// Log rotation / retention (SdLogService.cpp, LogRetentionService.cpp)
+#define SDLOG_ROTATE_BYTES       (4UL << 20)   // CSV logs: new segment at 4 MB or at local midnight
+#define LOGRET_BUDGET_MB         1024    // live logs + segments; capped at LOGRET_CARD_PCT of the card
+#define LOGRET_CARD_PCT          80
+#define LOGRET_MAX_AGE_DAYS      90      // 0 = size budget only
+#define LOGRET_SLICE_US          20000   // pruner work per DataLogger tick
+#define LOGRET_INTERVAL_MS       600000  // periodic pass (also after every rotation)
+
+// Health trend rollups (DataLogger.cpp, MetricRollup.h)
+#define HEALTH_SAMPLE_INTERVAL_MS 10000  // one health score into the 1 min / 1 h / 1 d buckets
+
 // SD SPI CS  (Config.h )
 #define SD_CS_PIN               46      // SD  CS 
 
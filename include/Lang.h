@@ -84,6 +84,8 @@ enum LangKey : uint8_t {
 //  API 
 void        setLanguage(Language lang);
 const char* L(LangKey key);                            //   
+const char* langString(Language lang, LangKey key);    // either language (glyph prewarm)
+bool        initKoreanFont();                          // Korean_Font.cpp, after tft.begin()
 void        printL(int16_t x, int16_t y, LangKey key); //    
 void        printL(int16_t x, int16_t y, const char* str); //   
 
@@ -0,0 +1,360 @@
+// LogRetention.h
+// ================================================================
+// Log rotation policy + incremental retention pruner
+// ================================================================
+//  Rotation: a live log (/logs/cycle_log.csv) is renamed to a segment
+//  when it passes its size limit or the local day changes:
+//      /logs/cycle_log-20261016-0.csv, -1, -2 ... (same day, by size)
+//  Day 00000000 = written before the clock was set.
+//
+//  Pruning: one pass lists the log directories, keeps the oldest
+//  segments in a bounded table and deletes from the oldest while the
+//  total (live files + segments) is over the byte budget or a segment
+//  is older than maxAgeDays. Undated segments go first. Live files
+//  never match the segment pattern and are never deleted.
+//
+//  step() does one directory entry or one delete at a time and returns
+//  once sliceUs is spent, so a pass spreads over as many ticks as the
+//  card needs and never holds the calling task long enough to trip
+//  its watchdog.
+//
+//  All directory access goes through RetentionFs (LogRetentionService.cpp
+//  implements it on the SD card under the bus lock).
+// ================================================================
+#ifndef LOG_RETENTION_H
+#define LOG_RETENTION_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+struct RotationPolicy {
+    uint32_t maxBytes;          // 0 = no size rotation
+    bool     daily;
+};
+
+struct RetentionPolicy {
+    uint64_t budgetBytes;       // live files + segments
+    uint16_t maxAgeDays;        // 0 = no age limit
+};
+
+// Directory listing + delete (SdRetentionFs on SD, MemFs in the test)
+class RetentionFs {
+public:
+    virtual ~RetentionFs() {}
+    virtual bool openDir(const char* dir) = 0;
+    // false at the end; name without the directory
+    virtual bool nextEntry(char* name, size_t cap, uint32_t& size, bool& isDir) = 0;
+    virtual void closeDir() = 0;
+    virtual bool remove(const char* path) = 0;
+};
+
+struct RetentionSegment {
+    uint32_t day;               // days since 1970-01-01, 0 = undated
+    uint16_t part;
+    uint32_t size;
+    uint8_t  dir;               // index into the pruner's directory list
+    char     name[40];
+};
+
+struct PrunerStats {
+    uint32_t passes;
+    uint32_t entries;           // directory entries read, last pass
+    uint32_t segments;          // segments seen, last pass
+    uint32_t deleted;
+    uint32_t failed;
+    uint64_t liveBytes;         // last pass
+    uint64_t segmentBytes;      // last pass, after deletes
+    uint64_t freedBytes;
+    uint32_t lastPassMs;        // wall time of the last complete pass
+    uint32_t maxStepUs;
+    uint32_t steps;             // ticks used by the last pass
+    bool     overBudget;        // live files alone exceed the budget
+};
+
+namespace retention {
+
+// Howard Hinnant's days_from_civil / civil_from_days (1970 .. 2105)
+inline uint32_t daysFromCivil(int y, unsigned m, unsigned d) {
+    y -= m <= 2;
+    int era = (y >= 0 ? y : y - 399) / 400;
+    unsigned yoe = (unsigned)(y - era * 400);
+    unsigned doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1;
+    unsigned doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return (uint32_t)(era * 146097 + (int)doe - 719468);
+}
+
+inline void civilFromDays(uint32_t z, int& y, unsigned& m, unsigned& d) {
+    uint32_t zz = z + 719468;
+    uint32_t era = zz / 146097;
+    uint32_t doe = zz - era * 146097;
+    uint32_t yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    uint32_t doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    uint32_t mp = (5 * doy + 2) / 153;
+    d = doy - (153 * mp + 2) / 5 + 1;
+    m = mp < 10 ? mp + 3 : mp - 9;
+    y = (int)(yoe + era * 400) + (m <= 2);
+}
+
+// today / segDay: days since epoch, 0 = clock not set
+inline bool rotateDue(const RotationPolicy& p, uint32_t fileBytes, uint32_t segDay, uint32_t today) {
+    if (p.maxBytes && fileBytes >= p.maxBytes) return true;
+    return p.daily && today && segDay && today != segDay;
+}
+
+// "/logs/cycle_log.csv" + day + part -> "/logs/cycle_log-20261016-0.csv"
+inline bool segmentPath(const char* base, uint32_t day, uint16_t part, char* out, size_t cap) {
+    const char* slash = strrchr(base, '/');
+    const char* dot = strrchr(base, '.');
+    if (!dot || (slash && dot < slash)) dot = base + strlen(base);
+    int y = 0;
+    unsigned m = 0, d = 0;
+    if (day) civilFromDays(day, y, m, d);
+    int n = snprintf(out, cap, "%.*s-%04d%02u%02u-%u%s", (int)(dot - base), base, y, m, d, part, dot);
+    return n > 0 && (size_t)n < cap;
+}
+
+// Segment file name (no directory) -> day / part. false = not a segment
+inline bool parseSegment(const char* name, uint32_t& day, uint16_t& part) {
+    const char* dot = strrchr(name, '.');
+    const char* end = dot ? dot : name + strlen(name);
+    const char* p = end;
+    while (p > name && p[-1] >= '0' && p[-1] <= '9') p--;
+    if (p == end || end - p > 4 || p - name < 11 || p[-1] != '-') return false;
+    const char* date = p - 9;
+    if (date[-1] != '-') return false;
+    for (int i = 0; i < 8; i++) if (date[i] < '0' || date[i] > '9') return false;
+
+    unsigned v = 0;
+    for (const char* q = p; q < end; q++) v = v * 10 + (unsigned)(*q - '0');
+    part = (uint16_t)v;
+
+    unsigned ymd = 0;
+    for (int i = 0; i < 8; i++) ymd = ymd * 10 + (unsigned)(date[i] - '0');
+    if (ymd == 0) { day = 0; return true; }
+    unsigned y = ymd / 10000, m = ymd / 100 % 100, d = ymd % 100;
+    if (y < 1970 || m < 1 || m > 12 || d < 1 || d > 31) return false;
+    day = daysFromCivil((int)y, m, d);
+    return true;
+}
+
+} // namespace retention
+
+// ================================================================
+//  Pruner
+// ================================================================
+template <size_t MAX_SEGMENTS, size_t MAX_DIRS = 4>
+class LogPruner {
+public:
+    void begin(RetentionFs* fs, const RetentionPolicy& p, uint32_t (*clockUs)()) {
+        fs_ = fs;
+        policy_ = p;
+        clock_ = clockUs;
+        nDirs_ = 0;
+        state_ = IDLE;
+        pending_ = false;
+        st_ = PrunerStats();
+    }
+
+    bool addDir(const char* dir) {
+        if (nDirs_ >= MAX_DIRS) return false;
+        dirs_[nDirs_++] = dir;
+        return true;
+    }
+
+    void setPolicy(const RetentionPolicy& p) { policy_ = p; }
+    const RetentionPolicy& policy() const { return policy_; }
+
+    // Start a pass on the next step(); ageDays > 0 overrides the age limit once
+    void request(uint16_t ageDays = 0) {
+        pending_ = true;
+        if (ageDays) ageOverride_ = ageDays;
+    }
+
+    bool busy() const { return state_ != IDLE || pending_; }
+
+    // One tick. today: days since epoch, 0 = unknown (no age pruning).
+    // Returns true while a pass is in progress.
+    bool step(uint32_t today, uint32_t sliceUs, uint32_t nowMs = 0) {
+        if (state_ == IDLE) {
+            if (!pending_ || !fs_ || nDirs_ == 0) return false;
+            startPass(today);
+        }
+        uint32_t t0 = clock();
+        passSteps_++;
+        do {
+            if (state_ == SCAN) scanOne();
+            else if (state_ == DELETE) deleteOne();
+            if (state_ == DONE) {
+                finishPass(nowMs);
+                break;
+            }
+        } while (clock() - t0 < sliceUs);
+        uint32_t us = clock() - t0;
+        if (us > st_.maxStepUs) st_.maxStepUs = us;
+        return state_ != IDLE;
+    }
+
+    PrunerStats stats() const { return st_; }
+    void resetStats() { st_ = PrunerStats(); }
+
+    // Segment table of the pass in progress / the last pass (oldest first)
+    size_t segmentCount() const { return n_; }
+    const RetentionSegment& segment(size_t i) const { return seg_[i]; }
+
+private:
+    enum State : uint8_t { IDLE, SCAN, DELETE, DONE };
+
+    void startPass(uint32_t today) {
+        pending_ = false;
+        today_ = today;
+        passAge_ = ageOverride_ ? ageOverride_ : policy_.maxAgeDays;
+        ageOverride_ = 0;
+        n_ = 0;
+        next_ = 0;
+        dir_ = 0;
+        dirOpen_ = false;
+        overflow_ = false;
+        liveBytes_ = segBytes_ = 0;
+        entries_ = segments_ = 0;
+        passSteps_ = 0;
+        state_ = SCAN;
+    }
+
+    void scanOne() {
+        if (dir_ >= nDirs_) {
+            state_ = DELETE;
+            return;
+        }
+        if (!dirOpen_) {
+            dirOpen_ = fs_->openDir(dirs_[dir_]);
+            if (!dirOpen_) dir_++;
+            return;
+        }
+        char name[sizeof(RetentionSegment::name)];
+        uint32_t size = 0;
+        bool isDir = false;
+        if (!fs_->nextEntry(name, sizeof(name), size, isDir)) {
+            fs_->closeDir();
+            dirOpen_ = false;
+            dir_++;
+            return;
+        }
+        entries_++;
+        if (isDir) return;
+
+        RetentionSegment s;
+        bool fits = strlen(name) < sizeof(name) - 1;         // else possibly truncated
+        if (!fits || !retention::parseSegment(name, s.day, s.part)) {
+            liveBytes_ += size;
+            return;
+        }
+        segments_++;
+        segBytes_ += size;
+        s.size = size;
+        s.dir = dir_;
+        strncpy(s.name, name, sizeof(s.name) - 1);
+        s.name[sizeof(s.name) - 1] = '\0';
+        insert(s);
+    }
+
+    // Sorted by (day, part); when full the newest entry falls out
+    void insert(const RetentionSegment& s) {
+        size_t i = n_;
+        if (n_ == MAX_SEGMENTS) {
+            overflow_ = true;
+            if (!older(s, seg_[n_ - 1])) return;
+            i = n_ - 1;
+        } else {
+            n_++;
+        }
+        while (i > 0 && older(s, seg_[i - 1])) {
+            seg_[i] = seg_[i - 1];
+            i--;
+        }
+        seg_[i] = s;
+    }
+
+    static bool older(const RetentionSegment& a, const RetentionSegment& b) {
+        if (a.day != b.day) return a.day < b.day;
+        if (a.part != b.part) return a.part < b.part;
+        return strcmp(a.name, b.name) < 0;
+    }
+
+    bool expired(const RetentionSegment& s) const {
+        return passAge_ && today_ && s.day && today_ > s.day && today_ - s.day > passAge_;
+    }
+
+    void deleteOne() {
+        if (next_ >= n_) {
+            // Table too small for this pass: look again for the next batch
+            if (overflow_) pending_ = true;
+            state_ = DONE;
+            return;
+        }
+        const RetentionSegment& s = seg_[next_];
+        bool over = liveBytes_ + segBytes_ > policy_.budgetBytes;
+        if (!over && !expired(s)) {
+            state_ = DONE;                       // everything after it is newer
+            return;
+        }
+        char path[96];
+        snprintf(path, sizeof(path), "%s/%s", strcmp(dirs_[s.dir], "/") == 0 ? "" : dirs_[s.dir], s.name);
+        if (fs_->remove(path)) {
+            st_.deleted++;
+            st_.freedBytes += s.size;
+            segBytes_ -= s.size;
+        } else {
+            st_.failed++;
+        }
+        next_++;
+    }
+
+    void finishPass(uint32_t nowMs) {
+        // Drop deleted entries so segment() shows what is left
+        if (next_ > 0) {
+            for (size_t i = next_; i < n_; i++) seg_[i - next_] = seg_[i];
+            n_ -= next_;
+            next_ = 0;
+        }
+        st_.passes++;
+        st_.entries = entries_;
+        st_.segments = segments_;
+        st_.liveBytes = liveBytes_;
+        st_.segmentBytes = segBytes_;
+        st_.overBudget = liveBytes_ > policy_.budgetBytes;
+        st_.lastPassMs = nowMs;
+        st_.steps = passSteps_;
+        state_ = IDLE;
+    }
+
+    uint32_t clock() const { return clock_ ? clock_() : 0; }
+
+    RetentionFs*     fs_ = nullptr;
+    RetentionPolicy  policy_ = {};
+    uint32_t       (*clock_)() = nullptr;
+    const char*      dirs_[MAX_DIRS] = {};
+    uint8_t          nDirs_ = 0;
+
+    State            state_ = IDLE;
+    bool             pending_ = false;
+    uint16_t         ageOverride_ = 0;
+    uint16_t         passAge_ = 0;
+    uint32_t         today_ = 0;
+    uint8_t          dir_ = 0;
+    bool             dirOpen_ = false;
+    bool             overflow_ = false;
+    uint64_t         liveBytes_ = 0;
+    uint64_t         segBytes_ = 0;
+    uint32_t         entries_ = 0;
+    uint32_t         segments_ = 0;
+    uint32_t         passSteps_ = 0;
+
+    RetentionSegment seg_[MAX_SEGMENTS];
+    size_t           n_ = 0;
+    size_t           next_ = 0;
+    PrunerStats      st_ = {};
+};
+
+#endif // LOG_RETENTION_H
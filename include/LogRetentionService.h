@@ -0,0 +1,19 @@
+#pragma once
+// ================================================================
+// LogRetentionService.h    SD log budget (LogRetention.h on the card)
+// ================================================================
+//  SdLogService rotates the CSV streams into dated segments; this
+//  module lists /logs and deletes the oldest segments while the total
+//  is over budget or past LOGRET_MAX_AGE_DAYS. The work runs from the
+//  DataLogger task in LOGRET_SLICE_US slices (logRetentionStep()).
+// ================================================================
+
+#include <Arduino.h>
+
+// After initSdLogService(). cardBytes caps the budget (0 = unknown)
+void initLogRetention(uint64_t cardBytes);
+void logRetentionStep();                          // DataLogger tick
+void logRetentionRequest(uint16_t ageDays = 0);   // pass on the next tick; ageDays overrides once
+
+uint32_t logRetentionToday();                     // local days since epoch, 0 = clock not set
+void printLogRetentionStats();
@@ -0,0 +1,374 @@
+// LogWriteBehind.h
+// ================================================================
+// Write-behind log stream: ring buffer -> block writes -> file
+// ================================================================
+//  - Producers append whole records (text + "\r\n") into a byte ring;
+//    nothing touches the file on their side. A full ring drops the
+//    record and counts it, producers never wait for the card.
+//  - service() runs from one background task. It keeps the file
+//    handle open and writes in blockSize multiples so the file offset
+//    stays block (cluster) aligned: first the lead-in up to the next
+//    boundary, then whole blocks. Data older than maxAgeMs is written
+//    regardless of size, and the handle is flush()ed (directory entry
+//    updated) at most every syncIntervalMs while dirty.
+//    Power-loss window: maxAgeMs + syncIntervalMs + one service tick.
+//  - A failed or short write closes the handle; the unwritten bytes
+//    stay buffered and the open is retried after reopenRetryMs.
+//
+//  Lock is a policy with lock()/unlock(); it is held only for index
+//  updates and the record memcpy, never across a sink call.
+// ================================================================
+#ifndef LOG_WRITE_BEHIND_H
+#define LOG_WRITE_BEHIND_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+// One long-lived append handle (FsLogSink on SD, StdioSink in the test)
+class LogSink {
+public:
+    virtual ~LogSink() {}
+    virtual bool     open(const char* path) = 0;     // append mode
+    virtual bool     isOpen() const = 0;
+    virtual uint32_t size() = 0;                      // current file length
+    virtual size_t   write(const uint8_t* data, size_t len) = 0;
+    virtual bool     flush() = 0;
+    virtual void     close() = 0;
+};
+
+struct LogWriteParams {
+    uint32_t blockSize;         // alignment / write unit (bytes)
+    uint32_t maxWritePerTick;   // bound on one service() call (bytes)
+    uint32_t syncIntervalMs;    // flush() cadence while dirty
+    uint32_t reopenRetryMs;     // after an open / write failure
+    uint32_t (*clockUs)();      // latency metric clock
+};
+
+struct LogStreamStats {
+    uint32_t records;           // accepted
+    uint32_t dropped;           // ring full / too long
+    uint32_t buffered;          // bytes waiting
+    uint32_t highWater;         // max bytes waiting
+    uint32_t capacity;
+    uint32_t bytesWritten;
+    uint32_t bytesPerSec;       // over the last >= 1 s of service()
+    uint32_t writes;            // sink write() calls
+    uint32_t syncs;             // sink flush() calls
+    uint32_t opens;
+    uint32_t errors;            // failed opens / short writes / failed flushes
+    uint32_t lastFlushUs;       // last service() pass that touched the sink
+    uint32_t maxFlushUs;
+};
+
+struct LogNoLock {
+    void lock() {}
+    void unlock() {}
+};
+
+template <class Lock = LogNoLock>
+class LogStream {
+public:
+    static constexpr size_t PATH_MAX_LEN = 64;
+
+    LogStream() : sink(nullptr), buf(nullptr), cap(0) { reset(); }
+
+    void begin(LogSink* s, uint8_t* buffer, uint32_t capacity,
+               const char* path, const char* header, uint32_t maxAgeMs,
+               const LogWriteParams& params) {
+        sink = s;
+        buf = buffer;
+        cap = buffer ? capacity : 0;
+        hdr = header;
+        maxAge = maxAgeMs;
+        p = params;
+        reset();
+        setPath(path);
+    }
+
+    // Takes effect on the next service(); buffered data goes to the new file
+    void setPath(const char* path) {
+        lk.lock();
+        if (path) {
+            strncpy(filePath, path, PATH_MAX_LEN - 1);
+            filePath[PATH_MAX_LEN - 1] = '\0';
+        } else {
+            filePath[0] = '\0';
+        }
+        pathChanged = true;
+        lk.unlock();
+    }
+
+    // One record; "\r\n" is appended. false = dropped
+    bool append(const char* text, size_t len, uint32_t nowMs) {
+        return put((const uint8_t*)text, len, true, nowMs);
+    }
+
+    bool append(const char* text, uint32_t nowMs) {
+        return append(text, text ? strlen(text) : 0, nowMs);
+    }
+
+    // Binary record, written as is (never split across a drop)
+    bool appendRaw(const void* data, size_t len, uint32_t nowMs) {
+        return put((const uint8_t*)data, len, false, nowMs);
+    }
+
+    // Background side. force = write everything and sync (shutdown, OTA)
+    // Returns bytes written to the sink
+    uint32_t service(uint32_t nowMs, bool force = false) {
+        updateRate(nowMs);
+        if (!sink) return 0;
+
+        lk.lock();
+        uint32_t pending = used;
+        uint32_t first   = oldestMs;
+        bool     reopen  = pathChanged;
+        pathChanged = false;
+        lk.unlock();
+
+        if (reopen && sink->isOpen()) {
+            syncAndClose();
+        }
+        if (reopen) retryAtMs = nowMs;
+
+        bool due = force || (pending > 0 && (int32_t)(nowMs - first) >= (int32_t)maxAge);
+        if (pending == 0 && !dirty) return 0;
+
+        uint32_t t0 = clock();
+        if (!sink->isOpen() && !openSink(nowMs)) return 0;
+
+        uint32_t toWrite = chunkSize(pending, due);
+        bool syncDue = force || (int32_t)(nowMs - lastSyncMs) >= (int32_t)p.syncIntervalMs;
+        if (toWrite == 0 && !(dirty && syncDue)) return 0;
+
+        uint32_t written = writeOut(toWrite, nowMs);
+
+        if (sink->isOpen() && dirty && syncDue) {
+            if (sink->flush()) {
+                st.syncs++;
+                dirty = false;
+                lastSyncMs = nowMs;
+            } else {
+                fail(nowMs);
+            }
+        }
+
+        uint32_t us = clock() - t0;
+        st.lastFlushUs = us;
+        if (us > st.maxFlushUs) st.maxFlushUs = us;
+        return written;
+    }
+
+    void close() {
+        if (sink && sink->isOpen()) syncAndClose();
+    }
+
+    // Close with the file ending on a record boundary (segment rotation).
+    // service() writes block-aligned runs that can stop mid-record, so
+    // everything buffered now - whole records only, appends are atomic
+    // under lk - is written first, ignoring the per-tick cap. false: a
+    // write failed, the rest stays buffered for the same path.
+    bool closeAtRecord(uint32_t nowMs) {
+        if (!sink || !sink->isOpen()) return false;
+        lk.lock();
+        uint32_t pending = used;
+        lk.unlock();
+        if (writeOut(pending, nowMs) < pending) return false;
+        syncAndClose();
+        return true;
+    }
+
+    LogStreamStats stats() {
+        lk.lock();
+        LogStreamStats s = st;
+        s.buffered = used;
+        lk.unlock();
+        s.capacity = cap;
+        return s;
+    }
+
+    void resetStats() {
+        lk.lock();
+        st = LogStreamStats();
+        st.highWater = used;
+        lk.unlock();
+        rateBytes = 0;
+    }
+
+    uint32_t buffered() {
+        lk.lock();
+        uint32_t n = used;
+        lk.unlock();
+        return n;
+    }
+
+    const char* path() const   { return filePath; }
+    bool        isOpen() const { return sink && sink->isOpen(); }
+    uint32_t    fileBytes() const { return fileSize; }   // open file length, service() side
+
+private:
+    void reset() {
+        wr = rd = used = 0;
+        oldestMs = 0;
+        fileSize = 0;
+        dirty = false;
+        lastSyncMs = 0;
+        retryAtMs = 0;
+        rateMs = 0;
+        rateBytes = 0;
+        rateStarted = false;
+        pathChanged = false;
+        filePath[0] = '\0';
+        st = LogStreamStats();
+    }
+
+    bool put(const uint8_t* data, size_t len, bool crlf, uint32_t nowMs) {
+        uint32_t need = (uint32_t)len + (crlf ? 2 : 0);
+        lk.lock();
+        if (need > cap - used) {
+            st.dropped++;
+            lk.unlock();
+            return false;
+        }
+        if (used == 0) oldestMs = nowMs;
+        copyIn(data, (uint32_t)len);
+        if (crlf) copyIn((const uint8_t*)"\r\n", 2);
+        if (used > st.highWater) st.highWater = used;
+        st.records++;
+        lk.unlock();
+        return true;
+    }
+
+    void copyIn(const uint8_t* src, uint32_t len) {
+        uint32_t run = cap - wr;
+        if (len <= run) {
+            memcpy(buf + wr, src, len);
+        } else {
+            memcpy(buf + wr, src, run);
+            memcpy(buf, src + run, len - run);
+        }
+        wr = (wr + len) % cap;
+        used += len;
+    }
+
+    // Lead-in to the next block boundary, then whole blocks; all of it
+    // when the oldest byte is due
+    uint32_t chunkSize(uint32_t pending, bool due) const {
+        uint32_t bs   = p.blockSize ? p.blockSize : 1;
+        uint32_t lead = bs - fileSize % bs;
+        uint32_t n    = 0;
+        if (pending >= lead) n = lead + (pending - lead) / bs * bs;
+        if (due) n = pending;
+        if (p.maxWritePerTick && n > p.maxWritePerTick) {
+            // keep the alignment when capping
+            uint32_t capped = p.maxWritePerTick;
+            if (capped > lead) capped = lead + (capped - lead) / bs * bs;
+            n = capped;
+        }
+        return n;
+    }
+
+    uint32_t writeOut(uint32_t toWrite, uint32_t nowMs) {
+        uint32_t written = 0;
+        while (written < toWrite) {
+            uint32_t run  = cap - rd;
+            uint32_t n    = toWrite - written < run ? toWrite - written : run;
+            size_t   done = sink->write(buf + rd, n);
+            st.writes++;
+            written += (uint32_t)done;
+            fileSize += (uint32_t)done;
+            lk.lock();
+            rd = (rd + (uint32_t)done) % cap;
+            used -= (uint32_t)done;
+            lk.unlock();
+            if (done > 0) dirty = true;
+            if (done < n) {
+                fail(nowMs);
+                break;
+            }
+        }
+        st.bytesWritten += written;
+        return written;
+    }
+
+    bool openSink(uint32_t nowMs) {
+        if (filePath[0] == '\0') return false;
+        if ((int32_t)(nowMs - retryAtMs) < 0) return false;
+        if (!sink->open(filePath)) {
+            st.errors++;
+            retryAtMs = nowMs + p.reopenRetryMs;
+            return false;
+        }
+        st.opens++;
+        fileSize = sink->size();
+        lastSyncMs = nowMs;
+        if (fileSize == 0 && hdr && hdr[0]) {
+            size_t len = strlen(hdr);
+            bool ok = sink->write((const uint8_t*)hdr, len) == len &&
+                      sink->write((const uint8_t*)"\r\n", 2) == 2;
+            st.writes += 2;
+            fileSize = sink->size();
+            dirty = true;
+            if (!ok) {
+                fail(nowMs);
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void fail(uint32_t nowMs) {
+        st.errors++;
+        sink->close();
+        dirty = false;
+        retryAtMs = nowMs + p.reopenRetryMs;
+    }
+
+    void syncAndClose() {
+        if (dirty && sink->flush()) st.syncs++;
+        sink->close();
+        dirty = false;
+    }
+
+    void updateRate(uint32_t nowMs) {
+        if (!rateStarted) {
+            rateStarted = true;
+            rateMs = nowMs;
+            rateBytes = st.bytesWritten;
+            return;
+        }
+        uint32_t dt = nowMs - rateMs;
+        if (dt < 1000) return;
+        st.bytesPerSec = (uint32_t)((uint64_t)(st.bytesWritten - rateBytes) * 1000u / dt);
+        rateMs = nowMs;
+        rateBytes = st.bytesWritten;
+    }
+
+    uint32_t clock() const { return p.clockUs ? p.clockUs() : 0; }
+
+    LogSink*       sink;
+    uint8_t*       buf;
+    uint32_t       cap;
+    const char*    hdr;
+    uint32_t       maxAge;
+    LogWriteParams p;
+    Lock           lk;
+
+    // Shared with producers (under lk)
+    uint32_t       wr, used;              // producer offset, bytes waiting
+    uint32_t       oldestMs;              // append time of the oldest waiting byte
+    bool           pathChanged;
+    char           filePath[PATH_MAX_LEN];
+    LogStreamStats st;
+
+    // Consumer only
+    uint32_t       rd;                    // consumer offset (used shrinks under lk)
+    uint32_t       fileSize;
+    bool           dirty;
+    uint32_t       lastSyncMs;
+    uint32_t       retryAtMs;
+    uint32_t       rateMs, rateBytes;
+    bool           rateStarted;
+};
+
+#endif // LOG_WRITE_BEHIND_H
@@ -0,0 +1,78 @@
+// LoopHistogram.h
+// ================================================================
+// Fixed-bin timing histogram for periodic loops
+// ================================================================
+//  - BINS linear bins of BIN_US microseconds; the last bin collects
+//    everything >= (BINS-1) * BIN_US.
+//  - record() is O(1) and allocation-free (safe in a control loop).
+//  - One writer. Readers on other tasks get an approximate view:
+//    counters may be one sample apart, which is fine for reporting.
+// ================================================================
+#ifndef LOOP_HISTOGRAM_H
+#define LOOP_HISTOGRAM_H
+
+#include <cstddef>
+#include <cstdint>
+
+template<size_t BINS, uint32_t BIN_US>
+class LoopHistogram {
+    static_assert(BINS >= 2, "LoopHistogram needs at least two bins");
+    static_assert(BIN_US >= 1, "Bin width must be at least 1 us");
+
+public:
+    LoopHistogram() { clear(); }
+
+    void clear() {
+        for (size_t i = 0; i < BINS; i++) bins[i] = 0;
+        n = 0;
+        sumUs = 0;
+        minUs = UINT32_MAX;
+        maxUs = 0;
+    }
+
+    void record(uint32_t us) {
+        size_t b = us / BIN_US;
+        if (b >= BINS) b = BINS - 1;
+        bins[b]++;
+        n++;
+        sumUs += us;
+        if (us < minUs) minUs = us;
+        if (us > maxUs) maxUs = us;
+    }
+
+    uint32_t count() const  { return n; }
+    uint32_t min() const    { return n ? minUs : 0; }
+    uint32_t max() const    { return maxUs; }
+    float    mean() const   { return n ? (float)sumUs / n : 0.0f; }
+    uint32_t bin(size_t i) const { return i < BINS ? bins[i] : 0; }
+
+    // Upper edge of the bin holding the p-th quantile (0 < p <= 1),
+    // clamped to the observed max so it never overstates.
+    uint32_t percentile(float p) const {
+        if (n == 0) return 0;
+        uint32_t target = (uint32_t)(p * n + 0.5f);
+        if (target < 1) target = 1;
+        uint32_t acc = 0;
+        for (size_t i = 0; i < BINS; i++) {
+            acc += bins[i];
+            if (acc >= target) {
+                if (i == BINS - 1) return maxUs;
+                uint32_t edge = (uint32_t)(i + 1) * BIN_US - 1;
+                return edge < maxUs ? edge : maxUs;
+            }
+        }
+        return maxUs;
+    }
+
+    static constexpr size_t   binCount() { return BINS; }
+    static constexpr uint32_t binWidthUs() { return BIN_US; }
+
+private:
+    uint32_t bins[BINS];
+    uint32_t n;
+    uint64_t sumUs;
+    uint32_t minUs;
+    uint32_t maxUs;
+};
+
+#endif // LOOP_HISTOGRAM_H
@@ -0,0 +1,352 @@
+// MetricRollup.h
+// ================================================================
+// Multi-resolution rollups of one scalar (1 min / 1 h / 1 day)
+// ================================================================
+//  Each level keeps a ring of closed buckets (count, sum, sumSq, min,
+//  max) plus one open bucket. A sample lands in the open minute; a
+//  closed minute is pushed to the minute ring and merged into the open
+//  hour, a closed hour into the open day. Every sample is therefore
+//  counted exactly once in (closed buckets of one level + the open
+//  buckets of that level and below).
+//
+//  window() answers mean / min / max / stddev and a count-weighted
+//  least-squares slope over bucket means from the finest level that
+//  still covers the range: O(buckets), never a rescan of raw data.
+//
+//  Closed hour / day buckets are handed to a callback for persistence
+//  (fixed ROLLUP_RECORD_SIZE records with CRC) and come back through
+//  restore() + endRestore() after a reboot. Minutes are not persisted.
+// ================================================================
+#ifndef METRIC_ROLLUP_H
+#define METRIC_ROLLUP_H
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include "TsLog.h"          // tslog::put32 / get32 / crc32
+
+enum RollupLevel : uint8_t {
+    ROLLUP_MINUTE = 0,
+    ROLLUP_HOUR,
+    ROLLUP_DAY,
+    ROLLUP_LEVELS
+};
+
+constexpr uint32_t ROLLUP_WIDTH_S[ROLLUP_LEVELS]  = { 60, 3600, 86400 };
+constexpr uint16_t ROLLUP_CAPACITY[ROLLUP_LEVELS] = { 120, 192, 32 };   // 2 h, 8 d, 32 d
+constexpr uint16_t ROLLUP_TOTAL_BUCKETS = 120 + 192 + 32;
+
+// Records covering the whole day ring: 24 hours + 1 day per day
+constexpr uint32_t ROLLUP_REPLAY_RECORDS = ROLLUP_CAPACITY[ROLLUP_DAY] * 25;
+
+struct RollupBucket {
+    uint32_t start;           // s, aligned to the level width
+    uint32_t count;
+    float    min;
+    float    max;
+    double   sum;
+    double   sumSq;
+
+    void clear(uint32_t s) { start = s; count = 0; min = max = 0.0f; sum = sumSq = 0.0; }
+    void add(float v) {
+        if (count == 0 || v < min) min = v;
+        if (count == 0 || v > max) max = v;
+        count++;
+        sum += v;
+        sumSq += (double)v * v;
+    }
+    void merge(const RollupBucket& b) {
+        if (b.count == 0) return;
+        if (count == 0 || b.min < min) min = b.min;
+        if (count == 0 || b.max > max) max = b.max;
+        count += b.count;
+        sum += b.sum;
+        sumSq += b.sumSq;
+    }
+    float mean() const { return count ? (float)(sum / count) : NAN; }
+};
+
+struct RollupWindow {
+    uint32_t    count;
+    float       mean;
+    float       min;
+    float       max;
+    float       stddev;           // population, from sum / sumSq
+    float       slopePerHour;     // weighted LS over bucket means
+    float       fitNow;           // regression line at `to`
+    uint16_t    buckets;          // points visited
+    RollupLevel level;
+};
+
+// ================================================================
+//  Persisted record (little-endian, ROLLUP_RECORD_SIZE bytes)
+//    0 magic u16 | 2 level u8 | 3 rsv | 4 start | 8 count
+//    12 min f32 | 16 max f32 | 20 crc32 (record, crc field as zero)
+//    24 sum f64 | 32 sumSq f64
+// ================================================================
+constexpr uint16_t ROLLUP_MAGIC       = 0x5552;     // "RU"
+constexpr size_t   ROLLUP_RECORD_SIZE = 40;
+
+namespace rollup {
+
+inline uint32_t floorTo(uint32_t t, RollupLevel l) { return t - t % ROLLUP_WIDTH_S[l]; }
+
+inline uint32_t f2u(float f)  { uint32_t u; memcpy(&u, &f, 4); return u; }
+inline float    u2f(uint32_t u) { float f; memcpy(&f, &u, 4); return f; }
+inline uint64_t d2u(double d) { uint64_t u; memcpy(&u, &d, 8); return u; }
+inline double   u2d(uint64_t u) { double d; memcpy(&d, &u, 8); return d; }
+
+inline uint32_t recordCrc(const uint8_t* r) {
+    static const uint8_t zero[4] = {};
+    uint32_t c = tslog::crc32(0, r, 20);
+    c = tslog::crc32(c, zero, 4);
+    return tslog::crc32(c, r + 24, ROLLUP_RECORD_SIZE - 24);
+}
+
+} // namespace rollup
+
+inline void rollupEncode(RollupLevel level, const RollupBucket& b, uint8_t* out) {
+    memset(out, 0, ROLLUP_RECORD_SIZE);
+    tslog::put16(out, ROLLUP_MAGIC);
+    out[2] = level;
+    tslog::put32(out + 4,  b.start);
+    tslog::put32(out + 8,  b.count);
+    tslog::put32(out + 12, rollup::f2u(b.min));
+    tslog::put32(out + 16, rollup::f2u(b.max));
+    tslog::put64(out + 24, rollup::d2u(b.sum));
+    tslog::put64(out + 32, rollup::d2u(b.sumSq));
+    tslog::put32(out + 20, rollup::recordCrc(out));
+}
+
+inline bool rollupDecode(const uint8_t* in, RollupLevel& level, RollupBucket& b) {
+    if (tslog::get16(in) != ROLLUP_MAGIC || in[2] >= ROLLUP_LEVELS) return false;
+    if (tslog::get32(in + 20) != rollup::recordCrc(in)) return false;
+    level   = (RollupLevel)in[2];
+    b.start = tslog::get32(in + 4);
+    b.count = tslog::get32(in + 8);
+    b.min   = rollup::u2f(tslog::get32(in + 12));
+    b.max   = rollup::u2f(tslog::get32(in + 16));
+    b.sum   = rollup::u2d(tslog::get64(in + 24));
+    b.sumSq = rollup::u2d(tslog::get64(in + 32));
+    return b.count > 0 && b.start % ROLLUP_WIDTH_S[level] == 0;
+}
+
+// ================================================================
+//  Rollup
+// ================================================================
+class MetricRollup {
+public:
+    typedef void (*CloseFn)(void* ctx, RollupLevel level, const RollupBucket& b);
+
+    MetricRollup() { reset(); }
+
+    void reset() {
+        for (uint8_t l = 0; l < ROLLUP_LEVELS; l++) {
+            head_[l] = n_[l] = 0;
+            open_[l].clear(0);
+            origin_[l] = 0;
+        }
+        late_ = 0;
+    }
+
+    // Called for every closed bucket (all levels), also from endRestore()
+    void onClose(CloseFn fn, void* ctx) { onClose_ = fn; ctx_ = ctx; }
+
+    // t in seconds, non-decreasing. Older samples are dropped (late()).
+    bool add(uint32_t t, float v) {
+        for (uint8_t l = 0; l < ROLLUP_LEVELS; l++) {
+            uint32_t s = rollup::floorTo(t, (RollupLevel)l);
+            if ((n_[l] && s <= newest((RollupLevel)l).start) || (open_[l].count && s < open_[l].start)) {
+                late_++;
+                return false;
+            }
+        }
+        if (origin_[ROLLUP_MINUTE] == UINT32_MAX) origin_[ROLLUP_MINUTE] = rollup::floorTo(t, ROLLUP_MINUTE);
+
+        uint32_t s0 = rollup::floorTo(t, ROLLUP_MINUTE);
+        if (open_[0].count && open_[0].start != s0) close(ROLLUP_MINUTE);
+        if (open_[0].count == 0) open_[0].clear(s0);
+        open_[0].add(v);
+        return true;
+    }
+
+    // Replay persisted buckets oldest first, then endRestore()
+    void restore(RollupLevel l, const RollupBucket& b) {
+        if (l == ROLLUP_MINUTE || (n_[l] && b.start <= newest(l).start)) return;
+        push(l, b);
+    }
+
+    // Hours after the last closed day are folded back into days (a day
+    // left open by a reboot is closed here); minutes start over.
+    void endRestore() {
+        uint32_t after = n_[ROLLUP_DAY] ? newest(ROLLUP_DAY).start + ROLLUP_WIDTH_S[ROLLUP_DAY] : 0;
+        open_[ROLLUP_DAY].clear(0);
+        for (uint16_t i = 0; i < n_[ROLLUP_HOUR]; i++) {
+            const RollupBucket& h = at(ROLLUP_HOUR, i);
+            if (h.start < after) continue;
+            uint32_t d = rollup::floorTo(h.start, ROLLUP_DAY);
+            if (open_[ROLLUP_DAY].count && open_[ROLLUP_DAY].start != d) close(ROLLUP_DAY);
+            if (open_[ROLLUP_DAY].count == 0) open_[ROLLUP_DAY].clear(d);
+            open_[ROLLUP_DAY].merge(h);
+        }
+        open_[ROLLUP_HOUR].clear(0);
+        open_[ROLLUP_MINUTE].clear(0);
+        origin_[ROLLUP_MINUTE] = UINT32_MAX;      // no minute history before the next add()
+    }
+
+    // ------------------------------------------------------------
+    //  Queries
+    // ------------------------------------------------------------
+    RollupWindow window(uint32_t from, uint32_t to) const {
+        RollupLevel l = ROLLUP_DAY;
+        for (uint8_t k = 0; k < ROLLUP_DAY; k++) {
+            if (from >= coverFrom((RollupLevel)k)) { l = (RollupLevel)k; break; }
+        }
+
+        Acc acc;
+        uint32_t lo = rollup::floorTo(from, l);
+        for (uint16_t i = 0; i < n_[l]; i++) {
+            const RollupBucket& b = at(l, i);
+            if (b.start < lo || b.start > to) continue;
+            acc.point(b, midpoint(b, l, to), to);
+        }
+        for (int k = l; k >= 0; k--) {
+            const RollupBucket& b = open_[k];
+            if (b.count == 0 || b.start > to || b.start + ROLLUP_WIDTH_S[k] <= from) continue;
+            acc.point(b, midpoint(b, (RollupLevel)k, to), to);
+        }
+        return acc.result(l);
+    }
+
+    // Means of the last n slots of level l ending with the slot holding
+    // `to` (oldest first). The current slot includes the finer open
+    // buckets; slots without data are NAN. Returns n.
+    size_t series(RollupLevel l, uint32_t to, float* out, size_t n) const {
+        uint32_t w = ROLLUP_WIDTH_S[l];
+        uint32_t last = rollup::floorTo(to, l);
+        for (size_t i = 0; i < n; i++) out[i] = NAN;
+        if (n == 0) return 0;
+        uint32_t first = last >= (n - 1) * w ? last - (uint32_t)(n - 1) * w : 0;
+
+        for (uint16_t i = 0; i < n_[l]; i++) {
+            const RollupBucket& b = at(l, i);
+            if (b.start < first || b.start > last) continue;
+            out[(b.start - first) / w] = b.mean();
+        }
+        // Open buckets are not in any ring yet; finer ones are never older
+        RollupBucket cur;
+        cur.clear(UINT32_MAX);
+        for (int k = l; k >= -1; k--) {
+            uint32_t slot = k >= 0 && open_[k].count ? rollup::floorTo(open_[k].start, l) : UINT32_MAX;
+            if (k >= 0 && slot == UINT32_MAX) continue;
+            if (cur.count && slot != cur.start) {
+                if (cur.start >= first && cur.start <= last) out[(cur.start - first) / w] = cur.mean();
+                cur.clear(UINT32_MAX);
+            }
+            if (k < 0) break;
+            if (cur.count == 0) cur.clear(slot);
+            cur.merge(open_[k]);
+        }
+        return n;
+    }
+
+    uint16_t size(RollupLevel l) const { return n_[l]; }
+    const RollupBucket& at(RollupLevel l, uint16_t i) const {        // 0 = oldest
+        uint16_t cap = ROLLUP_CAPACITY[l];
+        return buf_[offset(l) + (head_[l] + cap - n_[l] + i) % cap];
+    }
+    const RollupBucket& newest(RollupLevel l) const { return at(l, n_[l] - 1); }
+    const RollupBucket& open(RollupLevel l) const { return open_[l]; }
+    uint32_t late() const { return late_; }
+
+private:
+    struct Acc {
+        RollupBucket all;
+        double w = 0, wx = 0, wy = 0, wxx = 0, wxy = 0;
+        uint16_t points = 0;
+        Acc() { all.clear(0); }
+
+        void point(const RollupBucket& b, uint32_t mid, uint32_t to) {
+            all.merge(b);
+            double x = ((double)mid - (double)to) / 3600.0;    // hours before `to`
+            double y = b.sum / b.count;
+            w += b.count; wx += b.count * x; wy += b.count * y;
+            wxx += b.count * x * x; wxy += b.count * x * y;
+            points++;
+        }
+        RollupWindow result(RollupLevel l) const {
+            RollupWindow r = {};
+            r.level = l;
+            r.buckets = points;
+            r.count = all.count;
+            if (all.count == 0) {
+                r.mean = r.min = r.max = r.fitNow = NAN;
+                return r;
+            }
+            double mean = all.sum / all.count;
+            double var = all.sumSq / all.count - mean * mean;
+            r.mean = (float)mean;
+            r.min = all.min;
+            r.max = all.max;
+            r.stddev = var > 0 ? (float)std::sqrt(var) : 0.0f;
+            double den = w * wxx - wx * wx;
+            double slope = (points > 1 && den > 1e-9 * w * w) ? (w * wxy - wx * wy) / den : 0.0;
+            r.slopePerHour = (float)slope;
+            r.fitNow = (float)(wy / w - slope * (wx / w));
+            return r;
+        }
+    };
+
+    static uint16_t offset(RollupLevel l) {
+        uint16_t o = 0;
+        for (uint8_t k = 0; k < l; k++) o += ROLLUP_CAPACITY[k];
+        return o;
+    }
+
+    // Midpoint of the part of the bucket up to `to`
+    static uint32_t midpoint(const RollupBucket& b, RollupLevel l, uint32_t to) {
+        uint32_t end = b.start + ROLLUP_WIDTH_S[l];
+        if (end > to) end = to > b.start ? to : b.start;
+        return b.start + (end - b.start) / 2;
+    }
+
+    // Earliest time level l answers exactly: its oldest bucket once the
+    // ring has wrapped, else where its history begins.
+    uint32_t coverFrom(RollupLevel l) const {
+        if (n_[l] == ROLLUP_CAPACITY[l]) return at(l, 0).start;
+        return origin_[l];
+    }
+
+    void push(RollupLevel l, const RollupBucket& b) {
+        uint16_t cap = ROLLUP_CAPACITY[l];
+        buf_[offset(l) + head_[l]] = b;
+        head_[l] = (uint16_t)((head_[l] + 1) % cap);
+        if (n_[l] < cap) n_[l]++;
+    }
+
+    void close(RollupLevel l) {
+        RollupBucket b = open_[l];
+        open_[l].clear(0);
+        push(l, b);
+        if (onClose_) onClose_(ctx_, l, b);
+        if (l + 1 >= ROLLUP_LEVELS) return;
+
+        RollupLevel p = (RollupLevel)(l + 1);
+        uint32_t ps = rollup::floorTo(b.start, p);
+        if (open_[p].count && open_[p].start != ps) close(p);
+        if (open_[p].count == 0) open_[p].clear(ps);
+        open_[p].merge(b);
+    }
+
+    RollupBucket buf_[ROLLUP_TOTAL_BUCKETS];
+    RollupBucket open_[ROLLUP_LEVELS];
+    uint16_t     head_[ROLLUP_LEVELS];
+    uint16_t     n_[ROLLUP_LEVELS];
+    uint32_t     origin_[ROLLUP_LEVELS];
+    uint32_t     late_ = 0;
+    CloseFn      onClose_ = nullptr;
+    void*        ctx_ = nullptr;
+};
+
+#endif // METRIC_ROLLUP_H
@@ -0,0 +1,235 @@
+// MinMaxPyramid.h
+// ================================================================
+// Min / max / last decimation pyramid for the trend graph
+// ================================================================
+//  Level k keeps buckets of MINMAX_SPAN[k] samples in a ring of
+//  MINMAX_CAPACITY[k]. At the 100 ms graph rate that is 0.1 s, 1 s,
+//  10 s and 100 s buckets holding 12.8 s, 10.7 min, 64 min and 24.9 h.
+//  Every sample is merged into the newest bucket of each level, so
+//  add() is O(levels) and no level is ever rebuilt from raw data.
+//
+//  columns() maps a window of samples onto `width` pixel columns from
+//  the finest level that still covers the window. A column takes the
+//  min / max of every bucket it touches (a bucket straddling a column
+//  edge counts for both), so a one-sample spike is never dropped, at
+//  worst widened by one bucket. Cost is O(width + buckets in window);
+//  the capacities keep that under 3 x width for the 10 s / 10 min /
+//  1 h / 24 h windows on the 380 px graph.
+//
+//  range() gives the min / max of a trailing window for autoscale
+//  without a scan: each level keeps two monotonic deques of closed
+//  bucket indices (max-decreasing / min-increasing) over the window set
+//  with track(). A closing bucket pops dominated entries off the back,
+//  buckets leaving the window fall off the front; amortised O(1) per
+//  bucket, and the open bucket is folded in on read.
+// ================================================================
+#ifndef MINMAX_PYRAMID_H
+#define MINMAX_PYRAMID_H
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+constexpr uint8_t  MINMAX_LEVELS = 4;
+constexpr uint32_t MINMAX_SPAN[MINMAX_LEVELS]     = { 1, 10, 100, 1000 };
+constexpr uint16_t MINMAX_CAPACITY[MINMAX_LEVELS] = { 128, 640, 384, 896 };
+constexpr uint16_t MINMAX_TOTAL_BUCKETS = 128 + 640 + 384 + 896;
+
+// Empty bucket / column: min > max
+struct MinMaxBucket {
+    float min;
+    float max;
+    float last;
+
+    void clear() { min = INFINITY; max = -INFINITY; last = NAN; }
+    bool valid() const { return min <= max; }
+    void add(float v) {
+        if (v < min) min = v;
+        if (v > max) max = v;
+        last = v;
+    }
+    void merge(const MinMaxBucket& b) {
+        if (!b.valid()) return;
+        if (b.min < min) min = b.min;
+        if (b.max > max) max = b.max;
+        last = b.last;
+    }
+};
+
+typedef MinMaxBucket MinMaxColumn;
+
+class MinMaxPyramid {
+public:
+    MinMaxPyramid() { clear(); }
+
+    void clear() {
+        for (uint16_t i = 0; i < MINMAX_TOTAL_BUCKETS; i++) b_[i].clear();
+        for (uint8_t l = 0; l < MINMAX_LEVELS; l++) {
+            q_[Q_MAX][l] = q_[Q_MIN][l] = {0, 0};
+            if (!track_[l]) track_[l] = (MINMAX_CAPACITY[l] - 2) * MINMAX_SPAN[l];
+        }
+        count_ = 0;
+    }
+
+    // One sample per graph tick. NaN (sensor fault) leaves a gap.
+    void add(float v) {
+        for (uint8_t l = 0; l < MINMAX_LEVELS; l++) {
+            uint32_t idx = count_ / MINMAX_SPAN[l];
+            if (count_ % MINMAX_SPAN[l] == 0) {              // bucket opens, old ring entry goes
+                if (idx) closed(l, idx - 1);
+                slot(l, idx).clear();
+            }
+            if (!std::isnan(v)) slot(l, idx).add(v);
+        }
+        count_++;
+    }
+
+    // Trailing window followed by range() on its level (set once per
+    // graph window; clears that level's deques)
+    void track(uint32_t window) {
+        uint8_t l = levelFor(window);
+        uint32_t maxTrack = (MINMAX_CAPACITY[l] - 2) * MINMAX_SPAN[l];
+        track_[l] = window < maxTrack ? window : maxTrack;
+        q_[Q_MAX][l] = q_[Q_MIN][l] = {0, 0};
+        if (!count_) return;
+        int64_t newest = (int64_t)(count_ - 1) / MINMAX_SPAN[l];
+        int64_t first  = newest - MINMAX_CAPACITY[l] + 1;
+        for (int64_t i = first < 0 ? 0 : first; i < newest; i++) closed(l, (uint32_t)i);
+    }
+
+    // Min / max of the window given to track() (its level), ending at
+    // count() and widened to bucket edges like columns(). False if empty.
+    bool range(uint32_t window, float& lo, float& hi) const {
+        uint8_t l = levelFor(window);
+        MinMaxBucket r;
+        r.clear();
+        if (count_) {
+            uint32_t first = firstTracked(l);
+            for (uint8_t k = 0; k < 2; k++) {
+                // the window may have moved past the front since the last close
+                for (uint16_t i = 0; i < q_[k][l].size; i++) {
+                    uint32_t idx = qAt(k, l, i);
+                    if (idx >= first) { r.merge(slot(l, idx)); break; }
+                }
+            }
+            r.merge(slot(l, (count_ - 1) / MINMAX_SPAN[l]));   // open bucket
+        }
+        if (!r.valid()) return false;
+        lo = r.min;
+        hi = r.max;
+        return true;
+    }
+
+    uint32_t count() const { return count_; }                 // samples so far = next index
+    float last() const { return count_ ? slot(0, count_ - 1).last : NAN; }
+
+    // Finest level whose ring holds every bucket [end - window, end) can
+    // touch (window / span + 2 when the window is not bucket aligned)
+    uint8_t levelFor(uint32_t window) const {
+        for (uint8_t l = 0; l < MINMAX_LEVELS; l++) {
+            if (window / MINMAX_SPAN[l] + 2 <= MINMAX_CAPACITY[l]) return l;
+        }
+        return MINMAX_LEVELS - 1;
+    }
+
+    // Bucket `idx` of level l (sample idx * span ..), empty if expired / future
+    MinMaxBucket bucket(uint8_t l, int64_t idx) const {
+        MinMaxBucket e;
+        e.clear();
+        if (idx < 0 || count_ == 0) return e;
+        int64_t newest = (int64_t)(count_ - 1) / MINMAX_SPAN[l];
+        if (idx > newest || idx <= newest - MINMAX_CAPACITY[l]) return e;
+        return slot(l, (uint32_t)idx);
+    }
+
+    // Samples [end - window, end) onto out[0..width). Returns the number
+    // of buckets visited (O(width + window / span)).
+    uint32_t columns(uint32_t end, uint32_t window, MinMaxColumn* out, uint16_t width) const {
+        if (!width) return 0;
+        uint8_t  l    = levelFor(window);
+        int64_t  span = MINMAX_SPAN[l];
+        int64_t  from = (int64_t)end - window;
+        int64_t  prev = INT64_MIN;
+        MinMaxBucket pb;
+        pb.clear();
+        uint32_t visits = 0;
+
+        for (uint16_t c = 0; c < width; c++) {
+            int64_t lo = from + (int64_t)window * c / width;
+            int64_t hi = from + (int64_t)window * (c + 1) / width;
+            if (hi <= lo) hi = lo + 1;                       // window < width: samples repeat
+            int64_t b0 = floorDiv(lo, span);
+            int64_t b1 = floorDiv(hi - 1, span);
+
+            MinMaxColumn& col = out[c];
+            col.clear();
+            for (int64_t b = b0; b <= b1; b++) {
+                if (b == prev) { col.merge(pb); continue; }  // shared edge bucket, no re-read
+                pb = bucket(l, b);
+                prev = b;
+                visits++;
+                col.merge(pb);
+            }
+        }
+        return visits;
+    }
+
+private:
+    // Deques of bucket indices, one ring per level laid out like the buckets
+    enum { Q_MAX = 0, Q_MIN = 1 };
+    struct IndexDeque { uint16_t head, size; };
+
+    uint32_t& qAt(uint8_t k, uint8_t l, uint16_t i) {
+        return qIdx_[k][offset(l) + (q_[k][l].head + i) % MINMAX_CAPACITY[l]];
+    }
+    uint32_t qAt(uint8_t k, uint8_t l, uint16_t i) const {
+        return qIdx_[k][offset(l) + (q_[k][l].head + i) % MINMAX_CAPACITY[l]];
+    }
+
+    // Entry `old` no longer matters once `b` is in: b is as extreme and newer
+    static bool dominated(uint8_t k, const MinMaxBucket& old, const MinMaxBucket& b) {
+        return k == Q_MAX ? old.max <= b.max : old.min >= b.min;
+    }
+
+    // Oldest bucket of level l inside the tracked window
+    uint32_t firstTracked(uint8_t l) const {
+        return count_ > track_[l] ? (count_ - track_[l]) / MINMAX_SPAN[l] : 0;
+    }
+
+    // Bucket idx of level l is complete: push it, drop expired / dominated
+    void closed(uint8_t l, uint32_t idx) {
+        const MinMaxBucket& b = slot(l, idx);
+        uint32_t first = firstTracked(l);
+        for (uint8_t k = 0; k < 2; k++) {
+            IndexDeque& q = q_[k][l];
+            while (q.size && qAt(k, l, 0) < first) {
+                q.head = (q.head + 1) % MINMAX_CAPACITY[l];
+                q.size--;
+            }
+            if (!b.valid() || idx < first) continue;
+            while (q.size && dominated(k, slot(l, qAt(k, l, q.size - 1)), b)) q.size--;
+            qAt(k, l, q.size) = idx;
+            q.size++;
+        }
+    }
+
+    static int64_t floorDiv(int64_t a, int64_t b) {
+        int64_t q = a / b;
+        return (a % b != 0 && a < 0) ? q - 1 : q;
+    }
+
+    static constexpr uint16_t offset(uint8_t l) {
+        return l == 0 ? 0 : offset(l - 1) + MINMAX_CAPACITY[l - 1];
+    }
+
+    MinMaxBucket& slot(uint8_t l, uint32_t idx) { return b_[offset(l) + idx % MINMAX_CAPACITY[l]]; }
+    const MinMaxBucket& slot(uint8_t l, uint32_t idx) const { return b_[offset(l) + idx % MINMAX_CAPACITY[l]]; }
+
+    MinMaxBucket b_[MINMAX_TOTAL_BUCKETS];
+    uint32_t     qIdx_[2][MINMAX_TOTAL_BUCKETS];
+    IndexDeque   q_[2][MINMAX_LEVELS];
+    uint32_t     track_[MINMAX_LEVELS] = {};
+    uint32_t     count_;
+};
+
+#endif // MINMAX_PYRAMID_H
@@ -1,7 +1,55 @@
 #pragma once
 // ================================================================
-// PID_Control.h    PID  
+// PID_Control.h    PID
 // ================================================================
 
-void updatePID();
+#include <Arduino.h>
+#include "LoopHistogram.h"
+#include "RelayAutotune.h"
+
+// Period deviation: 10 us bins up to 640 us; execution time: 5 us bins
+typedef LoopHistogram<64, 10> PidJitterHistogram;
+typedef LoopHistogram<64, 5>  PidExecHistogram;
+
+struct PidTimingStats {
+    uint32_t rateHz;
+    uint32_t steps;           // control-law executions
+    uint32_t missedPeriods;   // timer ticks that coalesced (task ran late)
+    uint32_t jitterP50Us;     // |actual period - nominal|
+    uint32_t jitterP99Us;
+    uint32_t jitterMaxUs;
+    float    execMeanUs;
+    uint32_t execP99Us;
+    uint32_t execMaxUs;
+};
+
+void initPIDLoop();      // start the PID_LOOP_RATE_HZ timer + task (once)
+void updatePID();        // VacuumCtrl tick: arm / keep the loop running
 void resetPID();
+
+PidTimingStats getPidTimingStats();
+const PidJitterHistogram& getPidJitterHistogram();
+const PidExecHistogram&   getPidExecHistogram();
+void resetPidTiming();
+void printPidTiming();
+
+// Relay auto-tune: runs in the PIDLoop task from STATE_IDLE, driving the
+// pump around config.targetPressure. Any state change aborts it.
+struct PidAutotuneStatus {
+    AutotuneState   state;
+    AutotuneFailure failure;
+    uint8_t         cycles;
+    uint8_t         cyclesNeeded;
+    uint32_t        elapsedMs;
+    float           ku;
+    float           puSec;
+    AutotuneGains   zieglerNichols;
+    AutotuneGains   tyreusLuyben;
+};
+
+bool startPidAutotune();                     // false unless IDLE and not tripped
+void abortPidAutotune();
+bool isPidAutotuneRunning();
+PidAutotuneStatus getPidAutotuneStatus();
+bool applyPidAutotune(AutotuneRule rule);    // DONE only: copies gains into config
+const char* autotuneFailureName(AutotuneFailure f);
@@ -0,0 +1,181 @@
+// PidController.h
+// ================================================================
+// Compile-time configured PID controller
+// ================================================================
+//  - PidController<T, Options>: T is float or PidFixed (Q16.16);
+//    Options is a struct of static constexpr fields (see
+//    PidDefaultOptions) picking anti-windup, derivative source and
+//    filter, and output limits. Strategy branches are if constexpr,
+//    so unused paths cost nothing.
+//  - Gain-derived constants (Kp, Ki*dt, Kd/dt, Kt*dt, filter alpha)
+//    are folded in setGains()/setSampleTime(); step() is add/mul
+//    only, no division, no heap.
+//  - Integral state is kept in output units, so gain changes are
+//    bumpless.
+// ================================================================
+#ifndef PID_CONTROLLER_H
+#define PID_CONTROLLER_H
+
+#include <cmath>
+#include <cstdint>
+
+enum class PidAntiWindup : uint8_t {
+    None,               // plain integrator
+    Clamp,              // integral term clamped to +/- integralLimit
+    BackCalculation,    // bleed by saturation excess, Tt = sqrt(Ti*Td)
+};
+
+enum class PidDerivative : uint8_t {
+    OnError,            // d(error)/dt: setpoint steps kick
+    OnMeasurement,      // -d(measurement)/dt: no setpoint kick
+};
+
+struct PidDefaultOptions {
+    static constexpr PidAntiWindup antiWindup    = PidAntiWindup::BackCalculation;
+    static constexpr PidDerivative derivative    = PidDerivative::OnMeasurement;
+    static constexpr float         derivFilterHz = 20.0f;   // 0 = unfiltered
+    static constexpr float         outputMin     = 0.0f;
+    static constexpr float         outputMax     = 100.0f;
+    static constexpr float         integralLimit = 100.0f;  // Clamp only
+};
+
+// ================================================================
+//  Q16.16 fixed point (range +/-32768, resolution 1.5e-5)
+// ================================================================
+struct PidFixed {
+    int32_t raw;
+
+    constexpr PidFixed() : raw(0) {}
+    constexpr PidFixed(float f)
+        : raw((int32_t)(f * 65536.0f + (f >= 0.0f ? 0.5f : -0.5f))) {}
+
+    static constexpr PidFixed fromRaw(int32_t r) { PidFixed x; x.raw = r; return x; }
+    constexpr float toFloat() const { return raw / 65536.0f; }
+    explicit constexpr operator float() const { return toFloat(); }
+
+    friend constexpr PidFixed operator+(PidFixed a, PidFixed b) { return fromRaw(a.raw + b.raw); }
+    friend constexpr PidFixed operator-(PidFixed a, PidFixed b) { return fromRaw(a.raw - b.raw); }
+    friend constexpr PidFixed operator*(PidFixed a, PidFixed b) {
+        return fromRaw((int32_t)(((int64_t)a.raw * b.raw) >> 16));
+    }
+    constexpr PidFixed operator-() const { return fromRaw(-raw); }
+    PidFixed& operator+=(PidFixed b) { raw += b.raw; return *this; }
+
+    friend constexpr bool operator<(PidFixed a, PidFixed b) { return a.raw < b.raw; }
+    friend constexpr bool operator>(PidFixed a, PidFixed b) { return a.raw > b.raw; }
+};
+
+inline float pidToFloat(float v)    { return v; }
+inline float pidToFloat(PidFixed v) { return v.toFloat(); }
+
+// ================================================================
+//  Controller
+// ================================================================
+template<typename T, typename Options = PidDefaultOptions>
+class PidController {
+    static_assert(Options::outputMax > Options::outputMin, "PID output range is empty");
+    static_assert(Options::integralLimit >= 0.0f, "PID integral limit must be >= 0");
+
+public:
+    PidController() : kp(0.0f), kiDt(0.0f), kdDt(0.0f), ktDt(0.0f), alpha(1.0f),
+                      gainKp(0.0f), gainKi(0.0f), gainKd(0.0f), dtSec(0.0f) {
+        reset();
+    }
+
+    void setGains(float p, float i, float d) {
+        gainKp = p; gainKi = i; gainKd = d;
+        refold();
+    }
+
+    void setSampleTime(float dt) {
+        dtSec = dt;
+        refold();
+    }
+
+    void reset() {
+        err = T(0.0f); integ = T(0.0f); deriv = T(0.0f); out = T(0.0f);
+        dState = T(0.0f);
+        primed = false;
+    }
+
+    // Fixed-rate step (dt from setSampleTime)
+    inline T step(T setpoint, T measurement) {
+        err = setpoint - measurement;
+
+        // Derivative source: -measurement or error, optionally low-passed
+        T x = (Options::derivative == PidDerivative::OnMeasurement) ? -measurement : err;
+        if (!primed) {          // no kick on the first step
+            dState = x;
+            primed = true;
+        }
+        T prev = dState;
+        if constexpr (Options::derivFilterHz > 0.0f) dState += alpha * (x - dState);
+        else                                          dState = x;
+        deriv = kdDt * (dState - prev);
+
+        T unsat = kp * err + integ + deriv;
+        out = clampT(unsat, T(Options::outputMin), T(Options::outputMax));
+
+        if constexpr (Options::antiWindup == PidAntiWindup::BackCalculation) {
+            integ += kiDt * err + ktDt * (out - unsat);
+        } else if constexpr (Options::antiWindup == PidAntiWindup::Clamp) {
+            integ += kiDt * err;
+            integ = clampT(integ, T(-Options::integralLimit), T(Options::integralLimit));
+        } else {
+            integ += kiDt * err;
+        }
+        return out;
+    }
+
+    // Variable-rate step: refolds the constants only when dt changes
+    inline T step(T setpoint, T measurement, float dt) {
+        if (dt != dtSec) setSampleTime(dt);
+        return step(setpoint, measurement);
+    }
+
+    T error() const      { return err; }
+    T integral() const   { return integ; }     // output units
+    T derivative() const { return deriv; }     // output units
+    T output() const     { return out; }
+
+    float kP() const { return gainKp; }
+    float kI() const { return gainKi; }
+    float kD() const { return gainKd; }
+    float sampleTime() const { return dtSec; }
+
+    static constexpr float outputMin() { return Options::outputMin; }
+    static constexpr float outputMax() { return Options::outputMax; }
+
+private:
+    static T clampT(T v, T lo, T hi) { return v < lo ? lo : (v > hi ? hi : v); }
+
+    void refold() {
+        float dt = dtSec > 0.0f ? dtSec : 0.0f;
+        kp   = T(gainKp);
+        kiDt = T(gainKi * dt);
+        kdDt = T(dt > 0.0f ? gainKd / dt : 0.0f);
+
+        // Kt = 1/Tt with Tt = sqrt(Ti*Td) = sqrt(Kd/Ki), or Tt = Ti = Kp/Ki without D
+        float kt = 0.0f;
+        if (gainKi > 0.0f) {
+            kt = (gainKd > 0.0f) ? std::sqrt(gainKi / gainKd)
+                                 : (gainKp > 0.0f ? gainKi / gainKp : 0.0f);
+        }
+        ktDt = T(kt * dt);
+
+        if constexpr (Options::derivFilterHz > 0.0f) {
+            const float tau = 1.0f / (2.0f * 3.14159265f * Options::derivFilterHz);
+            alpha = T(dt > 0.0f ? dt / (tau + dt) : 1.0f);
+        }
+    }
+
+    // Folded constants
+    T kp, kiDt, kdDt, ktDt, alpha;
+    // State
+    T err, integ, deriv, out, dState;
+    bool primed;
+    // Source gains
+    float gainKp, gainKi, gainKd, dtSec;
+};
+
+#endif // PID_CONTROLLER_H
@@ -0,0 +1,87 @@
+// RampProfile.h
+// ================================================================
+// Time-based ramp generator for the pump PWM
+// ================================================================
+//  - start() records from/to/duration; valueAt(now) is a pure
+//    function of elapsed time, so the ramp advances correctly no
+//    matter how often (or how late) the control tick samples it.
+//  - Linear: constant slew. S-curve: quintic smootherstep
+//    (zero slope and zero acceleration at both ends, peak slope
+//    1.875 x the linear slope at the midpoint).
+//  - millis() wrap-safe (unsigned elapsed arithmetic).
+// ================================================================
+#ifndef RAMP_PROFILE_H
+#define RAMP_PROFILE_H
+
+#include <cstdint>
+
+enum RampShape : uint8_t {
+    RAMP_LINEAR = 0,
+    RAMP_SCURVE,
+};
+
+// Normalised profile: t in [0,1] -> [0,1]
+inline float rampShapeAt(RampShape shape, float t) {
+    if (t <= 0.0f) return 0.0f;
+    if (t >= 1.0f) return 1.0f;
+    if (shape != RAMP_SCURVE) return t;
+    // Upper half by symmetry: avoids float cancellation near t = 1
+    bool upper = t > 0.5f;
+    float u = upper ? 1.0f - t : t;
+    float s = u * u * u * (u * (u * 6.0f - 15.0f) + 10.0f);
+    return upper ? 1.0f - s : s;
+}
+
+class RampGenerator {
+public:
+    RampGenerator()
+        : startValue(0.0f), endValue(0.0f), startMs(0), lengthMs(0),
+          profile(RAMP_LINEAR), running(false) {}
+
+    void start(float from, float to, uint32_t durationMs, RampShape shape, uint32_t nowMs) {
+        startValue = from;
+        endValue   = to;
+        startMs    = nowMs;
+        lengthMs   = durationMs;
+        profile    = shape;
+        running    = (durationMs > 0 && from != to);
+    }
+
+    // Abandon the ramp; the caller takes over the output
+    void stop() { running = false; }
+
+    bool active() const { return running; }
+
+    uint32_t elapsedMs(uint32_t nowMs) const {
+        uint32_t e = nowMs - startMs;
+        return e > lengthMs ? lengthMs : e;
+    }
+
+    // 0..1 fraction of the ramp time elapsed (1 when idle)
+    float progress(uint32_t nowMs) const {
+        if (!running || lengthMs == 0) return 1.0f;
+        return (float)elapsedMs(nowMs) / (float)lengthMs;
+    }
+
+    bool done(uint32_t nowMs) const { return !running || nowMs - startMs >= lengthMs; }
+
+    float valueAt(uint32_t nowMs) const {
+        if (!running) return endValue;
+        return startValue + (endValue - startValue) * rampShapeAt(profile, progress(nowMs));
+    }
+
+    float     from() const       { return startValue; }
+    float     target() const     { return endValue; }
+    uint32_t  durationMs() const { return lengthMs; }
+    RampShape shape() const      { return profile; }
+
+private:
+    float     startValue;
+    float     endValue;
+    uint32_t  startMs;
+    uint32_t  lengthMs;
+    RampShape profile;
+    bool      running;
+};
+
+#endif // RAMP_PROFILE_H
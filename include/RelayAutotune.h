@@ -0,0 +1,197 @@
+// RelayAutotune.h
+// ================================================================
+// Relay-feedback (Astrom-Hagglund) PID auto-tuner
+// ================================================================
+//  - The pump duty is switched between bias +/- amplitude on the sign
+//    of (setpoint - measurement), with a hysteresis band. The loop
+//    settles into a limit cycle at the ultimate period Pu.
+//  - Each full cycle (rising relay switch to rising relay switch)
+//    yields a period and a peak-to-peak amplitude 2a. After the
+//    warm-up cycles the measured ones are averaged and
+//        Ku = 4 d / (pi * sqrt(a^2 - eps^2))
+//  - Proposed gains (parallel form, Ki = Kp/Ti, Kd = Kp*Td):
+//        Ziegler-Nichols : Kp 0.60 Ku, Ti Pu/2,   Td Pu/8
+//        Tyreus-Luyben   : Kp Ku/2.2,  Ti 2.2 Pu, Td Pu/6.3
+//  - Fails on timeout (no stable oscillation, e.g. reverse-acting
+//    plant), or when the measurement leaves setpoint +/- maxDeviation.
+//
+//  The relay acts on the same error sign as PidController, so the
+//  identified gains are positive for a plant the PID loop can drive.
+// ================================================================
+#ifndef RELAY_AUTOTUNE_H
+#define RELAY_AUTOTUNE_H
+
+#include <cmath>
+#include <cstdint>
+
+enum AutotuneState : uint8_t {
+    AUTOTUNE_IDLE = 0,
+    AUTOTUNE_RUNNING,
+    AUTOTUNE_DONE,
+    AUTOTUNE_FAILED,
+};
+
+enum AutotuneFailure : uint8_t {
+    AUTOTUNE_FAIL_NONE = 0,
+    AUTOTUNE_FAIL_TIMEOUT,       // no consistent oscillation in time
+    AUTOTUNE_FAIL_DEVIATION,     // measurement left the allowed band
+    AUTOTUNE_FAIL_ABORTED,       // safety trip / user / state change
+};
+
+enum AutotuneRule : uint8_t {
+    AUTOTUNE_RULE_ZIEGLER_NICHOLS = 0,
+    AUTOTUNE_RULE_TYREUS_LUYBEN,
+};
+
+struct RelayAutotuneConfig {
+    float    setpoint;
+    float    bias;            // relay centre, output units (%)
+    float    amplitude;       // relay step d, output units
+    float    hysteresis;      // eps, measurement units
+    float    maxDeviation;    // |meas - setpoint| limit, measurement units
+    float    outputMin;
+    float    outputMax;
+    uint8_t  warmupCycles;    // discarded
+    uint8_t  measureCycles;   // averaged
+    uint32_t timeoutMs;
+};
+
+struct AutotuneGains {
+    float kp;
+    float ki;
+    float kd;
+};
+
+class RelayAutotuner {
+public:
+    RelayAutotuner() { cfg = RelayAutotuneConfig(); reset(); }
+
+    void begin(const RelayAutotuneConfig& c, uint32_t nowMs) {
+        cfg = c;
+        reset();
+        st = AUTOTUNE_RUNNING;
+        startMs = nowMs;
+    }
+
+    void abort() {
+        if (st == AUTOTUNE_RUNNING) fail(AUTOTUNE_FAIL_ABORTED);
+    }
+
+    // One sample; returns the relay output to apply
+    float update(float measurement, uint32_t nowMs) {
+        if (st != AUTOTUNE_RUNNING) return cfg.outputMin;
+
+        if (nowMs - startMs > cfg.timeoutMs) { fail(AUTOTUNE_FAIL_TIMEOUT); return cfg.outputMin; }
+        if (std::fabs(measurement - cfg.setpoint) > cfg.maxDeviation) {
+            fail(AUTOTUNE_FAIL_DEVIATION);
+            return cfg.outputMin;
+        }
+
+        float error = cfg.setpoint - measurement;
+        if (!primed) {
+            relayHigh = error > 0.0f;
+            halfMax = halfMin = measurement;
+            primed = true;
+        }
+
+        if (measurement > halfMax) halfMax = measurement;
+        if (measurement < halfMin) halfMin = measurement;
+
+        if (relayHigh && error < -cfg.hysteresis) {
+            // End of the high half: its minimum is the trough
+            relayHigh = false;
+            trough = halfMin;
+            haveTrough = true;
+            halfMax = measurement;
+        } else if (!relayHigh && error > cfg.hysteresis) {
+            // End of the low half: its maximum is the peak; full cycle closes
+            relayHigh = true;
+            float peak = halfMax;
+            halfMin = measurement;
+            if (haveRise && haveTrough) closeCycle(nowMs - lastRiseMs, (peak - trough) * 0.5f);
+            lastRiseMs = nowMs;
+            haveRise = true;
+        }
+
+        float out = cfg.bias + (relayHigh ? cfg.amplitude : -cfg.amplitude);
+        if (out < cfg.outputMin) out = cfg.outputMin;
+        if (out > cfg.outputMax) out = cfg.outputMax;
+        return out;
+    }
+
+    AutotuneState   state() const    { return st; }
+    AutotuneFailure failure() const  { return why; }
+    bool            running() const  { return st == AUTOTUNE_RUNNING; }
+    uint8_t         cyclesSeen() const { return cycles; }
+    uint8_t         cyclesNeeded() const { return (uint8_t)(cfg.warmupCycles + cfg.measureCycles); }
+    uint32_t        elapsedMs(uint32_t nowMs) const { return nowMs - startMs; }
+    const RelayAutotuneConfig& config() const { return cfg; }
+
+    // Valid once state() == AUTOTUNE_DONE
+    float ultimateGain() const       { return ku; }
+    float ultimatePeriodSec() const  { return pu; }
+    float amplitude() const          { return amp; }
+
+    AutotuneGains gains(AutotuneRule rule) const {
+        return gainsFor(rule, ku, pu);
+    }
+
+    static AutotuneGains gainsFor(AutotuneRule rule, float ku, float pu) {
+        float kp, ti, td;
+        if (rule == AUTOTUNE_RULE_TYREUS_LUYBEN) {
+            kp = ku / 2.2f; ti = 2.2f * pu; td = pu / 6.3f;
+        } else {
+            kp = 0.6f * ku; ti = 0.5f * pu; td = 0.125f * pu;
+        }
+        AutotuneGains g;
+        g.kp = kp;
+        g.ki = ti > 0.0f ? kp / ti : 0.0f;
+        g.kd = kp * td;
+        return g;
+    }
+
+    static const char* ruleName(AutotuneRule rule) {
+        return rule == AUTOTUNE_RULE_TYREUS_LUYBEN ? "Tyreus-Luyben" : "Ziegler-Nichols";
+    }
+
+private:
+    void reset() {
+        st = AUTOTUNE_IDLE; why = AUTOTUNE_FAIL_NONE;
+        primed = relayHigh = haveRise = haveTrough = false;
+        halfMax = halfMin = trough = 0.0f;
+        startMs = lastRiseMs = 0;
+        cycles = 0;
+        sumPeriodMs = 0.0f; sumAmp = 0.0f;
+        ku = pu = amp = 0.0f;
+    }
+
+    void fail(AutotuneFailure f) { st = AUTOTUNE_FAILED; why = f; }
+
+    void closeCycle(uint32_t periodMs, float a) {
+        cycles++;
+        if (cycles <= cfg.warmupCycles) return;
+        sumPeriodMs += (float)periodMs;
+        sumAmp += a;
+        if (cycles < cyclesNeeded()) return;
+
+        float n = (float)cfg.measureCycles;
+        pu  = sumPeriodMs / n / 1000.0f;
+        amp = sumAmp / n;
+        float eff = amp * amp - cfg.hysteresis * cfg.hysteresis;
+        float denom = 3.14159265f * (eff > 0.0f ? std::sqrt(eff) : amp);
+        ku = denom > 0.0f ? 4.0f * cfg.amplitude / denom : 0.0f;
+        st = AUTOTUNE_DONE;
+    }
+
+    RelayAutotuneConfig cfg;
+    AutotuneState   st;
+    AutotuneFailure why;
+    bool     primed, relayHigh, haveRise, haveTrough;
+    float    halfMax, halfMin, trough;
+    uint32_t startMs, lastRiseMs;
+    uint8_t  cycles;
+    float    sumPeriodMs, sumAmp;
+    float    ku, pu, amp;
+};
+
+#endif // RELAY_AUTOTUNE_H
@@ -0,0 +1,125 @@
+// RetainedWidget.h
+// ================================================================
+// Retained widget layer for the immediate-mode UI screens
+// ================================================================
+//  A screen defines its widgets once (id, rectangle, optional parent)
+//  and keeps its draw code. Every frame it builds a key for each widget
+//  from what the widget would show - the formatted text, colour, state
+//  - and update() says whether that widget must repaint. Only widgets
+//  whose key changed repaint, each inside its own rectangle, so a new
+//  pressure reading redraws one numeric label instead of the screen.
+//
+//  Keys come from the drawn text, not the raw float: noise below the
+//  display resolution (-61.04 -> -61.03, both "-61.0") costs nothing.
+//
+//  A parent that repaints (a card whose border colour changed) marks
+//  its children dirty; update children after their parent. sync()
+//  with the UIManager redraw epoch invalidates the whole tree on
+//  screen entry and explicit redraw requests.
+// ================================================================
+#ifndef RETAINED_WIDGET_H
+#define RETAINED_WIDGET_H
+
+#include <cstdint>
+#include <cstring>
+
+struct WidgetRect {
+    int16_t x, y, w, h;
+    uint32_t area() const { return (uint32_t)w * h; }
+};
+
+// FNV-1a over everything a widget draws; 0 is kept for "never painted"
+class WidgetKey {
+public:
+    WidgetKey& add(uint32_t v) {
+        for (int i = 0; i < 4; i++) { h_ ^= (v >> (i * 8)) & 0xFF; h_ *= 16777619u; }
+        return *this;
+    }
+    WidgetKey& add(int32_t v) { return add((uint32_t)v); }   // colours, flags, pixel widths
+    WidgetKey& add(const char* s) {
+        for (; s && *s; s++) { h_ ^= (uint8_t)*s; h_ *= 16777619u; }
+        h_ ^= 0xFF; h_ *= 16777619u;                 // "ab"+"c" != "a"+"bc"
+        return *this;
+    }
+    uint32_t value() const { return h_ ? h_ : 1; }
+
+private:
+    uint32_t h_ = 2166136261u;
+};
+
+struct WidgetStats {
+    uint32_t frames;          // sync() calls
+    uint32_t fullFrames;      // ... that invalidated everything
+    uint32_t paints;          // widget repaints
+    uint64_t paintedPx;       // sum of repainted widget areas
+};
+
+template <uint8_t MAX_WIDGETS = 24>
+class WidgetTree {
+public:
+    static constexpr uint8_t NO_PARENT = 0xFF;
+
+    WidgetTree() { memset(&stats_, 0, sizeof(stats_)); }
+
+    void define(uint8_t id, const WidgetRect& r, uint8_t parent = NO_PARENT) {
+        if (id >= MAX_WIDGETS) return;
+        w_[id] = { r, parent, 0, true };
+        if (id >= n_) n_ = id + 1;
+    }
+
+    // Start of a frame. Returns true when everything must be repainted
+    // (the caller clears the background first).
+    bool sync(uint32_t epoch) {
+        stats_.frames++;
+        if (synced_ && epoch == epoch_) return false;
+        epoch_ = epoch;
+        synced_ = true;
+        invalidateAll();
+        stats_.fullFrames++;
+        return true;
+    }
+
+    void invalidateAll() {
+        for (uint8_t i = 0; i < n_; i++) w_[i].dirty = true;
+    }
+    void invalidate(uint8_t id) {
+        if (id < n_) w_[id].dirty = true;
+    }
+
+    // True when the widget has to repaint now: its key changed or it
+    // (or its parent) was invalidated. Children of a repainting widget
+    // become dirty.
+    bool update(uint8_t id, uint32_t key) {
+        if (id >= n_) return false;
+        Node& w = w_[id];
+        if (!w.dirty && w.key == key) return false;
+        w.key = key;
+        w.dirty = false;
+        for (uint8_t i = 0; i < n_; i++) {
+            if (w_[i].parent == id) w_[i].dirty = true;
+        }
+        stats_.paints++;
+        stats_.paintedPx += w.rect.area();
+        return true;
+    }
+
+    const WidgetRect&  rect(uint8_t id) const { return w_[id].rect; }
+    const WidgetStats& stats() const { return stats_; }
+    void resetStats() { memset(&stats_, 0, sizeof(stats_)); }
+
+private:
+    struct Node {
+        WidgetRect rect;
+        uint8_t    parent;
+        uint32_t   key;
+        bool       dirty;
+    };
+
+    Node        w_[MAX_WIDGETS] = {};
+    uint8_t     n_ = 0;
+    uint32_t    epoch_ = 0;
+    bool        synced_ = false;
+    WidgetStats stats_;
+};
+
+#endif // RETAINED_WIDGET_H
@@ -0,0 +1,238 @@
+// RingBuffer.h
+// ================================================================
+// Lock-free single-producer / single-consumer sample ring
+// ================================================================
+//  - Producer (SensorRead task) only calls push().
+//  - Consumer (logger/analytics task) only calls pop()/drain()/clear().
+//  - Other tasks discard the unread samples with requestClear(): it
+//    records the head at the time of the call and the consumer moves
+//    tail up to it on its next drain(), so tail keeps one writer and
+//    samples pushed after the request survive.
+//  - Window readers (getAverage() etc.) may run from any task.
+//
+//  head/tail are free-running 32-bit counters; a slot index is
+//  (counter & MASK), so CAPACITY must be a power of two.
+//  One slot is kept free for the in-flight write, so at most
+//  CAPACITY - 1 unread samples are held. push() never blocks; if the
+//  consumer falls further behind, the oldest samples are overwritten
+//  and counted in overrunCount() so the loss is visible, not silent.
+// ================================================================
+#ifndef RING_BUFFER_H
+#define RING_BUFFER_H
+
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+template<typename T, size_t CAPACITY>
+class RingBuffer {
+    static_assert(CAPACITY >= 2 && (CAPACITY & (CAPACITY - 1)) == 0,
+                  "RingBuffer CAPACITY must be a power of two");
+
+private:
+    static constexpr uint32_t MASK  = static_cast<uint32_t>(CAPACITY - 1);
+    static constexpr uint32_t DEPTH = static_cast<uint32_t>(CAPACITY - 1);
+
+    T buffer[CAPACITY];
+    std::atomic<uint32_t> head;      // written by producer only
+    std::atomic<uint32_t> tail;      // written by consumer only
+    std::atomic<uint32_t> overruns;  // samples overwritten before pop
+    std::atomic<uint32_t> clearTo;   // head seen by the latest requestClear()
+    std::atomic<bool>     clearPending;
+
+    // Oldest readable position for a given head (skips overwritten slots)
+    static uint32_t firstValid(uint32_t h, uint32_t t) {
+        return (h - t > DEPTH) ? h - DEPTH : t;
+    }
+
+public:
+    RingBuffer() : head(0), tail(0), overruns(0), clearTo(0), clearPending(false) {
+        memset(buffer, 0, sizeof(buffer));
+    }
+
+    // ------------------------------------------------------------
+    // Producer side
+    // ------------------------------------------------------------
+
+    // Add item to buffer (wait-free, never fails)
+    bool push(const T& item) {
+        uint32_t h = head.load(std::memory_order_relaxed);
+        buffer[h & MASK] = item;
+        head.store(h + 1, std::memory_order_release);
+        return true;
+    }
+
+    // ------------------------------------------------------------
+    // Consumer side
+    // ------------------------------------------------------------
+
+    // Get oldest item from buffer
+    bool pop(T& item) {
+        T batch[1];
+        if (drain(batch, 1) == 0) return false;
+        item = batch[0];
+        return true;
+    }
+
+    // Move up to maxItems samples into out[], oldest first.
+    // Returns the number of samples copied.
+    size_t drain(T* out, size_t maxItems) {
+        if (clearPending.load(std::memory_order_relaxed) &&
+            clearPending.exchange(false, std::memory_order_acquire)) {
+            uint32_t c = clearTo.load(std::memory_order_relaxed);
+            uint32_t t = tail.load(std::memory_order_relaxed);
+            if (static_cast<int32_t>(c - t) > 0) tail.store(c, std::memory_order_release);
+        }
+        if (out == nullptr || maxItems == 0) return 0;
+
+        for (;;) {
+            uint32_t t = tail.load(std::memory_order_relaxed);
+            uint32_t h = head.load(std::memory_order_acquire);
+            uint32_t start = firstValid(h, t);
+            uint32_t n = h - start;
+            if (n == 0) return 0;
+            if (n > maxItems) n = static_cast<uint32_t>(maxItems);
+
+            for (uint32_t i = 0; i < n; i++) {
+                out[i] = buffer[(start + i) & MASK];
+            }
+
+            // The producer may have lapped us while copying; once it has
+            // started writing index start + CAPACITY the oldest copied slot
+            // may be torn, so discard the copy and retry from the new head.
+            std::atomic_thread_fence(std::memory_order_acquire);
+            uint32_t h2 = head.load(std::memory_order_relaxed);
+            if (h2 - start >= CAPACITY) continue;
+
+            if (start != t) {
+                overruns.fetch_add(start - t, std::memory_order_relaxed);
+            }
+            tail.store(start + n, std::memory_order_release);
+            return n;
+        }
+    }
+
+    // Discard all unread samples (consumer only)
+    void clear() {
+        tail.store(head.load(std::memory_order_acquire), std::memory_order_release);
+    }
+
+    // ------------------------------------------------------------
+    // Any task
+    // ------------------------------------------------------------
+
+    // Discard the samples unread at this call; the consumer's next
+    // drain() skips them. Concurrent requests keep the later head.
+    void requestClear() {
+        uint32_t h = head.load(std::memory_order_acquire);
+        uint32_t c = clearTo.load(std::memory_order_relaxed);
+        while (static_cast<int32_t>(h - c) > 0 &&
+               !clearTo.compare_exchange_weak(c, h, std::memory_order_relaxed)) {
+        }
+        clearPending.store(true, std::memory_order_release);
+    }
+
+    // ------------------------------------------------------------
+    // Observers (any task)
+    // ------------------------------------------------------------
+
+    // Peek at latest item without removing
+    bool peek(T& item) const {
+        uint32_t h = head.load(std::memory_order_acquire);
+        if (h == tail.load(std::memory_order_acquire)) return false;
+        item = buffer[(h - 1) & MASK];
+        return true;
+    }
+
+    // Get current size
+    size_t size() const {
+        uint32_t h = head.load(std::memory_order_acquire);
+        uint32_t t = tail.load(std::memory_order_acquire);
+        return h - firstValid(h, t);
+    }
+
+    bool isFull() const  { return size() >= DEPTH; }
+    bool isEmpty() const { return size() == 0; }
+
+    static constexpr size_t capacity() { return DEPTH; }
+
+    uint32_t pushedCount() const  { return head.load(std::memory_order_relaxed); }
+    uint32_t overrunCount() const { return overruns.load(std::memory_order_relaxed); }
+
+    // ------------------------------------------------------------
+    // Window statistics over the unread samples
+    // ------------------------------------------------------------
+
+    // Get average of all values in buffer
+    T getAverage() const {
+        uint32_t start, n;
+        snapshot(start, n);
+        if (n == 0) return T(0);
+
+        T sum = 0;
+        for (uint32_t i = 0; i < n; i++) {
+            sum += buffer[(start + i) & MASK];
+        }
+        return sum / n;
+    }
+
+    // Get maximum value in buffer
+    T getMax() const {
+        uint32_t start, n;
+        snapshot(start, n);
+        if (n == 0) return T(0);
+
+        T maxVal = buffer[start & MASK];
+        for (uint32_t i = 1; i < n; i++) {
+            T v = buffer[(start + i) & MASK];
+            if (v > maxVal) maxVal = v;
+        }
+        return maxVal;
+    }
+
+    // Get minimum value in buffer
+    T getMin() const {
+        uint32_t start, n;
+        snapshot(start, n);
+        if (n == 0) return T(0);
+
+        T minVal = buffer[start & MASK];
+        for (uint32_t i = 1; i < n; i++) {
+            T v = buffer[(start + i) & MASK];
+            if (v < minVal) minVal = v;
+        }
+        return minVal;
+    }
+
+    // Get standard deviation
+    float getStdDev() const {
+        uint32_t start, n;
+        snapshot(start, n);
+        if (n < 2) return 0.0f;
+
+        float sum = 0.0f;
+        for (uint32_t i = 0; i < n; i++) {
+            sum += static_cast<float>(buffer[(start + i) & MASK]);
+        }
+        float avg = sum / n;
+
+        float sumSquares = 0.0f;
+        for (uint32_t i = 0; i < n; i++) {
+            float diff = static_cast<float>(buffer[(start + i) & MASK]) - avg;
+            sumSquares += diff * diff;
+        }
+        return sqrtf(sumSquares / n);
+    }
+
+private:
+    void snapshot(uint32_t& start, uint32_t& n) const {
+        uint32_t h = head.load(std::memory_order_acquire);
+        uint32_t t = tail.load(std::memory_order_acquire);
+        start = firstValid(h, t);
+        n = h - start;
+    }
+};
+
+#endif // RING_BUFFER_H
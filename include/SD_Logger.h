@@ -14,7 +14,7 @@ void initSD();
 //    
 void logCycle();
 void logError(const ErrorInfo& error);
-void logSensorTrend();
+void logSensorTrend(const SensorData* frames, size_t count);
 
 //   
 void generateDailyReport();
@@ -0,0 +1,40 @@
+#pragma once
+// ================================================================
+// SafetyIsr.h    E-stop / input interrupt fast path
+// ================================================================
+//  - E-stop falling edge: the IRAM ISR drives the pump PWM pin low
+//    (LEDC detached), 12V main off, valve off, 12V emergency on, then
+//    posts SM_EV_ESTOP_PRESSED. The debounce check runs afterwards in
+//    the SafetyIsr task and only classifies the trip for the log.
+//  - Limit switch / photo sensor edges post SM_EV_LIMIT_SWITCH /
+//    SM_EV_PART_REMOVED directly instead of waiting for the 100 ms
+//    sensor frame.
+//  - Reaction time is edge -> outputs safe, timestamped in hardware:
+//    MCPWM capture latches the E-stop falling edge and the 12V
+//    emergency pin's rise (the last output the ISR sets) on one timer.
+//    The worst value and the trip count are kept in NVS.
+// ================================================================
+
+#include <Arduino.h>
+
+struct SafetyLatencyStats {
+    uint32_t lastNs;          // reaction (edge -> outputs), most recent timed trip
+    uint32_t worstNs;         // since boot
+    uint32_t worstEverNs;     // persisted
+    uint32_t bodyNs;          // ISR body, most recent trip (CPU cycles)
+    uint32_t trips;           // ISR trips since boot
+    uint32_t tripsTotal;      // persisted
+    uint32_t confirmed;       // still pressed after SAFETY_ESTOP_CONFIRM_MS
+    uint32_t glitches;        // released before confirmation
+    uint32_t untimed;         // no output rise captured (capture off, already high)
+    uint32_t inputEdges;      // limit / photo events posted from the ISR
+};
+
+void initSafetyIsr();                 // after the input pins are configured
+
+bool safetyOutputsTripped();          // ISR has cut the outputs
+bool safetyRestoreOutputs();          // re-attach pump PWM; false while E-stop pressed
+
+SafetyLatencyStats getSafetyLatencyStats();
+void resetSafetyLatency();            // clears the persisted worst case too
+void printSafetyLatency();
@@ -0,0 +1,85 @@
+// SampleWindow.h
+// ================================================================
+// Fixed-capacity sliding window with a contiguous view
+// ================================================================
+//  - No heap: storage is a member array sized at compile time.
+//  - push() is O(1). Each sample is written twice (slot and slot + N)
+//    so the newest size() samples are always contiguous in memory;
+//    view() hands them out oldest-first as a plain pointer range.
+//  - Single-task use (SensorManager is owned by the sensor task).
+// ================================================================
+#ifndef SAMPLE_WINDOW_H
+#define SAMPLE_WINDOW_H
+
+#include <cstddef>
+#include <cstdint>
+
+// Read-only contiguous range, oldest sample first
+template<typename T>
+struct SampleView {
+    const T* ptr;
+    size_t   len;
+
+    const T* begin() const { return ptr; }
+    const T* end() const   { return ptr + len; }
+    const T* data() const  { return ptr; }
+    size_t   size() const  { return len; }
+    bool     empty() const { return len == 0; }
+    const T& operator[](size_t i) const { return ptr[i]; }
+    const T& front() const { return ptr[0]; }
+    const T& back() const  { return ptr[len - 1]; }
+
+    // Newest n samples (all of them if n >= len)
+    SampleView last(size_t n) const {
+        if (n > len) n = len;
+        return SampleView{ptr + (len - n), n};
+    }
+};
+
+template<typename T, size_t N>
+class SampleWindow {
+    static_assert(N >= 1, "SampleWindow needs at least one slot");
+
+public:
+    SampleWindow() : next(0), count(0) {}
+
+    void push(const T& value) {
+        buf[next]     = value;
+        buf[next + N] = value;
+        next = (next + 1 == N) ? 0 : next + 1;
+        if (count < N) count++;
+    }
+
+    void clear() {
+        next = 0;
+        count = 0;
+    }
+
+    // Oldest..newest. When full the window starts at 'next', otherwise at 0;
+    // in both cases [start, start + count) lies inside the mirrored array.
+    SampleView<T> view() const {
+        size_t start = (count < N) ? 0 : next;
+        return SampleView<T>{buf + start, count};
+    }
+
+    // Mean of the newest 'samples' values (0 if empty)
+    T average(size_t samples) const {
+        SampleView<T> v = view().last(samples);
+        if (v.empty()) return T(0);
+        T sum = T(0);
+        for (const T& x : v) sum += x;
+        return sum / static_cast<T>(v.size());
+    }
+
+    size_t size() const  { return count; }
+    bool   empty() const { return count == 0; }
+    bool   full() const  { return count == N; }
+    static constexpr size_t capacity() { return N; }
+
+private:
+    T      buf[2 * N];
+    size_t next;
+    size_t count;
+};
+
+#endif // SAMPLE_WINDOW_H
@@ -0,0 +1,50 @@
+#pragma once
+// ================================================================
+// SdLogService.h    Batched write-behind SD logging
+// ================================================================
+//  - sdLogAppend() formats nothing and never touches the card: the
+//    record is copied into the stream's PSRAM ring and the call
+//    returns. A full ring drops the record (counted).
+//  - One background task ("SdLog") owns every file handle. Handles
+//    stay open; data goes out in SDLOG_BLOCK_SIZE aligned writes or
+//    when it is older than the stream's max age, and File.flush()
+//    runs every SDLOG_SYNC_INTERVAL_MS while dirty (LogWriteBehind.h).
+//  - CSV streams rotate daily / at SDLOG_ROTATE_BYTES into dated
+//    segments that LogRetentionService prunes to the SD budget.
+// ================================================================
+
+#include <Arduino.h>
+#include <FS.h>
+#include "LogWriteBehind.h"
+
+enum SdLogStream : uint8_t {
+    SDLOG_CYCLE = 0,      // /logs/cycle_log.csv
+    SDLOG_ERROR,          // /logs/error_log.csv
+    SDLOG_TREND,          // /logs/sensor_trend.csv
+    SDLOG_TELEMETRY,      // /logs/telemetry.csv (taskLogger)
+    SDLOG_TS_DATA,        // /logs/trend.tsb, binary blocks (TsLog.h)
+    SDLOG_TS_INDEX,       // /logs/trend.tsi, block index
+    SDLOG_HEALTH_ROLLUP,  // /logs/health_rollup.bin, hour / day buckets (MetricRollup.h)
+    SDLOG_STREAM_COUNT
+};
+
+// fs: SD (SPI, guarded by SPIBusManager) or SD_MMC. First call wins.
+void initSdLogService(fs::FS& fs, bool sharedSpi);
+bool sdLogReady();
+
+bool sdLogAppend(SdLogStream s, const char* line);
+bool sdLogAppendRaw(SdLogStream s, const void* data, size_t len);
+bool sdLogPrintf(SdLogStream s, const char* fmt, ...) __attribute__((format(printf, 2, 3)));
+void sdLogSetPath(SdLogStream s, const char* path);
+
+void sdLogFlushAll();                 // write everything + sync on the next tick
+void sdLogCloseAll();                 // same, then close the handles (blocks up to 2 s)
+
+// Read side for modules that query their own files (TsLogger)
+fs::FS* sdLogFs();
+bool    sdLogLockBus(uint32_t timeoutMs);   // SPI_DEV_SD when the FS shares the bus
+void    sdLogUnlockBus();
+
+LogStreamStats getSdLogStats(SdLogStream s);
+void resetSdLogStats();
+void printSdLogStats();
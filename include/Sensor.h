@@ -5,6 +5,7 @@
 
 #include <OneWire.h>
 #include <DallasTemperature.h>
+#include "SensorFrame.h"
 
 //     () 
 extern OneWire oneWire;
@@ -14,7 +15,11 @@ extern DallasTemperature tempSensor;
 void initSensors();
 
 //    
-void  readSensors();
+// Single acquisition point: call once per SensorRead tick and pass the
+// frame on by reference. Valid until the next readSensors() call.
+const SensorFrame& readSensors();
+SensorFrame latestSensorFrame();   // any task, lock-free copy
+
 float readTemperature();    // DS18B20  
 float readPressure();
 float readCurrent();
@@ -28,9 +33,15 @@ void calibrateCurrent();
 void calibrateTemperature();
 
 //    
-void checkSensorHealth();
+void checkSensorHealth(const SensorFrame& frame);
+bool validateParameters(const SensorFrame& frame);
+void checkSensorHealth();          // uses latestSensorFrame()
 bool validateParameters();
 
+// Acquisition rate counters (serial "sensor_rate")
+SensorAcqStats getSensorAcqStats();
+void printSensorAcqStats();
+
 //     
 bool isTemperatureSensorConnected();
 int  getTemperatureSensorCount();
\ No newline at end of file
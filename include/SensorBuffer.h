@@ -3,6 +3,9 @@
 #define SENSOR_BUFFER_H
 
 #include <Arduino.h>
+#include "RingBuffer.h"
+#include "WindowStats.h"
+#include "SensorFrame.h"
 
 // SensorData  ( )
 #ifndef SENSOR_DATA_DEFINED
@@ -19,161 +22,6 @@ struct SensorData {
 #endif
 
 
-// ================================================================
-// Ring Buffer Template -   
-// ================================================================
-template<typename T, size_t CAPACITY>
-class RingBuffer {
-private:
-    T buffer[CAPACITY];
-    volatile size_t head;
-    volatile size_t tail;
-    volatile size_t count;
-    SemaphoreHandle_t mutex;
-    
-public:
-    RingBuffer() : head(0), tail(0), count(0) {
-        mutex = xSemaphoreCreateMutex();
-        memset(buffer, 0, sizeof(buffer));
-    }
-    
-    ~RingBuffer() {
-        if (mutex) {
-            vSemaphoreDelete(mutex);
-        }
-    }
-    
-    // Add item to buffer
-    bool push(const T& item) {
-        if (xSemaphoreTake(mutex, pdMS_TO_TICKS(10)) == pdTRUE) {
-            if (count >= CAPACITY) {
-                // Buffer full, overwrite oldest
-                tail = (tail + 1) % CAPACITY;
-            } else {
-                count++;
-            }
-            
-            buffer[head] = item;
-            head = (head + 1) % CAPACITY;
-            
-            xSemaphoreGive(mutex);
-            return true;
-        }
-        return false;
-    }
-    
-    // Get item from buffer
-    bool pop(T& item) {
-        if (xSemaphoreTake(mutex, pdMS_TO_TICKS(10)) == pdTRUE) {
-            if (count == 0) {
-                xSemaphoreGive(mutex);
-                return false;
-            }
-            
-            item = buffer[tail];
-            tail = (tail + 1) % CAPACITY;
-            count--;
-            
-            xSemaphoreGive(mutex);
-            return true;
-        }
-        return false;
-    }
-    
-    // Peek at latest item without removing
-    bool peek(T& item) const {
-        if (count == 0) return false;
-        size_t lastIndex = (head == 0) ? CAPACITY - 1 : head - 1;
-        item = buffer[lastIndex];
-        return true;
-    }
-    
-    // Get current size
-    size_t size() const {
-        return count;
-    }
-    
-    // Check if buffer is full
-    bool isFull() const {
-        return count >= CAPACITY;
-    }
-    
-    // Check if buffer is empty
-    bool isEmpty() const {
-        return count == 0;
-    }
-    
-    // Clear buffer
-    void clear() {
-        if (xSemaphoreTake(mutex, pdMS_TO_TICKS(10)) == pdTRUE) {
-            head = 0;
-            tail = 0;
-            count = 0;
-            xSemaphoreGive(mutex);
-        }
-    }
-    
-    // Get average of all values in buffer
-    T getAverage() const {
-        if (count == 0) return T(0);
-        
-        T sum = 0;
-        size_t index = tail;
-        for (size_t i = 0; i < count; i++) {
-            sum += buffer[index];
-            index = (index + 1) % CAPACITY;
-        }
-        return sum / count;
-    }
-    
-    // Get maximum value in buffer
-    T getMax() const {
-        if (count == 0) return T(0);
-        
-        T maxVal = buffer[tail];
-        size_t index = tail;
-        for (size_t i = 0; i < count; i++) {
-            if (buffer[index] > maxVal) {
-                maxVal = buffer[index];
-            }
-            index = (index + 1) % CAPACITY;
-        }
-        return maxVal;
-    }
-    
-    // Get minimum value in buffer
-    T getMin() const {
-        if (count == 0) return T(0);
-        
-        T minVal = buffer[tail];
-        size_t index = tail;
-        for (size_t i = 0; i < count; i++) {
-            if (buffer[index] < minVal) {
-                minVal = buffer[index];
-            }
-            index = (index + 1) % CAPACITY;
-        }
-        return minVal;
-    }
-    
-    // Get standard deviation
-    float getStdDev() const {
-        if (count < 2) return 0.0f;
-        
-        float avg = static_cast<float>(getAverage());
-        float sumSquares = 0.0f;
-        
-        size_t index = tail;
-        for (size_t i = 0; i < count; i++) {
-            float diff = static_cast<float>(buffer[index]) - avg;
-            sumSquares += diff * diff;
-            index = (index + 1) % CAPACITY;
-        }
-        
-        return sqrt(sumSquares / count);
-    }
-};
-
 // ================================================================
 //   
 // ================================================================
@@ -215,11 +63,13 @@ struct SensorStats {
 constexpr size_t TEMP_BUFFER_SIZE = 60;       // 60 samples = 1 @ 1Hz
 constexpr size_t PRESSURE_BUFFER_SIZE = 60;
 constexpr size_t CURRENT_BUFFER_SIZE = 60;
-constexpr size_t SENSOR_DATA_BUFFER_SIZE = 20;
+// Power of two (RingBuffer holds CAPACITY - 1 samples)
+constexpr size_t SENSOR_DATA_BUFFER_SIZE = 32; // drained by DataLogger task
 
-extern RingBuffer<float, TEMP_BUFFER_SIZE> temperatureBuffer;
-extern RingBuffer<float, PRESSURE_BUFFER_SIZE> pressureBuffer;
-extern RingBuffer<float, CURRENT_BUFFER_SIZE> currentBuffer;
+// Per-channel windows: statistics are maintained on push, queries are O(1)
+extern WindowStats<TEMP_BUFFER_SIZE> temperatureBuffer;
+extern WindowStats<PRESSURE_BUFFER_SIZE> pressureBuffer;
+extern WindowStats<CURRENT_BUFFER_SIZE> currentBuffer;
 extern RingBuffer<SensorData, SENSOR_DATA_BUFFER_SIZE> sensorDataBuffer;
 
 // ================================================================
@@ -227,7 +77,7 @@ extern RingBuffer<SensorData, SENSOR_DATA_BUFFER_SIZE> sensorDataBuffer;
 // ================================================================
 
 //    
-void updateSensorBuffers();
+void updateSensorBuffers(const SensorFrame& frame);
 
 //  
 void calculateSensorStats(SensorStats& stats);
@@ -235,6 +85,9 @@ void calculateSensorStats(SensorStats& stats);
 //  
 void clearSensorBuffers();
 
+// Batch-drain raw frames (DataLogger task is the single consumer)
+size_t drainSensorData(SensorData* out, size_t maxItems);
+
 //   
 void printBufferStatus();
 
@@ -0,0 +1,37 @@
+// SensorFrame.h
+// ================================================================
+// One acquisition of every sensor channel
+// ================================================================
+//  - Produced once per SensorRead tick by readSensors() (Sensor.cpp)
+//    and handed by const reference to the state machine, PID,
+//    buffers, health check and UI change detection, so they all see
+//    values from the same instant.
+//  - Other tasks get a copy through latestSensorFrame().
+// ================================================================
+#ifndef SENSOR_FRAME_H
+#define SENSOR_FRAME_H
+
+#include <cstdint>
+
+struct SensorFrame {
+    uint32_t seq;            // 1, 2, 3 ... (0 = nothing acquired yet)
+    uint64_t timestampUs;    // esp_timer time of the acquisition
+    float    pressure;       // kPa, offset applied
+    float    current;        // A, offset applied
+    float    temperature;    // C
+    bool     limitSwitch;
+    bool     photoSensor;
+    bool     emergencyStop;
+    uint32_t adcSeq;         // AdcStream frame used (0 = one-shot fallback)
+};
+
+// Rates over the interval since the previous getSensorAcqStats() call
+struct SensorAcqStats {
+    float framesPerSec;          // readSensors() acquisitions
+    float channelReadsPerSec;    // pressure/current values requested
+    float oneShotPerSec;         // conversions triggered by readers (analogRead)
+    float streamSamplesPerSec;   // DMA conversions (independent of readers)
+    uint32_t staleReads;         // ADC busy: last value returned (total)
+};
+
+#endif // SENSOR_FRAME_H
@@ -5,7 +5,8 @@
 #pragma once
 
 #include <Arduino.h>
-#include <vector>
+#include "SampleWindow.h"
+#include "SensorFrame.h"
 
 // ================================================================
 //    (Config.h )
@@ -32,7 +33,9 @@ public:
     void begin();
     
     //  
-    void readAllSensors();
+    void readAllSensors();                      // copies latestSensorFrame()
+    void applyFrame(const SensorFrame& frame);  // SensorRead task fan-out
+    uint32_t getFrameSeq() const { return frameSeq; }
     
     //  
     void updateBuffers();
@@ -50,10 +53,11 @@ public:
     float getTemperatureAverage(uint8_t samples = 10);
     float getCurrentAverage(uint8_t samples = 10);
     
-    //  
-    const std::vector<float>& getPressureBuffer() const { return pressureBuffer; }
-    const std::vector<float>& getTemperatureBuffer() const { return temperatureBuffer; }
-    const std::vector<float>& getCurrentBuffer() const { return currentBuffer; }
+    //   (contiguous, oldest first; valid until the next updateBuffers())
+    static constexpr size_t BUFFER_CAPACITY = 100;
+    SampleView<float> getPressureBuffer() const { return pressureBuffer.view(); }
+    SampleView<float> getTemperatureBuffer() const { return temperatureBuffer.view(); }
+    SampleView<float> getCurrentBuffer() const { return currentBuffer.view(); }
     
     // ================================================================
     //    ()
@@ -83,27 +87,16 @@ public:
 private:
     //   (!)
     SensorData sensorData;
+    uint32_t   frameSeq = 0;
     
-    // 
-    std::vector<float> pressureBuffer;
-    std::vector<float> temperatureBuffer;
-    std::vector<float> currentBuffer;
+    //  (static storage, no heap after begin())
+    SampleWindow<float, BUFFER_CAPACITY> pressureBuffer;
+    SampleWindow<float, BUFFER_CAPACITY> temperatureBuffer;
+    SampleWindow<float, BUFFER_CAPACITY> currentBuffer;
     
     //  
     float pressureOffset = 0.0f;
     float currentOffset = 0.0f;
-    
-    //   
-    float calculateAverage(const std::vector<float>& buffer, uint8_t samples);
-    void addToBuffer(std::vector<float>& buffer, float value, size_t maxSize = 100);
-    
-    //    ()
-    float readPressureSensor();
-    float readCurrentSensor();
-    float readTemperatureSensor();
-    bool readLimitSwitchSensor();
-    bool readPhotoSensorInput();
-    bool readEmergencyStopInput();
 };
 
 //  
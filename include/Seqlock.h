@@ -0,0 +1,67 @@
+// Seqlock.h
+// ================================================================
+// Single-writer "latest value" cell with lock-free readers
+// ================================================================
+//  - Two slots plus two generation counters (writes started /
+//    writes completed). write() fills the slot readers are NOT using,
+//    then publishes it; it never blocks or waits.
+//  - read() copies the last completed slot and only retries if the
+//    writer has since started overwriting that same slot, i.e. it was
+//    lapped by two writes during the copy.
+//  - A reader that preempts the writer mid-write (same core, higher
+//    priority) still reads the previous slot and never spins.
+//  - T must be trivially copyable (plain sensor/state structs).
+// ================================================================
+#ifndef SEQLOCK_H
+#define SEQLOCK_H
+
+#include <atomic>
+#include <cstdint>
+#include <type_traits>
+
+template<typename T>
+class Seqlock {
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "Seqlock payload must be trivially copyable");
+
+public:
+    Seqlock() : slot() {}
+
+    // Writer side (exactly one task)
+    void write(const T& v) {
+        uint32_t n = started.load(std::memory_order_relaxed) + 1;
+        started.store(n, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        slot[n & 1u] = v;
+        completed.store(n, std::memory_order_release);
+    }
+
+    // Reader side (any task)
+    T read() const {
+        T out;
+        while (!tryRead(out, UINT32_MAX)) {}
+        return out;
+    }
+
+    // Bounded variant; false only if lapped on every attempt
+    bool tryRead(T& out, uint32_t maxRetries = 8) const {
+        for (uint32_t i = 0; ; i++) {
+            uint32_t c = completed.load(std::memory_order_acquire);
+            out = slot[c & 1u];
+            std::atomic_thread_fence(std::memory_order_acquire);
+            // Slot c&1 is rewritten by write c+2; anything before that is fine
+            if (started.load(std::memory_order_relaxed) - c < 2u) return true;
+            if (i >= maxRetries) return false;
+        }
+    }
+
+    // Number of completed writes
+    uint32_t version() const { return completed.load(std::memory_order_acquire); }
+
+private:
+    T                     slot[2];
+    std::atomic<uint32_t> started{0};
+    std::atomic<uint32_t> completed{0};
+};
+
+#endif // SEQLOCK_H
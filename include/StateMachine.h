@@ -1,7 +1,18 @@
 #pragma once
 
+#include <freertos/FreeRTOS.h>
+#include "SensorFrame.h"
+#include "VacuumStateTable.h"
+
 // StateMachine.h      (, / )
-void        updateStateMachine();
+void        updateStateMachine(uint32_t waitMs = 0);   // blocks up to waitMs for events
 void        changeState(SystemState newState);
 const char* getStateName(SystemState state);
-void        initStateMachine();  // Mutex 
\ No newline at end of file
+void        initStateMachine();  // Mutex, event queue, timers
+
+// Event sources
+void        postStateEvent(SmEvent ev);                  // commands (any task)
+void        postStateEventFromISR(SmEvent ev, BaseType_t* woken); // GPIO ISR, IRAM
+void        stateMachineOnFrame(const SensorFrame& frame); // SensorRead task: level edges
+void        rearmStateEvents();                          // re-post active levels on next frame
+uint32_t    getStateEventsDropped();
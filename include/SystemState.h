@@ -0,0 +1,27 @@
+// SystemState.h
+// ================================================================
+// System state / control mode enums (no Config.h, for VacuumStateTable.h)
+// ================================================================
+#ifndef SYSTEM_STATE_H
+#define SYSTEM_STATE_H
+
+//   
+enum SystemState {
+  STATE_IDLE,
+  STATE_VACUUM_ON,
+  STATE_VACUUM_HOLD,
+  STATE_VACUUM_BREAK,
+  STATE_WAIT_REMOVAL,
+  STATE_COMPLETE,
+  STATE_ERROR,
+  STATE_EMERGENCY_STOP,
+  STATE_STANDBY 
+};
+
+enum ControlMode {
+  MODE_MANUAL,
+  MODE_AUTO,
+  MODE_PID
+};
+
+#endif // SYSTEM_STATE_H
@@ -1,5 +1,12 @@
 
 #pragma once
 // Trend_Graph.h -    
+#include <stdint.h>
+#include "GestureRecognizer.h"
+
+void initGraphData();                               // before the sensor task starts
+void addGraphPoint(float pressure, float current);  // every 100 ms sensor tick
 void drawTrendGraph();
+void handleGraphTouch(uint16_t x, uint16_t y);
+void handleGraphGesture(const Gesture& g);          // drag / swipe / long press (TouchDispatcher)
 void updateTrendData(float value);
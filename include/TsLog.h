@@ -0,0 +1,508 @@
+// TsLog.h
+// ================================================================
+// Binary columnar time-series log (pressure / current / temperature)
+// ================================================================
+//  Data file (.tsb): fixed TS_BLOCK_SIZE blocks, block n at n * size.
+//    header (TS_HEADER_SIZE, little-endian)
+//      magic "TSB1", version, channels, count, seq,
+//      tFirst (u64 ms), span (ms to the last sample),
+//      per channel min / max (i32) and sum (i64), column lengths, CRC32
+//    body: columns, not rows
+//      time    count-1 unsigned varint deltas (ms)
+//      ch0..2  zigzag varint of the first value, then zigzag deltas
+//    Values are fixed point: 0.01 kPa, 1 mA, 0.01 C. A slowly moving
+//    channel costs one byte per sample. CRC covers the whole block
+//    (CRC field as zero) so a torn or stale block is rejected.
+//
+//  Index file (.tsi): one TS_INDEX_SIZE entry per sealed block with
+//    the same time range and stats, so a range query binary-searches
+//    the index, takes the inner blocks' stats as they are and only
+//    decodes the two edge blocks. Clock steps back (reboot before NTP
+//    sync) split the index into sorted runs, see TsRuns.
+//
+//  No file access here: queries read index entries and blocks through
+//  the caller's get / fetch callbacks (TsLogger.cpp reads the SD card).
+// ================================================================
+#ifndef TS_LOG_H
+#define TS_LOG_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+enum TsChannel : uint8_t {
+    TS_CH_PRESSURE = 0,     // 0.01 kPa
+    TS_CH_CURRENT,          // 1 mA
+    TS_CH_TEMPERATURE,      // 0.01 C
+    TS_CHANNELS
+};
+
+constexpr uint32_t TS_MAGIC        = 0x31425354;   // "TSB1"
+constexpr uint8_t  TS_VERSION      = 1;
+constexpr size_t   TS_BLOCK_SIZE   = 4096;
+constexpr size_t   TS_HEADER_SIZE  = 84;
+constexpr size_t   TS_BODY_SIZE    = TS_BLOCK_SIZE - TS_HEADER_SIZE;
+constexpr size_t   TS_INDEX_SIZE   = 72;
+constexpr uint32_t TS_MAX_GAP_MS   = 0x0FFFFFFF;   // larger gaps start a new block
+constexpr size_t   TS_MAX_SAMPLES  = TS_BODY_SIZE / (TS_CHANNELS + 1) + 1;   // >= 1 byte per column
+
+constexpr int32_t  TS_SCALE[TS_CHANNELS]    = { 100, 1000, 100 };
+constexpr uint8_t  TS_DECIMALS[TS_CHANNELS] = { 2, 3, 2 };
+
+struct TsSample {
+    uint64_t tMs;
+    int32_t  v[TS_CHANNELS];
+};
+
+struct TsChannelStats {
+    int32_t min;
+    int32_t max;
+    int64_t sum;
+};
+
+// Header of a sealed block, also the content of an index entry
+struct TsBlockInfo {
+    uint32_t       seq;        // block number in the data file
+    uint16_t       count;
+    uint64_t       tFirst;
+    uint32_t       span;       // tLast - tFirst
+    TsChannelStats ch[TS_CHANNELS];
+
+    uint64_t tLast() const { return tFirst + span; }
+};
+
+// ================================================================
+//  Encoding helpers
+// ================================================================
+namespace tslog {
+
+inline int32_t quantize(float v, TsChannel c) {
+    float s = v * (float)TS_SCALE[c];
+    if (s >  1.0e9f) s =  1.0e9f;
+    if (s < -1.0e9f) s = -1.0e9f;
+    return (int32_t)(s < 0 ? s - 0.5f : s + 0.5f);
+}
+
+inline float toFloat(int32_t q, TsChannel c) {
+    return (float)q / (float)TS_SCALE[c];
+}
+
+inline uint32_t zigzag(int32_t v)     { return ((uint32_t)v << 1) ^ (uint32_t)(v >> 31); }
+inline int32_t  unzigzag(uint32_t u)  { return (int32_t)(u >> 1) ^ -(int32_t)(u & 1); }
+
+inline size_t putVarint(uint8_t* out, uint32_t v) {
+    size_t n = 0;
+    while (v >= 0x80) { out[n++] = (uint8_t)(v | 0x80); v >>= 7; }
+    out[n++] = (uint8_t)v;
+    return n;
+}
+
+// false on truncation / overlong encoding
+inline bool getVarint(const uint8_t*& p, const uint8_t* end, uint32_t& v) {
+    v = 0;
+    for (uint8_t shift = 0; shift < 35 && p < end; shift += 7) {
+        uint8_t b = *p++;
+        v |= (uint32_t)(b & 0x7F) << shift;
+        if (!(b & 0x80)) return true;
+    }
+    return false;
+}
+
+inline void put16(uint8_t* p, uint16_t v) { p[0] = (uint8_t)v; p[1] = (uint8_t)(v >> 8); }
+inline void put32(uint8_t* p, uint32_t v) { put16(p, (uint16_t)v); put16(p + 2, (uint16_t)(v >> 16)); }
+inline void put64(uint8_t* p, uint64_t v) { put32(p, (uint32_t)v); put32(p + 4, (uint32_t)(v >> 32)); }
+inline uint16_t get16(const uint8_t* p) { return (uint16_t)(p[0] | (p[1] << 8)); }
+inline uint32_t get32(const uint8_t* p) { return get16(p) | ((uint32_t)get16(p + 2) << 16); }
+inline uint64_t get64(const uint8_t* p) { return get32(p) | ((uint64_t)get32(p + 4) << 32); }
+
+struct Crc32Table {
+    uint32_t t[256];
+    constexpr Crc32Table() : t() {
+        for (uint32_t i = 0; i < 256; i++) {
+            uint32_t c = i;
+            for (int k = 0; k < 8; k++) c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            t[i] = c;
+        }
+    }
+};
+static constexpr Crc32Table CRC32_TABLE;
+
+inline uint32_t crc32(uint32_t crc, const uint8_t* p, size_t n) {
+    crc = ~crc;
+    while (n--) crc = CRC32_TABLE.t[(crc ^ *p++) & 0xFF] ^ (crc >> 8);
+    return ~crc;
+}
+
+// Block CRC with the CRC field (offset 80) taken as absent
+inline uint32_t blockCrc(const uint8_t* blk) {
+    uint32_t c = crc32(0, blk, 80);
+    return crc32(c, blk + 84, TS_BLOCK_SIZE - 84);
+}
+
+inline void putStats(uint8_t* p, const TsChannelStats* ch) {
+    for (uint8_t c = 0; c < TS_CHANNELS; c++, p += 16) {
+        put32(p, (uint32_t)ch[c].min);
+        put32(p + 4, (uint32_t)ch[c].max);
+        put64(p + 8, (uint64_t)ch[c].sum);
+    }
+}
+
+inline void getStats(const uint8_t* p, TsChannelStats* ch) {
+    for (uint8_t c = 0; c < TS_CHANNELS; c++, p += 16) {
+        ch[c].min = (int32_t)get32(p);
+        ch[c].max = (int32_t)get32(p + 4);
+        ch[c].sum = (int64_t)get64(p + 8);
+    }
+}
+
+} // namespace tslog
+
+// ================================================================
+//  Writer: fills one block at a time
+// ================================================================
+class TsBlockWriter {
+public:
+    explicit TsBlockWriter(uint32_t firstSeq = 0) { reset(firstSeq); }
+
+    void reset(uint32_t seq) {
+        info = TsBlockInfo();
+        info.seq = seq;
+        for (uint8_t c = 0; c <= TS_CHANNELS; c++) len[c] = 0;
+        lastT = 0;
+        for (uint8_t c = 0; c < TS_CHANNELS; c++) last[c] = 0;
+    }
+
+    // false = does not fit (block full, time went backwards or a long
+    // gap): seal() and add again
+    bool add(const TsSample& s) {
+        uint8_t enc[TS_CHANNELS + 1][5];
+        size_t  n[TS_CHANNELS + 1];
+
+        if (info.count == 0) {
+            n[0] = 0;
+        } else {
+            if (s.tMs < lastT || s.tMs - lastT > TS_MAX_GAP_MS) return false;
+            if (s.tMs - info.tFirst > 0xFFFFFFFFull) return false;          // span is u32
+            n[0] = tslog::putVarint(enc[0], (uint32_t)(s.tMs - lastT));
+        }
+        for (uint8_t c = 0; c < TS_CHANNELS; c++) {
+            int32_t d = info.count == 0 ? s.v[c] : (int32_t)((uint32_t)s.v[c] - (uint32_t)last[c]);
+            n[c + 1] = tslog::putVarint(enc[c + 1], tslog::zigzag(d));
+        }
+
+        size_t used = 0, extra = 0;
+        for (uint8_t c = 0; c <= TS_CHANNELS; c++) { used += len[c]; extra += n[c]; }
+        if (used + extra > TS_BODY_SIZE || info.count == 0xFFFF) return false;
+
+        for (uint8_t c = 0; c <= TS_CHANNELS; c++) {
+            memcpy(col[c] + len[c], enc[c], n[c]);
+            len[c] += (uint16_t)n[c];
+        }
+
+        if (info.count == 0) {
+            info.tFirst = s.tMs;
+            for (uint8_t c = 0; c < TS_CHANNELS; c++) info.ch[c] = { s.v[c], s.v[c], 0 };
+        }
+        info.span = (uint32_t)(s.tMs - info.tFirst);
+        for (uint8_t c = 0; c < TS_CHANNELS; c++) {
+            TsChannelStats& st = info.ch[c];
+            if (s.v[c] < st.min) st.min = s.v[c];
+            if (s.v[c] > st.max) st.max = s.v[c];
+            st.sum += s.v[c];
+            last[c] = s.v[c];
+        }
+        lastT = s.tMs;
+        info.count++;
+        return true;
+    }
+
+    bool               empty() const       { return info.count == 0; }
+    uint16_t           count() const       { return info.count; }
+    const TsBlockInfo& current() const     { return info; }
+    size_t             bodyUsed() const    { return (size_t)len[0] + len[1] + len[2] + len[3]; }
+
+    // Serialize into out[TS_BLOCK_SIZE]; the writer moves on to seq + 1
+    void seal(uint8_t* out, TsBlockInfo* sealed = nullptr) {
+        memset(out, 0, TS_BLOCK_SIZE);
+        tslog::put32(out + 0, TS_MAGIC);
+        out[4] = TS_VERSION;
+        out[5] = TS_CHANNELS;
+        tslog::put16(out + 6, info.count);
+        tslog::put32(out + 8, info.seq);
+        tslog::put64(out + 12, info.tFirst);
+        tslog::put32(out + 20, info.span);
+        tslog::putStats(out + 24, info.ch);
+        uint8_t* body = out + TS_HEADER_SIZE;
+        for (uint8_t c = 0; c <= TS_CHANNELS; c++) {
+            tslog::put16(out + 72 + 2 * c, len[c]);
+            memcpy(body, col[c], len[c]);
+            body += len[c];
+        }
+        tslog::put32(out + 80, tslog::blockCrc(out));
+        if (sealed) *sealed = info;
+        reset(info.seq + 1);
+    }
+
+private:
+    TsBlockInfo info;
+    uint8_t     col[TS_CHANNELS + 1][TS_BODY_SIZE];
+    uint16_t    len[TS_CHANNELS + 1];
+    uint64_t    lastT;
+    int32_t     last[TS_CHANNELS];
+};
+
+// ================================================================
+//  Reader
+// ================================================================
+// Header only; false if magic / version / CRC do not match
+inline bool tsParseBlock(const uint8_t* blk, TsBlockInfo& out) {
+    if (tslog::get32(blk) != TS_MAGIC || blk[4] != TS_VERSION || blk[5] != TS_CHANNELS) return false;
+    if (tslog::get32(blk + 80) != tslog::blockCrc(blk)) return false;
+    out.count  = tslog::get16(blk + 6);
+    out.seq    = tslog::get32(blk + 8);
+    out.tFirst = tslog::get64(blk + 12);
+    out.span   = tslog::get32(blk + 20);
+    tslog::getStats(blk + 24, out.ch);
+    return true;
+}
+
+// Decode samples; returns the number written to out (0 = corrupt block)
+inline size_t tsDecodeBlock(const uint8_t* blk, TsSample* out, size_t maxOut) {
+    TsBlockInfo info;
+    if (!tsParseBlock(blk, info)) return 0;
+
+    const uint8_t* col[TS_CHANNELS + 1];
+    const uint8_t* end[TS_CHANNELS + 1];
+    const uint8_t* p = blk + TS_HEADER_SIZE;
+    for (uint8_t c = 0; c <= TS_CHANNELS; c++) {
+        col[c] = p;
+        p += tslog::get16(blk + 72 + 2 * c);
+        end[c] = p;
+    }
+    if (p > blk + TS_BLOCK_SIZE) return 0;
+
+    size_t   n = info.count < maxOut ? info.count : maxOut;
+    uint64_t t = info.tFirst;
+    int32_t  v[TS_CHANNELS] = {};
+    for (size_t i = 0; i < n; i++) {
+        uint32_t u;
+        if (i > 0) {
+            if (!tslog::getVarint(col[0], end[0], u)) return i;
+            t += u;
+        }
+        for (uint8_t c = 0; c < TS_CHANNELS; c++) {
+            if (!tslog::getVarint(col[c + 1], end[c + 1], u)) return i;
+            v[c] = (int32_t)((uint32_t)v[c] + (uint32_t)tslog::unzigzag(u));
+        }
+        out[i].tMs = t;
+        memcpy(out[i].v, v, sizeof(v));
+    }
+    return n;
+}
+
+// ================================================================
+//  Index entries
+// ================================================================
+inline void tsEncodeIndex(const TsBlockInfo& info, uint8_t* out) {
+    memset(out, 0, TS_INDEX_SIZE);
+    tslog::put32(out + 0, info.seq);
+    tslog::put16(out + 4, info.count);
+    tslog::put64(out + 8, info.tFirst);
+    tslog::put32(out + 16, info.span);
+    tslog::putStats(out + 20, info.ch);
+    tslog::put32(out + 68, tslog::crc32(0, out, 68));
+}
+
+inline bool tsDecodeIndex(const uint8_t* in, TsBlockInfo& out) {
+    if (tslog::get32(in + 68) != tslog::crc32(0, in, 68)) return false;
+    out.seq    = tslog::get32(in + 0);
+    out.count  = tslog::get16(in + 4);
+    out.tFirst = tslog::get64(in + 8);
+    out.span   = tslog::get32(in + 16);
+    tslog::getStats(in + 20, out.ch);
+    return true;
+}
+
+// First entry in [lo, hi) whose tLast >= t; the entries must be
+// time-ordered (one TsRuns run).
+// get(i, info) reads entry i (RAM array or file seek); false = unreadable
+template <class GetEntry>
+size_t tsIndexLowerBound(size_t lo, size_t hi, uint64_t t, GetEntry get) {
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        TsBlockInfo e;
+        if (!get(mid, e) || e.tLast() < t) lo = mid + 1;
+        else                               hi = mid;
+    }
+    return lo;
+}
+
+template <class GetEntry>
+size_t tsIndexLowerBound(size_t n, uint64_t t, GetEntry get) {
+    return tsIndexLowerBound(0, n, t, get);
+}
+
+// ================================================================
+//  Time runs
+// ================================================================
+//  The index is only sorted between clock steps. Before NTP sync the
+//  log clock is millis(), so a reboot goes from wall-clock time back
+//  to time since boot, and an NTP correction can step back too. The
+//  writer starts a new block when time goes backwards; each stretch of
+//  entries whose time does not go back is a run. Searches stay inside
+//  a run and a range query visits every run.
+//
+//  add() is called for every index entry in file order: once over the
+//  whole index at boot, then for each entry appended. Past MAX_RUNS
+//  queries fall back to a linear scan.
+struct TsRuns {
+    static constexpr uint8_t MAX_RUNS = 32;
+
+    uint32_t start[MAX_RUNS];       // first entry of each run
+    uint8_t  count    = 0;
+    bool     overflow = false;
+    uint32_t entries  = 0;
+    uint64_t lastT    = 0;
+
+    // nullptr: unreadable entry (torn tail), keeps the positions
+    void add(const TsBlockInfo* e) {
+        if (e) {
+            if (count == 0 || e->tFirst < lastT) {
+                if (count < MAX_RUNS) start[count++] = entries;
+                else                  overflow = true;
+            }
+            lastT = e->tLast();
+        }
+        entries++;
+    }
+
+    uint32_t end(uint8_t r) const { return r + 1 < count ? start[r + 1] : entries; }
+};
+
+template <class GetEntry>
+TsRuns tsScanRuns(size_t n, GetEntry get) {
+    TsRuns runs;
+    for (size_t i = 0; i < n; i++) {
+        TsBlockInfo e;
+        runs.add(get(i, e) ? &e : nullptr);
+    }
+    return runs;
+}
+
+// visit(e) for every readable entry among the first n that may overlap
+// [from, to]. Entries the runs do not cover yet are scanned linearly.
+template <class GetEntry, class Visit>
+void tsForEachBlock(const TsRuns& runs, size_t n, uint64_t from, uint64_t to,
+                    GetEntry get, Visit visit) {
+    if (runs.overflow || runs.entries < n) {
+        for (size_t i = 0; i < n; i++) {
+            TsBlockInfo e;
+            if (get(i, e) && e.tLast() >= from && e.tFirst <= to) visit(e);
+        }
+        return;
+    }
+    for (uint8_t r = 0; r < runs.count; r++) {
+        size_t hi = runs.end(r) < n ? runs.end(r) : n;
+        for (size_t i = tsIndexLowerBound(runs.start[r], hi, from, get); i < hi; i++) {
+            TsBlockInfo e;
+            if (!get(i, e)) continue;
+            if (e.tFirst > to) break;
+            visit(e);
+        }
+    }
+}
+
+// ================================================================
+//  Range aggregate
+// ================================================================
+struct TsAggregate {
+    uint32_t       count;
+    TsChannelStats ch[TS_CHANNELS];
+    uint32_t       blocksFromIndex;   // stats taken from the index
+    uint32_t       blocksDecoded;     // edge blocks decoded
+
+    float mean(TsChannel c) const { return count ? tslog::toFloat((int32_t)(ch[c].sum / (int64_t)count), c) : 0.0f; }
+    float min(TsChannel c) const  { return tslog::toFloat(ch[c].min, c); }
+    float max(TsChannel c) const  { return tslog::toFloat(ch[c].max, c); }
+};
+
+namespace tslog {
+inline void merge(TsAggregate& a, const TsChannelStats* ch, uint32_t count) {
+    for (uint8_t c = 0; c < TS_CHANNELS; c++) {
+        if (a.count == 0 || ch[c].min < a.ch[c].min) a.ch[c].min = ch[c].min;
+        if (a.count == 0 || ch[c].max > a.ch[c].max) a.ch[c].max = ch[c].max;
+        a.ch[c].sum += ch[c].sum;
+    }
+    a.count += count;
+}
+} // namespace tslog
+
+// Stats over [from, to] across all runs. Blocks fully inside come from
+// the index; blocks straddling an edge are fetched (fetch(seq, blk)
+// fills one TS_BLOCK_SIZE buffer) and decoded. scratch holds one block
+// of samples.
+template <class GetEntry, class FetchBlock>
+TsAggregate tsQueryRange(const TsRuns& runs, size_t n, uint64_t from, uint64_t to,
+                         GetEntry get, FetchBlock fetch,
+                         uint8_t* blockBuf, TsSample* scratch, size_t scratchLen) {
+    TsAggregate a = {};
+    tsForEachBlock(runs, n, from, to, get, [&](const TsBlockInfo& e) {
+        if (e.tFirst >= from && e.tLast() <= to) {
+            tslog::merge(a, e.ch, e.count);
+            a.blocksFromIndex++;
+            return;
+        }
+        if (!fetch(e.seq, blockBuf)) return;
+        size_t k = tsDecodeBlock(blockBuf, scratch, scratchLen);
+        a.blocksDecoded++;
+        for (size_t j = 0; j < k; j++) {
+            if (scratch[j].tMs < from || scratch[j].tMs > to) continue;
+            TsChannelStats one[TS_CHANNELS];
+            for (uint8_t c = 0; c < TS_CHANNELS; c++) one[c] = { scratch[j].v[c], scratch[j].v[c], scratch[j].v[c] };
+            tslog::merge(a, one, 1);
+        }
+    });
+    return a;
+}
+
+// ================================================================
+//  CSV export
+// ================================================================
+constexpr const char* TS_CSV_HEADER = "timestamp_ms,pressure_kpa,current_a,temperature_c";
+
+namespace tslog {
+// Fixed point to text without float formatting
+inline size_t fmtFixed(char* out, int32_t q, uint8_t decimals) {
+    char tmp[16];
+    size_t n = 0;
+    uint32_t u = q < 0 ? 0u - (uint32_t)q : (uint32_t)q;
+    for (uint8_t d = 0; d < decimals; d++) { tmp[n++] = (char)('0' + u % 10); u /= 10; }
+    if (decimals) tmp[n++] = '.';
+    do { tmp[n++] = (char)('0' + u % 10); u /= 10; } while (u);
+    if (q < 0) tmp[n++] = '-';
+    for (size_t i = 0; i < n; i++) out[i] = tmp[n - 1 - i];
+    return n;
+}
+
+inline size_t fmtU64(char* out, uint64_t v) {
+    char tmp[20];
+    size_t n = 0;
+    do { tmp[n++] = (char)('0' + v % 10); v /= 10; } while (v);
+    for (size_t i = 0; i < n; i++) out[i] = tmp[n - 1 - i];
+    return n;
+}
+} // namespace tslog
+
+// One CSV row incl. "\r\n"; out needs 64 bytes. Returns the length
+inline size_t tsSampleToCsv(const TsSample& s, char* out) {
+    size_t n = tslog::fmtU64(out, s.tMs);
+    for (uint8_t c = 0; c < TS_CHANNELS; c++) {
+        out[n++] = ',';
+        n += tslog::fmtFixed(out + n, s.v[c], TS_DECIMALS[c]);
+    }
+    out[n++] = '\r';
+    out[n++] = '\n';
+    return n;
+}
+
+#endif // TS_LOG_H
@@ -0,0 +1,25 @@
+#pragma once
+// ================================================================
+// TsLogger.h    Binary sensor history (/logs/trend.tsb + .tsi)
+// ================================================================
+//  Every SensorRead frame (10 Hz) goes into a TsLog.h block; sealed
+//  4 KB blocks and their index entries are appended through the SdLog
+//  write-behind streams. Timestamps are epoch ms once NTP has synced,
+//  uptime ms before that.
+// ================================================================
+
+#include <Arduino.h>
+#include "Config.h"
+#include "TsLog.h"
+
+void initTsLogger();                                  // after initSdLogService()
+void tsLogFrames(const SensorData* frames, size_t count);
+void tsLogSealBlock();                                // partial block out now
+
+// Stats over [fromMs, toMs]: index search + two edge blocks
+bool tsLogQuery(uint64_t fromMs, uint64_t toMs, TsAggregate& out);
+// Whole range as CSV (TS_CSV_HEADER); returns rows written, -1 on error
+int32_t tsLogExportCsv(const char* outPath, uint64_t fromMs, uint64_t toMs);
+
+uint64_t tsLogNowMs();                                // same clock as the samples
+void printTsLogStats();
@@ -26,6 +26,9 @@ public:
     ScreenType getPreviousScreen() const { return previousScreen; }
     void redrawScreen();
     void requestRedraw();
+    // Bumped by every full-redraw request; retained widget trees
+    // (RetainedWidget.h) repaint everything when it moves
+    uint32_t getRedrawEpoch() const { return redrawEpoch; }
 
     //    
     void handleTouch();
@@ -66,6 +69,10 @@ private:
     ScreenType currentScreen  = SCREEN_MAIN;
     ScreenType previousScreen = SCREEN_MAIN;
     bool       needsRedraw    = true;
+    uint32_t   redrawEpoch    = 1;
+    ScreenType drawnScreen    = SCREEN_MAIN;    // last screen drawCurrentScreen() drew
+    uint32_t   lastSwitchUs   = 0;              // its first draw after a switch
+    uint32_t   maxSwitchUs    = 0;
     uint32_t   lastUpdate     = 0;
 
     // 
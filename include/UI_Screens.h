@@ -23,6 +23,14 @@ bool isResetConfirmPending();
 // ================================================================
 void drawMainScreen();
 void handleMainTouch(uint16_t x, uint16_t y);
+void printMainScreenStats();    // retained widget frame cost ("ui")
+void resetMainScreenStats();
+
+// ================================================================
+//  Touch input (TouchDispatcher.cpp)
+// ================================================================
+void initTouchInput();          // INT-driven reader task, before the UI task
+void printTouchStats();         // reads, samples, gestures ("touch"); resets
 
 // ================================================================
 //  
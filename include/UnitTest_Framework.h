@@ -126,6 +126,139 @@ public:
 };
 #endif
 
+// Sensor path primitives
+class Test_RingBuffer : public TestModule {
+public:
+    const char* getName() override { return "SPSC RingBuffer"; }
+    void runTests() override;
+};
+
+class Test_WindowStats : public TestModule {
+public:
+    const char* getName() override { return "Window Statistics"; }
+    void runTests() override;
+};
+
+class Test_SampleWindow : public TestModule {
+public:
+    const char* getName() override { return "Sample Window"; }
+    void runTests() override;
+};
+
+class Test_AdcDecimator : public TestModule {
+public:
+    const char* getName() override { return "ADC Decimator"; }
+    void runTests() override;
+};
+
+class Test_Seqlock : public TestModule {
+public:
+    const char* getName() override { return "Seqlock Snapshots"; }
+    void runTests() override;
+};
+
+class Test_LoopHistogram : public TestModule {
+public:
+    const char* getName() override { return "Loop Histogram"; }
+    void runTests() override;
+};
+
+class Test_RampProfile : public TestModule {
+public:
+    const char* getName() override { return "Pump Ramp Profile"; }
+    void runTests() override;
+};
+
+class Test_PidController : public TestModule {
+public:
+    const char* getName() override { return "PID Controller Template"; }
+    void runTests() override;
+};
+
+class Test_RelayAutotune : public TestModule {
+public:
+    const char* getName() override { return "Relay Auto-tuner"; }
+    void runTests() override;
+};
+
+class Test_StateTable : public TestModule {
+public:
+    const char* getName() override { return "State Table"; }
+    void runTests() override;
+};
+
+class Test_BuzzerPattern : public TestModule {
+public:
+    const char* getName() override { return "Buzzer Pattern"; }
+    void runTests() override;
+};
+
+class Test_LogWriteBehind : public TestModule {
+public:
+    const char* getName() override { return "Log Write-Behind"; }
+    void runTests() override;
+};
+
+class Test_TsLog : public TestModule {
+public:
+    const char* getName() override { return "Binary Trend Log"; }
+    void runTests() override;
+};
+
+class Test_MetricRollup : public TestModule {
+public:
+    const char* getName() override { return "Metric Rollup"; }
+    void runTests() override;
+};
+
+class Test_LogRetention : public TestModule {
+public:
+    const char* getName() override { return "Log Retention"; }
+    void runTests() override;
+};
+
+class Test_MinMaxPyramid : public TestModule {
+public:
+    const char* getName() override { return "MinMax Pyramid"; }
+    void runTests() override;
+};
+
+class Test_AxisAutoScale : public TestModule {
+public:
+    const char* getName() override { return "Axis AutoScale"; }
+    void runTests() override;
+};
+
+class Test_DirtyRegion : public TestModule {
+public:
+    const char* getName() override { return "Dirty Region"; }
+    void runTests() override;
+};
+
+class Test_RetainedWidget : public TestModule {
+public:
+    const char* getName() override { return "Retained Widget"; }
+    void runTests() override;
+};
+
+class Test_BackgroundCache : public TestModule {
+public:
+    const char* getName() override { return "Background Cache"; }
+    void runTests() override;
+};
+
+class Test_GlyphAtlas : public TestModule {
+public:
+    const char* getName() override { return "Glyph Atlas"; }
+    void runTests() override;
+};
+
+class Test_GestureRecognizer : public TestModule {
+public:
+    const char* getName() override { return "Gesture Recognizer"; }
+    void runTests() override;
+};
+
 // 
 //   
 // 
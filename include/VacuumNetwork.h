@@ -23,6 +23,8 @@ void publishSystemStatus();            //
 void publishSensorData();              //   
 void publishAlarmState();              //   
 void publishConfigUpdate();            //   
+void publishPidTiming();               // vacuum/pid_timing (GET_PID_TIMING)
+void publishAutotuneStatus();          // vacuum/autotune   (GET_AUTOTUNE)
 
 //  NTP 
 void initNTP();   // wifiConnected   syncTime() 
@@ -0,0 +1,230 @@
+// VacuumStateTable.h
+// ================================================================
+// Event-driven vacuum cycle state machine: transition table
+// ================================================================
+//  - SM_TABLE is a constexpr list of (state, event) -> guard,
+//    action, next-state rows. smDispatch() returns the first row
+//    whose state and event match and whose guard passes; rows with
+//    SM_ANY apply in every state and come first (safety).
+//  - Events come from SmEdgeDetector (sensor levels -> edges),
+//    one-shot state timers (SM_EV_TIMEOUT) and commands. Nothing is
+//    evaluated while no event arrives.
+//  - Actions are IDs; StateMachine.cpp performs them (errors, beeps,
+//    hold extension), so the table itself is hardware-free.
+// ================================================================
+#ifndef VACUUM_STATE_TABLE_H
+#define VACUUM_STATE_TABLE_H
+
+#include <cstddef>
+#include <cstdint>
+#include "SensorFrame.h"
+#include "SystemState.h"
+
+enum SmEvent : uint8_t {
+    // Safety (level-derived, highest priority first)
+    SM_EV_ESTOP_PRESSED = 0,
+    SM_EV_ESTOP_RELEASED,
+    SM_EV_OVERCURRENT,
+    SM_EV_TEMP_SHUTDOWN,      // >= config.tempShutdown
+    SM_EV_TEMP_CRITICAL,      // >= config.tempCritical
+    SM_EV_TEMP_WARNING,       // >= config.tempWarning (repeats while above)
+    SM_EV_TEMP_RECOVERED,     // <  config.tempCritical - 5
+    SM_EV_TEMP_COOLED,        // <  config.tempShutdown - 10
+    // Process
+    SM_EV_LIMIT_SWITCH,       // part placed
+    SM_EV_PRESSURE_REACHED,   // <= target + hysteresis
+    SM_EV_PART_REMOVED,       // photo sensor cleared
+    SM_EV_TIMEOUT,            // state timer expired
+    // Commands
+    SM_EV_CMD_START,
+    SM_EV_CMD_STOP,
+    SM_EV_CMD_ESTOP,
+    SM_EV_COUNT
+};
+
+static_assert(SM_EV_COUNT <= 32, "SmEdgeDetector uses a 32-bit event mask");
+
+enum SmAction : uint8_t {
+    SM_ACT_NONE = 0,
+    SM_ACT_ERR_OVERCURRENT,
+    SM_ACT_ERR_OVERHEAT_SHUTDOWN,
+    SM_ACT_ERR_OVERHEAT_CRITICAL,
+    SM_ACT_TEMP_WARNING,      // beep + voice, no transition
+    SM_ACT_EXTEND_HOLD,       // re-arm the WAIT_REMOVAL timer
+    SM_ACT_ERR_PHOTO_TIMEOUT,
+    SM_ACT_PART_REMOVED,
+    SM_ACT_CLEAR_ERROR,
+};
+
+// Guard inputs, filled by the dispatcher when an event is handled
+struct SmContext {
+    ControlMode mode;
+    bool  estopActive;
+    bool  errorIsOverheat;
+    bool  holdExtensionAvailable;
+    bool  autotuneRunning;
+    float temperature;
+    float tempShutdown;
+};
+
+typedef bool (*SmGuard)(const SmContext&);
+
+static constexpr uint8_t SM_ANY  = 0xFF;   // row applies in every state
+static constexpr uint8_t SM_STAY = 0xFE;   // no state change
+
+struct SmTransition {
+    uint8_t  from;     // SystemState or SM_ANY
+    SmEvent  event;
+    SmGuard  guard;    // nullptr = always
+    SmAction action;
+    uint8_t  to;       // SystemState or SM_STAY
+};
+
+// ================================================================
+//  Guards
+// ================================================================
+namespace sm_guard {
+    inline bool estopClear(const SmContext& c)   { return !c.estopActive; }
+    inline bool autoMode(const SmContext& c)     { return c.mode == MODE_AUTO; }
+    inline bool pidMode(const SmContext& c)      { return c.mode == MODE_PID; }
+    inline bool notTuning(const SmContext& c)    { return !c.autotuneRunning; }
+    inline bool canExtend(const SmContext& c)    { return c.holdExtensionAvailable; }
+    inline bool cannotExtend(const SmContext& c) { return !c.holdExtensionAvailable; }
+    inline bool overheat(const SmContext& c)     { return c.errorIsOverheat; }
+    inline bool notOverheat(const SmContext& c)  { return !c.errorIsOverheat; }
+    inline bool overheatCooled(const SmContext& c) {
+        return c.errorIsOverheat && c.temperature < c.tempShutdown - 10.0f;
+    }
+    inline bool overheatCooledReleased(const SmContext& c) {
+        return c.errorIsOverheat && !c.estopActive;
+    }
+}
+
+// ================================================================
+//  Table
+// ================================================================
+static constexpr SmTransition SM_TABLE[] = {
+    // from                 event                    guard                            action                         to
+    // Safety, every state (E-stop first; others yield while it is held)
+    { SM_ANY,               SM_EV_ESTOP_PRESSED,     nullptr,                         SM_ACT_NONE,                   STATE_EMERGENCY_STOP },
+    { SM_ANY,               SM_EV_OVERCURRENT,       sm_guard::estopClear,            SM_ACT_ERR_OVERCURRENT,        STATE_ERROR },
+    { SM_ANY,               SM_EV_TEMP_SHUTDOWN,     sm_guard::estopClear,            SM_ACT_ERR_OVERHEAT_SHUTDOWN,  STATE_EMERGENCY_STOP },
+    { SM_ANY,               SM_EV_TEMP_CRITICAL,     sm_guard::estopClear,            SM_ACT_ERR_OVERHEAT_CRITICAL,  STATE_ERROR },
+    { SM_ANY,               SM_EV_TEMP_WARNING,      sm_guard::estopClear,            SM_ACT_TEMP_WARNING,           SM_STAY },
+    { SM_ANY,               SM_EV_CMD_ESTOP,         nullptr,                         SM_ACT_NONE,                   STATE_ERROR },
+    { SM_ANY,               SM_EV_CMD_STOP,          sm_guard::estopClear,            SM_ACT_NONE,                   STATE_IDLE },
+
+    // Cycle
+    { STATE_IDLE,           SM_EV_LIMIT_SWITCH,      sm_guard::notTuning,             SM_ACT_NONE,                   STATE_VACUUM_ON },
+    { STATE_IDLE,           SM_EV_CMD_START,         nullptr,                         SM_ACT_NONE,                   STATE_VACUUM_ON },
+    { STATE_VACUUM_ON,      SM_EV_TIMEOUT,           sm_guard::autoMode,              SM_ACT_NONE,                   STATE_VACUUM_HOLD },
+    { STATE_VACUUM_ON,      SM_EV_PRESSURE_REACHED,  sm_guard::pidMode,               SM_ACT_NONE,                   STATE_VACUUM_HOLD },
+    { STATE_VACUUM_HOLD,    SM_EV_TIMEOUT,           nullptr,                         SM_ACT_NONE,                   STATE_VACUUM_BREAK },
+    { STATE_VACUUM_BREAK,   SM_EV_TIMEOUT,           nullptr,                         SM_ACT_NONE,                   STATE_WAIT_REMOVAL },
+    { STATE_WAIT_REMOVAL,   SM_EV_PART_REMOVED,      nullptr,                         SM_ACT_PART_REMOVED,           STATE_COMPLETE },
+    { STATE_WAIT_REMOVAL,   SM_EV_TIMEOUT,           sm_guard::canExtend,             SM_ACT_EXTEND_HOLD,            SM_STAY },
+    { STATE_WAIT_REMOVAL,   SM_EV_TIMEOUT,           sm_guard::cannotExtend,          SM_ACT_ERR_PHOTO_TIMEOUT,      STATE_ERROR },
+    { STATE_COMPLETE,       SM_EV_TIMEOUT,           nullptr,                         SM_ACT_NONE,                   STATE_IDLE },
+
+    // Recovery
+    { STATE_ERROR,          SM_EV_TEMP_RECOVERED,    sm_guard::overheat,              SM_ACT_CLEAR_ERROR,            STATE_IDLE },
+    { STATE_EMERGENCY_STOP, SM_EV_ESTOP_RELEASED,    sm_guard::notOverheat,           SM_ACT_NONE,                   STATE_IDLE },
+    { STATE_EMERGENCY_STOP, SM_EV_ESTOP_RELEASED,    sm_guard::overheatCooled,        SM_ACT_CLEAR_ERROR,            STATE_IDLE },
+    { STATE_EMERGENCY_STOP, SM_EV_TEMP_COOLED,       sm_guard::overheatCooledReleased, SM_ACT_CLEAR_ERROR,           STATE_IDLE },
+};
+
+static constexpr size_t SM_TABLE_SIZE = sizeof(SM_TABLE) / sizeof(SM_TABLE[0]);
+
+// Compile-time table checks
+constexpr bool smTableValid() {
+    for (size_t i = 0; i < SM_TABLE_SIZE; i++) {
+        const SmTransition& t = SM_TABLE[i];
+        if (t.event >= SM_EV_COUNT) return false;
+        if (t.from != SM_ANY && t.from > STATE_STANDBY) return false;
+        if (t.to != SM_STAY && t.to > STATE_STANDBY) return false;
+        // SM_ANY rows must precede state rows so safety always wins
+        if (i > 0 && t.from == SM_ANY && SM_TABLE[i - 1].from != SM_ANY) return false;
+    }
+    return true;
+}
+static_assert(smTableValid(), "SM_TABLE: bad row or SM_ANY row after a state row");
+
+// First matching row, or nullptr (event ignored in this state)
+inline const SmTransition* smDispatch(SystemState state, SmEvent ev, const SmContext& ctx) {
+    for (size_t i = 0; i < SM_TABLE_SIZE; i++) {
+        const SmTransition& t = SM_TABLE[i];
+        if (t.event != ev) continue;
+        if (t.from != SM_ANY && t.from != (uint8_t)state) continue;
+        if (t.guard && !t.guard(ctx)) continue;
+        return &t;
+    }
+    return nullptr;
+}
+
+// ================================================================
+//  Sensor levels -> events
+// ================================================================
+struct SmThresholds {
+    float currentCritical;   // A
+    float tempWarning;       // C
+    float tempCritical;
+    float tempShutdown;
+    float pressureReached;   // kPa, target + hysteresis
+    bool  tempEnabled;       // config.tempSensorEnabled
+};
+
+inline constexpr uint32_t smBit(SmEvent ev) { return 1u << ev; }
+
+// Level mask of one frame. Temperature bands are exclusive so only the
+// most severe one is active.
+inline uint32_t smSensorLevels(const SensorFrame& f, const SmThresholds& t) {
+    uint32_t m = 0;
+    m |= f.emergencyStop ? smBit(SM_EV_ESTOP_PRESSED) : smBit(SM_EV_ESTOP_RELEASED);
+    if (f.current > t.currentCritical)   m |= smBit(SM_EV_OVERCURRENT);
+    if (t.tempEnabled) {
+        if      (f.temperature >= t.tempShutdown) m |= smBit(SM_EV_TEMP_SHUTDOWN);
+        else if (f.temperature >= t.tempCritical) m |= smBit(SM_EV_TEMP_CRITICAL);
+        else if (f.temperature >= t.tempWarning)  m |= smBit(SM_EV_TEMP_WARNING);
+        if (f.temperature < t.tempCritical - 5.0f)  m |= smBit(SM_EV_TEMP_RECOVERED);
+        if (f.temperature < t.tempShutdown - 10.0f) m |= smBit(SM_EV_TEMP_COOLED);
+    }
+    if (f.limitSwitch)                   m |= smBit(SM_EV_LIMIT_SWITCH);
+    if (f.pressure <= t.pressureReached) m |= smBit(SM_EV_PRESSURE_REACHED);
+    if (!f.photoSensor)                  m |= smBit(SM_EV_PART_REMOVED);
+    return m;
+}
+
+//  Each level is posted on its rising edge. rearm() (on every state
+//  change) forgets the history so levels that are still true are
+//  posted again to the new state, as the old poll would have seen
+//  them. TEMP_WARNING is rate-limited instead: at most once per
+//  WARNING_REPEAT_MS while the band is active.
+class SmEdgeDetector {
+public:
+    static constexpr uint32_t WARNING_REPEAT_MS = 10000;
+
+    SmEdgeDetector() : last(0), lastWarnMs(0), warnSent(false) {}
+
+    // Returns the events to post (bit per SmEvent)
+    uint32_t poll(uint32_t levels, uint32_t nowMs) {
+        const uint32_t warnBit = smBit(SM_EV_TEMP_WARNING);
+        uint32_t rising = levels & ~last & ~warnBit;
+        last = levels;
+
+        if ((levels & warnBit) && (!warnSent || nowMs - lastWarnMs >= WARNING_REPEAT_MS)) {
+            rising |= warnBit;
+            lastWarnMs = nowMs;
+            warnSent = true;
+        }
+        return rising;
+    }
+
+    void rearm() { last = 0; }
+
+private:
+    uint32_t last;
+    uint32_t lastWarnMs;
+    bool     warnSent;
+};
+
+#endif // VACUUM_STATE_TABLE_H
@@ -0,0 +1,214 @@
+// WindowStats.h
+// ================================================================
+// O(1) sliding-window statistics (mean / std-dev / min / max)
+// ================================================================
+//  - push() updates everything incrementally:
+//      mean      Kahan-compensated running sum
+//      variance  sliding Welford update of M2
+//      min/max   monotonic deques of slot indices
+//  - getAverage()/getStdDev()/getMin()/getMax() are O(1).
+//  - Single writer (SensorRead task). push() publishes the stats
+//    through a Seqlock (Seqlock.h); summary() copies the last
+//    published slot, so a reader that preempts push() reads the
+//    previous stats instead of spinning, and never blocks the writer.
+//    Other tasks reset the window with requestClear(), which the
+//    writer applies on its next push().
+//  - Float drift is bounded by an exact re-seed every RESEED_WINDOWS
+//    window lengths (amortised O(1/RESEED_WINDOWS) per push).
+// ================================================================
+#ifndef WINDOW_STATS_H
+#define WINDOW_STATS_H
+
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+#include "Seqlock.h"
+
+struct WindowSummary {
+    uint32_t count;
+    float    mean;
+    float    stdDev;
+    float    min;
+    float    max;
+};
+
+template<size_t N>
+class WindowStats {
+    static_assert(N >= 2, "WindowStats window must hold at least 2 samples");
+
+public:
+    static constexpr uint32_t RESEED_WINDOWS = 8;
+
+    WindowStats() { clear(); }
+
+    // ------------------------------------------------------------
+    // Writer
+    // ------------------------------------------------------------
+    bool push(float x) {
+        if (clearPending.load(std::memory_order_relaxed) &&
+            clearPending.exchange(false, std::memory_order_acquire)) {
+            clear();
+        }
+        if (count < N) {
+            samples[writeSlot] = x;
+            count++;
+            kahanAdd(x);
+            float delta = x - mean;
+            mean = sum / count;
+            m2 += delta * (x - mean);
+        } else {
+            float old = samples[writeSlot];
+            evictSlot(writeSlot);
+            samples[writeSlot] = x;
+            kahanAdd(x - old);
+            float oldMean = mean;
+            mean = sum / N;
+            m2 += (x - old) * (x - mean + old - oldMean);
+        }
+        if (m2 < 0.0f) m2 = 0.0f;
+
+        pushMinMax(writeSlot, x);
+        writeSlot = (writeSlot + 1 == N) ? 0 : writeSlot + 1;
+
+        if (++sinceReseed >= N * RESEED_WINDOWS) reseed();
+
+        publish();
+        return true;
+    }
+
+    // Writer only (the SensorRead task, or with the writer stopped)
+    void clear() {
+        count = 0;
+        writeSlot = 0;
+        sum = comp = mean = m2 = 0.0f;
+        maxHead = maxSize = minHead = minSize = 0;
+        sinceReseed = 0;
+        publish();
+    }
+
+    // ------------------------------------------------------------
+    // Readers
+    // ------------------------------------------------------------
+
+    // Reset the window before the writer's next push()
+    void requestClear() {
+        clearPending.store(true, std::memory_order_release);
+    }
+
+    // Consistent snapshot; safe from any task while push() runs.
+    WindowSummary summary() const {
+        Published p = published.read();
+        WindowSummary s;
+        s.count  = p.count;
+        s.mean   = p.mean;
+        s.stdDev = (p.count < 2) ? 0.0f : sqrtf(p.m2 / p.count);
+        s.min    = p.min;
+        s.max    = p.max;
+        return s;
+    }
+
+    size_t size() const            { return count; }
+    bool   isEmpty() const         { return count == 0; }
+    bool   isFull() const          { return count >= N; }
+    static constexpr size_t capacity() { return N; }
+
+    float getAverage() const { return summary().mean; }
+    float getStdDev() const  { return summary().stdDev; }
+    float getMin() const     { return summary().min; }
+    float getMax() const     { return summary().max; }
+
+    // Latest sample (writer-side view)
+    bool peek(float& item) const {
+        if (count == 0) return false;
+        item = samples[(writeSlot == 0) ? N - 1 : writeSlot - 1];
+        return true;
+    }
+
+private:
+    float    samples[N];
+    size_t   count;
+    size_t   writeSlot;
+
+    float    sum;        // Kahan running sum
+    float    comp;       // Kahan compensation
+    float    mean;
+    float    m2;         // sum of squared deviations
+
+    // Monotonic deques (ring arrays of slot indices)
+    uint32_t maxQ[N];
+    uint32_t minQ[N];
+    size_t   maxHead, maxSize;
+    size_t   minHead, minSize;
+
+    size_t   sinceReseed;
+    std::atomic<bool> clearPending{false};
+
+    // What readers see; sqrt is left to summary()
+    struct Published {
+        uint32_t count;
+        float    mean, m2, min, max;
+    };
+    Seqlock<Published> published;
+
+    void publish() {
+        Published p = {};
+        p.count = static_cast<uint32_t>(count);
+        if (count) {
+            p.mean = mean;
+            p.m2   = m2;
+            p.max  = samples[maxQ[maxHead]];
+            p.min  = samples[minQ[minHead]];
+        }
+        published.write(p);
+    }
+
+    void kahanAdd(float v) {
+        float y = v - comp;
+        float t = sum + y;
+        comp = (t - sum) - y;
+        sum = t;
+    }
+
+    static size_t wrap(size_t i) { return (i >= N) ? i - N : i; }
+
+    // Oldest slot is about to be overwritten: drop it from the deque fronts
+    void evictSlot(size_t slot) {
+        if (maxSize && maxQ[maxHead] == slot) { maxHead = wrap(maxHead + 1); maxSize--; }
+        if (minSize && minQ[minHead] == slot) { minHead = wrap(minHead + 1); minSize--; }
+    }
+
+    void pushMinMax(size_t slot, float x) {
+        while (maxSize && samples[maxQ[wrap(maxHead + maxSize - 1)]] <= x) maxSize--;
+        maxQ[wrap(maxHead + maxSize)] = static_cast<uint32_t>(slot);
+        maxSize++;
+
+        while (minSize && samples[minQ[wrap(minHead + minSize - 1)]] >= x) minSize--;
+        minQ[wrap(minHead + minSize)] = static_cast<uint32_t>(slot);
+        minSize++;
+    }
+
+    // Exact two-pass recompute of sum/mean/M2 to cancel accumulated drift
+    void reseed() {
+        sinceReseed = 0;
+        float s = 0.0f, c = 0.0f;
+        for (size_t i = 0; i < count; i++) {
+            float y = samples[i] - c;
+            float t = s + y;
+            c = (t - s) - y;
+            s = t;
+        }
+        sum = s;
+        comp = c;
+        mean = sum / count;
+        float acc = 0.0f;
+        for (size_t i = 0; i < count; i++) {
+            float d = samples[i] - mean;
+            acc += d * d;
+        }
+        m2 = acc;
+    }
+};
+
+#endif // WINDOW_STATS_H
@@ -0,0 +1,270 @@
+// AdcStream.cpp
+#include "AdcStream.h"
+#include "AdditionalHardening.h"
+#include "Seqlock.h"
+
+#include <esp_adc/adc_continuous.h>
+#include <esp_timer.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <freertos/semphr.h>
+
+typedef AdcFramePipeline<ADC_STREAM_CIC_ORDER, ADC_STREAM_DECIMATION> StreamPipeline;
+
+// ================================================================
+//  State (pipeline is owned by the AdcStream task)
+// ================================================================
+static adc_continuous_handle_t s_handle  = nullptr;
+static TaskHandle_t            s_task    = nullptr;
+static volatile bool           s_running = false;
+static volatile bool           s_stopRequested = false;
+static SemaphoreHandle_t       s_parked  = nullptr;   // task acknowledged the stop
+
+static StreamPipeline          s_pipeline;
+static Seqlock<AdcFrame>       s_latest;
+
+static adc_channel_t           s_channel[ADC_STREAM_CH_COUNT];
+
+static volatile uint32_t       s_poolOverflows = 0;
+static volatile uint32_t       s_readErrors    = 0;
+static volatile uint32_t       s_unknownResults = 0;
+
+// ================================================================
+//  ADC1 ownership
+// ================================================================
+// One-shot conversions and the continuous driver must never use ADC1
+// at the same time: every one-shot conversion, start and stop hold
+// this mutex.
+static SemaphoreHandle_t adcLock() {
+    static SemaphoreHandle_t m = xSemaphoreCreateMutex();
+    return m;
+}
+
+// ================================================================
+//  Driver callbacks (ISR context)
+// ================================================================
+static bool IRAM_ATTR onConvDone(adc_continuous_handle_t, const adc_continuous_evt_data_t*, void*) {
+    BaseType_t woken = pdFALSE;
+    if (s_task) vTaskNotifyGiveFromISR(s_task, &woken);
+    return woken == pdTRUE;
+}
+
+static bool IRAM_ATTR onPoolOverflow(adc_continuous_handle_t, const adc_continuous_evt_data_t*, void*) {
+    s_poolOverflows = s_poolOverflows + 1;
+    return false;
+}
+
+// ================================================================
+//  Acquisition task: drain DMA frames -> decimate -> publish
+// ================================================================
+static void adcStreamTask(void*) {
+    static uint8_t buf[ADC_STREAM_FRAME_BYTES];
+
+    for (;;) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        if (!s_running) {
+            // Outside adc_continuous_read(): the handle may go now
+            if (s_stopRequested) {
+                s_stopRequested = false;
+                xSemaphoreGive(s_parked);
+            }
+            continue;
+        }
+
+        uint32_t len = 0;
+        esp_err_t err;
+        while ((err = adc_continuous_read(s_handle, buf, sizeof(buf), &len, 0)) == ESP_OK) {
+            uint32_t nowUs = (uint32_t)esp_timer_get_time();
+            for (uint32_t i = 0; i + SOC_ADC_DIGI_RESULT_BYTES <= len; i += SOC_ADC_DIGI_RESULT_BYTES) {
+                const adc_digi_output_data_t* p = (const adc_digi_output_data_t*)&buf[i];
+                uint32_t ch  = p->type2.channel;
+                uint16_t raw = p->type2.data;
+
+                uint8_t idx = ADC_STREAM_CH_COUNT;
+                if (ch == (uint32_t)s_channel[ADC_STREAM_CH_PRESSURE])     idx = ADC_STREAM_CH_PRESSURE;
+                else if (ch == (uint32_t)s_channel[ADC_STREAM_CH_CURRENT]) idx = ADC_STREAM_CH_CURRENT;
+
+                if (idx == ADC_STREAM_CH_COUNT) {
+                    s_unknownResults = s_unknownResults + 1;
+                    continue;
+                }
+                if (s_pipeline.push(idx, raw, nowUs)) {
+                    s_latest.write(s_pipeline.frame());
+                }
+            }
+        }
+        if (err != ESP_ERR_TIMEOUT && s_running) s_readErrors = s_readErrors + 1;
+    }
+}
+
+// ================================================================
+//  Start / stop
+// ================================================================
+static bool startLocked(uint8_t pressurePin, uint8_t currentPin) {
+    if (s_running) return true;
+
+    const uint8_t pins[ADC_STREAM_CH_COUNT] = { pressurePin, currentPin };
+    for (uint8_t i = 0; i < ADC_STREAM_CH_COUNT; i++) {
+        adc_unit_t unit;
+        if (adc_continuous_io_to_channel(pins[i], &unit, &s_channel[i]) != ESP_OK || unit != ADC_UNIT_1) {
+            Serial.printf("[AdcStream] GPIO%u is not an ADC1 pin\n", pins[i]);
+            return false;
+        }
+    }
+
+    adc_continuous_handle_cfg_t handleCfg = {};
+    handleCfg.max_store_buf_size = ADC_STREAM_POOL_BYTES;
+    handleCfg.conv_frame_size    = ADC_STREAM_FRAME_BYTES;
+    if (adc_continuous_new_handle(&handleCfg, &s_handle) != ESP_OK) {
+        Serial.println("[AdcStream] handle allocation failed");
+        s_handle = nullptr;
+        return false;
+    }
+
+    adc_digi_pattern_config_t pattern[ADC_STREAM_CH_COUNT] = {};
+    for (uint8_t i = 0; i < ADC_STREAM_CH_COUNT; i++) {
+        pattern[i].atten     = ADC_ATTEN_DB_12;
+        pattern[i].channel   = s_channel[i];
+        pattern[i].unit      = ADC_UNIT_1;
+        pattern[i].bit_width = SOC_ADC_DIGI_MAX_BITWIDTH;
+    }
+
+    adc_continuous_config_t cfg = {};
+    cfg.pattern_num    = ADC_STREAM_CH_COUNT;
+    cfg.adc_pattern    = pattern;
+    cfg.sample_freq_hz = ADC_STREAM_SAMPLE_RATE_HZ;
+    cfg.conv_mode      = ADC_CONV_SINGLE_UNIT_1;
+    cfg.format         = ADC_DIGI_OUTPUT_FORMAT_TYPE2;
+
+    adc_continuous_evt_cbs_t cbs = {};
+    cbs.on_conv_done = onConvDone;
+    cbs.on_pool_ovf  = onPoolOverflow;
+
+    if (adc_continuous_config(s_handle, &cfg) != ESP_OK ||
+        adc_continuous_register_event_callbacks(s_handle, &cbs, nullptr) != ESP_OK) {
+        Serial.println("[AdcStream] driver configuration failed");
+        adc_continuous_deinit(s_handle);
+        s_handle = nullptr;
+        return false;
+    }
+
+    s_pipeline.reset();
+    if (!s_parked) s_parked = xSemaphoreCreateBinary();
+    if (!s_task) {
+        xTaskCreatePinnedToCore(adcStreamTask, "AdcStream",
+                                ADC_STREAM_TASK_STACK, nullptr, ADC_STREAM_TASK_PRIORITY,
+                                &s_task, 1);
+    }
+
+    s_running = true;
+    if (adc_continuous_start(s_handle) != ESP_OK) {
+        Serial.println("[AdcStream] start failed");
+        s_running = false;
+        adc_continuous_deinit(s_handle);
+        s_handle = nullptr;
+        return false;
+    }
+
+    Serial.printf("[AdcStream] %d S/s, CIC%d/R%d -> %.1f frames/s\n",
+                  ADC_STREAM_SAMPLE_RATE_HZ, ADC_STREAM_CIC_ORDER, ADC_STREAM_DECIMATION,
+                  (float)ADC_STREAM_SAMPLE_RATE_HZ / ADC_STREAM_CH_COUNT / ADC_STREAM_DECIMATION);
+    return true;
+}
+
+bool adcStreamBegin(uint8_t pressurePin, uint8_t currentPin) {
+    xSemaphoreTake(adcLock(), portMAX_DELAY);
+    bool ok = startLocked(pressurePin, currentPin);
+    xSemaphoreGive(adcLock());
+    return ok;
+}
+
+// The task may be inside adc_continuous_read(): wake it and wait until
+// it has parked before the handle is freed. A task that does not answer
+// is deleted (adcStreamBegin() creates a new one).
+void adcStreamStop() {
+    xSemaphoreTake(adcLock(), portMAX_DELAY);
+    if (s_running) {
+        s_running = false;
+        adc_continuous_stop(s_handle);
+
+        xSemaphoreTake(s_parked, 0);
+        s_stopRequested = true;
+        xTaskNotifyGive(s_task);
+        if (xSemaphoreTake(s_parked, pdMS_TO_TICKS(ADC_STREAM_STOP_TIMEOUT_MS)) != pdTRUE) {
+            Serial.println("[AdcStream] task did not stop, deleting it");
+            vTaskDelete(s_task);
+            s_task = nullptr;
+            s_stopRequested = false;
+        }
+
+        adc_continuous_deinit(s_handle);
+        s_handle = nullptr;
+    }
+    xSemaphoreGive(adcLock());
+}
+
+bool adcStreamRunning() {
+    return s_running;
+}
+
+// ================================================================
+//  Readers (any task)
+// ================================================================
+bool adcStreamLatest(AdcFrame& out) {
+    if (!s_running || s_latest.version() == 0) return false;
+    if (!s_latest.tryRead(out)) return false;
+
+    uint32_t ageUs = (uint32_t)esp_timer_get_time() - out.timestampUs;
+    return ageUs <= ADC_STREAM_STALE_MS * 1000UL;
+}
+
+int adcOneShotRead(uint8_t pin, TickType_t wait) {
+    adc_unit_t    unit;
+    adc_channel_t ch;
+    bool adc1 = adc_continuous_io_to_channel(pin, &unit, &ch) == ESP_OK && unit == ADC_UNIT_1;
+
+    if (xSemaphoreTake(adcLock(), wait) != pdTRUE) return ADC_ONESHOT_BUSY;
+    int raw = -1;
+    if (!adc1 || !s_running) {
+        raw = analogRead(pin);
+    } else {
+        AdcFrame f;
+        if (s_latest.version() != 0 && s_latest.tryRead(f)) {
+            if (ch == s_channel[ADC_STREAM_CH_PRESSURE])     raw = (int)(f.rawPressure + 0.5f);
+            else if (ch == s_channel[ADC_STREAM_CH_CURRENT]) raw = (int)(f.rawCurrent + 0.5f);
+        }
+    }
+    xSemaphoreGive(adcLock());
+    return raw;
+}
+
+AdcStreamStats adcStreamGetStats() {
+    AdcStreamStats st;
+    st.samples       = s_pipeline.samplesIn();
+    st.frames        = s_latest.version();
+    st.rejected      = s_pipeline.rejectedCount() + s_unknownResults;
+    st.poolOverflows = s_poolOverflows;
+    st.readErrors    = s_readErrors;
+    return st;
+}
+
+void printAdcStreamStatus() {
+    AdcStreamStats st = adcStreamGetStats();
+    AdcFrame f;
+    bool fresh = adcStreamLatest(f);
+
+    Serial.println("\n========== ADC Stream ==========");
+    Serial.printf(" running   : %s\n", s_running ? "yes" : "no");
+    Serial.printf(" samples   : %lu\n", (unsigned long)st.samples);
+    Serial.printf(" frames    : %lu\n", (unsigned long)st.frames);
+    Serial.printf(" rejected  : %lu  overflow: %lu  errors: %lu\n",
+                  (unsigned long)st.rejected, (unsigned long)st.poolOverflows,
+                  (unsigned long)st.readErrors);
+    if (fresh) {
+        Serial.printf(" latest    : #%lu  %.2f kPa (%.1f)  %.2f A (%.1f)\n",
+                      (unsigned long)f.seq, f.pressure, f.rawPressure, f.current, f.rawCurrent);
+    } else {
+        Serial.println(" latest    : (no fresh frame)");
+    }
+    Serial.println("================================\n");
+}
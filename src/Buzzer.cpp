@@ -0,0 +1,83 @@
+// ================================================================
+// Buzzer.cpp    Non-blocking buzzer annunciator
+// ================================================================
+//  BuzzerSequencer runs in the esp_timer task: each callback applies
+//  the due steps, writes the pin and re-arms for the next deadline.
+//  Callers only take a short critical section.
+// ================================================================
+#include "Config.h"
+#include "Buzzer.h"
+
+#include <esp_timer.h>
+#include <freertos/FreeRTOS.h>
+
+static BuzzerSequencer    s_seq;
+static esp_timer_handle_t s_timer = nullptr;
+static portMUX_TYPE       s_mux = portMUX_INITIALIZER_UNLOCKED;
+
+static inline uint32_t nowMs() {
+  return (uint32_t)(esp_timer_get_time() / 1000);
+}
+
+// Apply due steps and schedule the next one
+static void service() {
+  uint32_t now = nowMs();
+  portENTER_CRITICAL(&s_mux);
+  bool level = s_seq.update(now);
+  bool more = s_seq.playing();
+  uint32_t waitMs = more ? s_seq.nextDeadline() - now : 0;
+  digitalWrite(PIN_BUZZER, level ? HIGH : LOW);   // under s_mux: no stale write from a racing caller
+  portEXIT_CRITICAL(&s_mux);
+
+  esp_timer_stop(s_timer);
+  if (more) esp_timer_start_once(s_timer, (uint64_t)(waitMs ? waitMs : 1) * 1000ULL);
+}
+
+static void buzzerTimerCallback(void*) {
+  service();
+}
+
+void initBuzzer() {
+  if (s_timer) return;
+  pinMode(PIN_BUZZER, OUTPUT);
+  digitalWrite(PIN_BUZZER, LOW);
+
+  esp_timer_create_args_t args = {};
+  args.callback = buzzerTimerCallback;
+  args.name     = "buzzer";
+  if (esp_timer_create(&args, &s_timer) != ESP_OK) {
+    s_timer = nullptr;
+    Serial.println("[Buzzer] timer create failed");
+  }
+}
+
+bool buzzerPlay(BuzzerPatternId id) {
+  if (s_timer == nullptr) return false;
+  portENTER_CRITICAL(&s_mux);
+  bool started = s_seq.play(id, nowMs());
+  portEXIT_CRITICAL(&s_mux);
+  if (started) service();
+  return started;
+}
+
+void buzzerStop() {
+  portENTER_CRITICAL(&s_mux);
+  s_seq.stop();
+  portEXIT_CRITICAL(&s_mux);
+  if (s_timer) esp_timer_stop(s_timer);
+  digitalWrite(PIN_BUZZER, LOW);
+}
+
+bool buzzerBusy() {
+  portENTER_CRITICAL(&s_mux);
+  bool busy = s_seq.playing();
+  portEXIT_CRITICAL(&s_mux);
+  return busy;
+}
+
+BuzzerPatternId buzzerCurrent() {
+  portENTER_CRITICAL(&s_mux);
+  BuzzerPatternId id = s_seq.current();
+  portEXIT_CRITICAL(&s_mux);
+  return id;
+}
@@ -7,6 +7,8 @@
 #include "Control.h"
 #include "PID_Control.h"
 #include "SensorManager.h"  //  SensorManager 
+#include "Sensor.h"         // readEmergencyStop()
+#include "SafetyIsr.h"      // safetyRestoreOutputs()
 
 // FreeRTOS (delay )
 #include <freertos/FreeRTOS.h>
@@ -20,13 +22,29 @@ bool    pumpActive  = false;
 bool    valveActive = false;
 uint8_t pumpPWM     = 0;
 
+// Pump PWM ramp, advanced by pumpControlTick(); guarded for cross-task start/stop
+static RampGenerator s_pumpRamp;
+static portMUX_TYPE  s_rampMux = portMUX_INITIALIZER_UNLOCKED;
+
+static void stopPumpRamp() {
+  portENTER_CRITICAL(&s_rampMux);
+  s_pumpRamp.stop();
+  portEXIT_CRITICAL(&s_rampMux);
+}
+
 //    
 void controlPump(bool enable, uint8_t pwm) {
   if (!checkSafetyInterlock(enable, valveActive)) {
     Serial.println("[] :   (  )");
     enable = false;
   }
+  // E-stop ISR detached the pump PWM; only re-attach once released
+  if (enable && !safetyRestoreOutputs()) {
+    Serial.println("[Safety] E-stop pressed: pump stays off");
+    enable = false;
+  }
 
+  stopPumpRamp();
   pumpActive = enable;
   pumpPWM    = enable ? constrain(pwm, PWM_MIN, PWM_MAX) : 0;
 
@@ -41,6 +59,19 @@ void controlPump(bool enable, uint8_t pwm) {
   Serial.printf("[] : %s (PWM: %d)\n", enable ? "ON" : "OFF", pumpPWM);
 }
 
+// Duty-only fast path for the PID loop (no logging; starts the pump once)
+void setPumpDuty(uint8_t pwm) {
+  if (!pumpActive) {
+    if (!valveActive) controlPump(true, pwm);
+    return;
+  }
+  if (s_pumpRamp.active()) stopPumpRamp();   // direct control wins
+  uint8_t duty = constrain(pwm, PWM_MIN, PWM_MAX);
+  if (duty == pumpPWM) return;
+  pumpPWM = duty;
+  ledcWrite(PWM_CHANNEL_PUMP, duty);
+}
+
 //    
 void controlValve(bool enable) {
   if (!checkSafetyInterlock(pumpActive, enable)) {
@@ -78,6 +109,7 @@ bool checkSafetyInterlock(bool requestPump, bool requestValve) {
 
 //    
 void emergencyShutdown() {
+  abortPidAutotune();
   controlPump(false);
   controlValve(false);
   control12VMain(false);
@@ -191,6 +223,12 @@ void printControlStatus() {
   } else {
     Serial.println();
   }
+  if (isPumpRamping()) {
+    PumpRampStatus r = getPumpRampStatus();
+    Serial.printf("Ramp: %d -> %d (%s) %lu/%lu ms, %.0f%%\n", r.fromPWM, r.targetPWM,
+                  r.shape == RAMP_SCURVE ? "S-curve" : "linear",
+                  (unsigned long)r.elapsedMs, (unsigned long)r.durationMs, r.progress * 100.0f);
+  }
   Serial.printf(": %s\n", valveActive ? "ON" : "OFF");
   Serial.printf("12V : %s\n", digitalRead(PIN_12V_MAIN) ? "ON" : "OFF");
   Serial.printf("12V : %s\n", digitalRead(PIN_12V_EMERGENCY) ? "ON" : "OFF");
@@ -247,7 +285,8 @@ bool performSafetyCheck() {
 // PWM   ( /)
 // ================================================================
 
-void setPumpPWM(uint8_t targetPWM, uint16_t rampTimeMs) {
+// Non-blocking: starts the ramp and returns; pumpControlTick() advances it.
+void setPumpPWM(uint8_t targetPWM, uint16_t rampTimeMs, RampShape shape) {
   if (!pumpActive) {
     Serial.println("[]  .  .");
     return;
@@ -257,31 +296,69 @@ void setPumpPWM(uint8_t targetPWM, uint16_t rampTimeMs) {
   
   if (rampTimeMs == 0) {
     //  
+    stopPumpRamp();
     pumpPWM = targetPWM;
     ledcWrite(PWM_CHANNEL_PUMP, pumpPWM);
     Serial.printf("[] PWM  : %d\n", pumpPWM);
-  } else {
-    //  
-    int step = (targetPWM > pumpPWM) ? 1 : -1;
-    uint16_t delayMs = rampTimeMs / abs(targetPWM - pumpPWM);
-    delayMs = max(delayMs, (uint16_t)10);  //  10ms
-    
-    Serial.printf("[] PWM : %d  %d (%dms)\n", pumpPWM, targetPWM, rampTimeMs);
-    
-    while (pumpPWM != targetPWM) {
-      pumpPWM += step;
-      ledcWrite(PWM_CHANNEL_PUMP, pumpPWM);
-      vTaskDelay(pdMS_TO_TICKS(delayMs));
-      
-      //  
-      if (sensorManager.getEmergencyStop()) {
-        emergencyShutdown();
-        return;
-      }
+    return;
+  }
+  
+  portENTER_CRITICAL(&s_rampMux);
+  s_pumpRamp.start(pumpPWM, targetPWM, rampTimeMs, shape, millis());
+  portEXIT_CRITICAL(&s_rampMux);
+  
+  Serial.printf("[] PWM : %d  %d (%dms, %s)\n", pumpPWM, targetPWM, rampTimeMs,
+                shape == RAMP_SCURVE ? "S-curve" : "linear");
+}
+
+// Control tick (PIDLoop task, PID_LOOP_RATE_HZ): E-stop cut + ramp advance
+bool pumpControlTick() {
+  if (readEmergencyStop()) {
+    if (pumpActive) {
+      // Cut the output now; updateStateMachine() runs the full shutdown
+      stopPumpRamp();
+      ledcWrite(PWM_CHANNEL_PUMP, 0);
+      control12VMain(false);
+      pumpPWM = 0;
+      pumpActive = false;
     }
-    
-    Serial.printf("[] PWM  : %d\n", pumpPWM);
+    return false;
   }
+  
+  if (!s_pumpRamp.active() || !pumpActive) return true;
+  
+  uint32_t now = millis();
+  portENTER_CRITICAL(&s_rampMux);
+  float value = s_pumpRamp.valueAt(now);
+  if (s_pumpRamp.done(now)) s_pumpRamp.stop();
+  portEXIT_CRITICAL(&s_rampMux);
+  
+  uint8_t duty = (uint8_t)lroundf(value);
+  if (duty != pumpPWM) {
+    pumpPWM = duty;
+    ledcWrite(PWM_CHANNEL_PUMP, duty);
+  }
+  return true;
+}
+
+PumpRampStatus getPumpRampStatus() {
+  PumpRampStatus st;
+  uint32_t now = millis();
+  portENTER_CRITICAL(&s_rampMux);
+  st.active     = s_pumpRamp.active();
+  st.shape      = s_pumpRamp.shape();
+  st.fromPWM    = (uint8_t)lroundf(s_pumpRamp.from());
+  st.targetPWM  = (uint8_t)lroundf(s_pumpRamp.target());
+  st.durationMs = s_pumpRamp.durationMs();
+  st.elapsedMs  = st.active ? s_pumpRamp.elapsedMs(now) : 0;
+  st.progress   = s_pumpRamp.progress(now);
+  portEXIT_CRITICAL(&s_rampMux);
+  st.currentPWM = pumpPWM;
+  return st;
+}
+
+bool isPumpRamping() {
+  return s_pumpRamp.active();
 }
 
 // ================================================================
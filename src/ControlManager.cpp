@@ -22,16 +22,10 @@ void ControlManager::begin() {
     pumpPWM = 0;
     
     // PID 
-    pidError = 0.0f;
-    pidIntegral = 0.0f;
-    pidDerivative = 0.0f;
-    pidLastError = 0.0f;
-    pidOutput = 0.0f;
+    pid.reset();
     
     // PID  
-    pidKp = config.pidKp;
-    pidKi = config.pidKi;
-    pidKd = config.pidKd;
+    pid.setGains(config.pidKp, config.pidKi, config.pidKd);
     
     lastPIDUpdate = 0;
     
@@ -132,48 +126,22 @@ void ControlManager::updatePID(float targetPressure, float currentPressure) {
     float dt = (now - lastPIDUpdate) / 1000.0f;  //  
     lastPIDUpdate = now;
     
-    //  
-    pidError = targetPressure - currentPressure;
-    
-    // P: 
-    float P = pidKp * pidError;
-    
-    // I: 
-    pidIntegral += pidError * dt;
-    pidIntegral = constrain(pidIntegral, -100.0f, 100.0f);  //   
-    float I = pidKi * pidIntegral;
-    
-    // D: 
-    pidDerivative = (pidError - pidLastError) / dt;
-    float D = pidKd * pidDerivative;
-    
-    // PID  
-    pidOutput = P + I + D;
-    pidOutput = constrain(pidOutput, 0.0f, 100.0f);  // 0-100%
+    // PID  (0-100%)
+    float output = pid.step(targetPressure, currentPressure, dt);
     
     // PWM  (0-255)
-    uint8_t pwm = map(pidOutput, 0, 100, 0, 255);
-    setPumpPWM(pwm);
-    
-    //    
-    pidLastError = pidError;
+    setPumpPWM((uint8_t)lroundf(output * 2.55f));
 }
 
 void ControlManager::resetPID() {
-    pidError = 0.0f;
-    pidIntegral = 0.0f;
-    pidDerivative = 0.0f;
-    pidLastError = 0.0f;
-    pidOutput = 0.0f;
+    pid.reset();
     lastPIDUpdate = millis();
     
     Serial.println("[ControlMgr] PID ");
 }
 
 void ControlManager::setPIDGains(float kp, float ki, float kd) {
-    pidKp = kp;
-    pidKi = ki;
-    pidKd = kd;
+    pid.setGains(kp, ki, kd);
     
     Serial.printf("[ControlMgr] PID : Kp=%.2f, Ki=%.2f, Kd=%.2f\n", kp, ki, kd);
 }
@@ -190,9 +158,9 @@ void ControlManager::printStatus() {
     Serial.printf(" : %s                              \n",
                   valveActive ? " ON" : " OFF");
     Serial.println("");
-    Serial.printf(" PID : %.1f%%                      \n", pidOutput);
-    Serial.printf(" PID : %.2f kPa                   \n", pidError);
-    Serial.printf(" PID : %.2f                        \n", pidIntegral);
+    Serial.printf(" PID : %.1f%%                      \n", pid.output());
+    Serial.printf(" PID : %.2f kPa                   \n", pid.error());
+    Serial.printf(" PID : %.2f                        \n", pid.integral());
     Serial.println("");
     Serial.printf("  : %s                         \n",
                   isSafeToOperate() ? " " : "  ");
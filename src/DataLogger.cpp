@@ -1,49 +1,268 @@
-// DataLogger.cpp -  (DataLogger.h  )
+// ================================================================
+// DataLogger.cpp    Health trend engine (DataLogger.h)
+// ================================================================
+//  logHealthData() runs in the DataLogger task (1 s) and feeds one
+//  health score every HEALTH_SAMPLE_INTERVAL_MS into a MetricRollup
+//  (1 min / 1 h / 1 day buckets, PSRAM). Trend queries only read bucket
+//  sums: 24 h and 7 d from hour buckets, 30 d from day buckets.
+//
+//  Closed hour / day buckets are appended to /logs/health_rollup.bin
+//  through the SdLog stream and replayed at the first wall-clock sample
+//  after boot. Before NTP the rollup runs on uptime seconds and is not
+//  persisted; switching to wall-clock time starts over from the file.
+// ================================================================
 #include "DataLogger.h"
 #include "Config.h"
+#include "HardenedConfig.h"
+#include "LogRetentionService.h"
+#include "MetricRollup.h"
+#include "SdLogService.h"
+#include "TsLogger.h"
+
+#include <new>
+#include <esp_heap_caps.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
 
 const char* DataLogger::HEALTH_LOG_FILE      = "/health.csv";
 const char* DataLogger::MAINTENANCE_LOG_FILE = "/maint.csv";
 const char* DataLogger::TREND_DATA_FILE      = "/trend.csv";
 
+static const char* ROLLUP_PATH = "/logs/health_rollup.bin";
+
+static MetricRollup*     s_rollup     = nullptr;
+static SemaphoreHandle_t s_mutex      = nullptr;
+static bool              s_wallClock  = false;     // rollup keyed on epoch seconds
+static float             s_lastHealth = HEALTH_EXCELLENT;
+static uint32_t          s_persisted  = 0;
+static uint32_t          s_dropped    = 0;         // SdLog ring full
+
 DataLogger dataLogger;
 
 DataLogger::DataLogger() : initialized(false), lastLogTime(0), logInterval(3600000) {}
 
+// ================================================================
+//  Rollup persistence
+// ================================================================
+static uint32_t nowSec(bool* wall = nullptr) {
+    uint64_t ms = tsLogNowMs();
+    if (wall) *wall = ms > 1000000000000ULL;
+    return (uint32_t)(ms / 1000);
+}
+
+static void persistBucket(void*, RollupLevel level, const RollupBucket& b) {
+    if (level == ROLLUP_MINUTE || !s_wallClock || !sdLogReady()) return;
+    uint8_t rec[ROLLUP_RECORD_SIZE];
+    rollupEncode(level, b, rec);
+    if (sdLogAppendRaw(SDLOG_HEALTH_ROLLUP, rec, sizeof(rec))) s_persisted++;
+    else s_dropped++;
+}
+
+// Replays the last ROLLUP_REPLAY_RECORDS records (~32 KB). A torn tail
+// is zero-padded to the record boundary first; padding fails the magic.
+static void restoreFromSd() {
+    fs::FS* fs = sdLogFs();
+    if (!fs || !sdLogReady() || !sdLogLockBus(SD_OPEN_TIMEOUT_MS)) return;
+    File f = fs->open(ROLLUP_PATH, FILE_READ);
+    uint32_t size = f ? f.size() : 0;
+    sdLogUnlockBus();
+
+    static uint8_t io[16 * ROLLUP_RECORD_SIZE];
+    uint32_t rem = size % ROLLUP_RECORD_SIZE;
+    if (rem) {
+        memset(io, 0, ROLLUP_RECORD_SIZE);
+        sdLogAppendRaw(SDLOG_HEALTH_ROLLUP, io, ROLLUP_RECORD_SIZE - rem);
+    }
+
+    uint32_t records = size / ROLLUP_RECORD_SIZE;
+    uint32_t first = records > ROLLUP_REPLAY_RECORDS ? records - ROLLUP_REPLAY_RECORDS : 0;
+    uint32_t restored = 0, bad = 0;
+    for (uint32_t i = first; f && i < records; ) {
+        uint32_t n = records - i < 16 ? records - i : 16;
+        if (!sdLogLockBus(SD_WRITE_TIMEOUT_MS)) break;
+        bool ok = f.seek(i * ROLLUP_RECORD_SIZE) && f.read(io, n * ROLLUP_RECORD_SIZE) == (int)(n * ROLLUP_RECORD_SIZE);
+        sdLogUnlockBus();
+        if (!ok) break;
+        for (uint32_t k = 0; k < n; k++) {
+            RollupLevel level;
+            RollupBucket b;
+            if (rollupDecode(io + k * ROLLUP_RECORD_SIZE, level, b)) { s_rollup->restore(level, b); restored++; }
+            else bad++;
+        }
+        i += n;
+    }
+    if (f) {
+        bool locked = sdLogLockBus(SD_WRITE_TIMEOUT_MS);
+        f.close();
+        if (locked) sdLogUnlockBus();
+    }
+    s_rollup->endRestore();
+
+    Serial.printf("[DataLogger] %s: %lu buckets restored, %lu rejected\n", ROLLUP_PATH, restored, bad);
+}
+
+// ================================================================
+//  Init / logging
+// ================================================================
 void DataLogger::begin() {
+    if (initialized) return;
+    void* mem = heap_caps_malloc(sizeof(MetricRollup), MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    if (!mem) mem = heap_caps_malloc(sizeof(MetricRollup), MALLOC_CAP_8BIT);
+    s_mutex = xSemaphoreCreateMutex();
+    if (!mem || !s_mutex) {
+        Serial.println("[DataLogger] alloc failed, health trends disabled");
+        return;
+    }
+    s_rollup = new (mem) MetricRollup();
+    s_rollup->onClose(persistBucket, nullptr);
     initialized = true;
-    Serial.println("[DataLogger]  ");
+    Serial.printf("[DataLogger] health rollups: %u buckets (%u B)\n",
+                  ROLLUP_TOTAL_BUCKETS, (unsigned)sizeof(MetricRollup));
+}
+
+void DataLogger::logHealthData(const HealthMonitor& hm) {
+    if (!initialized) return;
+    uint32_t now = millis();
+    if (lastLogTime != 0 && now - lastLogTime < HEALTH_SAMPLE_INTERVAL_MS) return;
+    lastLogTime = now;
+
+    float h = hm.getHealthScore();
+    logHealthDataDetailed(h, 0, 0, 0, 0, hm.getMaintenanceLevel());
+}
+
+void DataLogger::logHealthDataDetailed(float h, float pe, float th, float ch, float rh, MaintenanceLevel lv) {
+    if (!initialized || isnan(h)) return;
+    bool wall;
+    uint32_t t = nowSec(&wall);
+
+    xSemaphoreTake(s_mutex, portMAX_DELAY);
+    if (wall && !s_wallClock) {
+        s_rollup->reset();
+        s_wallClock = true;
+        restoreFromSd();
+    }
+    s_rollup->add(t, h);
+    s_lastHealth = h;
+    xSemaphoreGive(s_mutex);
 }
 
-void DataLogger::logHealthData(const HealthMonitor& hm) {}
-void DataLogger::logHealthDataDetailed(float h, float pe, float th, float ch, float rh, MaintenanceLevel lv) {}
 void DataLogger::logMaintenance(float before, float after, const char* note) {}
 
-TrendStatistics DataLogger::calculateTrend(uint16_t hours) { return TrendStatistics{}; }
-TrendStatistics DataLogger::getDailyTrend()   { return TrendStatistics{}; }
-TrendStatistics DataLogger::getWeeklyTrend()  { return TrendStatistics{}; }
-TrendStatistics DataLogger::getMonthlyTrend() { return TrendStatistics{}; }
+// ================================================================
+//  Trends (O(buckets), under the rollup mutex)
+// ================================================================
+static RollupWindow windowHours(uint32_t hours, uint32_t now) {
+    uint32_t span = hours * 3600UL;
+    return s_rollup->window(now > span ? now - span : 0, now);
+}
+
+TrendStatistics DataLogger::calculateTrend(uint16_t hours) {
+    TrendStatistics t = {};
+    t.avg_24h = t.avg_7d = t.avg_30d = s_lastHealth;
+    if (!initialized) return t;
+    uint32_t now = nowSec();
+
+    xSemaphoreTake(s_mutex, portMAX_DELAY);
+    RollupWindow d = windowHours(24, now);
+    RollupWindow w = windowHours(24 * 7, now);
+    RollupWindow m = windowHours(24 * 30, now);
+    RollupWindow x = hours == 24 ? d : hours == 24 * 7 ? w : hours == 24 * 30 ? m : windowHours(hours, now);
+    xSemaphoreGive(s_mutex);
+
+    if (d.count) t.avg_24h = d.mean;
+    if (w.count) t.avg_7d  = w.mean;
+    if (m.count) t.avg_30d = m.mean;
+    t.trend      = x.slopePerHour * 24.0f;
+    t.volatility = x.stddev;
+    t.lastUpdate = now;
+    return t;
+}
 
-bool DataLogger::getWeeklyHealthHistory(float* values, int& count) { count = 0; return false; }
+TrendStatistics DataLogger::getDailyTrend()   { return calculateTrend(24); }
+TrendStatistics DataLogger::getWeeklyTrend()  { return calculateTrend(24 * 7); }
+TrendStatistics DataLogger::getMonthlyTrend() { return calculateTrend(24 * 30); }
+
+static bool history(RollupLevel level, float* values, int n, int& count) {
+    count = 0;
+    if (!s_rollup) return false;
+    uint32_t now = nowSec();
+    xSemaphoreTake(s_mutex, portMAX_DELAY);
+    s_rollup->series(level, now, values, n);
+    xSemaphoreGive(s_mutex);
+    count = n;
+    for (int i = 0; i < n; i++) if (!isnan(values[i])) return true;
+    return false;
+}
+
+bool DataLogger::getWeeklyHealthHistory(float* values, int& count) { return history(ROLLUP_DAY, values, 7, count); }
+bool DataLogger::getHourlyHealthHistory(float* values, int& count) { return history(ROLLUP_HOUR, values, 24, count); }
 bool DataLogger::readHealthHistory(HealthLogEntry* buf, uint16_t maxCount, uint16_t& actualCount) { actualCount = 0; return false; }
 bool DataLogger::readMaintenanceHistory(char* buf, uint16_t maxSize) { return false; }
 
 bool DataLogger::exportHealthToCSV(const char* fn) { return false; }
 bool DataLogger::exportMaintenanceToCSV(const char* fn) { return false; }
 
-float DataLogger::predictHealthScore(uint8_t hoursAhead) { return 85.0f; }
-uint32_t DataLogger::estimateDaysToMaintenance() { return 30; }
+// Regression line of the window matching the horizon, extrapolated
+float DataLogger::predictHealthScore(uint16_t hoursAhead) {
+    if (!initialized) return s_lastHealth;
+    uint32_t span = hoursAhead <= 48 ? 24 : hoursAhead <= 24 * 7 ? 24 * 7 : 24 * 30;
+    uint32_t now = nowSec();
+    xSemaphoreTake(s_mutex, portMAX_DELAY);
+    RollupWindow w = windowHours(span, now);
+    xSemaphoreGive(s_mutex);
+    if (w.count == 0) return s_lastHealth;
+    return constrain(w.fitNow + w.slopePerHour * hoursAhead, 0.0f, 100.0f);
+}
 
-void DataLogger::clearOldLogs(uint16_t daysToKeep) {}
-uint32_t DataLogger::getLogSize() { return 0; }
-uint32_t DataLogger::getLogCount() { return 0; }
+// Days until the 7 d trend line crosses HEALTH_WARNING; 999 = not falling
+uint32_t DataLogger::estimateDaysToMaintenance() {
+    if (!initialized) return 999;
+    uint32_t now = nowSec();
+    xSemaphoreTake(s_mutex, portMAX_DELAY);
+    RollupWindow w = windowHours(24 * 7, now);
+    xSemaphoreGive(s_mutex);
+    float perDay = w.slopePerHour * 24.0f;
+    if (w.count == 0 || perDay > -0.01f) return 999;
+    if (w.fitNow <= HEALTH_WARNING) return 0;
+    float days = (w.fitNow - HEALTH_WARNING) / -perDay;
+    return days >= 999.0f ? 999 : (uint32_t)days;
+}
+
+// Background pass that also removes rotated segments older than daysToKeep
+void DataLogger::clearOldLogs(uint16_t daysToKeep) { logRetentionRequest(daysToKeep ? daysToKeep : 1); }
+uint32_t DataLogger::getLogSize() { return s_persisted * ROLLUP_RECORD_SIZE; }
+uint32_t DataLogger::getLogCount() { return s_persisted; }
 
 void DataLogger::ensureDirectories() {}
 void DataLogger::writeHealthEntry(const HealthLogEntry& e) {}
 bool DataLogger::appendToMaintenanceLog(uint32_t ts, float b, float a, const char* n) { return false; }
-float DataLogger::calculateLinearTrend(float* v, uint16_t c) { return 0; }
-float DataLogger::calculateVolatility(float* v, uint16_t c) { return 0; }
-float DataLogger::calculateAverage(float* v, uint16_t c) { return 0; }
+
+// ================================================================
+//  Array helpers (plain samples, oldest first)
+// ================================================================
+float DataLogger::calculateLinearTrend(float* v, uint16_t c) {
+    if (c < 2) return 0;
+    float mx = (c - 1) / 2.0f, my = calculateAverage(v, c), sxy = 0, sxx = 0;
+    for (uint16_t i = 0; i < c; i++) {
+        sxy += (i - mx) * (v[i] - my);
+        sxx += (i - mx) * (i - mx);
+    }
+    return sxy / sxx;
+}
+
+float DataLogger::calculateVolatility(float* v, uint16_t c) {
+    if (c < 2) return 0;
+    float m = calculateAverage(v, c), ss = 0;
+    for (uint16_t i = 0; i < c; i++) ss += (v[i] - m) * (v[i] - m);
+    return sqrtf(ss / c);
+}
+
+float DataLogger::calculateAverage(float* v, uint16_t c) {
+    if (c == 0) return 0;
+    float s = 0;
+    for (uint16_t i = 0; i < c; i++) s += v[i];
+    return s / c;
+}
 
 void getTimestampString(uint32_t ts, char* buf, size_t size) { snprintf(buf, size, "%lu", ts); }
 uint32_t parseTimestamp(const char* s) { return atol(s); }
@@ -5,6 +5,7 @@
 #include "ErrorHandler.h"
 #include "StateMachine.h"  // changeState, previousState
 #include "SD_Logger.h"     // logError(ErrorInfo&)
+#include "Buzzer.h"        // buzzerStop()
 
 // v3.9:  
 #ifdef ENABLE_VOICE_ALERTS
@@ -57,7 +58,7 @@ void clearError() {
   errorActive = false;
 
   digitalWrite(PIN_LED_RED, LOW);
-  digitalWrite(PIN_BUZZER,  LOW);
+  buzzerStop();
 
   Serial.println("[] ");
   
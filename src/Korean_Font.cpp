@@ -1,36 +1,59 @@
 
 #include "Config.h"                 // Arduino.h 
 #include "GFX_Wrapper.hpp"
+#include "Lang.h"
 #include <SPIFFS.h>
+#include <esp_heap_caps.h>
+
+// ====================  Hangul glyph font (tools/hgf_build.py)  ====================
+static const char* HGF_PATH = "/hangul16.hgf";
+
+static File        s_fontFile;
+static GlyphFont   s_font;
+static HangulAtlas s_atlas;
+
+static bool readFont(void*, uint32_t offset, void* dst, uint32_t len) {
+  if (!s_fontFile.seek(offset)) return false;
+  return s_fontFile.read((uint8_t*)dst, len) == len;
+}
+
+static void* psramAlloc(uint32_t bytes) {
+  void* p = heap_caps_malloc(bytes, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+  return p ? p : malloc(bytes);
+}
 
-// ====================    ====================
 bool initKoreanFont() {
-  // VLW   (SPIFFS)
-  if (SPIFFS.exists("/NanumGothic16.vlw")) {
-    // LovyanGFX VLW    
-    // tft.loadFont("/NanumGothic16.vlw", SPIFFS);
-    Serial.println("[]    ");
-    return true;
-  } else {
-    Serial.println("[]    ");
-    //      ( )
-    // tft.setFont(&fonts::lgfxJapanGothic_16);
+  if (!SPIFFS.begin(true) || !SPIFFS.exists(HGF_PATH)) {
+    Serial.printf("[Font] %s not found, ASCII only\n", HGF_PATH);
     return false;
   }
+  s_fontFile = SPIFFS.open(HGF_PATH, "r");
+  uint8_t* atlasMem = (uint8_t*)psramAlloc(HangulAtlas::BYTES);
+  if (!s_fontFile || !atlasMem || !s_font.open(readFont, nullptr, psramAlloc)) {
+    Serial.printf("[Font] %s invalid\n", HGF_PATH);
+    free(atlasMem);
+    if (s_fontFile) s_fontFile.close();
+    return false;
+  }
+  s_atlas.begin(atlasMem);
+
+  // Prewarm the glyphs of every UI string in both languages
+  uint32_t t0 = millis();
+  for (uint8_t k = 0; k < LANG_KEY_COUNT; k++) {
+    s_atlas.prewarm(s_font, langString(LANG_EN, (LangKey)k));
+    s_atlas.prewarm(s_font, langString(LANG_KO, (LangKey)k));
+  }
+  tft.setGlyphFont(&s_font, &s_atlas);
+  Serial.printf("[Font] %lu glyphs, %u prewarmed in %lu ms (%lu B atlas)\n",
+                s_font.count(), s_atlas.used(), millis() - t0, HangulAtlas::BYTES);
+  s_atlas.resetStats();
+  return true;
 }
 
 // ====================    ====================
 void printKoreanText(int16_t x, int16_t y, const char* text) {
-  // LovyanGFX   
   tft.setFont(nullptr);
-  tft.setTextSize(2);
+  tft.setTextSize(2);                 // glyph font is 16 px = size 2 line
   tft.setCursor(x, y);
   tft.print(text);
-  tft.setFont(nullptr); //   
 }
-
-//  :
-// printKoreanText(10, 50, "  ");
-// printKoreanText(10, 80, ": -80 kPa");
-
-
@@ -274,7 +274,13 @@ const char* L(LangKey key) {
   return (currentLang == LANG_KO) ? STR_KO[key] : STR_EN[key];
 }
 
+const char* langString(Language lang, LangKey key) {
+  if (key >= LANG_KEY_COUNT) return "?";
+  return (lang == LANG_KO) ? STR_KO[key] : STR_EN[key];
+}
+
 void setLanguage(Language lang) {
+  if (lang != currentLang) tft.bgInvalidateAll();   // cached screen backgrounds hold the old strings
   currentLang = lang;
 }
 
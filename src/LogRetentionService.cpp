@@ -0,0 +1,129 @@
+// ================================================================
+// LogRetentionService.cpp    SD log budget (LogRetention.h on the card)
+// ================================================================
+//  The pruner lists /logs one entry per call and deletes one segment
+//  per call, taking the SD bus only around each operation. Rotation
+//  (SdLog task) and the periodic timer request passes.
+// ================================================================
+#include "LogRetentionService.h"
+#include "LogRetention.h"
+#include "HardenedConfig.h"
+#include "SdLogService.h"
+
+#include <time.h>
+#include <esp_timer.h>
+
+// ================================================================
+//  fs::FS adapter
+// ================================================================
+class SdRetentionFs : public RetentionFs {
+public:
+    bool openDir(const char* dir) override {
+        fs::FS* fs = sdLogFs();
+        if (!fs || !sdLogLockBus(SD_OPEN_TIMEOUT_MS)) return false;
+        _dir = fs->open(dir);
+        bool ok = _dir && _dir.isDirectory();
+        sdLogUnlockBus();
+        return ok;
+    }
+
+    bool nextEntry(char* name, size_t cap, uint32_t& size, bool& isDir) override {
+        if (!_dir || !sdLogLockBus(SD_OPEN_TIMEOUT_MS)) return false;
+        File e = _dir.openNextFile();
+        bool ok = (bool)e;
+        if (ok) {
+            const char* n = e.name();
+            const char* slash = strrchr(n, '/');
+            snprintf(name, cap, "%s", slash ? slash + 1 : n);
+            size = (uint32_t)e.size();
+            isDir = e.isDirectory();
+            e.close();
+        }
+        sdLogUnlockBus();
+        return ok;
+    }
+
+    void closeDir() override {
+        if (!_dir) return;
+        bool locked = sdLogLockBus(SD_WRITE_TIMEOUT_MS);
+        _dir.close();
+        if (locked) sdLogUnlockBus();
+    }
+
+    bool remove(const char* path) override {
+        fs::FS* fs = sdLogFs();
+        if (!fs || !sdLogLockBus(SD_WRITE_TIMEOUT_MS)) return false;
+        bool ok = fs->remove(path);
+        sdLogUnlockBus();
+        return ok;
+    }
+
+private:
+    File _dir;
+};
+
+static SdRetentionFs      s_fs;
+static LogPruner<128>     s_pruner;
+static bool               s_ready = false;
+static uint32_t           s_lastPassMs = 0;
+
+static uint32_t clockUs() {
+    return (uint32_t)esp_timer_get_time();
+}
+
+uint32_t logRetentionToday() {
+    time_t now = time(nullptr);
+    if (now < 1000000000) return 0;
+    struct tm tm;
+    localtime_r(&now, &tm);
+    return retention::daysFromCivil(tm.tm_year + 1900, tm.tm_mon + 1, tm.tm_mday);
+}
+
+void initLogRetention(uint64_t cardBytes) {
+    if (s_ready || !sdLogReady()) return;
+    RetentionPolicy p;
+    p.budgetBytes = (uint64_t)LOGRET_BUDGET_MB << 20;
+    if (cardBytes && cardBytes / 100 * LOGRET_CARD_PCT < p.budgetBytes) {
+        p.budgetBytes = cardBytes / 100 * LOGRET_CARD_PCT;
+    }
+    p.maxAgeDays = LOGRET_MAX_AGE_DAYS;
+    s_pruner.begin(&s_fs, p, clockUs);
+    s_pruner.addDir("/logs");
+    s_pruner.request();                           // first pass at boot
+    s_ready = true;
+    Serial.printf("[LogRet] budget %llu MB, max age %u days, %u us/tick\n",
+                  p.budgetBytes >> 20, LOGRET_MAX_AGE_DAYS, LOGRET_SLICE_US);
+}
+
+void logRetentionRequest(uint16_t ageDays) {
+    if (s_ready) s_pruner.request(ageDays);
+}
+
+void logRetentionStep() {
+    if (!s_ready) return;
+    uint32_t now = millis();
+    if (!s_pruner.busy() && now - s_lastPassMs >= LOGRET_INTERVAL_MS) s_pruner.request();
+    if (s_pruner.busy()) {
+        s_pruner.step(logRetentionToday(), LOGRET_SLICE_US, now);
+        s_lastPassMs = now;
+    }
+}
+
+void printLogRetentionStats() {
+    Serial.println("\n=== Log retention ===");
+    if (!s_ready) {
+        Serial.println("not started (no SD)");
+        return;
+    }
+    PrunerStats st = s_pruner.stats();
+    const RetentionPolicy& p = s_pruner.policy();
+    Serial.printf("Budget %llu MB, max age %u days, %s\n", p.budgetBytes >> 20, p.maxAgeDays,
+                  s_pruner.busy() ? "pass running" : "idle");
+    Serial.printf("Last pass: %lu entries, %lu segments, live %llu KB, segments %llu KB, %lu ticks\n",
+                  st.entries, st.segments, st.liveBytes >> 10, st.segmentBytes >> 10, st.steps);
+    Serial.printf("Passes %lu, deleted %lu (%llu KB), failed %lu, worst tick %lu us\n",
+                  st.passes, st.deleted, st.freedBytes >> 10, st.failed, st.maxStepUs);
+    if (st.overBudget) Serial.println("WARNING: live (unrotated) logs alone exceed the budget");
+    size_t n = s_pruner.segmentCount();
+    if (n) Serial.printf("Oldest segment: %s\n", s_pruner.segment(0).name);
+}
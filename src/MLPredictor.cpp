@@ -38,21 +38,15 @@ float MLPredictor::predictNextValue(float* recentValues, int count) {
 }
 
 void MLPredictor::updateStatistics() {
-    float pMean = calculatePressureMean();
-    float pStd  = calculatePressureStdDev(pMean);
-    pressureStats.mean   = pMean;
-    pressureStats.stdDev = pStd;
-    calculatePressureMinMax(pressureStats.min, pressureStats.max);
+    // Window statistics are maintained on push; this is three O(1) snapshots
+    WindowSummary p = pressureBuffer.summary();
+    pressureStats = {p.mean, p.stdDev, p.min, p.max};
 
-    float tMean = calculateTemperatureMean();
-    float tStd  = calculateTemperatureStdDev(tMean);
-    temperatureStats.mean   = tMean;
-    temperatureStats.stdDev = tStd;
+    WindowSummary t = temperatureBuffer.summary();
+    temperatureStats = {t.mean, t.stdDev, t.min, t.max};
 
-    float cMean = calculateCurrentMean();
-    float cStd  = calculateCurrentStdDev(cMean);
-    currentStats.mean   = cMean;
-    currentStats.stdDev = cStd;
+    WindowSummary c = currentBuffer.summary();
+    currentStats = {c.mean, c.stdDev, c.min, c.max};
 }
 
 bool MLPredictor::isOutlier(float value, MLStatistics stats) {
@@ -60,15 +54,15 @@ bool MLPredictor::isOutlier(float value, MLStatistics stats) {
     return abs(value - stats.mean) > anomalyThreshold * stats.stdDev;
 }
 
-float MLPredictor::calculatePressureMean()                   { return pressureBuffer.getMax(); }
+float MLPredictor::calculatePressureMean()                   { return pressureBuffer.getAverage(); }
 float MLPredictor::calculatePressureStdDev(float mean)       { return pressureBuffer.getStdDev(); }
 void  MLPredictor::calculatePressureMinMax(float& mn, float& mx) { mn = pressureBuffer.getMin(); mx = pressureBuffer.getMax(); }
 
-float MLPredictor::calculateTemperatureMean()                 { return temperatureBuffer.getMax(); }
+float MLPredictor::calculateTemperatureMean()                 { return temperatureBuffer.getAverage(); }
 float MLPredictor::calculateTemperatureStdDev(float mean)     { return temperatureBuffer.getStdDev(); }
 void  MLPredictor::calculateTemperatureMinMax(float& mn, float& mx) { mn = temperatureBuffer.getMin(); mx = temperatureBuffer.getMax(); }
 
-float MLPredictor::calculateCurrentMean()                     { return currentBuffer.getMax(); }
+float MLPredictor::calculateCurrentMean()                     { return currentBuffer.getAverage(); }
 float MLPredictor::calculateCurrentStdDev(float mean)         { return currentBuffer.getStdDev(); }
 void  MLPredictor::calculateCurrentMinMax(float& mn, float& mx) { mn = currentBuffer.getMin(); mx = currentBuffer.getMax(); }
 
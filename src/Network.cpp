@@ -6,8 +6,9 @@
 #include "SensorManager.h"
 #include "Control.h"
 #include "VacuumNetwork.h"
-#include "StateMachine.h"  // changeState, getStateName
+#include "StateMachine.h"  // postStateEvent, getStateName
 #include "Sensor.h"        // calibratePressure, calibrateCurrent
+#include "PID_Control.h"   // getPidTimingStats, PID auto-tune
 #include "SD_Logger.h"     // getCurrentTimeISO8601, generateDailyReport
 #include <WiFi.h>
 #include <PubSubClient.h>
@@ -45,6 +46,8 @@ static PubSubClient  mqttClientObj(wifiClientObj);
 #define MQTT_TOPIC_COMMAND       "vacuum/command"
 #define MQTT_TOPIC_CONFIG        "vacuum/config"
 #define MQTT_TOPIC_RESPONSE      "vacuum/response"
+#define MQTT_TOPIC_PID_TIMING    "vacuum/pid_timing"
+#define MQTT_TOPIC_AUTOTUNE      "vacuum/autotune"
 
 //  MQTT   
 #define MQTT_RECONNECT_INTERVAL  5000  // 5  
@@ -244,6 +247,58 @@ void publishConfigUpdate() {
   mqttClientObj.publish(MQTT_TOPIC_CONFIG, buffer, true);
 }
 
+//  PID loop timing (jitter / execution histograms summary) 
+void publishPidTiming() {
+  if (!mqttConnected) return;
+
+  PidTimingStats st = getPidTimingStats();
+  StaticJsonDocument<384> doc;
+  doc["rate_hz"]        = st.rateHz;
+  doc["steps"]          = st.steps;
+  doc["missed"]         = st.missedPeriods;
+  doc["jitter_p50_us"]  = st.jitterP50Us;
+  doc["jitter_p99_us"]  = st.jitterP99Us;
+  doc["jitter_max_us"]  = st.jitterMaxUs;
+  doc["exec_mean_us"]   = st.execMeanUs;
+  doc["exec_p99_us"]    = st.execP99Us;
+  doc["exec_max_us"]    = st.execMaxUs;
+
+  JsonArray hist = doc.createNestedArray("jitter_hist");
+  const PidJitterHistogram& h = getPidJitterHistogram();
+  size_t last = 0;
+  for (size_t i = 0; i < PidJitterHistogram::binCount(); i++) if (h.bin(i)) last = i;
+  for (size_t i = 0; i <= last && i < 16; i++) hist.add(h.bin(i));
+
+  char buffer[384];
+  serializeJson(doc, buffer);
+  mqttClientObj.publish(MQTT_TOPIC_PID_TIMING, buffer);
+}
+
+void publishAutotuneStatus() {
+  if (!mqttConnected) return;
+
+  static const char* const STATE_NAMES[] = { "idle", "running", "done", "failed" };
+  PidAutotuneStatus st = getPidAutotuneStatus();
+  StaticJsonDocument<384> doc;
+  doc["state"]      = STATE_NAMES[st.state];
+  doc["cycles"]     = st.cycles;
+  doc["cycles_req"] = st.cyclesNeeded;
+  doc["elapsed_ms"] = st.elapsedMs;
+  if (st.state == AUTOTUNE_FAILED) doc["failure"] = autotuneFailureName(st.failure);
+  if (st.state == AUTOTUNE_DONE) {
+    doc["ku"]    = st.ku;
+    doc["pu_s"]  = st.puSec;
+    JsonObject zn = doc.createNestedObject("zn");
+    zn["kp"] = st.zieglerNichols.kp; zn["ki"] = st.zieglerNichols.ki; zn["kd"] = st.zieglerNichols.kd;
+    JsonObject tl = doc.createNestedObject("tl");
+    tl["kp"] = st.tyreusLuyben.kp;   tl["ki"] = st.tyreusLuyben.ki;   tl["kd"] = st.tyreusLuyben.kd;
+  }
+
+  char buffer[384];
+  serializeJson(doc, buffer);
+  mqttClientObj.publish(MQTT_TOPIC_AUTOTUNE, buffer);
+}
+
 //   publishMQTT() -   
 void publishMQTT() {
   publishSystemStatus();  // v4.0   
@@ -278,7 +333,7 @@ void handleMQTTCommand(const char* cmd, JsonDocument& doc) {
   //     
   if (strcmp(cmd, "START") == 0) {
     if (currentState == STATE_IDLE) {
-      changeState(STATE_VACUUM_ON);
+      postStateEvent(SM_EV_CMD_START);
       success = true;
       message = "Vacuum started";
     } else {
@@ -286,13 +341,13 @@ void handleMQTTCommand(const char* cmd, JsonDocument& doc) {
     }
   }
   else if (strcmp(cmd, "STOP") == 0) {
-    changeState(STATE_IDLE);
+    postStateEvent(SM_EV_CMD_STOP);
     success = true;
     message = "System stopped";
   }
   else if (strcmp(cmd, "EMERGENCY_STOP") == 0) {
     //  
-    changeState(STATE_ERROR);
+    postStateEvent(SM_EV_CMD_ESTOP);
     success = true;
     message = "Emergency stop activated";
   }
@@ -418,12 +473,53 @@ void handleMQTTCommand(const char* cmd, JsonDocument& doc) {
     success = true;
     message = "Status published";
   }
+  else if (strcmp(cmd, "GET_PID_TIMING") == 0) {
+    publishPidTiming();
+    success = true;
+    message = "PID timing published";
+  }
   else if (strcmp(cmd, "GET_CONFIG") == 0) {
     publishConfigUpdate();
     success = true;
     message = "Config published";
   }
   
+  //  PID auto-tune 
+  else if (strcmp(cmd, "AUTOTUNE_START") == 0) {
+    success = startPidAutotune();
+    message = success ? "Autotune started" : "Autotune needs IDLE state";
+  }
+  else if (strcmp(cmd, "AUTOTUNE_ABORT") == 0) {
+    abortPidAutotune();
+    success = true;
+    message = "Autotune aborted";
+  }
+  else if (strcmp(cmd, "AUTOTUNE_APPLY") == 0) {
+    AutotuneRule r = AUTOTUNE_RULE_TYREUS_LUYBEN;   // default: conservative
+    bool ruleOk = true;
+    if (doc.containsKey("rule")) {
+      // Non-string rule ({"rule":1}, null) reads as nullptr: reject it
+      const char* rule = doc["rule"] | "";
+      if (strcmp(rule, "ZN") == 0)      r = AUTOTUNE_RULE_ZIEGLER_NICHOLS;
+      else if (strcmp(rule, "TL") != 0) ruleOk = false;
+    }
+    if (!ruleOk) {
+      message = "Unknown autotune rule (ZN or TL)";
+    } else if (applyPidAutotune(r)) {
+      saveConfig();
+      publishConfigUpdate();
+      success = true;
+      message = "Autotune gains applied";
+    } else {
+      message = "No completed autotune result";
+    }
+  }
+  else if (strcmp(cmd, "GET_AUTOTUNE") == 0) {
+    publishAutotuneStatus();
+    success = true;
+    message = "Autotune status published";
+  }
+  
   //   
   else if (strcmp(cmd, "CALIBRATE_PRESSURE") == 0) {
     calibratePressure();
@@ -611,10 +707,10 @@ void handleSerialCommand() {
 
   //   - strcmp 
   if (strcmp(cmd, "START") == 0) {
-    if (currentState == STATE_IDLE) changeState(STATE_VACUUM_ON);
+    if (currentState == STATE_IDLE) postStateEvent(SM_EV_CMD_START);
   }
   else if (strcmp(cmd, "STOP") == 0) {
-    changeState(STATE_IDLE);
+    postStateEvent(SM_EV_CMD_STOP);
   }
   else if (strcmp(cmd, "STATUS") == 0) {
     Serial.printf(": %s\n", getStateName(currentState));
@@ -1,75 +1,343 @@
 // ================================================================
-// PID_Control.cpp    PID  
+// PID_Control.cpp    PID
+// ================================================================
+// The control law runs at a fixed PID_LOOP_RATE_HZ from a periodic
+// esp_timer that notifies a dedicated high-priority task, so dt is
+// constant and independent of the VacuumCtrl task cadence.
+// updatePID() (VacuumCtrl tick) only arms the loop; if it stops being
+// called (mode change, error) the loop disarms after PID_ARM_TIMEOUT_MS.
+//
+//  - control law: PidController (include/PidController.h) with
+//    derivative on measurement through a first-order low-pass and
+//    back-calculation anti-windup (tracking time Tt = sqrt(Ti*Td))
+//  - period-jitter and execution-time histograms (serial / MQTT)
+//  - relay auto-tune (RelayAutotune.h) in place of the control law,
+//    requested from the PID screen / MQTT, aborted by any state change
 // ================================================================
 #include "Config.h"
 #include "PID_Control.h"
-#include "Control.h"        // controlPump()
-#include "SensorManager.h"
-
-//  PID  
-static float    pidError      = 0.0f;
-static float    pidIntegral   = 0.0f;
-static float    pidDerivative = 0.0f;
-static float    pidLastError  = 0.0f;
-static float    pidOutput     = 0.0f;
-static uint32_t lastPIDUpdate = 0;
+#include "PidController.h"
+#include "Control.h"        // setPumpDuty(), controlPump(), pumpControlTick()
+#include "Sensor.h"         // readPressure(): latest ADC frame, no conversion
+#include "StateMachine.h"   // rearmStateEvents()
 
-//  
-extern SensorManager sensorManager;
+#include <esp_timer.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
 
+static constexpr uint32_t PID_PERIOD_US     = 1000000UL / PID_LOOP_RATE_HZ;
+static constexpr uint32_t PID_TASK_STACK    = 3072;
+static constexpr UBaseType_t PID_TASK_PRIO  = configMAX_PRIORITIES - 2;
 
-//  PID  
-void updatePID() {
-  uint32_t currentTime = millis();
+struct VacuumPidOptions {
+  static constexpr PidAntiWindup antiWindup    = PidAntiWindup::BackCalculation;
+  static constexpr PidDerivative derivative    = PidDerivative::OnMeasurement;
+  static constexpr float         derivFilterHz = PID_DERIV_FILTER_HZ;
+  static constexpr float         outputMin     = PID_OUTPUT_MIN;
+  static constexpr float         outputMax     = PID_OUTPUT_MAX;
+  static constexpr float         integralLimit = 0.0f;
+};
 
-  //  
-  if (currentTime - lastPIDUpdate < PID_UPDATE_INTERVAL) return;
+//  PID  (owned by the PIDLoop task)
+static PidController<float, VacuumPidOptions> s_pid;
+static uint8_t s_pidPwm = 0;
 
-  float dt = (currentTime - lastPIDUpdate) / 1000.0f;
-  lastPIDUpdate = currentTime;
+static esp_timer_handle_t s_pidTimer   = nullptr;
+static TaskHandle_t       s_pidTask    = nullptr;
+static volatile uint32_t  s_armedAtMs  = 0;
+static volatile bool      s_armed      = false;
+static volatile bool      s_resetReq   = false;
 
-  //  
-  pidError = config.targetPressure - sensorManager.getPressure();
+// Timing instrumentation
+static PidJitterHistogram s_periodJitter;
+static PidExecHistogram   s_execTime;
+static volatile uint32_t  s_missedPeriods = 0;
+static volatile uint32_t  s_steps = 0;
 
-  //   (Anti-windup)
-  pidIntegral += pidError * dt;
-  pidIntegral  = constrain(pidIntegral, -INTEGRAL_LIMIT, INTEGRAL_LIMIT);
+// Auto-tune (owned by the PIDLoop task; requests from UI / MQTT / state machine)
+static RelayAutotuner     s_tuner;
+static volatile bool      s_tuneStartReq = false;
+static volatile bool      s_tuneAbortReq = false;
 
-  // 
-  pidDerivative = (pidError - pidLastError) / dt;
-  pidLastError  = pidError;
+// ================================================================
+//  Control law (fixed dt)
+// ================================================================
+static void pidStep() {
+  // Gains are refolded only when they change (UI / MQTT / autotune)
+  if (config.pidKp != s_pid.kP() || config.pidKi != s_pid.kI() || config.pidKd != s_pid.kD()) {
+    s_pid.setGains(config.pidKp, config.pidKi, config.pidKd);
+  }
 
-  // PID 
-  pidOutput = (config.pidKp * pidError)
-            + (config.pidKi * pidIntegral)
-            + (config.pidKd * pidDerivative);
-  pidOutput = constrain(pidOutput, PID_OUTPUT_MIN, PID_OUTPUT_MAX);
+  float output = s_pid.step(config.targetPressure, readPressure());
 
-  // PWM 
-  uint8_t pwm = map((long)pidOutput,
-                    (long)PID_OUTPUT_MIN, (long)PID_OUTPUT_MAX,
-                    (long)PWM_MIN,        (long)PWM_MAX);
+  // PWM
+  float span = (output - PID_OUTPUT_MIN) / (PID_OUTPUT_MAX - PID_OUTPUT_MIN);
+  s_pidPwm = (uint8_t)lroundf(PWM_MIN + span * (PWM_MAX - PWM_MIN));
 
   //   (  )
   if (currentState == STATE_VACUUM_ON || currentState == STATE_VACUUM_HOLD) {
-    controlPump(true, pwm);
+    setPumpDuty(s_pidPwm);
+  }
+}
+
+// ================================================================
+//  Auto-tune (replaces the control law while running)
+// ================================================================
+static void finishAutotune() {
+  // The state machine owns the pump outside IDLE (abort by state change)
+  if (currentState == STATE_IDLE) controlPump(false);
+  rearmStateEvents();   // a part placed during the run starts the cycle now
+
+  if (s_tuner.state() == AUTOTUNE_DONE) {
+    AutotuneGains zn = s_tuner.gains(AUTOTUNE_RULE_ZIEGLER_NICHOLS);
+    AutotuneGains tl = s_tuner.gains(AUTOTUNE_RULE_TYREUS_LUYBEN);
+    Serial.printf("[PID] autotune done: Ku %.2f Pu %.2f s\n", s_tuner.ultimateGain(), s_tuner.ultimatePeriodSec());
+    Serial.printf("[PID]   ZN Kp %.2f Ki %.2f Kd %.2f | TL Kp %.2f Ki %.2f Kd %.2f\n",
+                  zn.kp, zn.ki, zn.kd, tl.kp, tl.ki, tl.kd);
+  } else {
+    Serial.printf("[PID] autotune failed: %s\n", autotuneFailureName(s_tuner.failure()));
+  }
+}
+
+static void beginAutotune() {
+  RelayAutotuneConfig c;
+  c.setpoint      = config.targetPressure;
+  c.bias          = AUTOTUNE_RELAY_BIAS;
+  c.amplitude     = AUTOTUNE_RELAY_AMPLITUDE;
+  c.hysteresis    = AUTOTUNE_HYSTERESIS;
+  c.maxDeviation  = AUTOTUNE_MAX_DEVIATION;
+  c.outputMin     = PID_OUTPUT_MIN;
+  c.outputMax     = PID_OUTPUT_MAX;
+  c.warmupCycles  = AUTOTUNE_WARMUP_CYCLES;
+  c.measureCycles = AUTOTUNE_MEASURE_CYCLES;
+  c.timeoutMs     = AUTOTUNE_TIMEOUT_MS;
+  s_tuner.begin(c, millis());
+  Serial.printf("[PID] autotune: relay %.0f +/- %.0f %% around %.1f kPa\n",
+                c.bias, c.amplitude, c.setpoint);
+}
+
+// Returns true while the tuner owns the pump this tick
+static bool autotuneTick(bool outputAllowed) {
+  if (s_tuneAbortReq) {
+    s_tuneAbortReq = false;
+    s_tuneStartReq = false;
+    if (s_tuner.running()) {
+      s_tuner.abort();
+      finishAutotune();
+    }
+  }
+  if (s_tuneStartReq) {
+    beginAutotune();
+    s_tuneStartReq = false;        // after begin: isPidAutotuneRunning() never gaps
   }
+  if (!s_tuner.running()) return false;
+
+  if (!outputAllowed) {            // E-stop: pumpControlTick() already cut the output
+    s_tuner.abort();
+    finishAutotune();
+    return true;
+  }
+
+  float out = s_tuner.update(readPressure(), millis());
+  if (!s_tuner.running()) {
+    finishAutotune();
+    return true;
+  }
+  float span = (out - PID_OUTPUT_MIN) / (PID_OUTPUT_MAX - PID_OUTPUT_MIN);
+  setPumpDuty((uint8_t)lroundf(PWM_MIN + span * (PWM_MAX - PWM_MIN)));
+  return true;
+}
+
+// ================================================================
+//  Timer -> task
+// ================================================================
+static void pidTimerCallback(void*) {
+  // esp_timer task context
+  if (s_pidTask) xTaskNotifyGive(s_pidTask);
+}
+
+static void pidLoopTask(void*) {
+  int64_t lastWakeUs = 0;
+  bool wasArmed = false;
+  s_pid.setSampleTime(PID_PERIOD_US / 1000000.0f);
+
+  for (;;) {
+    uint32_t pending = ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    int64_t t0 = esp_timer_get_time();
+
+    if (pending > 1) s_missedPeriods = s_missedPeriods + (pending - 1);
+    if (lastWakeUs != 0) {
+      int64_t dev = (t0 - lastWakeUs) - (int64_t)PID_PERIOD_US;
+      s_periodJitter.record((uint32_t)(dev < 0 ? -dev : dev));
+    }
+    lastWakeUs = t0;
+
+    bool outputAllowed = pumpControlTick();   // E-stop cut + PWM ramp, every tick
+
+    if (autotuneTick(outputAllowed)) {
+      s_execTime.record((uint32_t)(esp_timer_get_time() - t0));
+      continue;
+    }
+
+    if (s_resetReq) {
+      s_pid.reset();
+      s_resetReq = false;
+    }
+
+    bool armed = outputAllowed && s_armed && (millis() - s_armedAtMs <= PID_ARM_TIMEOUT_MS);
+    if (!armed) {
+      if (wasArmed) s_pid.reset();   // start clean on re-arm
+      wasArmed = false;
+      continue;
+    }
+    wasArmed = true;
+
+    pidStep();
+    s_steps = s_steps + 1;
+    s_execTime.record((uint32_t)(esp_timer_get_time() - t0));
+  }
+}
+
+void initPIDLoop() {
+  if (s_pidTimer) return;
+
+  xTaskCreatePinnedToCore(pidLoopTask, "PIDLoop", PID_TASK_STACK, nullptr,
+                          PID_TASK_PRIO, &s_pidTask, 1);
+
+  esp_timer_create_args_t args = {};
+  args.callback        = pidTimerCallback;
+  args.dispatch_method = ESP_TIMER_TASK;
+  args.name            = "pid";
+  if (esp_timer_create(&args, &s_pidTimer) != ESP_OK ||
+      esp_timer_start_periodic(s_pidTimer, PID_PERIOD_US) != ESP_OK) {
+    Serial.println("[PID] esp_timer  ");
+    return;
+  }
+  Serial.printf("[PID]  %d Hz (period %lu us)\n", PID_LOOP_RATE_HZ, (unsigned long)PID_PERIOD_US);
+}
+
+//  PID  (VacuumCtrl tick: arm / keep-alive)
+void updatePID() {
+  s_armedAtMs = millis();
+  s_armed = true;
 
   //   (5 )
   static uint32_t lastDebugPrint = 0;
-  if (currentTime - lastDebugPrint >= 5000) {
+  uint32_t now = millis();
+  if (now - lastDebugPrint >= 5000) {
     Serial.printf("[PID] Error: %.2f, I: %.2f, D: %.2f, Output: %.1f%%, PWM: %d\n",
-                  pidError, pidIntegral, pidDerivative, pidOutput, pwm);
-    lastDebugPrint = currentTime;
+                  s_pid.error(), s_pid.integral(), s_pid.derivative(), s_pid.output(), s_pidPwm);
+    lastDebugPrint = now;
   }
 }
 
-//  PID  
+//  PID
 void resetPID() {
-  pidError      = 0.0f;
-  pidIntegral   = 0.0f;
-  pidDerivative = 0.0f;
-  pidLastError  = 0.0f;
-  pidOutput     = 0.0f;
+  s_armed = false;
+  s_resetReq = true;
   Serial.println("[PID]  ");
 }
+
+// ================================================================
+//  Timing statistics
+// ================================================================
+PidTimingStats getPidTimingStats() {
+  PidTimingStats st;
+  st.rateHz        = PID_LOOP_RATE_HZ;
+  st.steps         = s_steps;
+  st.missedPeriods = s_missedPeriods;
+  st.jitterP50Us   = s_periodJitter.percentile(0.50f);
+  st.jitterP99Us   = s_periodJitter.percentile(0.99f);
+  st.jitterMaxUs   = s_periodJitter.max();
+  st.execMeanUs    = s_execTime.mean();
+  st.execP99Us     = s_execTime.percentile(0.99f);
+  st.execMaxUs     = s_execTime.max();
+  return st;
+}
+
+const PidJitterHistogram& getPidJitterHistogram() { return s_periodJitter; }
+const PidExecHistogram&   getPidExecHistogram()   { return s_execTime; }
+
+void resetPidTiming() {
+  s_periodJitter.clear();
+  s_execTime.clear();
+  s_missedPeriods = 0;
+}
+
+void printPidTiming() {
+  PidTimingStats st = getPidTimingStats();
+  Serial.println("\n========== PID loop timing ==========");
+  Serial.printf(" rate      : %lu Hz  steps: %lu  missed: %lu\n",
+                (unsigned long)st.rateHz, (unsigned long)st.steps,
+                (unsigned long)st.missedPeriods);
+  Serial.printf(" jitter us : p50 %lu  p99 %lu  max %lu\n",
+                (unsigned long)st.jitterP50Us, (unsigned long)st.jitterP99Us,
+                (unsigned long)st.jitterMaxUs);
+  Serial.printf(" exec us   : mean %.1f  p99 %lu  max %lu\n",
+                st.execMeanUs, (unsigned long)st.execP99Us, (unsigned long)st.execMaxUs);
+
+  Serial.printf(" jitter histogram (%lu us bins):\n", (unsigned long)PidJitterHistogram::binWidthUs());
+  for (size_t i = 0; i < PidJitterHistogram::binCount(); i++) {
+    uint32_t c = s_periodJitter.bin(i);
+    if (c == 0) continue;
+    Serial.printf("   %s%5lu : %lu\n", i + 1 == PidJitterHistogram::binCount() ? ">=" : "  ",
+                  (unsigned long)(i * PidJitterHistogram::binWidthUs()), (unsigned long)c);
+  }
+  Serial.println("=====================================\n");
+}
+
+// ================================================================
+//  Auto-tune API
+// ================================================================
+bool startPidAutotune() {
+  if (isPidAutotuneRunning()) return false;
+  if (currentState != STATE_IDLE || readEmergencyStop()) {
+    Serial.println("[PID] autotune: system must be IDLE");
+    return false;
+  }
+  s_tuneAbortReq = false;
+  s_tuneStartReq = true;
+  return true;
+}
+
+void abortPidAutotune() {
+  if (isPidAutotuneRunning()) s_tuneAbortReq = true;
+}
+
+bool isPidAutotuneRunning() {
+  return s_tuneStartReq || s_tuner.running();
+}
+
+PidAutotuneStatus getPidAutotuneStatus() {
+  PidAutotuneStatus st;
+  st.state          = s_tuneStartReq ? AUTOTUNE_RUNNING : s_tuner.state();
+  st.failure        = s_tuner.failure();
+  st.cycles         = s_tuner.cyclesSeen();
+  st.cyclesNeeded   = s_tuner.cyclesNeeded();
+  st.elapsedMs      = s_tuner.running() ? s_tuner.elapsedMs(millis()) : 0;
+  st.ku             = s_tuner.ultimateGain();
+  st.puSec          = s_tuner.ultimatePeriodSec();
+  st.zieglerNichols = s_tuner.gains(AUTOTUNE_RULE_ZIEGLER_NICHOLS);
+  st.tyreusLuyben   = s_tuner.gains(AUTOTUNE_RULE_TYREUS_LUYBEN);
+  return st;
+}
+
+bool applyPidAutotune(AutotuneRule rule) {
+  if (isPidAutotuneRunning() || s_tuner.state() != AUTOTUNE_DONE) return false;
+  AutotuneGains g = s_tuner.gains(rule);
+  config.pidKp = g.kp;
+  config.pidKi = g.ki;
+  config.pidKd = g.kd;
+  Serial.printf("[PID] %s gains applied: Kp %.2f Ki %.2f Kd %.2f\n",
+                RelayAutotuner::ruleName(rule), g.kp, g.ki, g.kd);
+  return true;
+}
+
+const char* autotuneFailureName(AutotuneFailure f) {
+  switch (f) {
+    case AUTOTUNE_FAIL_TIMEOUT:   return "timeout (no stable oscillation)";
+    case AUTOTUNE_FAIL_DEVIATION: return "pressure left the allowed band";
+    case AUTOTUNE_FAIL_ABORTED:   return "aborted";
+    default:                      return "none";
+  }
+}
@@ -215,9 +215,11 @@ void RemoteManager::handleRemoteSensorData() {
     StaticJsonDocument<512> doc;
     
     //  
-    doc["temperature"] = readTemperature();
-    doc["pressure"] = readPressure();
-    doc["current"] = readCurrent();
+    SensorFrame frame = latestSensorFrame();
+    doc["temperature"] = frame.temperature;
+    doc["pressure"] = frame.pressure;
+    doc["current"] = frame.current;
+    doc["seq"] = frame.seq;
     
     // 
     SensorStats stats;
@@ -21,6 +21,9 @@ extern SensorManager sensorManager;
 #include "SD_Logger.h"
 #include "StateMachine.h"
 #include "SafeSD.h"
+#include "SdLogService.h"
+#include "TsLogger.h"
+#include "LogRetentionService.h"
 #include "EnhancedWatchdog.h"
 #include <SD.h>
 #include <time.h>
@@ -37,18 +40,16 @@ void initSD() {
         return;
     }
     Serial.println("[SD]  ");
-}
-
-//  :    
-static void writeHeaderIfEmpty(SafeSDFile& f, const char* header) {
-    if (f.get().size() == 0) {
-        f->println(header);
-    }
+    initSdLogService(SD, true);
+    initTsLogger();
+    initLogRetention(SD.totalBytes());
 }
 
 //    
+// Records go to the write-behind rings (SdLogService); the SdLog task
+// owns the files, writes the CSV headers and does the SD I/O.
 void logCycle() {
-    if (!SafeSDFile::_sdReady) return;
+    if (!sdLogReady()) return;
 
     char iso[ISO8601_BUFFER_SIZE];
     getCurrentTimeISO8601(iso, sizeof(iso));
@@ -64,22 +65,14 @@ void logCycle() {
              stats.averageCurrent,
              currentState == STATE_COMPLETE ? 1 : 0);
 
-    // [4][8] SafeSD: SPI  + WDT feed 
-    SafeSDFile f("/logs/cycle_log.csv", FILE_APPEND);
-    if (!f.isOpen()) {
-        Serial.println("[SD] cycle_log  ");
-        return;
+    if (!sdLogAppend(SDLOG_CYCLE, line)) {
+        Serial.println("[SD] cycle_log buffer full, record dropped");
     }
-
-    writeHeaderIfEmpty(f, "CycleNum,ISO8601,Duration,MinPressure,MaxPressure,AvgCurrent,Success");
-    WDT_FEED();
-    f->println(line);
-    //   close + WDT feed
 }
 
 //    
 void logError(const ErrorInfo& error) {
-    if (!SafeSDFile::_sdReady) return;
+    if (!sdLogReady()) return;
 
     char iso[ISO8601_BUFFER_SIZE];
     getCurrentTimeISO8601(iso, sizeof(iso));
@@ -90,39 +83,41 @@ void logError(const ErrorInfo& error) {
              error.code, error.severity,
              error.message);
 
-    SafeSDFile f("/logs/error_log.csv", FILE_APPEND);
-    if (!f.isOpen()) {
-        Serial.println("[SD] error_log  ");
+    if (!sdLogAppend(SDLOG_ERROR, line)) {
+        Serial.println("[SD] error_log buffer full, record dropped");
         return;
     }
 
-    writeHeaderIfEmpty(f, "Timestamp,ISO8601,Code,Severity,Message");
-    WDT_FEED();
-    f->println(line);
-
     Serial.println("[SD]   ");
 }
 
 //     
-void logSensorTrend() {
-    if (!SafeSDFile::_sdReady) return;
+// One aggregated row per drained batch: every frame pushed by the
+// SensorRead task contributes, nothing is resampled away.
+void logSensorTrend(const SensorData* frames, size_t count) {
+    if (!sdLogReady() || frames == nullptr || count == 0) return;
+
+    float sumP = 0.0f, sumI = 0.0f;
+    float minP = frames[0].pressure, maxP = frames[0].pressure;
+    for (size_t i = 0; i < count; i++) {
+        sumP += frames[i].pressure;
+        sumI += frames[i].current;
+        if (frames[i].pressure < minP) minP = frames[i].pressure;
+        if (frames[i].pressure > maxP) maxP = frames[i].pressure;
+    }
 
     char iso[ISO8601_BUFFER_SIZE];
     getCurrentTimeISO8601(iso, sizeof(iso));
 
     char line[256];
-    snprintf(line, sizeof(line), "%lu,%s,%.2f,%.2f,%s",
-             millis(), iso,
-             sensorManager.getPressure(),
-             sensorManager.getCurrent(),
+    snprintf(line, sizeof(line), "%lu,%s,%.2f,%.2f,%.2f,%.2f,%u,%s",
+             frames[count - 1].timestamp, iso,
+             sumP / count, minP, maxP,
+             sumI / count,
+             (unsigned)count,
              getStateName(currentState));
 
-    SafeSDFile f("/logs/sensor_trend.csv", FILE_APPEND);
-    if (!f.isOpen()) return;
-
-    writeHeaderIfEmpty(f, "Timestamp,ISO8601,Pressure,Current,State");
-    WDT_FEED();
-    f->println(line);
+    sdLogAppend(SDLOG_TREND, line);
 }
 
 //    
@@ -183,8 +178,9 @@ void generateDailyReport() {
 }
 
 //     
+// Rotated segments are pruned in the background (LogRetentionService)
 void cleanupOldLogs() {
-    //   
+    logRetentionRequest();
     Serial.println("[SD]   ...");
 }
 
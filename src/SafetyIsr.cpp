@@ -0,0 +1,320 @@
+// ================================================================
+// SafetyIsr.cpp    E-stop / input interrupt fast path
+// ================================================================
+//  ISR -> outputs safe -> state event; confirmation, statistics and
+//  NVS writes happen in the SafetyIsr task. pumpControlTick() keeps
+//  its readEmergencyStop() check as the polled backstop.
+// ================================================================
+#include "Config.h"
+#include "SafetyIsr.h"
+#include "Sensor.h"          // readEmergencyStop()
+#include "StateMachine.h"    // postStateEventFromISR()
+
+#include <Preferences.h>
+#include <driver/gpio.h>
+#include <driver/mcpwm_cap.h>
+#include <esp_cpu.h>
+#include <esp_rom_gpio.h>
+#include <esp_rom_sys.h>
+#include <esp_timer.h>
+#include <hal/gpio_ll.h>
+#include <soc/gpio_sig_map.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+static constexpr uint32_t NOTIFY_ESTOP = 1u << 0;
+
+static TaskHandle_t s_safetyTask = nullptr;
+static Preferences  s_safetyPrefs;
+
+// ISR -> task
+static volatile bool     s_outputsCut   = false;
+static volatile bool     s_tripPending  = false;   // set by ISR, cleared after confirmation
+static volatile uint32_t s_tripCycles   = 0;
+static volatile uint32_t s_inputEdges   = 0;
+static volatile int64_t  s_lastLimitUs  = 0;
+static volatile int64_t  s_lastPhotoUs  = 0;
+
+// MCPWM capture: the E-stop falling edge and the 12V emergency rising
+// edge latched on one hardware timer (ISR -> task)
+static mcpwm_cap_timer_handle_t s_capTimer = nullptr;
+static uint32_t          s_capHz        = 0;        // 0: no capture, trips untimed
+static uint32_t          s_capBurstTicks = 0;
+static volatile uint32_t s_capEdge      = 0;
+static volatile uint32_t s_capOut       = 0;
+static volatile bool     s_capEdgeSeen  = false;
+static volatile bool     s_capOutSeen   = false;
+
+// Task-owned
+static SafetyLatencyStats s_stats = {};
+static portMUX_TYPE       s_statsMux = portMUX_INITIALIZER_UNLOCKED;
+
+// ================================================================
+//  ISRs (IRAM; register access only)
+// ================================================================
+static inline void IRAM_ATTR cutOutputsFromIsr() {
+  // Take the pump pin away from LEDC and hold it low
+  esp_rom_gpio_connect_out_signal(PIN_PUMP_PWM, SIG_GPIO_OUT_IDX, false, false);
+  gpio_ll_set_level(&GPIO, PIN_PUMP_PWM, 0);
+  gpio_ll_set_level(&GPIO, PIN_12V_MAIN, 0);
+  gpio_ll_set_level(&GPIO, PIN_VALVE, 0);
+  gpio_ll_set_level(&GPIO, PIN_12V_EMERGENCY, 1);
+}
+
+static void IRAM_ATTR estopIsr(void*) {
+  uint32_t c0 = esp_cpu_get_cycle_count();
+  if (gpio_ll_get_level(&GPIO, PIN_EMERGENCY_STOP) != 0) return;   // LOW = pressed
+
+  cutOutputsFromIsr();
+  uint32_t cycles = esp_cpu_get_cycle_count() - c0;
+  s_outputsCut = true;
+
+  // Contact bounce re-enters here; only the first edge is measured
+  if (s_tripPending) return;
+  s_tripPending = true;
+  s_tripCycles = cycles;
+
+  BaseType_t woken = pdFALSE;
+  postStateEventFromISR(SM_EV_ESTOP_PRESSED, &woken);
+  if (s_safetyTask) xTaskNotifyFromISR(s_safetyTask, NOTIFY_ESTOP, eSetBits, &woken);
+  portYIELD_FROM_ISR(woken);
+}
+
+// Capture callbacks. Bounce re-captures the E-stop pin; the first edge
+// of a burst is kept, and the first output rise after it.
+static bool IRAM_ATTR estopEdgeCaptured(mcpwm_cap_channel_handle_t, const mcpwm_capture_event_data_t* e, void*) {
+  uint32_t t = e->cap_value;
+  if (!s_capEdgeSeen || t - s_capEdge > s_capBurstTicks) {
+    s_capEdge = t;
+    s_capOutSeen = false;
+    s_capEdgeSeen = true;
+  }
+  return false;
+}
+
+static bool IRAM_ATTR outputRiseCaptured(mcpwm_cap_channel_handle_t, const mcpwm_capture_event_data_t* e, void*) {
+  if (s_capEdgeSeen && !s_capOutSeen) {
+    s_capOut = e->cap_value;
+    s_capOutSeen = true;
+  }
+  return false;
+}
+
+// Level re-checked in the ISR; edges inside the lockout are bounce
+static inline bool IRAM_ATTR acceptEdge(volatile int64_t& lastUs) {
+  int64_t now = esp_timer_get_time();
+  if (now - lastUs < SAFETY_INPUT_DEBOUNCE_US) return false;
+  lastUs = now;
+  return true;
+}
+
+static void IRAM_ATTR limitSwitchIsr(void*) {
+  if (gpio_ll_get_level(&GPIO, PIN_LIMIT_SWITCH) != 0) return;     // LOW = part placed
+  if (!acceptEdge(s_lastLimitUs)) return;
+  BaseType_t woken = pdFALSE;
+  postStateEventFromISR(SM_EV_LIMIT_SWITCH, &woken);
+  s_inputEdges = s_inputEdges + 1;
+  portYIELD_FROM_ISR(woken);
+}
+
+static void IRAM_ATTR photoSensorIsr(void*) {
+  if (gpio_ll_get_level(&GPIO, PIN_PHOTO_SENSOR) == 0) return;     // HIGH = part removed
+  if (!acceptEdge(s_lastPhotoUs)) return;
+  BaseType_t woken = pdFALSE;
+  postStateEventFromISR(SM_EV_PART_REMOVED, &woken);
+  s_inputEdges = s_inputEdges + 1;
+  portYIELD_FROM_ISR(woken);
+}
+
+// ================================================================
+//  Confirmation / statistics task
+// ================================================================
+static void safetyIsrTask(void*) {
+  for (;;) {
+    uint32_t bits = 0;
+    xTaskNotifyWait(0, UINT32_MAX, &bits, portMAX_DELAY);
+    if (!(bits & NOTIFY_ESTOP)) continue;
+
+    uint32_t bodyNs = (uint32_t)((uint64_t)s_tripCycles * 1000ULL / esp_rom_get_cpu_ticks_per_us());
+
+    // Debounce for the log only: the outputs are already safe. The
+    // capture interrupts have long run by the end of it.
+    vTaskDelay(pdMS_TO_TICKS(SAFETY_ESTOP_CONFIRM_MS));
+    bool confirmed = readEmergencyStop();
+
+    // Edge -> 12V emergency pin high, the last output the ISR sets. No
+    // rise (already high, capture unavailable) leaves the trip untimed.
+    bool timed = false;
+    uint32_t ns = 0;
+    if (s_capHz && s_capEdgeSeen && s_capOutSeen) {
+      uint32_t ticks = s_capOut - s_capEdge;
+      if (ticks < s_capHz / 1000) {                        // > 1 ms: not this trip's rise
+        ns = (uint32_t)((uint64_t)ticks * 1000000000ULL / s_capHz);
+        timed = true;
+      }
+    }
+    s_capEdgeSeen = false;
+
+    bool newWorst = false;
+    portENTER_CRITICAL(&s_statsMux);
+    s_stats.bodyNs = bodyNs;
+    s_stats.trips++;
+    s_stats.tripsTotal++;
+    if (confirmed) s_stats.confirmed++;
+    else           s_stats.glitches++;
+    if (timed) {
+      s_stats.lastNs = ns;
+      if (ns > s_stats.worstNs) s_stats.worstNs = ns;
+      newWorst = ns > s_stats.worstEverNs;
+      if (newWorst) s_stats.worstEverNs = ns;
+    } else {
+      s_stats.untimed++;
+    }
+    uint32_t worstEver = s_stats.worstEverNs;
+    uint32_t total = s_stats.tripsTotal;
+    portEXIT_CRITICAL(&s_statsMux);
+
+    s_safetyPrefs.begin("safety", false);
+    s_safetyPrefs.putUInt("trips", total);
+    if (newWorst) s_safetyPrefs.putUInt("reactNs", worstEver);
+    s_safetyPrefs.end();
+
+    if (timed) {
+      Serial.printf("[Safety] E-stop %s: edge -> outputs safe in %.2f us (worst %.2f us)\n",
+                    confirmed ? "confirmed" : "glitch", ns / 1000.0f, worstEver / 1000.0f);
+    } else {
+      Serial.printf("[Safety] E-stop %s: reaction untimed, ISR body %.2f us\n",
+                    confirmed ? "confirmed" : "glitch", bodyNs / 1000.0f);
+    }
+
+    s_tripPending = false;
+  }
+}
+
+// ================================================================
+//  Setup / API
+// ================================================================
+static bool addCaptureChannel(int gpio, bool negEdge, bool loopBack, bool pullUp,
+                              mcpwm_capture_event_cb_t cb) {
+  mcpwm_capture_channel_config_t cfg = {};
+  cfg.gpio_num = gpio;
+  cfg.prescale = 1;
+  cfg.flags.neg_edge = negEdge;
+  cfg.flags.pos_edge = !negEdge;
+  cfg.flags.pull_up = pullUp;
+  cfg.flags.io_loop_back = loopBack;     // output pin: keep its output path
+  mcpwm_cap_channel_handle_t ch = nullptr;
+  if (mcpwm_new_capture_channel(s_capTimer, &cfg, &ch) != ESP_OK) return false;
+  mcpwm_capture_event_callbacks_t cbs = {};
+  cbs.on_cap = cb;
+  return mcpwm_capture_channel_register_event_callbacks(ch, &cbs, nullptr) == ESP_OK &&
+         mcpwm_capture_channel_enable(ch) == ESP_OK;
+}
+
+// Hardware timestamps for the reaction time. gpio_config() inside the
+// channel setup resets the pin's interrupt type, so this runs before
+// the GPIO interrupts are armed.
+static void initReactionCapture() {
+  mcpwm_capture_timer_config_t tcfg = {};
+  tcfg.group_id = 0;
+  tcfg.clk_src  = MCPWM_CAPTURE_CLK_SRC_DEFAULT;
+  uint32_t hz = 0;
+  if (mcpwm_new_capture_timer(&tcfg, &s_capTimer) != ESP_OK ||
+      mcpwm_capture_timer_get_resolution(s_capTimer, &hz) != ESP_OK ||
+      !addCaptureChannel(PIN_EMERGENCY_STOP, true,  false, true,  estopEdgeCaptured) ||
+      !addCaptureChannel(PIN_12V_EMERGENCY,  false, true,  false, outputRiseCaptured) ||
+      mcpwm_capture_timer_enable(s_capTimer) != ESP_OK ||
+      mcpwm_capture_timer_start(s_capTimer) != ESP_OK) {
+    Serial.println("[Safety] MCPWM capture unavailable, E-stop reaction untimed");
+    return;
+  }
+  s_capBurstTicks = hz / 1000 * SAFETY_ESTOP_CONFIRM_MS;
+  s_capHz = hz;
+}
+
+void initSafetyIsr() {
+  if (s_safetyTask) return;
+
+  s_safetyPrefs.begin("safety", true);
+  s_stats.worstEverNs = s_safetyPrefs.getUInt("reactNs", 0);
+  s_stats.tripsTotal  = s_safetyPrefs.getUInt("trips", 0);
+  s_safetyPrefs.end();
+
+  xTaskCreatePinnedToCore(safetyIsrTask, "SafetyIsr", 3072, nullptr,
+                          configMAX_PRIORITIES - 2, &s_safetyTask, 1);
+
+  initReactionCapture();
+
+  esp_err_t err = gpio_install_isr_service(ESP_INTR_FLAG_IRAM);
+  if (err != ESP_OK && err != ESP_ERR_INVALID_STATE) {   // already installed is fine
+    Serial.printf("[Safety] ISR service failed (%d), E-stop is polled only\n", err);
+    return;
+  }
+
+  gpio_set_intr_type((gpio_num_t)PIN_EMERGENCY_STOP, GPIO_INTR_NEGEDGE);
+  gpio_set_intr_type((gpio_num_t)PIN_LIMIT_SWITCH,   GPIO_INTR_NEGEDGE);
+  gpio_set_intr_type((gpio_num_t)PIN_PHOTO_SENSOR,   GPIO_INTR_POSEDGE);
+  gpio_isr_handler_add((gpio_num_t)PIN_EMERGENCY_STOP, estopIsr,       nullptr);
+  gpio_isr_handler_add((gpio_num_t)PIN_LIMIT_SWITCH,   limitSwitchIsr, nullptr);
+  gpio_isr_handler_add((gpio_num_t)PIN_PHOTO_SENSOR,   photoSensorIsr, nullptr);
+  gpio_intr_enable((gpio_num_t)PIN_EMERGENCY_STOP);
+  gpio_intr_enable((gpio_num_t)PIN_LIMIT_SWITCH);
+  gpio_intr_enable((gpio_num_t)PIN_PHOTO_SENSOR);
+
+  // Already pressed at boot: no edge will come
+  if (readEmergencyStop()) {
+    cutOutputsFromIsr();
+    s_outputsCut = true;
+    postStateEvent(SM_EV_ESTOP_PRESSED);
+  }
+
+  Serial.printf("[Safety] E-stop ISR armed (worst reaction %.2f us, %lu trips)\n",
+                s_stats.worstEverNs / 1000.0f, s_stats.tripsTotal);
+}
+
+bool safetyOutputsTripped() {
+  return s_outputsCut;
+}
+
+bool safetyRestoreOutputs() {
+  if (!s_outputsCut) return true;
+  if (readEmergencyStop()) return false;
+  // Give the pin back to the LEDC channel: the reverse of cutOutputsFromIsr()
+  esp_rom_gpio_connect_out_signal(PIN_PUMP_PWM, LEDC_LS_SIG_OUT0_IDX + PWM_CHANNEL_PUMP, false, false);
+  s_outputsCut = false;
+  Serial.println("[Safety] pump PWM re-attached");
+  return true;
+}
+
+SafetyLatencyStats getSafetyLatencyStats() {
+  portENTER_CRITICAL(&s_statsMux);
+  SafetyLatencyStats st = s_stats;
+  portEXIT_CRITICAL(&s_statsMux);
+  st.inputEdges = s_inputEdges;
+  return st;
+}
+
+void resetSafetyLatency() {
+  portENTER_CRITICAL(&s_statsMux);
+  s_stats = SafetyLatencyStats();
+  portEXIT_CRITICAL(&s_statsMux);
+  s_safetyPrefs.begin("safety", false);
+  s_safetyPrefs.clear();
+  s_safetyPrefs.end();
+}
+
+void printSafetyLatency() {
+  SafetyLatencyStats st = getSafetyLatencyStats();
+  Serial.println("\n=== E-stop fast path ===");
+  Serial.printf("Outputs  : %s\n", s_outputsCut ? "CUT" : "normal");
+  // Edge and output rise latched by MCPWM capture: includes interrupt
+  // entry and dispatch, not just the ISR body
+  Serial.printf("Reaction : last %.2f us, worst %.2f us (boot), %.2f us (ever)\n",
+                st.lastNs / 1000.0f, st.worstNs / 1000.0f, st.worstEverNs / 1000.0f);
+  Serial.printf("           E-stop edge -> 12V emergency on (capture %s)\n",
+                s_capHz ? "on" : "unavailable");
+  Serial.printf("ISR body : last %.2f us\n", st.bodyNs / 1000.0f);
+  Serial.printf("Trips    : %lu (confirmed %lu, glitch %lu, untimed %lu), total %lu\n",
+                st.trips, st.confirmed, st.glitches, st.untimed, st.tripsTotal);
+  Serial.printf("Inputs   : %lu limit/photo edges from ISR\n", st.inputEdges);
+}
@@ -0,0 +1,350 @@
+// ================================================================
+// SdLogService.cpp    Batched write-behind SD logging
+// ================================================================
+//  Producers copy records into per-stream PSRAM rings under a short
+//  critical section. The SdLog task (Core 0) services every stream
+//  each SDLOG_TICK_MS, or sooner when a ring passes one block.
+//  CSV streams are rotated into dated segments after their service
+//  call (LogRetention.h naming); the pruner deletes old segments.
+// ================================================================
+#include "Config.h"
+#include "SdLogService.h"
+#include "SafeSD.h"
+#include "SPIBusManager.h"
+#include "EnhancedWatchdog.h"
+#include "LogRetention.h"
+#include "LogRetentionService.h"
+
+#include <cstdarg>
+#include <time.h>
+#include <esp_heap_caps.h>
+#include <esp_memory_utils.h>
+#include <esp_timer.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include <freertos/task.h>
+
+// ================================================================
+//  Stream table
+// ================================================================
+struct SdLogStreamDef {
+    const char* name;
+    const char* path;         // nullptr = set by sdLogSetPath()
+    const char* header;
+    uint32_t    ringBytes;
+    uint32_t    maxAgeMs;
+    bool        rotate;       // daily + SDLOG_ROTATE_BYTES; binary files keep offsets, never rotated
+};
+
+static const SdLogStreamDef STREAM_DEFS[SDLOG_STREAM_COUNT] = {
+    { "cycle",     "/logs/cycle_log.csv",
+      "CycleNum,ISO8601,Duration,MinPressure,MaxPressure,AvgCurrent,Success",
+      16 * 1024, SDLOG_MAX_AGE_MS, true },
+    { "error",     "/logs/error_log.csv",
+      "Timestamp,ISO8601,Code,Severity,Message",
+      8 * 1024,  SDLOG_MAX_AGE_ERROR_MS, true },
+    { "trend",     "/logs/sensor_trend.csv",
+      "Timestamp,ISO8601,Pressure,MinPressure,MaxPressure,Current,Samples,State",
+      32 * 1024, SDLOG_MAX_AGE_MS, true },
+    { "telemetry", "/logs/telemetry.csv",
+      "timestamp_ms,pressure_kpa,temperature_c,pump_duty,estop,free_heap",
+      16 * 1024, SDLOG_MAX_AGE_MS, true },
+    { "ts_data",   "/logs/trend.tsb",  nullptr, 16 * 1024, SDLOG_MAX_AGE_ERROR_MS, false },
+    { "ts_index",  "/logs/trend.tsi",  nullptr, 2 * 1024,  SDLOG_MAX_AGE_ERROR_MS, false },
+    { "health",    "/logs/health_rollup.bin", nullptr, 1024, SDLOG_MAX_AGE_MS, false },
+};
+
+// ================================================================
+//  Target glue: lock policy and File-backed sink
+// ================================================================
+struct PortMuxLock {
+    portMUX_TYPE mux = portMUX_INITIALIZER_UNLOCKED;
+    void lock()   { portENTER_CRITICAL(&mux); }
+    void unlock() { portEXIT_CRITICAL(&mux); }
+};
+
+class FsLogSink : public LogSink {
+public:
+    void attach(fs::FS* f, bool spi) { _fs = f; _spi = spi; }
+
+    bool open(const char* path) override {
+        if (!acquire(SD_OPEN_TIMEOUT_MS)) return false;
+        if (_spi && !SafeSDFile::_sdReady) { release(); return false; }
+        WDT_FEED();
+        _file = _fs->open(path, FILE_APPEND);
+        bool ok = (bool)_file;
+        release();
+        return ok;
+    }
+
+    bool isOpen() const override { return (bool)_file; }
+
+    uint32_t size() override { return _file ? (uint32_t)_file.size() : 0; }
+
+    size_t write(const uint8_t* data, size_t len) override {
+        if (!acquire(SD_WRITE_TIMEOUT_MS)) return 0;
+        WDT_FEED();
+        size_t n = _file.write(data, len);
+        release();
+        return n;
+    }
+
+    bool flush() override {
+        if (!acquire(SD_WRITE_TIMEOUT_MS)) return false;
+        WDT_FEED();
+        _file.flush();
+        release();
+        return true;
+    }
+
+    void close() override {
+        if (!_file) return;
+        bool locked = acquire(SD_WRITE_TIMEOUT_MS);
+        _file.close();
+        if (locked) release();
+    }
+
+private:
+    bool acquire(uint32_t timeoutMs) {
+        return !_spi || SPIBusManager::getInstance().acquire(SPI_DEV_SD, timeoutMs);
+    }
+    void release() {
+        if (_spi) SPIBusManager::getInstance().release(SPI_DEV_SD);
+    }
+
+    fs::FS* _fs = nullptr;
+    bool    _spi = false;
+    File    _file;
+};
+
+// ================================================================
+//  State
+// ================================================================
+static LogStream<PortMuxLock> s_streams[SDLOG_STREAM_COUNT];
+static FsLogSink              s_sinks[SDLOG_STREAM_COUNT];
+static TaskHandle_t           s_task = nullptr;
+static fs::FS*                s_fs = nullptr;
+static bool                   s_sharedSpi = false;
+static SemaphoreHandle_t      s_serviceMutex = nullptr;   // one service pass at a time
+static volatile bool          s_forceFlush = false;
+static uint32_t               s_segDay[SDLOG_STREAM_COUNT];      // day the live file started, 0 = unknown
+static uint32_t               s_rotateRetryMs[SDLOG_STREAM_COUNT];
+static uint32_t               s_rotations = 0;
+
+static inline uint32_t nowMs() {
+    return (uint32_t)(esp_timer_get_time() / 1000);
+}
+
+static uint32_t clockUs() {
+    return (uint32_t)esp_timer_get_time();
+}
+
+static uint8_t* allocRing(uint32_t bytes) {
+    uint8_t* p = (uint8_t*)heap_caps_malloc(bytes, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    if (!p) p = (uint8_t*)heap_caps_malloc(bytes / 4, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    return p;
+}
+
+// Local day of the file's last write, 0 if missing or written before NTP
+static uint32_t fileDay(fs::FS& fs, const char* path) {
+    if (!path || !sdLogLockBus(SD_OPEN_TIMEOUT_MS)) return 0;
+    File f = fs.open(path, FILE_READ);
+    time_t t = f ? f.getLastWrite() : 0;
+    if (f) f.close();
+    sdLogUnlockBus();
+    if (t < 1000000000) return 0;
+    struct tm tm;
+    localtime_r(&t, &tm);
+    return retention::daysFromCivil(tm.tm_year + 1900, tm.tm_mon + 1, tm.tm_mday);
+}
+
+// Close at a record boundary, rename to <stem>-<day>-<part>.<ext>; the
+// next service() opens a fresh live file (header included). Runs only
+// in the service pass.
+static void rotateIfDue(uint8_t i, uint32_t now) {
+    LogStream<PortMuxLock>& st = s_streams[i];
+    if (!STREAM_DEFS[i].rotate || !st.isOpen() || (int32_t)(now - s_rotateRetryMs[i]) < 0) return;
+    uint32_t today = logRetentionToday();
+    if (s_segDay[i] == 0) s_segDay[i] = today;                   // adopt once the clock is set
+    RotationPolicy pol = { SDLOG_ROTATE_BYTES, true };
+    if (!retention::rotateDue(pol, st.fileBytes(), s_segDay[i], today)) return;
+
+    char base[LogStream<PortMuxLock>::PATH_MAX_LEN];
+    char seg[LogStream<PortMuxLock>::PATH_MAX_LEN + 16];
+    strncpy(base, st.path(), sizeof(base));
+    if (!st.closeAtRecord(now)) return;                          // write failed: retried on reopen
+    bool ok = false;
+    if (sdLogLockBus(SD_WRITE_TIMEOUT_MS)) {
+        for (uint16_t part = 0; part < 100 && !ok; part++) {
+            if (!retention::segmentPath(base, s_segDay[i], part, seg, sizeof(seg))) break;
+            if (s_fs->exists(seg)) continue;
+            ok = s_fs->rename(base, seg);
+            break;
+        }
+        sdLogUnlockBus();
+    }
+    if (!ok) {
+        s_rotateRetryMs[i] = now + SDLOG_REOPEN_RETRY_MS * 30;
+        Serial.printf("[SdLog] rotate %s failed, keeps appending\n", base);
+        return;
+    }
+    s_segDay[i] = today;
+    s_rotations++;
+    logRetentionRequest();
+}
+
+static void servicePass(bool force) {
+    uint32_t now = nowMs();
+    for (uint8_t i = 0; i < SDLOG_STREAM_COUNT; i++) {
+        s_streams[i].service(now, force);
+        rotateIfDue(i, now);
+    }
+}
+
+static void sdLogTask(void*) {
+    for (;;) {
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(SDLOG_TICK_MS));
+        bool force = s_forceFlush;
+        s_forceFlush = false;
+        if (xSemaphoreTake(s_serviceMutex, pdMS_TO_TICKS(SD_WRITE_TIMEOUT_MS)) == pdTRUE) {
+            servicePass(force);
+            xSemaphoreGive(s_serviceMutex);
+        }
+        WDT_FEED();
+    }
+}
+
+// ================================================================
+//  API
+// ================================================================
+void initSdLogService(fs::FS& fs, bool sharedSpi) {
+    if (s_task) return;
+
+    s_serviceMutex = xSemaphoreCreateMutex();
+    if (!s_serviceMutex) {
+        Serial.println("[SdLog] mutex alloc failed, SD logging disabled");
+        return;
+    }
+
+    if (!sharedSpi && !fs.exists("/logs")) fs.mkdir("/logs");   // SafeSDManager does this for SD
+    s_fs = &fs;
+    s_sharedSpi = sharedSpi;
+
+    LogWriteParams params;
+    params.blockSize       = SDLOG_BLOCK_SIZE;
+    params.maxWritePerTick = SDLOG_MAX_WRITE_PER_TICK;
+    params.syncIntervalMs  = SDLOG_SYNC_INTERVAL_MS;
+    params.reopenRetryMs   = SDLOG_REOPEN_RETRY_MS;
+    params.clockUs         = clockUs;
+
+    uint32_t total = 0;
+    for (uint8_t i = 0; i < SDLOG_STREAM_COUNT; i++) {
+        const SdLogStreamDef& d = STREAM_DEFS[i];
+        uint8_t* ring = allocRing(d.ringBytes);
+        uint32_t cap = ring == nullptr ? 0
+                     : esp_ptr_external_ram(ring) ? d.ringBytes : d.ringBytes / 4;
+        s_sinks[i].attach(&fs, sharedSpi);
+        s_streams[i].begin(&s_sinks[i], ring, cap, d.path, d.header, d.maxAgeMs, params);
+        s_segDay[i] = d.rotate ? fileDay(fs, d.path) : 0;
+        total += cap;
+    }
+
+    xTaskCreatePinnedToCore(sdLogTask, "SdLog", SDLOG_TASK_STACK, nullptr, 1, &s_task, 0);
+
+    Serial.printf("[SdLog] write-behind started: %u streams, %lu bytes buffered, %u B blocks\n",
+                  SDLOG_STREAM_COUNT, total, SDLOG_BLOCK_SIZE);
+}
+
+bool sdLogReady() {
+    return s_task != nullptr;
+}
+
+bool sdLogAppend(SdLogStream s, const char* line) {
+    if (!s_task || s >= SDLOG_STREAM_COUNT || !line) return false;
+    bool ok = s_streams[s].append(line, nowMs());
+    // Wake the writer early once a full block is waiting
+    if (ok && s_streams[s].buffered() >= SDLOG_BLOCK_SIZE) xTaskNotifyGive(s_task);
+    return ok;
+}
+
+bool sdLogAppendRaw(SdLogStream s, const void* data, size_t len) {
+    if (!s_task || s >= SDLOG_STREAM_COUNT || !data) return false;
+    bool ok = s_streams[s].appendRaw(data, len, nowMs());
+    if (ok && s_streams[s].buffered() >= SDLOG_BLOCK_SIZE) xTaskNotifyGive(s_task);
+    return ok;
+}
+
+bool sdLogPrintf(SdLogStream s, const char* fmt, ...) {
+    char line[256];
+    va_list args;
+    va_start(args, fmt);
+    vsnprintf(line, sizeof(line), fmt, args);
+    va_end(args);
+    return sdLogAppend(s, line);
+}
+
+void sdLogSetPath(SdLogStream s, const char* path) {
+    if (s >= SDLOG_STREAM_COUNT) return;
+    s_streams[s].setPath(path);
+}
+
+void sdLogFlushAll() {
+    if (!s_task) return;
+    s_forceFlush = true;
+    xTaskNotifyGive(s_task);
+}
+
+void sdLogCloseAll() {
+    if (!s_task) return;
+    if (xSemaphoreTake(s_serviceMutex, pdMS_TO_TICKS(2000)) != pdTRUE) {
+        Serial.println("[SdLog] close: writer busy, buffered records may be lost");
+        return;
+    }
+    servicePass(true);
+    for (uint8_t i = 0; i < SDLOG_STREAM_COUNT; i++) s_streams[i].close();
+    xSemaphoreGive(s_serviceMutex);
+}
+
+fs::FS* sdLogFs() {
+    return s_fs;
+}
+
+bool sdLogLockBus(uint32_t timeoutMs) {
+    if (s_sharedSpi && !SafeSDFile::_sdReady) return false;
+    return !s_sharedSpi || SPIBusManager::getInstance().acquire(SPI_DEV_SD, timeoutMs);
+}
+
+void sdLogUnlockBus() {
+    if (s_sharedSpi) SPIBusManager::getInstance().release(SPI_DEV_SD);
+}
+
+LogStreamStats getSdLogStats(SdLogStream s) {
+    if (s >= SDLOG_STREAM_COUNT) return LogStreamStats();
+    return s_streams[s].stats();
+}
+
+void resetSdLogStats() {
+    for (uint8_t i = 0; i < SDLOG_STREAM_COUNT; i++) s_streams[i].resetStats();
+}
+
+void printSdLogStats() {
+    Serial.println("\n=== SD write-behind ===");
+    if (!s_task) {
+        Serial.println("not started (no SD)");
+        return;
+    }
+    Serial.printf("Block %u B, max age %u/%u ms, sync %u ms\n",
+                  SDLOG_BLOCK_SIZE, SDLOG_MAX_AGE_MS, SDLOG_MAX_AGE_ERROR_MS, SDLOG_SYNC_INTERVAL_MS);
+    Serial.printf("Rotation: daily or %lu KB, %lu rotations\n", SDLOG_ROTATE_BYTES >> 10, s_rotations);
+    for (uint8_t i = 0; i < SDLOG_STREAM_COUNT; i++) {
+        LogStreamStats st = s_streams[i].stats();
+        Serial.printf("%-9s %s %s\n", STREAM_DEFS[i].name,
+                      s_streams[i].isOpen() ? "open  " : "closed",
+                      s_streams[i].path()[0] ? s_streams[i].path() : "-");
+        Serial.printf("          rec %lu, dropped %lu, buf %lu/%lu (peak %lu)\n",
+                      st.records, st.dropped, st.buffered, st.capacity, st.highWater);
+        Serial.printf("          %lu B written, %lu B/s, %lu writes, %lu syncs, %lu opens, %lu errors\n",
+                      st.bytesWritten, st.bytesPerSec, st.writes, st.syncs, st.opens, st.errors);
+        Serial.printf("          flush last %lu us, worst %lu us\n", st.lastFlushUs, st.maxFlushUs);
+    }
+}
@@ -4,6 +4,12 @@
 
 #include "Sensor.h"
 #include "Config.h"
+#include "AdcStream.h"
+#include "AdditionalHardening.h"   // ADC_CONTROL_WAIT_TICKS
+#include "SafeSensor.h"
+#include "SafetyIsr.h"
+#include "Seqlock.h"
+#include <esp_timer.h>
 #include <Arduino.h>
 
 // FreeRTOS (delay )
@@ -23,6 +29,42 @@ static float pressureOffset = 0.0f;
 static float currentOffset = 0.0f;
 static float temperatureOffset = 0.0f;
 
+// ================================================================
+//  Single acquisition point (SensorRead task)
+// ================================================================
+static SensorFrame          s_frame = {};       // owned by the SensorRead task
+static Seqlock<SensorFrame> s_publishedFrame;   // copy for other tasks
+
+// Legacy mirror of the latest frame for modules that still read the global
+SensorData sensorData = {};
+
+// Acquisition counters (see getSensorAcqStats)
+static volatile uint32_t s_channelReads = 0;
+static volatile uint32_t s_oneShotConversions = 0;
+static volatile uint32_t s_staleReads = 0;
+
+// Stream stale or stopped. While it runs this is its last raw value
+// (ADC1 stays with the stream); 0 before the first frame.
+static int oneShotRead(uint8_t pin) {
+    s_oneShotConversions = s_oneShotConversions + 1;
+    int raw = adcOneShotRead(pin);
+    return raw < 0 ? 0 : raw;
+}
+
+// Control path (PIDLoop, priority configMAX-2): never waits behind a
+// lower-priority holder of the ADC mutex. Busy -> false, the caller
+// keeps its last value and the read is counted as stale.
+static bool controlRead(uint8_t pin, float& units, const AdcCalibration& cal) {
+    s_oneShotConversions = s_oneShotConversions + 1;
+    int raw = adcOneShotRead(pin, ADC_CONTROL_WAIT_TICKS);
+    if (raw == ADC_ONESHOT_BUSY) {
+        s_staleReads = s_staleReads + 1;
+        return false;
+    }
+    units = cal.toUnits((float)(raw < 0 ? 0 : raw));
+    return true;
+}
+
 // ================================================================
 //  
 // ================================================================
@@ -37,6 +79,12 @@ void initSensors() {
     pinMode(PIN_LIMIT_SWITCH,    INPUT_PULLUP);
     pinMode(PIN_PHOTO_SENSOR,    INPUT_PULLUP);
     pinMode(PIN_EMERGENCY_STOP,  INPUT_PULLUP);
+    initSafetyIsr();   // edge interrupts on the three inputs above
+    
+    // Pressure/current: continuous DMA acquisition (one-shot fallback)
+    if (!adcStreamBegin(PIN_PRESSURE_SENSOR, PIN_CURRENT_SENSOR)) {
+        Serial.println("[Sensor] ADC stream unavailable, using one-shot reads");
+    }
     
     // DS18B20   
     tempSensor.begin();
@@ -98,32 +146,35 @@ float readTemperature() {
 //   ()
 // ================================================================
 float readPressure() {
-    int rawValue = analogRead(PIN_PRESSURE_SENSOR);
+    s_channelReads = s_channelReads + 1;
     
-    // ADC  (kPa) 
-    // ESP32-S3: 12 ADC (0-4095)
-    // : 0-3.3V  0-200 kPa
-    float voltage = (rawValue / 4095.0f) * 3.3f;
-    float pressure = (voltage / 3.3f) * 200.0f;  //    
+    // Latest decimated frame; no conversion is triggered here
+    AdcFrame frame;
+    if (adcStreamLatest(frame)) {
+        return frame.pressure + pressureOffset;
+    }
     
-    return pressure + pressureOffset;
+    // ESP32-S3: 12 ADC (0-4095), 0-3.3V  0-200 kPa
+    static float last = 0.0f;
+    controlRead(PIN_PRESSURE_SENSOR, last, ADC_CAL_PRESSURE);
+    return last + pressureOffset;
 }
 
 // ================================================================
 //   ()
 // ================================================================
 float readCurrent() {
-    int rawValue = analogRead(PIN_CURRENT_SENSOR);
-    
-    // ADC  (A) 
-    // : ACS712-30A  (2.5V = 0A, 66mV/A)
-    float voltage = (rawValue / 4095.0f) * 3.3f;
-    float current = (voltage - 1.65f) / 0.066f;
+    s_channelReads = s_channelReads + 1;
     
-    //    
-    if (current < 0) current = -current;
+    AdcFrame frame;
+    if (adcStreamLatest(frame)) {
+        return frame.current + currentOffset;
+    }
     
-    return current + currentOffset;
+    // : ACS712-30A  (1.65V = 0A, 66mV/A),   
+    static float last = 0.0f;
+    controlRead(PIN_CURRENT_SENSOR, last, ADC_CAL_CURRENT);
+    return last + currentOffset;
 }
 
 // ================================================================
@@ -144,18 +195,81 @@ bool readEmergencyStop() {
 // ================================================================
 //   
 // ================================================================
-void readSensors() {
-    //    
-    float temp = readTemperature();
-    float press = readPressure();
-    float curr = readCurrent();
-    bool limit = readLimitSwitch();
-    bool photo = readPhotoSensor();
-    bool estop = readEmergencyStop();
-    
-    //   ( )
-    // Serial.printf("T:%.2f P:%.2f C:%.2f L:%d Ph:%d E:%d\n", 
-    //               temp, press, curr, limit, photo, estop);
+const SensorFrame& readSensors() {
+    SensorFrame f;
+    f.seq = s_frame.seq + 1;
+    f.timestampUs = (uint64_t)esp_timer_get_time();
+    
+    // Pressure and current from the same ADC frame
+    AdcFrame adc;
+    s_channelReads = s_channelReads + 2;
+    if (adcStreamLatest(adc)) {
+        f.pressure = adc.pressure + pressureOffset;
+        f.current  = adc.current + currentOffset;
+        f.adcSeq   = adc.seq;
+    } else {
+        f.pressure = ADC_CAL_PRESSURE.toUnits((float)oneShotRead(PIN_PRESSURE_SENSOR)) + pressureOffset;
+        f.current  = ADC_CAL_CURRENT.toUnits((float)oneShotRead(PIN_CURRENT_SENSOR)) + currentOffset;
+        f.adcSeq   = 0;
+    }
+    
+    // [9] DS18B20 is polled by its own task; readTemperature() only as fallback
+    f.temperature   = safeDS18B20.isPresent() ? safeDS18B20.getTemperature() : readTemperature();
+    f.limitSwitch   = readLimitSwitch();
+    f.photoSensor   = readPhotoSensor();
+    f.emergencyStop = readEmergencyStop();
+    
+    s_frame = f;
+    s_publishedFrame.write(f);
+    sensorData = { f.pressure, f.current, f.temperature,
+                   f.limitSwitch, f.photoSensor, f.emergencyStop,
+                   (uint32_t)(f.timestampUs / 1000) };
+    return s_frame;
+}
+
+SensorFrame latestSensorFrame() {
+    return s_publishedFrame.read();
+}
+
+// ================================================================
+//  Acquisition rates
+// ================================================================
+SensorAcqStats getSensorAcqStats() {
+    static uint64_t lastUs = 0;
+    static uint32_t lastFrames = 0, lastReads = 0, lastOneShot = 0, lastStream = 0;
+    
+    uint64_t nowUs   = (uint64_t)esp_timer_get_time();
+    uint32_t frames  = s_publishedFrame.version();
+    uint32_t reads   = s_channelReads;
+    uint32_t oneShot = s_oneShotConversions;
+    uint32_t stream  = adcStreamGetStats().samples;
+    
+    SensorAcqStats st = {};
+    st.staleReads = s_staleReads;
+    if (lastUs != 0 && nowUs > lastUs) {
+        float dt = (float)(nowUs - lastUs) / 1000000.0f;
+        st.framesPerSec        = (frames - lastFrames) / dt;
+        st.channelReadsPerSec  = (reads - lastReads) / dt;
+        st.oneShotPerSec       = (oneShot - lastOneShot) / dt;
+        st.streamSamplesPerSec = (stream - lastStream) / dt;
+    }
+    lastUs = nowUs;
+    lastFrames = frames;
+    lastReads = reads;
+    lastOneShot = oneShot;
+    lastStream = stream;
+    return st;
+}
+
+void printSensorAcqStats() {
+    SensorAcqStats st = getSensorAcqStats();
+    Serial.println("\n[Sensor] === Acquisition rates ===");
+    Serial.printf("[Sensor] frames/s        : %.1f\n", st.framesPerSec);
+    Serial.printf("[Sensor] channel reads/s : %.1f\n", st.channelReadsPerSec);
+    Serial.printf("[Sensor] one-shot conv/s : %.1f\n", st.oneShotPerSec);
+    Serial.printf("[Sensor] DMA samples/s   : %.1f\n", st.streamSamplesPerSec);
+    Serial.printf("[Sensor] stale (ADC busy): %lu\n", st.staleReads);
+    Serial.println("[Sensor] (rates since the previous call)\n");
 }
 
 // ================================================================
@@ -168,11 +282,9 @@ void calibratePressure() {
     vTaskDelay(pdMS_TO_TICKS(2000));  // 2 
     
     float sum = 0;
+    pressureOffset = 0.0f;
     for (int i = 0; i < 10; i++) {
-        int raw = analogRead(PIN_PRESSURE_SENSOR);
-        float voltage = (raw / 4095.0f) * 3.3f;
-        float pressure = (voltage / 3.3f) * 200.0f;
-        sum += pressure;
+        sum += readPressure();
         vTaskDelay(pdMS_TO_TICKS(100));
     }
     
@@ -188,11 +300,9 @@ void calibrateCurrent() {
     vTaskDelay(pdMS_TO_TICKS(2000));  // 2 
     
     float sum = 0;
+    currentOffset = 0.0f;
     for (int i = 0; i < 10; i++) {
-        int raw = analogRead(PIN_CURRENT_SENSOR);
-        float voltage = (raw / 4095.0f) * 3.3f;
-        float current = abs((voltage - 1.65f) / 0.066f);
-        sum += current;
+        sum += readCurrent();
         vTaskDelay(pdMS_TO_TICKS(100));
     }
     
@@ -214,6 +324,10 @@ void calibrateTemperature() {
 //   
 // ================================================================
 void checkSensorHealth() {
+    checkSensorHealth(latestSensorFrame());
+}
+
+void checkSensorHealth(const SensorFrame& frame) {
     bool healthy = true;
     
     Serial.println("\n[Sensor] ===    ===");
@@ -223,12 +337,11 @@ void checkSensorHealth() {
         Serial.println("[Sensor]     !");
         healthy = false;
     } else {
-        float temp = readTemperature();
-        Serial.printf("[Sensor]   : %.2fC\n", temp);
+        Serial.printf("[Sensor]   : %.2fC\n", frame.temperature);
     }
     
     //   
-    float pressure = readPressure();
+    float pressure = frame.pressure;
     if (pressure < -50.0f || pressure > 300.0f) {
         Serial.printf("[Sensor]    : %.2f kPa\n", pressure);
         healthy = false;
@@ -237,7 +350,7 @@ void checkSensorHealth() {
     }
     
     //   
-    float current = readCurrent();
+    float current = frame.current;
     if (current < 0 || current > 50.0f) {
         Serial.printf("[Sensor]    : %.2f A\n", current);
         healthy = false;
@@ -246,9 +359,9 @@ void checkSensorHealth() {
     }
     
     //  
-    Serial.printf("[Sensor]   : %s\n", readLimitSwitch() ? "" : "");
-    Serial.printf("[Sensor]   : %s\n", readPhotoSensor() ? "" : "");
-    Serial.printf("[Sensor]  : %s\n", readEmergencyStop() ? "" : "");
+    Serial.printf("[Sensor]   : %s\n", frame.limitSwitch ? "" : "");
+    Serial.printf("[Sensor]   : %s\n", frame.photoSensor ? "" : "");
+    Serial.printf("[Sensor]  : %s\n", frame.emergencyStop ? "" : "");
     
     if (healthy) {
         Serial.println("[Sensor] ===    ===\n");
@@ -258,9 +371,13 @@ void checkSensorHealth() {
 }
 
 bool validateParameters() {
-    float temp = readTemperature();
-    float press = readPressure();
-    float curr = readCurrent();
+    return validateParameters(latestSensorFrame());
+}
+
+bool validateParameters(const SensorFrame& frame) {
+    float temp = frame.temperature;
+    float press = frame.pressure;
+    float curr = frame.current;
     
     //   
     bool tempOK = (temp > -10.0f && temp < 80.0f);
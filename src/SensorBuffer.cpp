@@ -5,31 +5,24 @@
 // ================================================================
 //   
 // ================================================================
-RingBuffer<float, TEMP_BUFFER_SIZE> temperatureBuffer;
-RingBuffer<float, PRESSURE_BUFFER_SIZE> pressureBuffer;
-RingBuffer<float, CURRENT_BUFFER_SIZE> currentBuffer;
+WindowStats<TEMP_BUFFER_SIZE> temperatureBuffer;
+WindowStats<PRESSURE_BUFFER_SIZE> pressureBuffer;
+WindowStats<CURRENT_BUFFER_SIZE> currentBuffer;
 RingBuffer<SensorData, SENSOR_DATA_BUFFER_SIZE> sensorDataBuffer;
 
 // ================================================================
 //    
 // ================================================================
-void updateSensorBuffers() {
+void updateSensorBuffers(const SensorFrame& frame) {
     //   
-    float temperature = readTemperature();
-    float pressure = readPressure();
-    float current = readCurrent();
-    bool limitSwitch = readLimitSwitch();
-    bool photoSensor = readPhotoSensor();
-    bool emergencyStop = readEmergencyStop();
-    uint32_t timestamp = millis();
-    
-    //   
-    temperatureBuffer.push(temperature);
-    pressureBuffer.push(pressure);
-    currentBuffer.push(current);
+    temperatureBuffer.push(frame.temperature);
+    pressureBuffer.push(frame.pressure);
+    currentBuffer.push(frame.current);
     
     //     
-    SensorData data = {pressure, current, temperature, limitSwitch, photoSensor, emergencyStop, timestamp};
+    SensorData data = {frame.pressure, frame.current, frame.temperature,
+                       frame.limitSwitch, frame.photoSensor, frame.emergencyStop,
+                       (uint32_t)(frame.timestampUs / 1000)};
     sensorDataBuffer.push(data);
 }
 
@@ -37,32 +30,46 @@ void updateSensorBuffers() {
 //  
 // ================================================================
 void calculateSensorStats(SensorStats& stats) {
-    stats.avgTemperature = temperatureBuffer.getAverage();
-    stats.maxTemperature = temperatureBuffer.getMax();
-    stats.minTemperature = temperatureBuffer.getMin();
-    stats.tempStdDev = temperatureBuffer.getStdDev();
+    // One O(1) snapshot per channel instead of four window scans
+    WindowSummary t = temperatureBuffer.summary();
+    WindowSummary p = pressureBuffer.summary();
+    WindowSummary c = currentBuffer.summary();
+
+    stats.avgTemperature = t.mean;
+    stats.maxTemperature = t.max;
+    stats.minTemperature = t.min;
+    stats.tempStdDev = t.stdDev;
     
-    stats.avgPressure = pressureBuffer.getAverage();
-    stats.maxPressure = pressureBuffer.getMax();
-    stats.minPressure = pressureBuffer.getMin();
-    stats.pressureStdDev = pressureBuffer.getStdDev();
+    stats.avgPressure = p.mean;
+    stats.maxPressure = p.max;
+    stats.minPressure = p.min;
+    stats.pressureStdDev = p.stdDev;
     
-    stats.avgCurrent = currentBuffer.getAverage();
-    stats.maxCurrent = currentBuffer.getMax();
-    stats.minCurrent = currentBuffer.getMin();
-    stats.currentStdDev = currentBuffer.getStdDev();
+    stats.avgCurrent = c.mean;
+    stats.maxCurrent = c.max;
+    stats.minCurrent = c.min;
+    stats.currentStdDev = c.stdDev;
     
-    stats.sampleCount = temperatureBuffer.size();
+    stats.sampleCount = t.count;
 }
 
 // ================================================================
 //  
 // ================================================================
+// Any task: the SensorRead task resets the windows on its next push and
+// the DataLogger task drops the unread frames on its next drain
 void clearSensorBuffers() {
-    temperatureBuffer.clear();
-    pressureBuffer.clear();
-    currentBuffer.clear();
-    sensorDataBuffer.clear();
+    temperatureBuffer.requestClear();
+    pressureBuffer.requestClear();
+    currentBuffer.requestClear();
+    sensorDataBuffer.requestClear();
+}
+
+// ================================================================
+//  Raw frame consumer (DataLogger task only)
+// ================================================================
+size_t drainSensorData(SensorData* out, size_t maxItems) {
+    return sensorDataBuffer.drain(out, maxItems);
 }
 
 // ================================================================
@@ -86,6 +93,9 @@ void printBufferStatus() {
     Serial.printf(" : %zu/%d (%.1f%%)\n",
                   sensorDataBuffer.size(), SENSOR_DATA_BUFFER_SIZE,
                   (float)sensorDataBuffer.size() / SENSOR_DATA_BUFFER_SIZE * 100);
+    Serial.printf(" : pushed=%lu overrun=%lu\n",
+                  (unsigned long)sensorDataBuffer.pushedCount(),
+                  (unsigned long)sensorDataBuffer.overrunCount());
     
     //  
     if (temperatureBuffer.size() > 0) {
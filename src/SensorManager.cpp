@@ -29,9 +29,7 @@ void SensorManager::begin() {
     sensorData.timestamp = millis();
     
     //  
-    pressureBuffer.reserve(100);
-    temperatureBuffer.reserve(100);
-    currentBuffer.reserve(100);
+    clearBuffers();
     
     //  
     pressureOffset = 0.0f;
@@ -47,53 +45,28 @@ void SensorManager::begin() {
 //  
 // ================================================================
 void SensorManager::readAllSensors() {
-    //   
-    sensorData.pressure = readPressureSensor();
-    sensorData.current = readCurrentSensor();
-    sensorData.temperature = readTemperatureSensor();
-    sensorData.limitSwitch = readLimitSwitchSensor();
-    sensorData.photoSensor = readPhotoSensorInput();
-    sensorData.emergencyStop = readEmergencyStopInput();
-    sensorData.timestamp = millis();
-}
-
-// ================================================================
-//    
-// ================================================================
-float SensorManager::readPressureSensor() {
-    //   
-    float raw = readPressure();
-    return raw - pressureOffset;
-}
-
-float SensorManager::readCurrentSensor() {
-    float raw = readCurrent();
-    return raw - currentOffset;
-}
-
-float SensorManager::readTemperatureSensor() {
-    return readTemperature();
-}
-
-bool SensorManager::readLimitSwitchSensor() {
-    return readLimitSwitch();
+    // No conversions here: reuse the frame the SensorRead task acquired
+    applyFrame(latestSensorFrame());
 }
 
-bool SensorManager::readPhotoSensorInput() {
-    return readPhotoSensor();
-}
-
-bool SensorManager::readEmergencyStopInput() {
-    return readEmergencyStop();
+void SensorManager::applyFrame(const SensorFrame& frame) {
+    sensorData.pressure = frame.pressure - pressureOffset;
+    sensorData.current = frame.current - currentOffset;
+    sensorData.temperature = frame.temperature;
+    sensorData.limitSwitch = frame.limitSwitch;
+    sensorData.photoSensor = frame.photoSensor;
+    sensorData.emergencyStop = frame.emergencyStop;
+    sensorData.timestamp = (uint32_t)(frame.timestampUs / 1000);
+    frameSeq = frame.seq;
 }
 
 // ================================================================
 //  
 // ================================================================
 void SensorManager::updateBuffers() {
-    addToBuffer(pressureBuffer, sensorData.pressure, 100);
-    addToBuffer(temperatureBuffer, sensorData.temperature, 100);
-    addToBuffer(currentBuffer, sensorData.current, 100);
+    pressureBuffer.push(sensorData.pressure);
+    temperatureBuffer.push(sensorData.temperature);
+    currentBuffer.push(sensorData.current);
 }
 
 void SensorManager::clearBuffers() {
@@ -102,13 +75,6 @@ void SensorManager::clearBuffers() {
     currentBuffer.clear();
 }
 
-void SensorManager::addToBuffer(std::vector<float>& buffer, float value, size_t maxSize) {
-    buffer.push_back(value);
-    if (buffer.size() > maxSize) {
-        buffer.erase(buffer.begin());
-    }
-}
-
 // ================================================================
 // 
 // ================================================================
@@ -177,30 +143,16 @@ bool SensorManager::checkSensorHealth() {
 // ================================================================
 //  
 // ================================================================
-float SensorManager::calculateAverage(const std::vector<float>& buffer, uint8_t samples) {
-    if (buffer.empty()) return 0.0f;
-    
-    size_t count = min((size_t)samples, buffer.size());
-    float sum = 0.0f;
-    
-    //  N  
-    for (size_t i = buffer.size() - count; i < buffer.size(); i++) {
-        sum += buffer[i];
-    }
-    
-    return sum / count;
-}
-
 float SensorManager::getPressureAverage(uint8_t samples) {
-    return calculateAverage(pressureBuffer, samples);
+    return pressureBuffer.average(samples);
 }
 
 float SensorManager::getTemperatureAverage(uint8_t samples) {
-    return calculateAverage(temperatureBuffer, samples);
+    return temperatureBuffer.average(samples);
 }
 
 float SensorManager::getCurrentAverage(uint8_t samples) {
-    return calculateAverage(currentBuffer, samples);
+    return currentBuffer.average(samples);
 }
 
 // ================================================================
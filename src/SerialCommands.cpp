@@ -6,6 +6,16 @@
 #include "Config.h"
 #include "EnhancedWatchdog.h"
 #include "ConfigManager.h"
+#include "Sensor.h"
+#include "AdcStream.h"
+#include "PID_Control.h"
+#include "SafetyIsr.h"
+#include "SdLogService.h"
+#include "TsLogger.h"
+#include "LogRetentionService.h"
+#include "GFX_Wrapper.hpp"
+#include "UI_Screens.h"
+#include "UIManager.h"
 #include <cstring>
 #include <cctype>
 
@@ -67,7 +77,8 @@ void processSerialCommands() {
     else if (strncmp(cmd, "sensor", 6) == 0 || strncmp(cmd, "read", 4) == 0) {
         handleSensorCommands(cmd);
     }
-    else if (strncmp(cmd, "control", 7) == 0 || strncmp(cmd, "vacuum", 6) == 0 || strncmp(cmd, "pump", 4) == 0) {
+    else if (strncmp(cmd, "control", 7) == 0 || strncmp(cmd, "vacuum", 6) == 0 || strncmp(cmd, "pump", 4) == 0 ||
+             strncmp(cmd, "pid", 3) == 0) {
         handleControlCommands(cmd);
     }
     else if (strncmp(cmd, "debug", 5) == 0 || strncmp(cmd, "test", 4) == 0) {
@@ -100,6 +111,7 @@ void handleSystemCommands(const char* cmd) {
     }
     else if (strcmp(cmd, "sys_restart") == 0 || strcmp(cmd, "restart") == 0 || strcmp(cmd, "reboot") == 0) {
         Serial.println("  ...");
+        sdLogCloseAll();
         vTaskDelay(pdMS_TO_TICKS(1000));
         ESP.restart();
     }
@@ -357,6 +369,10 @@ void handleSensorCommands(const char* cmd) {
         Serial.printf(" : %.2f A                          \n", sensorData.current);
         Serial.println("\n");
     }
+    else if (strcmp(cmd, "sensor_rate") == 0) {
+        printSensorAcqStats();
+        printAdcStreamStatus();
+    }
     else {
         Serial.println("     ");
     }
@@ -377,6 +393,58 @@ void handleControlCommands(const char* cmd) {
         Serial.printf(" : %s                              \n", valveActive ? " ON" : " OFF");
         Serial.println("\n");
     }
+    else if (strcmp(cmd, "pid_timing") == 0) {
+        printPidTiming();
+    }
+    else if (strcmp(cmd, "pid_timing_reset") == 0) {
+        resetPidTiming();
+        Serial.println("[PID] timing histograms cleared");
+    }
+    else if (strcmp(cmd, "estop_latency") == 0) {
+        printSafetyLatency();
+    }
+    else if (strcmp(cmd, "estop_latency_reset") == 0) {
+        resetSafetyLatency();
+        Serial.println("[Safety] E-stop latency record cleared");
+    }
+    else if (strcmp(cmd, "sdlog") == 0) {
+        printSdLogStats();
+    }
+    else if (strcmp(cmd, "sdlog_flush") == 0) {
+        sdLogFlushAll();
+        Serial.println("[SdLog] flush requested");
+    }
+    else if (strcmp(cmd, "sdlog_reset") == 0) {
+        resetSdLogStats();
+        Serial.println("[SdLog] statistics cleared");
+    }
+    else if (strcmp(cmd, "tslog") == 0) {
+        printTsLogStats();
+    }
+    else if (strcmp(cmd, "tslog_export") == 0) {
+        // Last 24 h of the binary history as CSV
+        uint64_t now = tsLogNowMs();
+        tsLogExportCsv("/logs/trend_export.csv", now > 86400000ULL ? now - 86400000ULL : 0, now);
+    }
+    else if (strcmp(cmd, "logret") == 0) {
+        printLogRetentionStats();
+    }
+    else if (strcmp(cmd, "logret_run") == 0) {
+        logRetentionRequest();
+        Serial.println("[LogRet] pass requested");
+    }
+    else if (strcmp(cmd, "gfx") == 0) {
+        tft.printFlushStats();
+        tft.resetFlushStats();
+    }
+    else if (strcmp(cmd, "ui") == 0) {
+        printMainScreenStats();
+        resetMainScreenStats();
+        uiManager.printStatus();
+    }
+    else if (strcmp(cmd, "touch") == 0) {
+        printTouchStats();
+    }
     else {
         Serial.println("     ");
     }
@@ -446,6 +514,15 @@ void showHelp() {
     Serial.println("                                                   ");
     Serial.println("  /                                       ");
     Serial.println("   sensor_read    -                      ");
+    Serial.println("   sensor_rate    - ADC / acquisition rates          ");
+    Serial.println("   pid_timing     - PID loop jitter / exec time      ");
+    Serial.println("   estop_latency  - E-stop edge -> outputs safe      ");
+    Serial.println("   sdlog          - SD write-behind rates / latency  ");
+    Serial.println("   tslog          - binary trend log size / 1 h query");
+    Serial.println("   logret         - log rotation / SD budget pruner  ");
+    Serial.println("   gfx            - display flush bytes / rects / time");
+    Serial.println("   ui             - main screen widget repaints, screen switch time");
+    Serial.println("   touch          - touch INT edges / I2C reads / gestures");
     Serial.println("   control_status -                        ");
     Serial.println("                                                   ");
     Serial.println("                                            ");
@@ -12,6 +12,7 @@
 #include <freertos/FreeRTOS.h>
 #include <freertos/task.h>
 #include "SensorManager.h"  // SensorManager 
+#include "Buzzer.h"
 
 //  
 SmartAlert smartAlert;
@@ -208,9 +209,7 @@ void SmartAlert::sendErrorAlert(ErrorCode error, const char* message) {
     
     //  ()
     if (config.buzzerEnabled) {
-        digitalWrite(PIN_BUZZER, HIGH);
-        vTaskDelay(pdMS_TO_TICKS(1000));
-        digitalWrite(PIN_BUZZER, LOW);
+        buzzerPlay(BZ_PAT_ALERT_ERROR);
     }
     
     // 
@@ -254,23 +253,12 @@ void SmartAlert::sendBuzzerAlert(MaintenanceLevel level) {
     switch (level) {
         case MAINTENANCE_REQUIRED:
             //   2
-            digitalWrite(PIN_BUZZER, HIGH);
-            vTaskDelay(pdMS_TO_TICKS(100));
-            digitalWrite(PIN_BUZZER, LOW);
-            vTaskDelay(pdMS_TO_TICKS(100));
-            digitalWrite(PIN_BUZZER, HIGH);
-            vTaskDelay(pdMS_TO_TICKS(100));
-            digitalWrite(PIN_BUZZER, LOW);
+            buzzerPlay(BZ_PAT_MAINT_REQUIRED);
             break;
             
         case MAINTENANCE_URGENT:
             //   3
-            for (int i = 0; i < 3; i++) {
-                digitalWrite(PIN_BUZZER, HIGH);
-                vTaskDelay(pdMS_TO_TICKS(300));
-                digitalWrite(PIN_BUZZER, LOW);
-                vTaskDelay(pdMS_TO_TICKS(200));
-            }
+            buzzerPlay(BZ_PAT_MAINT_URGENT);
             break;
             
         default:
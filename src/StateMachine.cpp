@@ -5,10 +5,10 @@
 // - [K3] Mutex / 
 // -    (Mutex )
 // -   100% 
+// - Table-driven and event-driven (VacuumStateTable.h): sensor edges,
+//   state timers and commands post events; no polling between them
 // ================================================================
 #include "Config.h"
-#include "SensorManager.h"
-extern SensorManager sensorManager;
 
 #include "StateMachine.h"
 #include "Control.h"
@@ -17,6 +17,12 @@ extern SensorManager sensorManager;
 #include "SD_Logger.h"
 #include "Trend_Graph.h"
 #include "Lang.h"
+#include "Sensor.h"
+#include "VacuumStateTable.h"
+#include "Buzzer.h"
+
+#include <esp_timer.h>
+#include <freertos/queue.h>
 
 // v3.9:  
 #ifdef ENABLE_VOICE_ALERTS
@@ -34,178 +40,216 @@ static uint8_t holdExtensionCount = 0;
 // [K3]   Mutex (/   )
 static SemaphoreHandle_t g_stateMutex = nullptr;
 
-//     
-void updateStateMachine() {
-  uint32_t elapsedTime = millis() - stateStartTime;
+// ================================================================
+//  Event-driven dispatch (VacuumStateTable.h)
+// ================================================================
+//  Sensor edges (stateMachineOnFrame), one-shot state timers and
+//  commands post to s_eventQueue; updateStateMachine() blocks on it,
+//  so nothing is evaluated between events.
+static constexpr uint32_t COMPLETE_DWELL_MS   = 1000;
+static constexpr UBaseType_t SM_QUEUE_DEPTH   = 32;
 
-  //   (NC : LOW = )
-  if (!sensorManager.getEmergencyStop()) {
-    changeState(STATE_EMERGENCY_STOP);
-    return;
+struct SmQueuedEvent {
+  SmEvent  event;
+  uint32_t gen;          // SM_EV_TIMEOUT: timer generation at expiry
+};
+
+static QueueHandle_t      s_eventQueue  = nullptr;
+static esp_timer_handle_t s_stateTimer  = nullptr;
+static volatile uint32_t  s_timerGen    = 0;      // bumped on every re-arm
+static volatile int64_t   s_timerDueUs  = 0;
+static volatile bool      s_rearmEdges  = true;   // set by changeState(), SensorRead task consumes
+static volatile uint32_t  s_eventsDropped = 0;
+static SmEdgeDetector     s_edges;                // SensorRead task only
+
+// Safety events jump the queue
+static inline bool IRAM_ATTR isUrgentEvent(SmEvent ev) {
+  return ev <= SM_EV_TEMP_CRITICAL || ev == SM_EV_CMD_ESTOP;
+}
+
+static void enqueueEvent(const SmQueuedEvent& q) {
+  if (s_eventQueue == nullptr) return;
+  BaseType_t ok = isUrgentEvent(q.event) ? xQueueSendToFront(s_eventQueue, &q, 0)
+                                         : xQueueSendToBack(s_eventQueue, &q, 0);
+  if (ok != pdTRUE) s_eventsDropped = s_eventsDropped + 1;
+}
+
+void postStateEvent(SmEvent ev) {
+  SmQueuedEvent q = { ev, 0 };
+  enqueueEvent(q);
+}
+
+// GPIO ISR (SafetyIsr.cpp): IRAM, never blocks
+void IRAM_ATTR postStateEventFromISR(SmEvent ev, BaseType_t* woken) {
+  if (s_eventQueue == nullptr) return;
+  SmQueuedEvent q = { ev, 0 };
+  BaseType_t ok = isUrgentEvent(ev) ? xQueueSendToFrontFromISR(s_eventQueue, &q, woken)
+                                    : xQueueSendToBackFromISR(s_eventQueue, &q, woken);
+  if (ok != pdTRUE) s_eventsDropped = s_eventsDropped + 1;
+}
+
+static void stateTimerCallback(void*) {
+  // esp_timer task context
+  SmQueuedEvent q = { SM_EV_TIMEOUT, s_timerGen };
+  enqueueEvent(q);
+}
+
+// Restart the state timer; 0 = no timeout in this state. A TIMEOUT
+// already queued by the previous arm is dropped by its generation.
+static void armStateTimer(uint32_t ms) {
+  if (s_stateTimer == nullptr) return;
+  esp_timer_stop(s_stateTimer);
+  s_timerGen = s_timerGen + 1;
+  if (ms == 0) return;
+  s_timerDueUs = esp_timer_get_time() + (int64_t)ms * 1000;
+  esp_timer_start_once(s_stateTimer, (uint64_t)ms * 1000ULL);
+}
+
+static uint32_t stateTimeoutMs(SystemState state) {
+  switch (state) {
+    case STATE_VACUUM_ON:    return currentMode == MODE_AUTO ? config.vacuumOnTime : 0;
+    case STATE_VACUUM_HOLD:  return config.vacuumHoldTime;
+    case STATE_VACUUM_BREAK: return config.vacuumBreakTime;
+    case STATE_WAIT_REMOVAL: return config.waitRemovalTime;
+    case STATE_COMPLETE:     return COMPLETE_DWELL_MS;
+    default:                 return 0;
   }
+}
 
-  //  
-  if (sensorManager.getCurrent() > CURRENT_THRESHOLD_CRITICAL) {
-    setError(ERROR_OVERCURRENT, SEVERITY_CRITICAL, " ");
-    changeState(STATE_ERROR);
-    return;
+// ================================================================
+//  Sensor frame -> events (SensorRead task)
+// ================================================================
+void stateMachineOnFrame(const SensorFrame& frame) {
+  if (s_rearmEdges) {
+    s_rearmEdges = false;
+    s_edges.rearm();
   }
 
-  //    (v3.5) 
-  if (config.tempSensorEnabled) {
-    //    (70C)
-    if (sensorManager.getTemperature() >= config.tempShutdown) {
-      setError(ERROR_OVERHEAT, SEVERITY_CRITICAL, " -  ");
-      changeState(STATE_EMERGENCY_STOP);
-      return;
-    }
-    
-    //   (60C) -   
-    if (sensorManager.getTemperature() >= config.tempCritical) {
-      setError(ERROR_OVERHEAT, SEVERITY_RECOVERABLE, " -  ");
-      changeState(STATE_ERROR);
-      return;
-    }
-    
-    //   (50C) -  +  
-    if (sensorManager.getTemperature() >= config.tempWarning) {
-      static uint32_t lastBeep = 0;
-      if (millis() - lastBeep >= 10000) {  // 10
-        digitalWrite(PIN_BUZZER, HIGH);
-        vTaskDelay(pdMS_TO_TICKS(200));
-        digitalWrite(PIN_BUZZER, LOW);
-        vTaskDelay(pdMS_TO_TICKS(100));
-        digitalWrite(PIN_BUZZER, HIGH);
-        vTaskDelay(pdMS_TO_TICKS(200));
-        digitalWrite(PIN_BUZZER, LOW);
-        
-        Serial.printf("[]  : %.1fC\n", sensorManager.getTemperature());
-        
-        // v3.9:  
-        #ifdef ENABLE_VOICE_ALERTS
-        if (voiceAlert.isOnline()) {
-          voiceAlert.enqueue(1, 5);  //  
-        }
-        #endif
-        
-        lastBeep = millis();
-      }
-    }
+  SmThresholds th;
+  th.currentCritical = CURRENT_THRESHOLD_CRITICAL;
+  th.tempWarning     = config.tempWarning;
+  th.tempCritical    = config.tempCritical;
+  th.tempShutdown    = config.tempShutdown;
+  th.pressureReached = config.targetPressure + config.pressureHysteresis;
+  th.tempEnabled     = config.tempSensorEnabled;
+
+  uint32_t events = s_edges.poll(smSensorLevels(frame, th), millis());
+  for (uint8_t ev = 0; events != 0; ev++, events >>= 1) {
+    if (events & 1u) postStateEvent((SmEvent)ev);
   }
+}
 
-  //  
-  switch (currentState) {
-    //  IDLE 
-    case STATE_IDLE:
-      if (sensorManager.getLimitSwitch()) changeState(STATE_VACUUM_ON);
+// ================================================================
+//  Actions
+// ================================================================
+static void runAction(SmAction action, const SensorFrame& frame) {
+  switch (action) {
+    case SM_ACT_NONE:
       break;
 
-    //  VACUUM_ON 
-    case STATE_VACUUM_ON:
-      if (currentMode == MODE_AUTO) {
-        if (elapsedTime >= config.vacuumOnTime) changeState(STATE_VACUUM_HOLD);
-      } else if (currentMode == MODE_PID) {
-        if (sensorManager.getPressure() <= config.targetPressure + config.pressureHysteresis) {
-          changeState(STATE_VACUUM_HOLD);
-        }
-      }
+    case SM_ACT_ERR_OVERCURRENT:
+      setError(ERROR_OVERCURRENT, SEVERITY_CRITICAL, " ");
       break;
 
-    //  VACUUM_HOLD 
-    case STATE_VACUUM_HOLD:
-      if (elapsedTime >= config.vacuumHoldTime) {
-        changeState(STATE_VACUUM_BREAK);
-      }
+    case SM_ACT_ERR_OVERHEAT_SHUTDOWN:
+      setError(ERROR_OVERHEAT, SEVERITY_CRITICAL, " -  ");
       break;
 
-    //  VACUUM_BREAK 
-    case STATE_VACUUM_BREAK:
-      if (elapsedTime >= config.vacuumBreakTime) {
-        changeState(STATE_WAIT_REMOVAL);
-      }
+    case SM_ACT_ERR_OVERHEAT_CRITICAL:
+      setError(ERROR_OVERHEAT, SEVERITY_RECOVERABLE, " -  ");
       break;
 
-    //  WAIT_REMOVAL (  ) 
-    case STATE_WAIT_REMOVAL:
-      //   (  )
-      if (!sensorManager.getPhotoSensor()) {
-        Serial.println("[WAIT_REMOVAL]     COMPLETE");
-        holdExtensionCount = 0;
-        changeState(STATE_COMPLETE);
-        break;
+    case SM_ACT_TEMP_WARNING:
+      buzzerPlay(BZ_PAT_TEMP_WARNING);
+      Serial.printf("[]  : %.1fC\n", frame.temperature);
+      #ifdef ENABLE_VOICE_ALERTS
+      if (voiceAlert.isOnline()) {
+        voiceAlert.enqueue(1, 5);  //  
       }
-      
-      //  
-      if (elapsedTime >= config.waitRemovalTime) {
-        //    &&    
-        if (config.holdExtensionEnabled && 
-            holdExtensionCount < config.maxHoldExtensions) {
-          
-          holdExtensionCount++;
-          stateStartTime = millis();
-          
-          Serial.printf("[WAIT_REMOVAL]   %d/%d (+ %lu ms)\n",
-                        holdExtensionCount, 
-                        config.maxHoldExtensions,
-                        config.vacuumHoldExtension);
-          
-          //  
-          digitalWrite(PIN_BUZZER, HIGH);
-          vTaskDelay(pdMS_TO_TICKS(100));
-          digitalWrite(PIN_BUZZER, LOW);
-          
-          // v3.9:   (  )
-          #ifdef ENABLE_VOICE_ALERTS
-          if (voiceAlert.isOnline()) {
-            voiceAlert.enqueue(1, 6);  //   
-          }
-          #endif
-        } 
-        else {
-          Serial.printf("[WAIT_REMOVAL]  ( %d )  ERROR\n", 
-                        holdExtensionCount);
-          holdExtensionCount = 0;
-          setError(ERROR_PHOTO_TIMEOUT, SEVERITY_INFO, "  ");
-          changeState(STATE_ERROR);
-        }
+      #endif
+      break;
+
+    case SM_ACT_EXTEND_HOLD:
+      holdExtensionCount++;
+      stateStartTime = millis();
+      armStateTimer(config.waitRemovalTime);
+      Serial.printf("[WAIT_REMOVAL]   %d/%d (+ %lu ms)\n",
+                    holdExtensionCount,
+                    config.maxHoldExtensions,
+                    config.vacuumHoldExtension);
+      buzzerPlay(BZ_PAT_SHORT);
+      #ifdef ENABLE_VOICE_ALERTS
+      if (voiceAlert.isOnline()) {
+        voiceAlert.enqueue(1, 6);  //   
       }
+      #endif
       break;
 
-    //  COMPLETE 
-    case STATE_COMPLETE:
-      if (elapsedTime >= 1000) changeState(STATE_IDLE);
+    case SM_ACT_ERR_PHOTO_TIMEOUT:
+      Serial.printf("[WAIT_REMOVAL]  ( %d )  ERROR\n", holdExtensionCount);
+      holdExtensionCount = 0;
+      setError(ERROR_PHOTO_TIMEOUT, SEVERITY_INFO, "  ");
       break;
 
-    //  ERROR 
-    case STATE_ERROR:
-      //       
-      if (config.tempSensorEnabled && 
-          currentError.code == ERROR_OVERHEAT &&
-          sensorManager.getTemperature() < config.tempCritical - 5.0) {
-        Serial.println("[ERROR]     ");
-        clearError();
-        changeState(STATE_IDLE);
-      }
+    case SM_ACT_PART_REMOVED:
+      Serial.println("[WAIT_REMOVAL]     COMPLETE");
+      holdExtensionCount = 0;
       break;
 
-    //  EMERGENCY_STOP 
-    case STATE_EMERGENCY_STOP:
-      if (sensorManager.getEmergencyStop()) {
-        //       
-        if (currentError.code == ERROR_OVERHEAT) {
-          if (sensorManager.getTemperature() < config.tempShutdown - 10.0) {
-            Serial.println("[EMERGENCY]     ");
-            clearError();
-            changeState(STATE_IDLE);
-          }
-        } else {
-          changeState(STATE_IDLE);
-        }
-      }
+    case SM_ACT_CLEAR_ERROR:
+      Serial.printf("[%s]     \n", currentState == STATE_ERROR ? "ERROR" : "EMERGENCY");
+      clearError();
       break;
   }
 }
 
+static void dispatchEvent(const SmQueuedEvent& q) {
+  if (q.event == SM_EV_TIMEOUT &&
+      (q.gen != s_timerGen || esp_timer_get_time() < s_timerDueUs)) {
+    return;   // stale: the state changed or the timer was re-armed
+  }
+
+  SensorFrame frame = latestSensorFrame();
+  SmContext ctx;
+  ctx.mode                   = currentMode;
+  ctx.estopActive            = frame.emergencyStop;
+  ctx.errorIsOverheat        = currentError.code == ERROR_OVERHEAT;
+  ctx.holdExtensionAvailable = config.holdExtensionEnabled &&
+                               holdExtensionCount < config.maxHoldExtensions;
+  ctx.autotuneRunning        = isPidAutotuneRunning();
+  ctx.temperature            = frame.temperature;
+  ctx.tempShutdown           = config.tempShutdown;
+
+  const SmTransition* t = smDispatch(currentState, q.event, ctx);
+  if (t == nullptr) return;
+
+  runAction(t->action, frame);
+  if (t->to != SM_STAY) changeState((SystemState)t->to);
+}
+
+// Waits up to waitMs for an event, then drains the queue
+void updateStateMachine(uint32_t waitMs) {
+  if (s_eventQueue == nullptr) {
+    vTaskDelay(pdMS_TO_TICKS(waitMs));
+    return;
+  }
+
+  SmQueuedEvent q;
+  if (xQueueReceive(s_eventQueue, &q, pdMS_TO_TICKS(waitMs)) != pdTRUE) return;
+  do {
+    dispatchEvent(q);
+  } while (xQueueReceive(s_eventQueue, &q, 0) == pdTRUE);
+}
+
+// Re-post levels that were ignored (e.g. limit switch while auto-tuning)
+void rearmStateEvents() {
+  s_rearmEdges = true;
+}
+
+uint32_t getStateEventsDropped() {
+  return s_eventsDropped;
+}
+
 // StateMachine   Mutex  void 
 void initStateMachine() {
   if (g_stateMutex == nullptr) {
@@ -216,6 +260,20 @@ void initStateMachine() {
       Serial.println("[StateMachine] Mutex  ");
     }
   }
+
+  if (s_eventQueue == nullptr) {
+    s_eventQueue = xQueueCreate(SM_QUEUE_DEPTH, sizeof(SmQueuedEvent));
+  }
+  if (s_stateTimer == nullptr) {
+    esp_timer_create_args_t args = {};
+    args.callback = stateTimerCallback;
+    args.name     = "sm_state";
+    esp_timer_create(&args, &s_stateTimer);
+  }
+  initBuzzer();
+  if (s_eventQueue == nullptr || s_stateTimer == nullptr) {
+    Serial.println("[StateMachine] event queue / timer init failed");
+  }
 }
 
 //  changeState()  Mutex 
@@ -233,10 +291,15 @@ void changeState(SystemState newState) {
     return;
   }
 
+  // Any transition (safety trip, START, ...) ends an auto-tune run
+  abortPidAutotune();
+
   previousState = currentState;
   currentState = newState;
   stateStartTime = millis();
   screenNeedsRedraw = true;
+  armStateTimer(stateTimeoutMs(newState));
+  s_rearmEdges = true;
   
   Serial.printf("[ ] %s  %s\n", 
                 getStateName(previousState), 
@@ -292,9 +355,7 @@ void changeState(SystemState newState) {
     case STATE_COMPLETE:
       stats.successfulCycles++;
       logCycle();
-      digitalWrite(PIN_BUZZER, HIGH);
-      vTaskDelay(pdMS_TO_TICKS(100));
-      digitalWrite(PIN_BUZZER, LOW);
+      buzzerPlay(BZ_PAT_SHORT);
       break;
 
     case STATE_ERROR:
@@ -303,16 +364,12 @@ void changeState(SystemState newState) {
       stats.failedCycles++;
       stats.totalErrors++;
       logCycle();
-      digitalWrite(PIN_BUZZER, HIGH);
-      vTaskDelay(pdMS_TO_TICKS(500));
-      digitalWrite(PIN_BUZZER, LOW);
+      buzzerPlay(BZ_PAT_ERROR);
       break;
 
     case STATE_EMERGENCY_STOP:
       emergencyShutdown();
-      digitalWrite(PIN_BUZZER, HIGH);
-      vTaskDelay(pdMS_TO_TICKS(1000));
-      digitalWrite(PIN_BUZZER, LOW);
+      buzzerPlay(BZ_PAT_ESTOP);
       break;
   }
 
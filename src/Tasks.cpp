@@ -15,6 +15,15 @@
 #include "HardenedConfig.h"
 #include "SPIBusManager.h"
 #include "SafeSensor.h"
+#include "Sensor.h"
+#include "SensorBuffer.h"
+#include "SensorManager.h"
+#include "PID_Control.h"
+#include "SD_Logger.h"
+#include "StateMachine.h"
+#include "TsLogger.h"
+#include "LogRetentionService.h"
+#include "Trend_Graph.h"
 
 // ================================================================
 //  
@@ -32,12 +41,7 @@ TaskHandle_t ds18b20TaskHandle  = NULL;   // [] DS18B20
 // ================================================================
 //  
 // ================================================================
-extern void updateStateMachine();
 extern void handleError();
-extern void updatePID();
-extern void readSensors();
-extern void updateSensorBuffers();
-extern void checkSensorHealth();
 extern void handleTouch();
 extern void handleKeyboardInput();
 extern void updateUI();
@@ -69,26 +73,6 @@ extern Statistics    stats;
 
 extern uint32_t g_estopStartMs;  // UI_Screen_EStop.cpp 
 
-// ================================================================
-//     [R1]
-// Tasks.cpp  (static  ) 
-// ================================================================
-struct SensorSnapshot {
-    float pressure    = 9999.0f;
-    float temperature = 9999.0f;
-    float current     = 9999.0f;
-    SystemState state = STATE_IDLE;
-    bool  errorActive = false;
-};
-
-//  
-static constexpr float PRESSURE_DELTA  = 0.2f;   // kPa
-static constexpr float TEMP_DELTA      = 0.3f;   // C
-static constexpr float CURRENT_DELTA   = 0.05f;  // A
-
-//   
-static SensorSnapshot g_lastSensor;
-
 // ================================================================
 // [2] WDT :     
 // :   WDT_TIMEOUT   WiFi   reset
@@ -109,9 +93,9 @@ static void registerAllTasks() {
 // ================================================================
 
 //  1. Vacuum Control 
+// State events are dispatched by vacuumControlTask() as they arrive;
+// this housekeeping part keeps the 100 ms cadence.
 static void vacuumControlStep() {
-    updateStateMachine();
-
     if (errorActive) {
         handleError();
     }
@@ -129,33 +113,17 @@ static void vacuumControlStep() {
 // [9] DS18B20 safeDS18B20.getTemperature()  ()
 // ================================================================
 static void sensorReadStep() {
-    readSensors();
-    updateSensorBuffers();
-    checkSensorHealth();
-
-    // [9] DS18B20   
-    if (safeDS18B20.isPresent()) {
-        sensorData.temperature = safeDS18B20.getTemperature();
-    }
-
-    // [R1]    
-    if (currentScreen == SCREEN_MAIN) {
-        bool changed =
-            fabsf(sensorData.pressure    - g_lastSensor.pressure)    > PRESSURE_DELTA  ||
-            fabsf(sensorData.temperature - g_lastSensor.temperature) > TEMP_DELTA      ||
-            fabsf(sensorData.current     - g_lastSensor.current)     > CURRENT_DELTA   ||
-            currentState != g_lastSensor.state ||
-            errorActive  != g_lastSensor.errorActive;
-
-        if (changed) {
-            g_lastSensor.pressure    = sensorData.pressure;
-            g_lastSensor.temperature = sensorData.temperature;
-            g_lastSensor.current     = sensorData.current;
-            g_lastSensor.state       = currentState;
-            g_lastSensor.errorActive = errorActive;
-            screenNeedsRedraw        = true;
-        }
-    }
+    // One acquisition per tick ([9] DS18B20 value comes from its own task),
+    // fanned out by reference so every consumer sees the same instant
+    const SensorFrame& frame = readSensors();
+    sensorManager.applyFrame(frame);   // PID / UI getters
+    stateMachineOnFrame(frame);        // level edges -> state events
+    updateSensorBuffers(frame);
+    checkSensorHealth(frame);
+    addGraphPoint(frame.pressure, frame.current);   // trend history, one sample per 100 ms tick
+
+    // SCREEN_MAIN needs no redraw flag: its retained widgets compare the
+    // displayed text each UI tick and repaint only what changed
 
     WDT_CHECKIN("SensorRead");
 }
@@ -171,13 +139,8 @@ static void uiUpdateStep() {
 
     uint32_t now = millis();
 
-    // [8] : SPI    
-    {
-        SPIGuard touchGuard(SPI_DEV_TOUCH, SPI_MUTEX_TIMEOUT_MS);
-        if (touchGuard.acquired()) {
-            handleTouch();
-        }
-    }
+    // Gestures queued by the touch reader task (no bus access here)
+    handleTouch();
 
     if (keyboardConnected) {
         handleKeyboardInput();
@@ -318,12 +281,22 @@ static void mqttHandlerStep() {
 // [4] SafeSD   SD  ( SD_Logger.cpp )
 // ================================================================
 static void dataLoggerStep() {
+    // Single consumer of sensorDataBuffer: drain everything SensorRead
+    // produced since the last tick (10 frames/s, 31-frame headroom).
+    static SensorData batch[SENSOR_DATA_BUFFER_SIZE];
+    size_t n = drainSensorData(batch, SENSOR_DATA_BUFFER_SIZE);
+    if (n > 0) {
+        logSensorTrend(batch, n);
+        tsLogFrames(batch, n);
+    }
+
 #ifdef ENABLE_DATA_LOGGING
     // SafeSDManager  SPIGuard 
     dataLogger.logHealthData(healthMonitor);
 #endif
 
     checkSDWriteStatus();
+    logRetentionStep();               // LOGRET_SLICE_US at most
 
     WDT_CHECKIN("DataLogger");
 }
@@ -417,7 +390,24 @@ static void dataLoggerAndMonitorStep() {
 // ================================================================
 // TASK WRAPPERS
 // ================================================================
-void vacuumControlTask(void* param) { taskLoop(vacuumControlStep,         100); }
+// VacuumCtrl: blocks on the state-event queue until the next 100 ms
+// housekeeping step is due, dispatching events as they arrive
+void vacuumControlTask(void* param) {
+    const TickType_t period = pdMS_TO_TICKS(100);
+    TickType_t lastStep = xTaskGetTickCount();
+
+    for (;;) {
+        TickType_t since = xTaskGetTickCount() - lastStep;
+        updateStateMachine(since < period ? (period - since) * portTICK_PERIOD_MS : 0);
+
+        if (xTaskGetTickCount() - lastStep >= period) {
+            lastStep += period;
+            if (xTaskGetTickCount() - lastStep >= period) lastStep = xTaskGetTickCount();
+            vacuumControlStep();
+        }
+    }
+}
+
 void sensorReadTask(void* param)    { taskLoop(sensorReadStep,            100); }
 void uiUpdateTask(void* param)      { taskLoop(uiUpdateStep,               50); }
 void wifiManagerTask(void* param)   { taskLoop(wifiManagerStep,           500); }  // [] 5000500 ()
@@ -444,12 +434,16 @@ void createAllTasks() {
     // WDT   (  )
     registerAllTasks();
 
+    // Fixed-rate PID loop (esp_timer -> PIDLoop task, Core 1)
+    initPIDLoop();
+
     //  Core 1: /UI/ ( ) 
     xTaskCreatePinnedToCore(
         vacuumControlTask, "VacuumCtrl",
         4096, NULL, 3,  //  3 ()
         &vacuumTaskHandle, 1);
 
+    initGraphData();                  // trend pyramids before the first sample
     xTaskCreatePinnedToCore(
         sensorReadTask, "SensorRead",
         3072, NULL, 2,
@@ -482,6 +476,9 @@ void createAllTasks() {
         4096, NULL, 1,
         &mqttTaskHandle, 0);
 
+#ifdef ENABLE_DATA_LOGGING
+    dataLogger.begin();               // health rollups, restored on the first wall-clock sample
+#endif
     xTaskCreatePinnedToCore(
         dataLoggerTask, "DataLogger",
         4096, NULL, 1,
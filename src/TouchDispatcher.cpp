@@ -3,10 +3,21 @@
 // 
 // Tasks.cpp   handleTouch() 
 // UIManager::handleTouch()    
+//
+// The AXS15231B is read only when its INT line fires (and while a
+// finger is down); samples go through a queue to the UI task, where
+// GestureRecognizer turns them into tap / long-press / drag / swipe.
 // ================================================================
 #include "Config.h"
 #include "UI_Screens.h"
 #include "UIManager.h"
+#include "GestureRecognizer.h"
+#include "Trend_Graph.h"
+
+#include <driver/gpio.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+#include <freertos/task.h>
 
 extern TFT_GFX tft;
 extern ScreenType currentScreen;
@@ -14,32 +25,97 @@ extern uint32_t lastIdleTime;
 extern bool sleepMode;
 extern UIManager uiManager;
 
+static constexpr uint8_t  TOUCH_QUEUE_DEPTH = 16;
+static constexpr uint32_t TOUCH_FOLLOW_MS   = 15;    // re-read period while a finger is down
+
+static TaskHandle_t      s_touchTask  = nullptr;
+static QueueHandle_t     s_touchQueue = nullptr;
+static GestureRecognizer s_gestures;
+static bool              s_swallow    = false;       // touch that woke the screen
+
+// Reader task -> stats
+static volatile uint32_t s_intEdges   = 0;
+static volatile uint32_t s_i2cReads   = 0;
+static volatile uint32_t s_queueDrops = 0;
+static uint32_t          s_maxLatencyMs = 0;         // sample -> dispatch, UI task
+
 // ================================================================
-//   
+//  INT edge -> reader task
 // ================================================================
-static bool getTouch(uint16_t* x, uint16_t* y) {
-    return tft.getTouch(x, y);
+static void IRAM_ATTR touchIntIsr(void*) {
+    s_intEdges = s_intEdges + 1;
+    BaseType_t woken = pdFALSE;
+    if (s_touchTask) vTaskNotifyGiveFromISR(s_touchTask, &woken);
+    portYIELD_FROM_ISR(woken);
 }
 
-// ================================================================
-//       
-// ================================================================
-void handleTouch() {
-    uint16_t x = 0, y = 0;
-    
-    if (!getTouch(&x, &y)) {
-        return;  //  
+// Idle: blocked until INT. Touching: the controller is followed every
+// TOUCH_FOLLOW_MS (or sooner on INT) until it reports no point, since
+// the lift itself does not always raise an edge. Only changes are queued;
+// one that finds the queue full is re-read and re-sent on the next pass.
+static void touchReaderTask(void*) {
+    TouchChangeTracker last;
+    for (;;) {
+        bool follow = last.down || last.pending || PIN_TOUCH_INT < 0;
+        ulTaskNotifyTake(pdTRUE, follow ? pdMS_TO_TICKS(TOUCH_FOLLOW_MS) : portMAX_DELAY);
+
+        uint16_t x = 0, y = 0;
+        bool now = tft.getTouch(&x, &y);
+        s_i2cReads = s_i2cReads + 1;
+        if (!last.changed(now, (int16_t)x, (int16_t)y)) {
+            last.pending = false;               // back where the queue last saw it
+            continue;
+        }
+
+        TouchSample sample = { millis(), (int16_t)x, (int16_t)y, now };
+        if (xQueueSend(s_touchQueue, &sample, 0) == pdTRUE) {
+            last.sent(sample);
+        } else {
+            last.dropped();
+            s_queueDrops = s_queueDrops + 1;
+        }
+    }
+}
+
+void initTouchInput() {
+    if (s_touchTask) return;
+    s_touchQueue = xQueueCreate(TOUCH_QUEUE_DEPTH, sizeof(TouchSample));
+    xTaskCreatePinnedToCore(touchReaderTask, "TouchRd", 2560, nullptr, 4, &s_touchTask, 1);
+
+    if (PIN_TOUCH_INT < 0) {
+        Serial.println("[Touch] no INT pin, polling every 15 ms");
+        return;
     }
-    
-    //    ( )
-    lastIdleTime = millis();
-    if (sleepMode) {
-        extern void exitSleepMode();
-        exitSleepMode();
-        return;  //    
+    esp_err_t err = gpio_install_isr_service(ESP_INTR_FLAG_IRAM);
+    if (err != ESP_OK && err != ESP_ERR_INVALID_STATE) {   // already installed is fine
+        Serial.printf("[Touch] ISR service failed (%d)\n", err);
+        return;
     }
-    
-    //    
+    gpio_set_direction((gpio_num_t)PIN_TOUCH_INT, GPIO_MODE_INPUT);
+    gpio_set_pull_mode((gpio_num_t)PIN_TOUCH_INT, GPIO_PULLUP_ONLY);
+    gpio_set_intr_type((gpio_num_t)PIN_TOUCH_INT, GPIO_INTR_NEGEDGE);
+    gpio_isr_handler_add((gpio_num_t)PIN_TOUCH_INT, touchIntIsr, nullptr);
+    gpio_intr_enable((gpio_num_t)PIN_TOUCH_INT);
+    Serial.printf("[Touch] INT on GPIO %d\n", PIN_TOUCH_INT);
+}
+
+void printTouchStats() {
+    const GestureStats& g = s_gestures.stats();
+    Serial.println("\n=== Touch ===");
+    Serial.printf("INT edges %lu, I2C reads %lu, samples %lu (queue drops %lu)\n",
+                  s_intEdges, s_i2cReads, g.samples, s_queueDrops);
+    Serial.printf("Taps %lu, long-press %lu, drags %lu, swipes %lu, bounces %lu, dropped %lu\n",
+                  g.taps, g.longPresses, g.drags, g.swipes, g.bounces, g.dropped);
+    Serial.printf("Max sample -> dispatch %lu ms\n", s_maxLatencyMs);
+    s_gestures.resetStats();
+    s_intEdges = s_i2cReads = s_queueDrops = 0;
+    s_maxLatencyMs = 0;
+}
+
+// ================================================================
+//  Tap -> screen handler
+// ================================================================
+static void dispatchTap(uint16_t x, uint16_t y) {
     switch (currentScreen) {
         case SCREEN_MAIN:
             handleMainTouch(x, y);
@@ -129,6 +205,48 @@ void handleTouch() {
     }
 }
 
+// The trend graph takes drags, swipes and long presses; elsewhere a
+// long press is a slow tap
+static void dispatchGesture(const Gesture& g) {
+    if (currentScreen == SCREEN_TREND_GRAPH && g.type != GESTURE_TAP) {
+        handleGraphGesture(g);
+        return;
+    }
+    if (g.type == GESTURE_TAP || g.type == GESTURE_LONG_PRESS) dispatchTap(g.x, g.y);
+}
+
+// ================================================================
+//  UI task: drain the queue, O(1) per sample / gesture
+// ================================================================
+void handleTouch() {
+    if (!s_touchQueue) return;
+
+    TouchSample sample;
+    while (xQueueReceive(s_touchQueue, &sample, 0) == pdTRUE) {
+        if (sample.down) {
+            lastIdleTime = millis();
+            if (sleepMode) {
+                extern void exitSleepMode();
+                exitSleepMode();
+                s_swallow = true;               // the waking touch is not a tap
+            }
+        }
+        if (s_swallow) {
+            if (!sample.down) s_swallow = false;
+            continue;
+        }
+        s_gestures.feed(sample);
+    }
+    uint32_t now = millis();
+    s_gestures.tick(now);
+
+    Gesture g;
+    while (s_gestures.next(g)) {
+        if (now - g.ms > s_maxLatencyMs) s_maxLatencyMs = now - g.ms;
+        dispatchGesture(g);
+    }
+}
+
 // ================================================================
 // updateUI  (Tasks.cpp )
 // ================================================================
@@ -53,7 +53,13 @@
 #include "Config.h"                 // enum, struct, extern  + PIN_BUZZER
 #include "GFX_Wrapper.hpp"
 #include "Lang.h"                   // L(), printL(), 
+#include "Buzzer.h"                 // buzzerPlay()
+#include "MinMaxPyramid.h"          // min / max / last per pixel column
+#include "AxisAutoScale.h"          // Y range hysteresis
+#include "Trend_Graph.h"            // Gesture
 #include <SD.h>
+#include <new>
+#include <esp_heap_caps.h>
 #include <freertos/FreeRTOS.h>
 #include <freertos/task.h>
 #include <freertos/queue.h>
@@ -73,6 +79,21 @@ static constexpr uint16_t GW    = 380;
 static constexpr uint16_t GH    = 80;
 static constexpr uint16_t G_GAP = 20;              /*    */
 
+/* History windows (samples at SAMPLE_INTERVAL), one min-max span per
+ * pixel column from MinMaxPyramid regardless of the window length    */
+struct TrendWindow { const char* label; uint32_t samples; };
+static constexpr TrendWindow WINDOWS[] = {
+  { "10s",    100 },
+  { "10m",   6000 },
+  { "1h",   36000 },
+  { "24h", 864000 },
+};
+static constexpr uint8_t  WINDOW_COUNT = sizeof(WINDOWS) / sizeof(WINDOWS[0]);
+static constexpr uint16_t WIN_Y = GY + (GH + G_GAP + 20) + GH + 25;   /* window selector row */
+static constexpr uint16_t WIN_W = 40, WIN_H = 22, WIN_SP = 6;
+
+static constexpr uint32_t SCALE_HOLD_MS = 3000;   /* axis shrinks after this long loose */
+
 static constexpr float DEF_P_MIN = -100.0f;
 static constexpr float DEF_P_MAX =    0.0f;
 static constexpr float DEF_C_MIN =    0.0f;
@@ -102,6 +123,7 @@ struct GraphData {
   float currentMin ,  currentMax;
   bool  autoScale;                    /* true =   */
 
+  uint8_t  window;                    /* WINDOWS[] index */
   uint8_t  zoomLevel;                 /* 1 | 2 | 4 */
   int16_t  panOffset;
 
@@ -114,6 +136,14 @@ struct GraphData {
 GraphData graphData;                  /*   (  extern ) */
 static char g_csvBuffer[4096];        /* CSV   */
 
+/* Long history for drawing (PSRAM, ~41 KB per channel). The raw ring
+ * above stays for the CSV export. Written by the sensor task, read by
+ * the UI task: a torn bucket only shows for one frame.               */
+static MinMaxPyramid* pyrPressure = nullptr;
+static MinMaxPyramid* pyrCurrent  = nullptr;
+static MinMaxColumn   g_cols[GW];
+static AxisScaler     scaleP, scaleC;
+
 /* 
  *  SD      union OPEN DATA 
  *
@@ -394,10 +424,7 @@ void checkSDWriteStatus() {
     tft.setCursor(140, 165);  tft.printf("%s", (const char*)sdStatusMsg);
 
     /*    2   ( ~200 ms,    ) */
-    digitalWrite(PIN_BUZZER, HIGH); vTaskDelay(pdMS_TO_TICKS(80));
-    digitalWrite(PIN_BUZZER, LOW);  vTaskDelay(pdMS_TO_TICKS(40));
-    digitalWrite(PIN_BUZZER, HIGH); vTaskDelay(pdMS_TO_TICKS(80));
-    digitalWrite(PIN_BUZZER, LOW);
+    buzzerPlay(BZ_PAT_SUCCESS);
   } else {
     tft.fillRect(130, 140, 220, 40, TFT_RED);
     tft.setTextColor(TFT_WHITE, TFT_RED);
@@ -406,8 +433,7 @@ void checkSDWriteStatus() {
     tft.setCursor(140, 165);  tft.printf("%s", (const char*)sdStatusMsg);
 
     /*    1   */
-    digitalWrite(PIN_BUZZER, HIGH); vTaskDelay(pdMS_TO_TICKS(200));
-    digitalWrite(PIN_BUZZER, LOW);
+    buzzerPlay(BZ_PAT_FAIL);
   }
 
   sdMsgShowUntil = now + 2000;        /*  2   (delay ) */
@@ -416,9 +442,28 @@ void checkSDWriteStatus() {
 /* ================================================================
  *       setup()     
  *  ============================================================== */
+static MinMaxPyramid* allocPyramid() {
+  void* mem = heap_caps_malloc(sizeof(MinMaxPyramid), MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+  if (!mem) mem = heap_caps_malloc(sizeof(MinMaxPyramid), MALLOC_CAP_8BIT);
+  return mem ? new (mem) MinMaxPyramid() : nullptr;
+}
+
 void initGraphData() {
   memset(&graphData, 0, sizeof(graphData));
 
+  if (!pyrPressure) pyrPressure = allocPyramid();
+  if (!pyrCurrent)  pyrCurrent  = allocPyramid();
+  for (MinMaxPyramid* p : { pyrPressure, pyrCurrent }) {
+    if (!p) continue;
+    p->clear();
+    for (const TrendWindow &w : WINDOWS) p->track(w.samples);   /* running range per window */
+  }
+  if (!pyrPressure || !pyrCurrent)
+    Serial.println("[] pyramid alloc failed, long windows disabled");
+
+  scaleP.begin({ 0.1f, 10.0f, NAN }, SCALE_HOLD_MS);   /* 10 % margin, flat = 10 kPa     */
+  scaleC.begin({ 0.1f,  1.0f, 0.0f }, SCALE_HOLD_MS);  /* 10 % margin, flat = 1 A, >= 0  */
+
   graphData.pressureMin = DEF_P_MIN;
   graphData.pressureMax = DEF_P_MAX;
   graphData.currentMin  = DEF_C_MIN;
@@ -448,77 +493,51 @@ void addGraphPoint(float pressure, float current) {
   }
   graphData.pointCount = graphData.bufferFull ? MAX_POINTS : graphData.writeIndex;
 
-  // if (graphData.autoScale) autoScale();  // 
+  if (pyrPressure) pyrPressure->add(pressure);
+  if (pyrCurrent)  pyrCurrent->add(current);
+
+  if (graphData.autoScale) autoScale();
 }
 
 /* ================================================================
  *    1   
- *       min/max  (10 % )
+ *  Running min/max of the selected window from the pyramid deques
+ *  (O(1), no rescan), moved only past the AxisScaler hysteresis:
+ *  grows at once, shrinks after SCALE_HOLD_MS, snaps to grid steps.
+ *  Runs on every sample; zoom / pan keep the full-window range.
  *  ============================================================== */
 void autoScale() {
-  if (!graphData.pointCount) return;
-
-  uint16_t si = graphData.bufferFull ? graphData.writeIndex : 0;
-
-  float pMin, pMax, cMin, cMax;
-  pMin = pMax = graphData.pressure[si % MAX_POINTS];
-  cMin = cMax = graphData.current [si % MAX_POINTS];
-
-  for (uint16_t i = 1; i < graphData.pointCount; i++) {
-    uint16_t idx = (si + i) % MAX_POINTS;
-    float p = graphData.pressure[idx];
-    float c = graphData.current [idx];
-    if (p < pMin) pMin = p;           /*   min/max  */
-    if (p > pMax) pMax = p;
-    if (c > cMax) cMax = c;
-    if (c < cMin) cMin = c;
-  }
+  if (!pyrPressure || !pyrCurrent) return;
 
-  /*    (10 %)   pMin  pMax   */
-  float pr = pMax - pMin;
-  if (pr > 0.0f) { pMin -= pr * 0.1f;  pMax += pr * 0.1f; }
-  else           { pMin -= 5.0f;  pMax += 5.0f; }   /*   5 kPa */
-
-  /*    */
-  float cr = cMax - cMin;
-  if (cr > 0.0f) { cMax += cr * 0.1f;  cMin -= cr * 0.1f;  if (cMin < 0) cMin = 0; }
-  else           { cMax = cMin + 1.0f; }
-
-  /*  :  =   (  ) 
-   *   pressureMin = pMin (  ,  )
-   *   pressureMax = pMax (  ,  )
-   *   drawPressureGraph  mapVal(val, pMin, pMax, 0, GH)  
-   *   pMiny=0(), pMaxy=GH()    */
-  graphData.pressureMin = pMin;
-  graphData.pressureMax = pMax;
-  graphData.currentMin  = cMin;
-  graphData.currentMax  = cMax;
+  uint32_t w   = WINDOWS[graphData.window].samples;
+  uint32_t now = millis();
+  float lo, hi;
+  bool  moved = false;
+  if (pyrPressure->range(w, lo, hi)) moved |= scaleP.update(lo, hi, now);
+  if (pyrCurrent ->range(w, lo, hi)) moved |= scaleC.update(lo, hi, now);
+  if (!moved) return;
+
+  graphData.pressureMin = scaleP.lo();
+  graphData.pressureMax = scaleP.hi();
+  graphData.currentMin  = scaleC.lo();
+  graphData.currentMax  = scaleC.hi();
+  if (currentScreen == SCREEN_TREND_GRAPH) screenNeedsRedraw = true;
 }
 
+/* Fixed default range; autoscale refits from scratch when next enabled */
 void resetScale() {
   graphData.pressureMin = DEF_P_MIN;
   graphData.pressureMax = DEF_P_MAX;
   graphData.currentMin  = DEF_C_MIN;
   graphData.currentMax  = DEF_C_MAX;
-  graphData.autoScale   = true;
+  scaleP.reset();
+  scaleC.reset();
 }
 
 /* ================================================================
  *    2   / 
  *    1  2  4  1 
  *  ============================================================== */
-static void applyZoom(uint16_t &x1, uint16_t &x2,
-                      uint16_t baseX, uint16_t baseW) {
-  if (graphData.zoomLevel == 1) return;
-  int16_t c = (int16_t)(baseX + baseW / 2);
-  int16_t nx1 = c + ((int16_t)x1 - c) * graphData.zoomLevel + graphData.panOffset;
-  int16_t nx2 = c + ((int16_t)x2 - c) * graphData.zoomLevel + graphData.panOffset;
-
-  /*        */
-  x1 = (uint16_t)constrain(nx1, (int16_t)baseX,            (int16_t)(baseX + baseW));
-  x2 = (uint16_t)constrain(nx2, (int16_t)baseX,            (int16_t)(baseX + baseW));
-}
-
 void handleZoom(uint16_t x, uint16_t y) {
   static uint32_t lastTap = 0;
   static uint16_t ltX = 0, ltY = 0;
@@ -546,6 +565,31 @@ void handlePan(int16_t delta) {
   screenNeedsRedraw = true;
 }
 
+/* ================================================================
+ *  Gestures on the plot: a drag pans with the finger (right = older
+ *  samples), a swipe flings another quarter graph, a long press
+ *  returns to 1x.
+ *  ============================================================== */
+void handleGraphGesture(const Gesture& g) {
+  if (g.x < GX || g.x > GX + GW) return;
+  switch (g.type) {
+    case GESTURE_DRAG:
+      handlePan(g.dx);
+      break;
+    case GESTURE_SWIPE:
+      if (g.dir == SWIPE_LEFT)  handlePan(-(int16_t)(GW / 4));
+      if (g.dir == SWIPE_RIGHT) handlePan((int16_t)(GW / 4));
+      break;
+    case GESTURE_LONG_PRESS:
+      graphData.zoomLevel = 1;
+      graphData.panOffset = 0;
+      screenNeedsRedraw = true;
+      break;
+    default:
+      break;
+  }
+}
+
 /* ================================================================
  *    4  
  *  ANIM      (2 )
@@ -557,9 +601,9 @@ void startAnimation() {
 
 void updateAnimation() {
   if (!graphData.animated) return;
-  graphData.animationProgress += 2;
-  if (graphData.animationProgress >= graphData.pointCount) {
-    graphData.animationProgress = graphData.pointCount;
+  graphData.animationProgress += GW / 20;    /* columns per frame */
+  if (graphData.animationProgress >= GW) {
+    graphData.animationProgress = GW;
     graphData.animated = false;
   }
 }
@@ -573,6 +617,60 @@ static inline float mapVal(float v,
   return (v - iMin) * (oMax - oMin) / (iMax - iMin) + oMin;
 }
 
+/* ================================================================
+ *  Visible range: zoom narrows the window around its centre, pan
+ *  (pixels, + = older) shifts it. Returns false without history.
+ *  ============================================================== */
+static bool visibleRange(const MinMaxPyramid* p, uint32_t &end, uint32_t &window) {
+  if (!p || !p->count()) return false;
+  uint32_t full = WINDOWS[graphData.window].samples;
+  window = full / graphData.zoomLevel;
+  int64_t e = (int64_t)p->count() - (full - window) / 2
+            - (int64_t)graphData.panOffset * window / GW;
+  end = (uint32_t)constrain(e, (int64_t)0, (int64_t)p->count());
+  return true;
+}
+
+/* ================================================================
+ *  One vertical min-max span per pixel column, O(GW) for any window.
+ *  Each span is stretched to the previous column's last value so the
+ *  trace stays connected; empty columns (no data / gap) stay blank.
+ *  ============================================================== */
+static void drawColumns(const MinMaxPyramid* p, uint16_t x, uint16_t y,
+                        float vMin, float vMax, uint16_t color) {
+  uint32_t end, window;
+  if (!visibleRange(p, end, window)) return;
+  p->columns(end, window, g_cols, GW);
+
+  uint16_t cnt  = graphData.animated ? graphData.animationProgress : GW;
+  float    prev = NAN;
+  for (uint16_t c = 0; c < cnt; c++) {
+    const MinMaxColumn &col = g_cols[c];
+    if (!col.valid()) { prev = NAN; continue; }
+
+    float hi = col.max, lo = col.min;
+    if (!isnan(prev)) { hi = fmaxf(hi, prev);  lo = fminf(lo, prev); }
+    prev = col.last;
+
+    int16_t yTop = y + GH - (int16_t)constrain(mapVal(hi, vMin, vMax, 0, GH), 0.0f, (float)GH);
+    int16_t yBot = y + GH - (int16_t)constrain(mapVal(lo, vMin, vMax, 0, GH), 0.0f, (float)GH);
+    tft.drawFastVLine(x + c, yTop, yBot - yTop + 1, color);
+  }
+}
+
+/* X axis: age of each grid line in the visible window ("-5m" .. "0") */
+static void drawTimeLabel(uint16_t xp, uint16_t yp, int i) {
+  uint32_t end = 0, window = WINDOWS[graphData.window].samples / graphData.zoomLevel;
+  uint32_t lag  = visibleRange(pyrPressure, end, window) ? pyrPressure->count() - end : 0;
+  uint32_t ageS = (lag + window * (6 - i) / 6) * SAMPLE_INTERVAL / 1000;
+
+  tft.setCursor(xp - 8, yp);
+  if      (ageS == 0)     tft.print("0");
+  else if (ageS < 120)    tft.printf("-%lus", (unsigned long)ageS);
+  else if (ageS < 7200)   tft.printf("-%lum", (unsigned long)(ageS / 60));
+  else                    tft.printf("-%luh", (unsigned long)(ageS / 3600));
+}
+
 /* ================================================================
  *    
  *  ============================================================== */
@@ -606,50 +704,11 @@ static void drawPressureGraph() {
       tft.drawPixel(xp, yp, TFT_DARKGREY);
 
     tft.setTextColor(TFT_LIGHTGREY, TFT_BLACK);
-    tft.setCursor(xp - 8, GY + GH + 3);
-    if (graphData.pointCount) {
-      uint16_t li = (graphData.bufferFull
-                   ? graphData.writeIndex
-                   : graphData.pointCount - 1) % MAX_POINTS;
-      tft.printf("%.1f", graphData.timestamp[li] / 1000.0f * i / 6.0f);
-    } else {
-      tft.printf("%d", i);
-    }
+    drawTimeLabel(xp, GY + GH + 3, i);
   }
 
-  /*   */
-  if (graphData.pointCount > 1) {
-    uint16_t si  = graphData.bufferFull ? graphData.writeIndex : 0;
-    uint16_t cnt = graphData.animated
-                 ? graphData.animationProgress
-                 : graphData.pointCount;
-
-    for (uint16_t i = 1; i < cnt; i++) {
-      uint16_t i1 = (si + i - 1) % MAX_POINTS;
-      uint16_t i2 = (si + i    ) % MAX_POINTS;
-
-      uint16_t x1 = GX + (uint16_t)((uint32_t)GW * (i - 1) / graphData.pointCount);
-      uint16_t y1 = GY + GH - (uint16_t)mapVal(graphData.pressure[i1],
-                     graphData.pressureMin, graphData.pressureMax, 0, GH);
-      uint16_t x2 = GX + (uint16_t)((uint32_t)GW *  i      / graphData.pointCount);
-      uint16_t y2 = GY + GH - (uint16_t)mapVal(graphData.pressure[i2],
-                     graphData.pressureMin, graphData.pressureMax, 0, GH);
-
-      applyZoom(x1, x2, GX, GW);
-      y1 = constrain(y1, GY, GY + GH);
-      y2 = constrain(y2, GY, GY + GH);
-
-      /*     */
-      tft.drawLine(x1, y1,     x2, y2,     TFT_CYAN);
-      tft.drawLine(x1, y1 + 1, x2, y2 + 1, TFT_CYAN);
-
-      /* 10   */
-      if (i % 10 == 0) {
-        tft.fillCircle(x2, y2, 2, TFT_WHITE);
-        tft.drawCircle(x2, y2, 3, TFT_CYAN);
-      }
-    }
-  }
+  /* min-max span per column */
+  drawColumns(pyrPressure, GX, GY, graphData.pressureMin, graphData.pressureMax, TFT_CYAN);
 
   /*    (PID  ) */
   if (currentMode == MODE_PID) {
@@ -712,48 +771,11 @@ static void drawCurrentGraph() {
       tft.drawPixel(xp, yp, TFT_DARKGREY);
 
     tft.setTextColor(TFT_LIGHTGREY, TFT_BLACK);
-    tft.setCursor(xp - 8, y + GH + 3);
-    if (graphData.pointCount) {
-      uint16_t li = (graphData.bufferFull
-                   ? graphData.writeIndex
-                   : graphData.pointCount - 1) % MAX_POINTS;
-      tft.printf("%.1f", graphData.timestamp[li] / 1000.0f * i / 6.0f);
-    } else {
-      tft.printf("%d", i);
-    }
+    drawTimeLabel(xp, y + GH + 3, i);
   }
 
-  /*   */
-  if (graphData.pointCount > 1) {
-    uint16_t si  = graphData.bufferFull ? graphData.writeIndex : 0;
-    uint16_t cnt = graphData.animated
-                 ? graphData.animationProgress
-                 : graphData.pointCount;
-
-    for (uint16_t i = 1; i < cnt; i++) {
-      uint16_t i1 = (si + i - 1) % MAX_POINTS;
-      uint16_t i2 = (si + i    ) % MAX_POINTS;
-
-      uint16_t x1 = x + (uint16_t)((uint32_t)GW * (i - 1) / graphData.pointCount);
-      uint16_t y1 = y + GH - (uint16_t)mapVal(graphData.current[i1],
-                     graphData.currentMin, graphData.currentMax, 0, GH);
-      uint16_t x2 = x + (uint16_t)((uint32_t)GW *  i      / graphData.pointCount);
-      uint16_t y2 = y + GH - (uint16_t)mapVal(graphData.current[i2],
-                     graphData.currentMin, graphData.currentMax, 0, GH);
-
-      applyZoom(x1, x2, x, GW);
-      y1 = constrain(y1, y, y + GH);
-      y2 = constrain(y2, y, y + GH);
-
-      tft.drawLine(x1, y1,     x2, y2,     TFT_YELLOW);
-      tft.drawLine(x1, y1 + 1, x2, y2 + 1, TFT_YELLOW);
-
-      if (i % 10 == 0) {
-        tft.fillCircle(x2, y2, 2, TFT_WHITE);
-        tft.drawCircle(x2, y2, 3, TFT_YELLOW);
-      }
-    }
-  }
+  /* min-max span per column */
+  drawColumns(pyrCurrent, x, y, graphData.currentMin, graphData.currentMax, TFT_YELLOW);
 
   /*   ( ) */
   {
@@ -850,6 +872,23 @@ static void drawGraphControls() {
   printL(bX + 12, bY + 9, BTN_ANIM);
 }
 
+/* ================================================================
+ *  Window selector  10s | 10m | 1h | 24h  (below the current graph)
+ *  ============================================================== */
+static void drawWindowSelector() {
+  tft.setTextSize(1);
+  for (uint8_t i = 0; i < WINDOW_COUNT; i++) {
+    uint16_t bX  = GX + i * (WIN_W + WIN_SP);
+    bool     sel = (i == graphData.window);
+    uint16_t bg  = sel ? TFT_CYAN : TFT_DARKGREY;
+    tft.fillRect(bX, WIN_Y, WIN_W, WIN_H, bg);
+    tft.drawRect(bX, WIN_Y, WIN_W, WIN_H, TFT_CYAN);
+    tft.setTextColor(sel ? TFT_BLACK : TFT_CYAN, bg);
+    tft.setCursor(bX + 8, WIN_Y + 7);
+    tft.print(WINDOWS[i].label);
+  }
+}
+
 /* ================================================================
  *        UI_Screens.cpp updateUI() 
  *  ============================================================== */
@@ -864,7 +903,7 @@ void drawTrendGraph() {
   tft.setTextSize(1);
   tft.setTextColor(TFT_WHITE, TFT_BLACK);
   tft.setCursor(200, 15);
-  tft.printf("Pts:%d/%d", graphData.pointCount, MAX_POINTS);
+  tft.printf("Win:%s", WINDOWS[graphData.window].label);
 
   if (graphData.zoomLevel > 1) {
     tft.setCursor(330, 15);
@@ -875,6 +914,7 @@ void drawTrendGraph() {
   drawCurrentGraph();
   drawLegend();
   drawGraphControls();
+  drawWindowSelector();
 
   if (graphData.animated) updateAnimation();
 }
@@ -912,11 +952,27 @@ void handleGraphTouch(uint16_t x, uint16_t y) {
   /* ANIM */
   bX -= (bW + sp);
   if (x >= bX && x <= bX + bW && y >= bY && y <= bY + bH) {
-    if (!graphData.animated && graphData.pointCount) startAnimation();
+    if (!graphData.animated && pyrPressure && pyrPressure->count()) startAnimation();
     screenNeedsRedraw = true;
     return;
   }
 
+  /* Window selector: new window starts unzoomed */
+  if (y >= WIN_Y && y <= WIN_Y + WIN_H) {
+    for (uint8_t i = 0; i < WINDOW_COUNT; i++) {
+      uint16_t wX = GX + i * (WIN_W + WIN_SP);
+      if (x >= wX && x <= wX + WIN_W) {
+        graphData.window    = i;
+        graphData.zoomLevel = 1;
+        graphData.panOffset = 0;
+        scaleP.reset();               /* refit to the new window on the next sample */
+        scaleC.reset();
+        screenNeedsRedraw   = true;
+        return;
+      }
+    }
+  }
+
   /*       */
   if (x >= GX && x <= GX + GW)
     handleZoom(x, y);
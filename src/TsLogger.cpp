@@ -0,0 +1,339 @@
+// ================================================================
+// TsLogger.cpp    Binary sensor history (/logs/trend.tsb + .tsi)
+// ================================================================
+//  DataLogger task: tsLogFrames() encodes the drained frames; a full
+//  block (or one older than TSLOG_MAX_BLOCK_SPAN_MS) is sealed and
+//  handed to the SdLog streams together with its index entry.
+//  Queries and exports read the files back in the caller's task.
+//
+//  Block n lives at n * TS_BLOCK_SIZE. A torn tail left by a power
+//  loss is padded to the next boundary at boot (the padding fails
+//  the CRC and is skipped), so block numbers stay file offsets.
+//
+//  Until NTP syncs the log clock is millis(), so after a reboot the
+//  stamps restart near zero. The writer seals on every step back and
+//  s_runs records where the index restarts; queries search each run.
+// ================================================================
+#include "TsLogger.h"
+#include "HardenedConfig.h"
+#include "SdLogService.h"
+#include "EnhancedWatchdog.h"
+
+#include <new>
+#include <sys/time.h>
+#include <esp_heap_caps.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+
+static const char* TS_DATA_PATH  = "/logs/trend.tsb";
+static const char* TS_INDEX_PATH = "/logs/trend.tsi";
+
+static TsBlockWriter*    s_writer  = nullptr;     // PSRAM (~16 KB of column buffers)
+static uint8_t*          s_block   = nullptr;     // seal / read buffer
+static SemaphoreHandle_t s_mutex   = nullptr;
+static TsRuns            s_runs;                  // sorted stretches of the index
+
+static uint32_t s_samples       = 0;
+static uint32_t s_blocksSealed  = 0;
+static uint32_t s_blocksDropped = 0;              // SdLog ring full
+static uint32_t s_indexDropped  = 0;
+static uint64_t s_bodyBytes     = 0;
+
+static void* psramAlloc(size_t bytes) {
+  void* p = heap_caps_malloc(bytes, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+  return p ? p : heap_caps_malloc(bytes, MALLOC_CAP_8BIT);
+}
+
+uint64_t tsLogNowMs() {
+  struct timeval tv;
+  gettimeofday(&tv, nullptr);
+  if (tv.tv_sec > 1000000000) return (uint64_t)tv.tv_sec * 1000ULL + tv.tv_usec / 1000;
+  return millis();
+}
+
+// ================================================================
+//  Read helpers (bus locked per call)
+// ================================================================
+static uint32_t fileSize(const char* path) {
+  fs::FS* fs = sdLogFs();
+  if (!fs || !sdLogLockBus(SD_OPEN_TIMEOUT_MS)) return 0;
+  uint32_t n = 0;
+  File f = fs->open(path, FILE_READ);
+  if (f) { n = f.size(); f.close(); }
+  sdLogUnlockBus();
+  return n;
+}
+
+static bool readAt(File& f, uint32_t offset, uint8_t* out, size_t len) {
+  if (!sdLogLockBus(SD_WRITE_TIMEOUT_MS)) return false;
+  bool ok = f.seek(offset) && f.read(out, len) == (int)len;
+  sdLogUnlockBus();
+  return ok;
+}
+
+static File openForRead(const char* path) {
+  File f;
+  fs::FS* fs = sdLogFs();
+  if (!fs || !sdLogLockBus(SD_OPEN_TIMEOUT_MS)) return f;
+  f = fs->open(path, FILE_READ);
+  sdLogUnlockBus();
+  return f;
+}
+
+static void closeLocked(File& f) {
+  bool locked = sdLogLockBus(SD_WRITE_TIMEOUT_MS);
+  f.close();
+  if (locked) sdLogUnlockBus();
+}
+
+// Zero-fill a torn tail up to the next record boundary
+static void padTail(SdLogStream s, uint32_t size, uint32_t unit) {
+  uint32_t rem = size % unit;
+  if (rem == 0) return;
+  memset(s_block, 0, TS_BLOCK_SIZE);
+  sdLogAppendRaw(s, s_block, unit - rem);
+  Serial.printf("[TsLog] padded torn tail (%lu bytes) in stream %u\n", unit - rem, s);
+}
+
+// One pass over the index, a block of entries per read. The padded
+// torn entry (if any) counts as unreadable.
+static void scanRuns(uint32_t indexSize) {
+  uint32_t full = indexSize / TS_INDEX_SIZE;
+  const uint32_t perRead = TS_BLOCK_SIZE / TS_INDEX_SIZE;
+  File f = openForRead(TS_INDEX_PATH);
+  for (uint32_t i = 0; i < full; i += perRead) {
+    uint32_t n = full - i < perRead ? full - i : perRead;
+    bool ok = f && readAt(f, i * TS_INDEX_SIZE, s_block, n * TS_INDEX_SIZE);
+    for (uint32_t k = 0; k < n; k++) {
+      TsBlockInfo e;
+      s_runs.add(ok && tsDecodeIndex(s_block + k * TS_INDEX_SIZE, e) ? &e : nullptr);
+    }
+  }
+  if (indexSize % TS_INDEX_SIZE) s_runs.add(nullptr);
+  if (f) closeLocked(f);
+}
+
+// ================================================================
+//  Writer
+// ================================================================
+void initTsLogger() {
+  if (s_writer || !sdLogReady()) return;
+
+  void* mem = psramAlloc(sizeof(TsBlockWriter));
+  s_block   = (uint8_t*)psramAlloc(TS_BLOCK_SIZE);
+  s_mutex   = xSemaphoreCreateMutex();
+  if (!mem || !s_block || !s_mutex) {
+    Serial.println("[TsLog] alloc failed, binary history disabled");
+    return;
+  }
+
+  uint32_t dataSize  = fileSize(TS_DATA_PATH);
+  uint32_t indexSize = fileSize(TS_INDEX_PATH);
+  padTail(SDLOG_TS_DATA,  dataSize,  TS_BLOCK_SIZE);
+  padTail(SDLOG_TS_INDEX, indexSize, TS_INDEX_SIZE);
+
+  scanRuns(indexSize);
+
+  uint32_t nextSeq = (dataSize + TS_BLOCK_SIZE - 1) / TS_BLOCK_SIZE;
+  s_writer = new (mem) TsBlockWriter(nextSeq);
+
+  Serial.printf("[TsLog] %s: %lu blocks, next seq %lu, %u time runs%s\n", TS_DATA_PATH,
+                indexSize / TS_INDEX_SIZE, nextSeq, s_runs.count, s_runs.overflow ? "+" : "");
+}
+
+static void sealLocked() {
+  if (s_writer->empty()) return;
+  TsBlockInfo info;
+  size_t body = s_writer->bodyUsed();
+  s_writer->seal(s_block, &info);
+
+  if (!sdLogAppendRaw(SDLOG_TS_DATA, s_block, TS_BLOCK_SIZE)) {
+    // Not in the file: reuse the block number, the samples are lost
+    s_writer->reset(info.seq);
+    s_blocksDropped++;
+    return;
+  }
+  uint8_t entry[TS_INDEX_SIZE];
+  tsEncodeIndex(info, entry);
+  if (sdLogAppendRaw(SDLOG_TS_INDEX, entry, TS_INDEX_SIZE)) s_runs.add(&info);
+  else                                                       s_indexDropped++;
+
+  s_blocksSealed++;
+  s_bodyBytes += body;
+}
+
+void tsLogFrames(const SensorData* frames, size_t count) {
+  if (!s_writer || !frames || count == 0) return;
+
+  // millis() frame stamps -> the log clock
+  uint64_t nowLog = tsLogNowMs();
+  uint32_t nowMs  = millis();
+
+  xSemaphoreTake(s_mutex, portMAX_DELAY);
+  for (size_t i = 0; i < count; i++) {
+    int32_t age = (int32_t)(nowMs - frames[i].timestamp);
+    TsSample s;
+    s.tMs = nowLog - (uint64_t)(age > 0 ? age : 0);
+    s.v[TS_CH_PRESSURE]    = tslog::quantize(frames[i].pressure,    TS_CH_PRESSURE);
+    s.v[TS_CH_CURRENT]     = tslog::quantize(frames[i].current,     TS_CH_CURRENT);
+    s.v[TS_CH_TEMPERATURE] = tslog::quantize(frames[i].temperature, TS_CH_TEMPERATURE);
+    if (!s_writer->add(s)) {
+      sealLocked();
+      s_writer->add(s);
+    }
+    s_samples++;
+  }
+  if (s_writer->current().span >= TSLOG_MAX_BLOCK_SPAN_MS) sealLocked();
+  xSemaphoreGive(s_mutex);
+}
+
+void tsLogSealBlock() {
+  if (!s_writer) return;
+  xSemaphoreTake(s_mutex, portMAX_DELAY);
+  sealLocked();
+  xSemaphoreGive(s_mutex);
+}
+
+// ================================================================
+//  Query / export
+// ================================================================
+// Index + data handles for one query; s_mutex held (s_block shared)
+struct TsFiles {
+  File     index;
+  File     data;
+  uint32_t entries = 0;
+
+  bool open() {
+    index = openForRead(TS_INDEX_PATH);
+    data  = openForRead(TS_DATA_PATH);
+    if (!index || !data) { close(); return false; }
+    entries = index.size() / TS_INDEX_SIZE;
+    return true;
+  }
+  void close() {
+    if (index) closeLocked(index);
+    if (data)  closeLocked(data);
+  }
+  bool entry(size_t i, TsBlockInfo& e) {
+    uint8_t raw[TS_INDEX_SIZE];
+    return readAt(index, i * TS_INDEX_SIZE, raw, sizeof(raw)) && tsDecodeIndex(raw, e);
+  }
+  bool block(uint32_t seq, uint8_t* out) {
+    WDT_FEED();
+    return readAt(data, seq * TS_BLOCK_SIZE, out, TS_BLOCK_SIZE);
+  }
+};
+
+bool tsLogQuery(uint64_t fromMs, uint64_t toMs, TsAggregate& out) {
+  if (!s_writer) return false;
+  TsSample* scratch = (TsSample*)psramAlloc(TS_MAX_SAMPLES * sizeof(TsSample));
+  if (!scratch) return false;
+
+  xSemaphoreTake(s_mutex, portMAX_DELAY);
+  TsFiles f;
+  bool ok = f.open();
+  if (ok) {
+    out = tsQueryRange(s_runs, f.entries, fromMs, toMs,
+                       [&](size_t i, TsBlockInfo& e) { return f.entry(i, e); },
+                       [&](uint32_t seq, uint8_t* blk) { return f.block(seq, blk); },
+                       s_block, scratch, TS_MAX_SAMPLES);
+    f.close();
+  }
+  xSemaphoreGive(s_mutex);
+  heap_caps_free(scratch);
+  return ok;
+}
+
+int32_t tsLogExportCsv(const char* outPath, uint64_t fromMs, uint64_t toMs) {
+  if (!s_writer || !outPath) return -1;
+
+  tsLogSealBlock();
+  sdLogCloseAll();                       // everything buffered is on the card
+
+  TsSample* scratch = (TsSample*)psramAlloc(TS_MAX_SAMPLES * sizeof(TsSample));
+  char*     text    = (char*)psramAlloc(TS_BLOCK_SIZE);
+  if (!scratch || !text) {
+    heap_caps_free(scratch);
+    heap_caps_free(text);
+    return -1;
+  }
+
+  int32_t rows = -1;
+  xSemaphoreTake(s_mutex, portMAX_DELAY);
+  TsFiles f;
+  File out;
+  if (f.open() && sdLogLockBus(SD_OPEN_TIMEOUT_MS)) {
+    out = sdLogFs()->open(outPath, FILE_WRITE);
+    sdLogUnlockBus();
+  }
+  if (out) {
+    rows = 0;
+    size_t pos = 0;
+    auto put = [&](const char* s, size_t n) {
+      if (pos + n > TS_BLOCK_SIZE) {
+        if (sdLogLockBus(SD_WRITE_TIMEOUT_MS)) { out.write((const uint8_t*)text, pos); sdLogUnlockBus(); }
+        pos = 0;
+      }
+      memcpy(text + pos, s, n);
+      pos += n;
+    };
+    put(TS_CSV_HEADER, strlen(TS_CSV_HEADER));
+    put("\r\n", 2);
+
+    tsForEachBlock(s_runs, f.entries, fromMs, toMs,
+                   [&](size_t i, TsBlockInfo& e) { return f.entry(i, e); },
+                   [&](const TsBlockInfo& e) {
+      if (!f.block(e.seq, s_block)) return;
+      size_t k = tsDecodeBlock(s_block, scratch, TS_MAX_SAMPLES);
+      for (size_t j = 0; j < k; j++) {
+        if (scratch[j].tMs < fromMs || scratch[j].tMs > toMs) continue;
+        char row[64];
+        put(row, tsSampleToCsv(scratch[j], row));
+        rows++;
+      }
+    });
+    if (sdLogLockBus(SD_WRITE_TIMEOUT_MS)) {
+      if (pos) out.write((const uint8_t*)text, pos);
+      out.close();
+      sdLogUnlockBus();
+    }
+  }
+  f.close();
+  xSemaphoreGive(s_mutex);
+
+  heap_caps_free(scratch);
+  heap_caps_free(text);
+  Serial.printf("[TsLog] export %s: %ld rows\n", outPath, rows);
+  return rows;
+}
+
+void printTsLogStats() {
+  Serial.println("\n=== Binary trend log ===");
+  if (!s_writer) {
+    Serial.println("not started");
+    return;
+  }
+  uint32_t pending = s_writer->count();
+  uint32_t stored  = s_samples - pending;
+  Serial.printf("Samples  : %lu (%lu in the open block)\n", s_samples, pending);
+  Serial.printf("Blocks   : %lu sealed, %lu dropped, %lu index entries dropped\n",
+                s_blocksSealed, s_blocksDropped, s_indexDropped);
+  Serial.printf("Index    : %lu entries in %u time runs%s\n", s_runs.entries, s_runs.count,
+                s_runs.overflow ? " (too many, linear search)" : "");
+  if (stored > 0) {
+    Serial.printf("Size     : %.2f B/sample on card, %.2f B/sample encoded (+%u B index/block)\n",
+                  (float)s_blocksSealed * TS_BLOCK_SIZE / stored,
+                  (float)s_bodyBytes / stored, (unsigned)TS_INDEX_SIZE);
+  }
+
+  TsAggregate a;
+  uint64_t now = tsLogNowMs();
+  uint32_t t0 = micros();
+  if (tsLogQuery(now - 3600000ULL, now, a)) {
+    Serial.printf("Last 1 h : %lu samples, P avg %.2f [%.2f, %.2f] kPa, I avg %.2f A, T max %.1f C\n",
+                  a.count, a.mean(TS_CH_PRESSURE), a.min(TS_CH_PRESSURE), a.max(TS_CH_PRESSURE),
+                  a.mean(TS_CH_CURRENT), a.max(TS_CH_TEMPERATURE));
+    Serial.printf("           %lu blocks from index, %lu decoded, %lu us\n",
+                  a.blocksFromIndex, a.blocksDecoded, micros() - t0);
+  }
+}
@@ -33,6 +33,7 @@ void UIManager::begin() {
     currentScreen  = SCREEN_MAIN;
     previousScreen = SCREEN_MAIN;
     needsRedraw    = true;
+    redrawEpoch++;
     lastUpdate     = 0;
 
     messageActive   = false;
@@ -87,6 +88,7 @@ void UIManager::update() {
     if (toastActive && (now - toastStartTime >= toastDuration)) {
         toastActive = false;
         needsRedraw = true;
+        redrawEpoch++;
     }
 
     // PIN    
@@ -109,6 +111,7 @@ void UIManager::setScreen(ScreenType screen) {
             previousScreen = currentScreen;
             currentScreen  = screen;
             needsRedraw    = true;
+            redrawEpoch++;
             Serial.printf("[UIMgr] : %d  %d\n",
                           (int)previousScreen, (int)currentScreen);
         }
@@ -118,10 +121,12 @@ void UIManager::setScreen(ScreenType screen) {
 
 void UIManager::redrawScreen() {
     needsRedraw = true;
+    redrawEpoch++;
 }
 
 void UIManager::requestRedraw() {
     needsRedraw = true;
+    redrawEpoch++;
 }
 
 // ================================================================
@@ -134,6 +139,10 @@ void UIManager::drawCurrentScreen() {
         return;
     }
 
+    // First draw after setScreen(): time it (cached background + dynamic content)
+    bool     switching = (currentScreen != drawnScreen);
+    uint32_t t0        = micros();
+
     switch (currentScreen) {
         case SCREEN_MAIN:            drawMainScreen();           break;
         case SCREEN_SETTINGS:        drawSettingsScreen();       break;
@@ -172,7 +181,12 @@ void UIManager::drawCurrentScreen() {
     if (toastActive) {
         drawToastOverlay();
     }
-    Serial.println("FL_ENTER"); Serial.flush(); uint32_t t0=millis(); tft.flush(); Serial.printf("[flush] %lums\n",millis()-t0); Serial.flush();
+    if (switching) {
+        drawnScreen  = currentScreen;
+        lastSwitchUs = micros() - t0;
+        if (lastSwitchUs > maxSwitchUs) maxSwitchUs = lastSwitchUs;
+    }
+    tft.flush();                      // dirty rects only; "gfx" prints the byte counters
 
 
 }
@@ -226,6 +240,7 @@ void UIManager::hideMessage() {
     if (!messageActive) return;
     messageActive = false;
     needsRedraw   = true;
+    redrawEpoch++;
 }
 
 // ================================================================
@@ -292,6 +307,7 @@ void UIManager::showPopupU32(const char* label, uint32_t* target,
 void UIManager::hidePopup() {
     popupActive = false;
     needsRedraw = true;
+    redrawEpoch++;
 }
 
 // ================================================================
@@ -318,6 +334,7 @@ void UIManager::exitSleepMode() {
     sleepMode = false;
     setBrightness(savedBrightness);
     needsRedraw = true;
+    redrawEpoch++;
     Serial.println("[UIMgr]  ");
 }
 
@@ -341,4 +358,6 @@ void UIManager::printStatus() {
         toastActive   ? "Y" : "N",
         popupActive   ? "Y" : "N",
         brightness);
+    Serial.printf("[UIMgr] Screen switch draw: last %lu us, max %lu us\n",
+                  lastSwitchUs, maxSwitchUs);
 }
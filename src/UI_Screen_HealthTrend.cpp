@@ -5,6 +5,7 @@
 #include "Config.h"
 #include "ManagerUI.h"
 #include "HealthMonitor.h"
+#include "DataLogger.h"
 
 using namespace UIComponents;
 using namespace UITheme;
@@ -88,19 +89,28 @@ void drawHealthTrendScreen() {
     tft.print(" 24  ()");
     
     //    ( )
-    int16_t barStartX = graphCard.x + CARD_PADDING;
+    int16_t barStartX = graphCard.x + CARD_PADDING + 30;          // room for the Y labels
     int16_t barStartY = graphCard.y + graphCard.h - CARD_PADDING - 5;
-    int16_t barWidth = 15;
-    int16_t barSpacing = 4;
+    int16_t barSpacing = 2;
     int16_t maxBarHeight = 70;
-    
-    //   ( healthMonitor  )
-    float healthData[] = {98, 97, 96, 95, 94, 93, 92, 91, 90, 89, 88, 87, 86, 85};
-    
-    for (int i = 0; i < 14; i++) {
+
+    // Hourly means from the DataLogger rollups, oldest first (NAN = no data)
+    float healthData[24];
+    int count = 0;
+#ifdef ENABLE_DATA_LOGGING
+    dataLogger.getHourlyHealthHistory(healthData, count);
+#endif
+    if (count == 0) {
+        healthData[0] = currentHealth;
+        count = 1;
+    }
+    int16_t barWidth = (graphCard.x + graphCard.w - CARD_PADDING - barStartX) / 24 - barSpacing;
+
+    for (int i = 0; i < count; i++) {
         float value = healthData[i];
+        if (isnan(value)) continue;
         int16_t barHeight = (value / 100.0f) * maxBarHeight;
-        int16_t barX = barStartX + i * (barWidth + barSpacing);
+        int16_t barX = barStartX + (24 - count + i) * (barWidth + barSpacing);
         int16_t barY = barStartY - barHeight;
         
         uint16_t barColor;
@@ -9,12 +9,13 @@ using namespace UIComponents;using namespace UITheme;
 //  
 extern uint8_t helpPageIndex;
 
-void drawHelpScreen() {
+// ================================================================
+// Static layer of a page: everything but the header. Rendered once
+// per page into the background cache.
+// ================================================================
+static void drawHelpStatic() {
     tft.fillScreen(COLOR_BG_DARK);
     
-    //   
-    drawHeader("");
-    
     //    
     int16_t startY = HEADER_HEIGHT + SPACING_SM;
     
@@ -258,6 +259,17 @@ void drawHelpScreen() {
     drawNavBar(navButtons, navCount);
 }
 
+void drawHelpScreen() {
+    uint16_t layer = bgKey(SCREEN_HELP, helpPageIndex);
+    if (!tft.bgRestore(layer)) {
+        drawHelpStatic();
+        tft.bgCapture(layer);
+    }
+    
+    //   
+    drawHeader("");
+}
+
 void handleHelpTouch(uint16_t x, uint16_t y) {
     int16_t navY = SCREEN_HEIGHT - FOOTER_HEIGHT;
     
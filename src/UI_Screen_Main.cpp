@@ -11,6 +11,10 @@
 #include "SensorManager.h"
 #include "SystemController.h"
 #include "ErrorHandler.h"
+#include "RetainedWidget.h"
+#ifdef ENABLE_PREDICTIVE_MAINTENANCE
+#include "HealthMonitor.h"
+#endif
 
 using namespace UIComponents;
 using namespace UITheme;
@@ -112,113 +116,166 @@ static void drawStatusBar() {
         tft.setCursor(bx, y + 6);
         tft.print("!         !");
     }
+}
 
-    //  (NTP  )
-    extern bool ntpSynced;
-    if (ntpSynced) {
-        extern NTPClient ntpClient;
-        String t = ntpClient.getFormattedTime();
-        tft.setTextSize(TEXT_SIZE_SMALL);
-        tft.setTextColor(COLOR_TEXT_SECONDARY);
-        int16_t tx = SCREEN_WIDTH - SPACING_SM - tft.textWidth(t.c_str());
-        tft.setCursor(tx, y + 6);
-        tft.print(t);
-    }
+// ================================================================
+//  (NTP  ) - own widget, repaints once a second
+// ================================================================
+static void drawClock(const WidgetRect& r, const String& t) {
+    tft.fillRect(r.x, r.y, r.w, r.h, COLOR_BG_CARD);
+    if (t.length() == 0) return;
+    tft.setTextSize(TEXT_SIZE_SMALL);
+    tft.setTextColor(COLOR_TEXT_SECONDARY);
+    tft.setCursor(r.x + r.w - tft.textWidth(t.c_str()), r.y);
+    tft.print(t);
+}
+
+// ================================================================
+// Retained widgets: each card is split into a frame (border, titles,
+// units) and the parts that follow the sensors, so a new reading only
+// repaints its own label / bar. Keys are built from the drawn text.
+// ================================================================
+namespace {
+
+enum MainWidget : uint8_t {
+    W_HEADER, W_STATUS, W_CLOCK,
+    W_P_CARD, W_P_VALUE, W_P_BAR,
+    W_T_CARD, W_T_VALUE, W_T_CURRENT,
+    W_PUMP_CARD, W_PUMP_DUTY, W_PUMP_BAR,
+    W_BUTTONS, W_EVENT,
+    W_MAIN_COUNT
+};
+
+WidgetTree<W_MAIN_COUNT> g_mainWidgets;
+bool g_mainDefined = false;
+
+constexpr int16_t VALUE_DY   = CARD_PADDING + 14;          // size-3 value under the card title
+constexpr int16_t VALUE_H    = 24;
+constexpr int16_t CURRENT_W  = 48;                         // "12.34A" at size 1
+constexpr int16_t DUTY_W     = 80;                         // "100%" at size 2
+constexpr int16_t CLOCK_W    = 48;                         // "12:34:56" at size 1
+
+WidgetRect cardValueRect(int16_t cx) {
+    return { (int16_t)(cx + CARD_PADDING), (int16_t)(MainLayout::CARD_ROW1_Y + VALUE_DY),
+             (int16_t)(MainLayout::CARD_W - CARD_PADDING * 2), VALUE_H };
+}
+
+void defineMainWidgets() {
+    using namespace MainLayout;
+    WidgetTree<W_MAIN_COUNT>& t = g_mainWidgets;
+    t.define(W_HEADER,    { 0, 0, SCREEN_WIDTH, HEADER_HEIGHT });
+    t.define(W_STATUS,    { 0, STATUS_BAR_Y, SCREEN_WIDTH, STATUS_BAR_H });
+    t.define(W_CLOCK,     { (int16_t)(SCREEN_WIDTH - SPACING_SM - CLOCK_W), (int16_t)(STATUS_BAR_Y + 6),
+                            CLOCK_W, 8 }, W_STATUS);
+    t.define(W_P_CARD,    { CARD_COL1_X, CARD_ROW1_Y, CARD_W, CARD_H });
+    t.define(W_P_VALUE,   cardValueRect(CARD_COL1_X), W_P_CARD);
+    t.define(W_P_BAR,     { (int16_t)(CARD_COL1_X + CARD_PADDING), (int16_t)(CARD_ROW1_Y + CARD_H - 10),
+                            (int16_t)(CARD_W - CARD_PADDING * 2), 6 }, W_P_CARD);
+    t.define(W_T_CARD,    { CARD_COL2_X, CARD_ROW1_Y, CARD_W, CARD_H });
+    t.define(W_T_VALUE,   cardValueRect(CARD_COL2_X), W_T_CARD);
+    t.define(W_T_CURRENT, { (int16_t)(CARD_COL2_X + CARD_W - CARD_PADDING - CURRENT_W),
+                            (int16_t)(CARD_ROW1_Y + CARD_PADDING), CURRENT_W, 8 }, W_T_CARD);
+    t.define(W_PUMP_CARD, { SPACING_SM, PUMP_CARD_Y, PUMP_CARD_W, PUMP_CARD_H });
+    t.define(W_PUMP_DUTY, { (int16_t)(SPACING_SM + CARD_PADDING), (int16_t)(PUMP_CARD_Y + CARD_PADDING + 16),
+                            DUTY_W, 16 }, W_PUMP_CARD);
+    t.define(W_PUMP_BAR,  { (int16_t)(SPACING_SM + CARD_PADDING), (int16_t)(PUMP_CARD_Y + PUMP_CARD_H - 12),
+                            (int16_t)(PUMP_CARD_W - CARD_PADDING * 2), 8 }, W_PUMP_CARD);
+    t.define(W_BUTTONS,   { 0, BTN_ROW_Y, SCREEN_WIDTH, BTN_H });
+    t.define(W_EVENT,     { 0, EVENT_ROW_Y, SCREEN_WIDTH, 20 });
+    g_mainDefined = true;
+}
+
+void clearWidget(uint8_t id, uint16_t color) {
+    const WidgetRect& r = g_mainWidgets.rect(id);
+    tft.fillRect(r.x, r.y, r.w, r.h, color);
+}
+
+// Card background, border, title and unit; the live parts are children
+void drawSensorCardFrame(int16_t cx, uint16_t border, const char* title, const char* unit) {
+    CardConfig card = {
+        .x = cx,
+        .y = MainLayout::CARD_ROW1_Y,
+        .w = MainLayout::CARD_W,
+        .h = MainLayout::CARD_H,
+        .bgColor = COLOR_BG_CARD,
+        .borderColor = border,
+        .elevated = false
+    };
+    drawCard(card);
+
+    tft.setTextSize(TEXT_SIZE_SMALL);
+    tft.setTextColor(COLOR_TEXT_SECONDARY);
+    tft.setCursor(card.x + CARD_PADDING, card.y + CARD_PADDING);
+    tft.print(title);
+
+    tft.setCursor(card.x + CARD_PADDING,
+                  card.y + MainLayout::CARD_H - CARD_PADDING - 12);
+    tft.print(unit);
 }
 
+void drawCardValue(uint8_t id, const char* text, uint16_t color) {
+    const WidgetRect& r = g_mainWidgets.rect(id);
+    tft.fillRect(r.x, r.y, r.w, r.h, COLOR_BG_CARD);
+    tft.setTextSize(3);
+    tft.setTextColor(color);
+    tft.setCursor(r.x, r.y);
+    tft.print(text);
+}
+
+} // namespace
+
 // ================================================================
 //    ( / )
 // ================================================================
 static void drawSensorCards() {
+    WidgetTree<W_MAIN_COUNT>& t = g_mainWidgets;
     float pressure = sensorManager.getPressure();
     float temp     = sensorManager.getTemperature();
     float current  = sensorManager.getCurrent();
 
     //    
-    {
-        CardConfig card = {
-            .x = MainLayout::CARD_COL1_X,
-            .y = MainLayout::CARD_ROW1_Y,
-            .w = MainLayout::CARD_W,
-            .h = MainLayout::CARD_H,
-            .bgColor = COLOR_BG_CARD,
-            .borderColor = pressureColor(pressure),
-            .elevated = false
-        };
-        drawCard(card);
-
-        // 
-        tft.setTextSize(TEXT_SIZE_SMALL);
-        tft.setTextColor(COLOR_TEXT_SECONDARY);
-        tft.setCursor(card.x + CARD_PADDING, card.y + CARD_PADDING);
-        tft.print("");
+    uint16_t pColor = pressureColor(pressure);
+    if (t.update(W_P_CARD, WidgetKey().add(pColor).value())) {
+        drawSensorCardFrame(MainLayout::CARD_COL1_X, pColor, "", "kPa");
+    }
 
-        //  ( )
-        char buf[16];
-        snprintf(buf, sizeof(buf), "%.1f", pressure);
-        tft.setTextSize(3);
-        tft.setTextColor(pressureColor(pressure));
-        tft.setCursor(card.x + CARD_PADDING,
-                      card.y + CARD_PADDING + 14);
-        tft.print(buf);
+    char buf[16];
+    snprintf(buf, sizeof(buf), "%.1f", pressure);
+    if (t.update(W_P_VALUE, WidgetKey().add(buf).add(pColor).value())) {
+        drawCardValue(W_P_VALUE, buf, pColor);
+    }
 
-        // 
-        tft.setTextSize(TEXT_SIZE_SMALL);
-        tft.setTextColor(COLOR_TEXT_SECONDARY);
-        tft.setCursor(card.x + CARD_PADDING,
-                      card.y + MainLayout::CARD_H - CARD_PADDING - 12);
-        tft.print("kPa");
-
-        //   
-        float pct = constrain(
-            (pressure - PRESSURE_MIN_KPA) /
-            (PRESSURE_MAX_KPA - PRESSURE_MIN_KPA) * 100.0f,
-            0.0f, 100.0f);
-        drawProgressBar(card.x + CARD_PADDING,
-                        card.y + MainLayout::CARD_H - 10,
-                        card.w - CARD_PADDING * 2, 6,
-                        pct, pressureColor(pressure));
+    //   ; keyed on the filled width in pixels
+    float pct = constrain(
+        (pressure - PRESSURE_MIN_KPA) /
+        (PRESSURE_MAX_KPA - PRESSURE_MIN_KPA) * 100.0f,
+        0.0f, 100.0f);
+    const WidgetRect& bar = t.rect(W_P_BAR);
+    int16_t fillW = (int16_t)((bar.w - 4) * pct / 100);
+    if (t.update(W_P_BAR, WidgetKey().add(fillW).add(pColor).value())) {
+        drawProgressBar(bar.x, bar.y, bar.w, bar.h, pct, pColor);
     }
 
     //    
-    {
-        CardConfig card = {
-            .x = MainLayout::CARD_COL2_X,
-            .y = MainLayout::CARD_ROW1_Y,
-            .w = MainLayout::CARD_W,
-            .h = MainLayout::CARD_H,
-            .bgColor = COLOR_BG_CARD,
-            .borderColor = tempColor(temp),
-            .elevated = false
-        };
-        drawCard(card);
-
-        tft.setTextSize(TEXT_SIZE_SMALL);
-        tft.setTextColor(COLOR_TEXT_SECONDARY);
-        tft.setCursor(card.x + CARD_PADDING, card.y + CARD_PADDING);
-        tft.print("");
-
-        char buf[16];
-        snprintf(buf, sizeof(buf), "%.1f", temp);
-        tft.setTextSize(3);
-        tft.setTextColor(tempColor(temp));
-        tft.setCursor(card.x + CARD_PADDING,
-                      card.y + CARD_PADDING + 14);
-        tft.print(buf);
+    uint16_t tColor = tempColor(temp);
+    if (t.update(W_T_CARD, WidgetKey().add(tColor).value())) {
+        drawSensorCardFrame(MainLayout::CARD_COL2_X, tColor, "", "\xB0""C");  // C ( )
+    }
 
-        tft.setTextSize(TEXT_SIZE_SMALL);
-        tft.setTextColor(COLOR_TEXT_SECONDARY);
-        tft.setCursor(card.x + CARD_PADDING,
-                      card.y + MainLayout::CARD_H - CARD_PADDING - 12);
-        tft.print("\xB0""C");  // C ( )
+    snprintf(buf, sizeof(buf), "%.1f", temp);
+    if (t.update(W_T_VALUE, WidgetKey().add(buf).add(tColor).value())) {
+        drawCardValue(W_T_VALUE, buf, tColor);
+    }
 
-        //   
-        char cBuf[16];
-        snprintf(cBuf, sizeof(cBuf), "%.2fA", current);
+    //   
+    char cBuf[16];
+    snprintf(cBuf, sizeof(cBuf), "%.2fA", current);
+    if (t.update(W_T_CURRENT, WidgetKey().add(cBuf).value())) {
+        const WidgetRect& r = t.rect(W_T_CURRENT);
+        tft.fillRect(r.x, r.y, r.w, r.h, COLOR_BG_CARD);
         tft.setTextSize(1);
         tft.setTextColor(COLOR_TEXT_SECONDARY);
-        tft.setCursor(card.x + card.w - CARD_PADDING - tft.textWidth(cBuf),
-                      card.y + CARD_PADDING);
+        tft.setCursor(r.x + r.w - tft.textWidth(cBuf), r.y);
         tft.print(cBuf);
     }
 }
@@ -229,6 +286,8 @@ static void drawSensorCards() {
 static void drawPumpCard() {
     extern float pumpDutyCycle;
     extern bool  pumpRunning;
+    extern bool  valveState[3];
+    WidgetTree<W_MAIN_COUNT>& t = g_mainWidgets;
 
     CardConfig card = {
         .x = SPACING_SM,
@@ -239,43 +298,52 @@ static void drawPumpCard() {
         .borderColor = pumpRunning ? COLOR_PRIMARY : COLOR_BORDER,
         .elevated = false
     };
-    drawCard(card);
 
-    // 
-    tft.setTextSize(TEXT_SIZE_SMALL);
-    tft.setTextColor(COLOR_TEXT_SECONDARY);
-    tft.setCursor(card.x + CARD_PADDING, card.y + CARD_PADDING);
-    tft.print("");
+    uint32_t frameKey = WidgetKey().add(pumpRunning)
+                                   .add(valveState[0] | valveState[1] << 1 | valveState[2] << 2)
+                                   .value();
+    if (t.update(W_PUMP_CARD, frameKey)) {
+        drawCard(card);
 
-    //  
-    drawBadge(card.x + CARD_PADDING + 36, card.y + CARD_PADDING - 2,
-              pumpRunning ? "" : "",
-              pumpRunning ? BADGE_SUCCESS : BADGE_INFO);
+        // 
+        tft.setTextSize(TEXT_SIZE_SMALL);
+        tft.setTextColor(COLOR_TEXT_SECONDARY);
+        tft.setCursor(card.x + CARD_PADDING, card.y + CARD_PADDING);
+        tft.print("");
+
+        //  
+        drawBadge(card.x + CARD_PADDING + 36, card.y + CARD_PADDING - 2,
+                  pumpRunning ? "" : "",
+                  pumpRunning ? BADGE_SUCCESS : BADGE_INFO);
+
+        //   ()
+        const char* vLabels[] = {"V1", "V2", "V3"};
+        for (uint8_t i = 0; i < 3; i++) {
+            int16_t vx = card.x + card.w - CARD_PADDING - (3 - i) * 42;
+            drawBadge(vx, card.y + CARD_PADDING + 14,
+                      vLabels[i],
+                      valveState[i] ? BADGE_SUCCESS : BADGE_INFO);
+        }
+    }
 
     //  
+    uint16_t color = pumpRunning ? COLOR_PRIMARY : COLOR_TEXT_DISABLED;
     char dutyBuf[16];
     snprintf(dutyBuf, sizeof(dutyBuf), "%.0f%%", pumpDutyCycle);
-    tft.setTextSize(TEXT_SIZE_MEDIUM);
-    tft.setTextColor(pumpRunning ? COLOR_PRIMARY : COLOR_TEXT_DISABLED);
-    tft.setCursor(card.x + CARD_PADDING,
-                  card.y + CARD_PADDING + 16);
-    tft.print(dutyBuf);
+    if (t.update(W_PUMP_DUTY, WidgetKey().add(dutyBuf).add(color).value())) {
+        clearWidget(W_PUMP_DUTY, COLOR_BG_CARD);
+        tft.setTextSize(TEXT_SIZE_MEDIUM);
+        tft.setTextColor(color);
+        tft.setCursor(card.x + CARD_PADDING,
+                      card.y + CARD_PADDING + 16);
+        tft.print(dutyBuf);
+    }
 
     // 
-    drawProgressBar(card.x + CARD_PADDING,
-                    card.y + MainLayout::PUMP_CARD_H - 12,
-                    card.w - CARD_PADDING * 2, 8,
-                    pumpDutyCycle,
-                    pumpRunning ? COLOR_PRIMARY : COLOR_TEXT_DISABLED);
-
-    //   ()
-    extern bool valveState[3];
-    const char* vLabels[] = {"V1", "V2", "V3"};
-    for (uint8_t i = 0; i < 3; i++) {
-        int16_t vx = card.x + card.w - CARD_PADDING - (3 - i) * 42;
-        drawBadge(vx, card.y + CARD_PADDING + 14,
-                  vLabels[i],
-                  valveState[i] ? BADGE_SUCCESS : BADGE_INFO);
+    const WidgetRect& bar = t.rect(W_PUMP_BAR);
+    int16_t fillW = (int16_t)((bar.w - 4) * constrain(pumpDutyCycle, 0.0f, 100.0f) / 100);
+    if (t.update(W_PUMP_BAR, WidgetKey().add(fillW).add(color).value())) {
+        drawProgressBar(bar.x, bar.y, bar.w, bar.h, pumpDutyCycle, color);
     }
 }
 
@@ -358,24 +426,16 @@ static void drawEventRow() {
     }
 }
 
-/// ================================================================
+// ================================================================
 // drawMainScreen - 메인 화면
+// Called every UI tick; only widgets whose key changed repaint. A
+// redraw request from UIManager (screen entry, popup closed) restores
+// the static layer (background + nav bar) from the PSRAM cache and
+// repaints every widget. "ui" on the serial console prints the frame
+// cost.
 // ================================================================
-void drawMainScreen() {
-    Serial.println("[UI] drawMainScreen called"); Serial.flush();
-    Serial.printf("[UI] fillScreen color: 0x%04X\n", COLOR_BG_DARK); Serial.flush();
- 
-    Serial.println("A1"); Serial.flush(); drawHeader("Vacuum");
-    Serial.println("A2"); Serial.flush(); // drawStatusBar disabled
-    Serial.println("A3"); Serial.flush(); // drawSensorCards disabled
-    Serial.println("A4"); Serial.flush(); // drawPumpCard disabled
-    return; // ALL DISABLED FOR TEST
-    // return disabled
-    drawSensorCards();
-    drawPumpCard();
-    drawControlButtons();
-    drawEventRow();
- 
+static void drawMainStatic() {
+    tft.fillScreen(COLOR_BG_DARK);
     NavButton nav[] = {
         {"시작", BTN_PRIMARY,   true},
         {"정지", BTN_OUTLINE, true},
@@ -384,6 +444,74 @@ void drawMainScreen() {
     drawNavBar(nav, 3);
 }
 
+void drawMainScreen() {
+    if (!g_mainDefined) defineMainWidgets();
+    WidgetTree<W_MAIN_COUNT>& t = g_mainWidgets;
+    if (t.sync(uiManager.getRedrawEpoch()) && !tft.bgRestore(bgKey(SCREEN_MAIN))) {
+        drawMainStatic();
+        tft.bgCapture(bgKey(SCREEN_MAIN));
+    }
+
+    float health = 0.0f;
+#ifdef ENABLE_PREDICTIVE_MAINTENANCE
+    extern HealthMonitor healthMonitor;
+    health = healthMonitor.getHealthScore();
+#endif
+    char hBuf[8];
+    snprintf(hBuf, sizeof(hBuf), "%.0f", health);
+    if (t.update(W_HEADER, WidgetKey().add(hBuf).add(systemController.isOperatorMode()).value())) {
+        clearWidget(W_HEADER, COLOR_BG_DARK);
+        drawHeader("Vacuum");
+    }
+
+    extern bool mqttConnected;
+    extern bool ntpSynced;
+    String clock;
+    if (ntpSynced) {
+        extern NTPClient ntpClient;
+        clock = ntpClient.getFormattedTime();
+    }
+    uint32_t statusKey = WidgetKey().add(WiFi.status() == WL_CONNECTED)
+                                    .add(mqttConnected)
+                                    .add(errorActive)
+                                    .value();
+    if (t.update(W_STATUS, statusKey)) drawStatusBar();
+    if (t.update(W_CLOCK, WidgetKey().add(clock.c_str()).value())) drawClock(t.rect(W_CLOCK), clock);
+
+    drawSensorCards();
+    drawPumpCard();
+
+    SystemPermissions perms = systemController.getPermissions();
+    uint32_t btnKey = WidgetKey().add(perms.canStart).add(perms.canStop).add(errorActive).value();
+    if (t.update(W_BUTTONS, btnKey)) {
+        clearWidget(W_BUTTONS, COLOR_BG_DARK);
+        drawControlButtons();
+    }
+
+    uint32_t eventKey = WidgetKey().add(errorActive)
+                                   .add(errorActive ? currentError.message : "")
+                                   .value();
+    if (t.update(W_EVENT, eventKey)) drawEventRow();
+}
+
+// Frame cost of the retained main screen vs a full redraw per frame
+void printMainScreenStats() {
+    const WidgetStats& s = g_mainWidgets.stats();
+    uint32_t full = (uint32_t)SCREEN_WIDTH * SCREEN_HEIGHT;
+    uint32_t n = s.frames ? s.frames : 1;
+    Serial.println("\n=== Main screen widgets ===");
+    Serial.printf("Frames %lu (full redraw %lu), widget repaints %lu\n",
+                  s.frames, s.fullFrames, s.paints);
+    Serial.printf("Avg %lu px/frame vs %lu px immediate (%lu.%lu %%)\n",
+                  (uint32_t)(s.paintedPx / n), full,
+                  (uint32_t)(s.paintedPx * 100 / ((uint64_t)full * n)),
+                  (uint32_t)(s.paintedPx * 1000 / ((uint64_t)full * n) % 10));
+}
+
+void resetMainScreenStats() {
+    g_mainWidgets.resetStats();
+}
+
 // ================================================================
 //    [U8] currentScreen    uiManager.setScreen()
 // ================================================================
@@ -13,6 +13,13 @@ using namespace UITheme;
 //  PID 
 static int8_t selectedPIDParam = -1;
 
+// Completed auto-tune whose (Tyreus-Luyben) gains are not in config yet
+static bool tuneResultPending(const PidAutotuneStatus& t) {
+    return t.state == AUTOTUNE_DONE &&
+           (config.pidKp != t.tyreusLuyben.kp || config.pidKi != t.tyreusLuyben.ki ||
+            config.pidKd != t.tyreusLuyben.kd);
+}
+
 void drawPIDScreen() {
     tft.fillScreen(COLOR_BG_DARK);
     
@@ -158,8 +165,34 @@ void drawPIDScreen() {
         drawButton(plus10Btn);
     }
     
+    // Auto-tune progress / result replaces the preview
+    PidAutotuneStatus tune = getPidAutotuneStatus();
+    if (selectedPIDParam < 0 && tune.state != AUTOTUNE_IDLE) {
+        int16_t previewY = startY + 3 * (cardH + SPACING_SM) + SPACING_SM;
+        
+        tft.setTextSize(TEXT_SIZE_SMALL);
+        tft.setTextColor(COLOR_TEXT_SECONDARY);
+        tft.setCursor(SPACING_SM + 4, previewY);
+        tft.print("Auto-tune (relay)");
+        
+        tft.setTextSize(TEXT_SIZE_MEDIUM);
+        tft.setCursor(SPACING_SM + 4, previewY + 16);
+        if (tune.state == AUTOTUNE_RUNNING) {
+            tft.setTextColor(COLOR_ACCENT);
+            tft.printf("cycle %d/%d  %lus", tune.cycles, tune.cyclesNeeded,
+                       (unsigned long)(tune.elapsedMs / 1000));
+        } else if (tune.state == AUTOTUNE_DONE) {
+            tft.setTextColor(COLOR_SUCCESS);
+            tft.printf("Kp %.2f Ki %.2f Kd %.2f", tune.tyreusLuyben.kp,
+                       tune.tyreusLuyben.ki, tune.tyreusLuyben.kd);
+        } else {
+            tft.setTextColor(COLOR_WARNING);
+            tft.print(autotuneFailureName(tune.failure));
+        }
+    }
+    
     //  PID  
-    if (selectedPIDParam < 0) {
+    else if (selectedPIDParam < 0) {
         int16_t previewY = startY + 3 * (cardH + SPACING_SM) + SPACING_SM;
         
         tft.setTextSize(TEXT_SIZE_SMALL);
@@ -192,10 +225,22 @@ void drawPIDScreen() {
         };
         drawNavBar(navButtons, 2);
     } else {
+        bool canTune = systemController.getPermissions().canChangeSettings;
+        const char* autoLabel = "Auto";
+        ButtonStyle autoStyle = BTN_PRIMARY;
+        if (tune.state == AUTOTUNE_RUNNING) {
+            autoLabel = "Stop";
+            autoStyle = BTN_DANGER;
+        } else if (tuneResultPending(tune)) {
+            autoLabel = "Apply";
+            autoStyle = BTN_SUCCESS;
+        } else {
+            canTune = canTune && currentState == STATE_IDLE;
+        }
         NavButton navButtons[] = {
             {"", BTN_OUTLINE, true},
             {"", BTN_SECONDARY, systemController.getPermissions().canChangeSettings},
-            {"Auto", BTN_PRIMARY, false} //    
+            {autoLabel, autoStyle, canTune}
         };
         drawNavBar(navButtons, 3);
     }
@@ -408,6 +453,30 @@ void handlePIDTouch(uint16_t x, uint16_t y) {
                     screenNeedsRedraw = true;
                     return;
                 }
+                
+                // Auto-tune: start / stop / apply (Tyreus-Luyben)
+                ButtonConfig autoBtn = {
+                    .x = (int16_t)(SPACING_SM + (buttonW + SPACING_SM) * 2),
+                    .y = (int16_t)(navY + 2),
+                    .w = buttonW,
+                    .h = (int16_t)(FOOTER_HEIGHT - 4),
+                    .label = "Auto",
+                    .style = BTN_PRIMARY,
+                    .enabled = true
+                };
+                
+                if (isButtonPressed(autoBtn, x, y)) {
+                    PidAutotuneStatus ts = getPidAutotuneStatus();
+                    if (ts.state == AUTOTUNE_RUNNING) {
+                        abortPidAutotune();
+                    } else if (tuneResultPending(ts)) {
+                        applyPidAutotune(AUTOTUNE_RULE_TYREUS_LUYBEN);
+                    } else {
+                        startPidAutotune();
+                    }
+                    screenNeedsRedraw = true;
+                    return;
+                }
             }
         }
     }
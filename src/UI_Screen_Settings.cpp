@@ -97,18 +97,19 @@ namespace SettingsLayout {
     constexpr int16_t  CARD_GAP  = SPACING_SM;
 }
 
-// ================================================================
-//     [U10][U11]
-// ================================================================
-void drawSettingsScreen() {
-    tft.fillScreen(COLOR_BG_DARK);   // [U11] TFT_BLACK  COLOR_BG_DARK
-    drawHeader("");
-
-    MenuItem items[20];
-    uint8_t  count = 0;
-    buildMenuItems(items, &count);
+// Static layer: cards and nav bar. The variant covers what changes
+// them besides the language (bgInvalidateAll): operator mode locks
+// manager items, the voice-alert card shows online / offline.
+static uint8_t settingsVariant() {
+    uint8_t v = systemController.isOperatorMode() ? 1 : 0;
+#ifdef ENABLE_VOICE_ALERTS
+    if (voiceAlert.isOnline()) v |= 2;
+#endif
+    return v;
+}
 
-    uint8_t rows = (count + SettingsLayout::COLS - 1) / SettingsLayout::COLS;
+static void drawSettingsStatic(const MenuItem items[], uint8_t count) {
+    tft.fillScreen(COLOR_BG_DARK);   // [U11] TFT_BLACK  COLOR_BG_DARK
 
     for (uint8_t i = 0; i < count; i++) {
         uint8_t  row = i / SettingsLayout::COLS;
@@ -162,11 +163,31 @@ void drawSettingsScreen() {
         }
     }
 
+    NavButton nav[] = {{"", BTN_OUTLINE, true}};
+    drawNavBar(nav, 1);
+}
+
+// ================================================================
+//     [U10][U11]
+// ================================================================
+void drawSettingsScreen() {
+    MenuItem items[20];
+    uint8_t  count = 0;
+    buildMenuItems(items, &count);
+
+    uint16_t layer = bgKey(SCREEN_SETTINGS, settingsVariant());
+    if (!tft.bgRestore(layer)) {
+        drawSettingsStatic(items, count);
+        tft.bgCapture(layer);
+    }
+    drawHeader("");
+
     //    ()
 #ifdef ENABLE_PREDICTIVE_MAINTENANCE
     if (!systemController.isOperatorMode()) {
         MaintenanceLevel level = healthMonitor.getMaintenanceLevel();
         if (level >= MAINTENANCE_REQUIRED) {
+            uint8_t rows = (count + SettingsLayout::COLS - 1) / SettingsLayout::COLS;
             int16_t btnY = SettingsLayout::START_Y
                            + rows * (SettingsLayout::CARD_H + SettingsLayout::CARD_GAP);
             ButtonConfig maintBtn = {
@@ -179,9 +200,6 @@ void drawSettingsScreen() {
         }
     }
 #endif
-
-    NavButton nav[] = {{"", BTN_OUTLINE, true}};
-    drawNavBar(nav, 1);
 }
 
 // ================================================================
@@ -244,7 +262,7 @@ void handleSettingsTouch(uint16_t x, uint16_t y) {
 
             //   (index 8, screen == SCREEN_SETTINGS)
             if (i == 8) {
-                currentLang = (currentLang == LANG_EN) ? LANG_KO : LANG_EN;
+                setLanguage((currentLang == LANG_EN) ? LANG_KO : LANG_EN);
                 config.language = (uint8_t)currentLang;
 #ifdef ENABLE_VOICE_ALERTS
                 if (voiceAlert.isOnline()) {
@@ -137,65 +137,50 @@ void drawStateNode(const StateNode& node, bool isActive, bool isSelected) {
 }
 
 // ================================================================
-//   
+// Layout shared by the static layer and the dynamic content
 // ================================================================
-void drawStateDiagramScreen() {
+namespace DiagramLayout {
+    constexpr int16_t STATUS_Y  = HEADER_HEIGHT + SPACING_SM;
+    constexpr int16_t STATUS_H  = 35;
+    constexpr int16_t DIAGRAM_Y = STATUS_Y + STATUS_H + SPACING_SM;
+    constexpr int16_t DIAGRAM_H = 170;
+    constexpr int16_t INFO_Y    = DIAGRAM_Y + DIAGRAM_H + SPACING_SM;
+    constexpr int16_t INFO_H    = 50;
+    constexpr int16_t CARD_X    = SPACING_SM;
+    constexpr int16_t CARD_W    = SCREEN_WIDTH - SPACING_SM * 2;
+}
+
+// ================================================================
+// Static layer of a page: card frames, arrows, nav bar. Rendered once
+// per page into the PSRAM background cache (tft.bgCapture).
+// ================================================================
+static void drawStateDiagramStatic() {
+    using namespace DiagramLayout;
     tft.fillScreen(COLOR_BG_DARK);
-    
-    //   
-    drawHeader(" ");
-    
+
     //     
-    int16_t statusY = HEADER_HEIGHT + SPACING_SM;
-    
     CardConfig statusCard = {
-        .x = SPACING_SM,
-        .y = statusY,
-        .w = (int16_t)(SCREEN_WIDTH - SPACING_SM * 2),
-        .h = 35,
+        .x = CARD_X,
+        .y = STATUS_Y,
+        .w = CARD_W,
+        .h = STATUS_H,
         .bgColor = COLOR_BG_CARD
     };
     drawCard(statusCard);
-    
+
     tft.setTextSize(TEXT_SIZE_SMALL);
     tft.setTextColor(COLOR_TEXT_SECONDARY);
     tft.setCursor(statusCard.x + CARD_PADDING, statusCard.y + CARD_PADDING);
     tft.print(" :");
-    
-    //  
-    const char* stateName = getStateName(currentState);
-    BadgeType badgeType;
-    
-    if (currentState == STATE_ERROR || currentState == STATE_EMERGENCY_STOP) {
-        badgeType = BADGE_DANGER;
-    } else if (currentState == STATE_IDLE) {
-        badgeType = BADGE_INFO;
-    } else {
-        badgeType = BADGE_SUCCESS;
-    }
-    
-    drawBadge(statusCard.x + 100, statusCard.y + CARD_PADDING, stateName, badgeType);
-    
+
     //  
-    tft.setTextColor(COLOR_TEXT_SECONDARY);
     tft.setCursor(statusCard.x + statusCard.w - 50, statusCard.y + CARD_PADDING);
     tft.printf("Page %d/2", stateDiagramPage + 1);
-    
-    //    
-    int16_t diagramY = statusCard.y + statusCard.h + SPACING_SM;
-    int16_t diagramH = 170;
-    
+
     // 
-    tft.fillRect(0, diagramY, SCREEN_WIDTH, diagramH, COLOR_BG_DARK);
-    
-    //    
-    const StateNode* nodes;
-    uint8_t nodeCount;
-    
+    tft.fillRect(0, DIAGRAM_Y, SCREEN_WIDTH, DIAGRAM_H, COLOR_BG_DARK);
+
     if (stateDiagramPage == 0) {
-        nodes = PAGE0_NODES;
-        nodeCount = PAGE0_NODE_COUNT;
-        
         // Page 0 
         drawArrow(110, 85, 170, 85, COLOR_SUCCESS);          // IDLE  VAC_ON
         drawArrow(230, 85, 290, 85, COLOR_SUCCESS);          // VAC_ON  VAC_HOLD
@@ -205,77 +190,117 @@ void drawStateDiagramScreen() {
         drawArrow(290, 155, 230, 155, COLOR_SECONDARY);      // WAIT  COMPLETE ()
         drawArrow(170, 155, 110, 155, COLOR_SUCCESS);        // COMPLETE  ()
         drawArrow(105, 105, 105, 125, COLOR_SUCCESS);        //  IDLE ()
-        
     } else {
-        nodes = PAGE1_NODES;
-        nodeCount = PAGE1_NODE_COUNT;
-        
         // Page 1  ()
         drawArrow(160, 90, 330, 90, COLOR_DANGER, true);     // WAIT  ERROR
         drawArrow(340, 110, 150, 200, COLOR_DANGER, true);   // ERROR  IDLE
         drawArrow(220, 180, 150, 210, COLOR_DANGER, true);   // EMERGENCY  IDLE
     }
-    
+
+    //   
+    CardConfig infoCard = {
+        .x = CARD_X,
+        .y = INFO_Y,
+        .w = CARD_W,
+        .h = INFO_H,
+        .bgColor = COLOR_BG_CARD
+    };
+    drawCard(infoCard);
+
+    //    
+    NavButton navButtons[] = {
+        {"", BTN_SECONDARY, stateDiagramPage > 0},
+        {"", BTN_SECONDARY, stateDiagramPage < 1},
+        {"", BTN_OUTLINE, true}
+    };
+    drawNavBar(navButtons, 3);
+}
+
+// ================================================================
+//   
+// Static layer from the background cache, then header, current
+// state, nodes and the selection text on top.
+// ================================================================
+void drawStateDiagramScreen() {
+    using namespace DiagramLayout;
+    uint16_t layer = bgKey(SCREEN_STATE_DIAGRAM, stateDiagramPage);
+    if (!tft.bgRestore(layer)) {
+        drawStateDiagramStatic();
+        tft.bgCapture(layer);
+    }
+
+    //    ( )
+    drawHeader(" ");
+
+    //  
+    const char* stateName = getStateName(currentState);
+    BadgeType badgeType;
+
+    if (currentState == STATE_ERROR || currentState == STATE_EMERGENCY_STOP) {
+        badgeType = BADGE_DANGER;
+    } else if (currentState == STATE_IDLE) {
+        badgeType = BADGE_INFO;
+    } else {
+        badgeType = BADGE_SUCCESS;
+    }
+
+    drawBadge(CARD_X + 100, STATUS_Y + CARD_PADDING, stateName, badgeType);
+
+    //    
+    const StateNode* nodes;
+    uint8_t nodeCount;
+
+    if (stateDiagramPage == 0) {
+        nodes = PAGE0_NODES;
+        nodeCount = PAGE0_NODE_COUNT;
+    } else {
+        nodes = PAGE1_NODES;
+        nodeCount = PAGE1_NODE_COUNT;
+    }
+
     //  
     for (uint8_t i = 0; i < nodeCount; i++) {
         bool isActive = (nodes[i].state == currentState);
         bool isSelected = (nodes[i].state == (SystemState)selectedState);
         drawStateNode(nodes[i], isActive, isSelected);
     }
-    
+
     //    
-    int16_t infoY = diagramY + diagramH + SPACING_SM;
-    
-    CardConfig infoCard = {
-        .x = SPACING_SM,
-        .y = infoY,
-        .w = (int16_t)(SCREEN_WIDTH - SPACING_SM * 2),
-        .h = 50,
-        .bgColor = COLOR_BG_CARD
-    };
-    drawCard(infoCard);
-    
+    int16_t textX = CARD_X + CARD_PADDING;
+    int16_t textY = INFO_Y + CARD_PADDING;
     tft.setTextSize(TEXT_SIZE_SMALL);
-    
+
     if (selectedState >= 0) {
         //   
         tft.setTextColor(COLOR_PRIMARY);
-        tft.setCursor(infoCard.x + CARD_PADDING, infoCard.y + CARD_PADDING);
+        tft.setCursor(textX, textY);
         tft.print(getStateName((SystemState)selectedState));
-        
+
         tft.setTextSize(1);
         tft.setTextColor(COLOR_TEXT_SECONDARY);
-        tft.setCursor(infoCard.x + CARD_PADDING, infoCard.y + CARD_PADDING + 16);
-        
+        tft.setCursor(textX, textY + 16);
+
         if (stateDiagramPage == 0) {
             tft.print("  ");
         } else {
             tft.print("/  ");
         }
-        
+
     } else {
         //  
         tft.setTextColor(COLOR_TEXT_SECONDARY);
-        tft.setCursor(infoCard.x + CARD_PADDING, infoCard.y + CARD_PADDING);
-        
+        tft.setCursor(textX, textY);
+
         if (stateDiagramPage == 0) {
             tft.print("   ");
-            tft.setCursor(infoCard.x + CARD_PADDING, infoCard.y + CARD_PADDING + 16);
+            tft.setCursor(textX, textY + 16);
             tft.print("     ");
         } else {
             tft.print("    ");
-            tft.setCursor(infoCard.x + CARD_PADDING, infoCard.y + CARD_PADDING + 16);
+            tft.setCursor(textX, textY + 16);
             tft.print("    ");
         }
     }
-    
-    //    
-    NavButton navButtons[] = {
-        {"", BTN_SECONDARY, stateDiagramPage > 0},
-        {"", BTN_SECONDARY, stateDiagramPage < 1},
-        {"", BTN_OUTLINE, true}
-    };
-    drawNavBar(navButtons, 3);
 }
 
 // ================================================================
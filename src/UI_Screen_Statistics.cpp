@@ -12,133 +12,117 @@
 using namespace UIComponents;
 using namespace UITheme;
 
-void drawStatisticsScreen() {
+// ================================================================
+// Card rects shared by the static layer and the values
+// ================================================================
+namespace StatsLayout {
+    constexpr int16_t START_Y = HEADER_HEIGHT + SPACING_SM;
+    constexpr int16_t CARD_W  = (SCREEN_WIDTH - SPACING_SM * 3) / 2;
+    constexpr int16_t CARD_H  = 80;
+
+    // 0 cycles, 1 success, 2 uptime, 3 errors (2 x 2 grid)
+    inline CardConfig valueCard(uint8_t i) {
+        return {
+            .x = (int16_t)(SPACING_SM + (i % 2) * (CARD_W + SPACING_SM)),
+            .y = (int16_t)(START_Y + (i / 2) * (CARD_H + SPACING_SM)),
+            .w = CARD_W,
+            .h = CARD_H,
+            .bgColor = COLOR_BG_CARD
+        };
+    }
+
+    inline CardConfig sensorCard() {
+        return {
+            .x = SPACING_SM,
+            .y = (int16_t)(START_Y + (CARD_H + SPACING_SM) * 2),
+            .w = (int16_t)(SCREEN_WIDTH - SPACING_SM * 2),
+            .h = 90,
+            .bgColor = COLOR_BG_CARD
+        };
+    }
+}
+
+// ================================================================
+// Static layer: card frames, sensor card title, nav bar. Variant 1
+// has the reset button enabled (canChangeSettings).
+// ================================================================
+static void drawStatisticsStatic(bool canReset) {
+    using namespace StatsLayout;
     tft.fillScreen(COLOR_BG_DARK);
-    
+
+    for (uint8_t i = 0; i < 4; i++) drawCard(valueCard(i));
+
+    CardConfig sensor = sensorCard();
+    drawCard(sensor);
+    tft.setTextSize(TEXT_SIZE_SMALL);
+    tft.setTextColor(COLOR_TEXT_PRIMARY);
+    tft.setCursor(sensor.x + CARD_PADDING, sensor.y + CARD_PADDING);
+    tft.print("  ( 1)");
+
+    //    
+    NavButton navButtons[] = {
+        {"", BTN_OUTLINE, true},
+        {"", BTN_DANGER, canReset}
+    };
+    drawNavBar(navButtons, 2);
+}
+
+static void drawStatValue(uint8_t card, const char* label, const char* value,
+                          const char* unit, uint16_t color) {
+    CardConfig c = StatsLayout::valueCard(card);
+    ValueDisplayConfig v = {
+        .x = (int16_t)(c.x + CARD_PADDING),
+        .y = (int16_t)(c.y + CARD_PADDING),
+        .label = label,
+        .value = value,
+        .unit = unit,
+        .valueColor = color
+    };
+    drawValueDisplay(v);
+}
+
+void drawStatisticsScreen() {
+    bool canReset = systemController.getPermissions().canChangeSettings;
+    uint16_t layer = bgKey(SCREEN_STATISTICS, canReset ? 1 : 0);
+    if (!tft.bgRestore(layer)) {
+        drawStatisticsStatic(canReset);
+        tft.bgCapture(layer);
+    }
+
     //   
     drawHeader("");
-    
-    //    
-    int16_t startY = HEADER_HEIGHT + SPACING_SM;
-    int16_t cardW = (SCREEN_WIDTH - SPACING_SM * 3) / 2;
-    int16_t cardH = 80;
-    
+
     //  
-    CardConfig cycleCard = {
-        .x = SPACING_SM,
-        .y = startY,
-        .w = cardW,
-        .h = cardH,
-        .bgColor = COLOR_BG_CARD
-    };
-    drawCard(cycleCard);
-    
     char cycleVal[16];
     snprintf(cycleVal, sizeof(cycleVal), "%lu", stats.totalCycles);
-    
-    ValueDisplayConfig cycleDisplay = {
-        .x = (int16_t)(cycleCard.x + CARD_PADDING),
-        .y = (int16_t)(cycleCard.y + CARD_PADDING),
-        .label = " ",
-        .value = cycleVal,
-        .unit = "",
-        .valueColor = COLOR_PRIMARY
-    };
-    drawValueDisplay(cycleDisplay);
-    
+    drawStatValue(0, " ", cycleVal, "", COLOR_PRIMARY);
+
     // 
-    CardConfig successCard = {
-        .x = (int16_t)(SPACING_SM + cardW + SPACING_SM),
-        .y = startY,
-        .w = cardW,
-        .h = cardH,
-        .bgColor = COLOR_BG_CARD
-    };
-    drawCard(successCard);
-    
     float successRate = (stats.totalCycles > 0) 
                         ? (float)stats.successfulCycles / stats.totalCycles * 100 
                         : 0;
-    
     char successVal[16];
     snprintf(successVal, sizeof(successVal), "%.1f", successRate);
-    
-    ValueDisplayConfig successDisplay = {
-        .x = (int16_t)(successCard.x + CARD_PADDING),
-        .y = (int16_t)(successCard.y + CARD_PADDING),
-        .label = "",
-        .value = successVal,
-        .unit = "%",
-        .valueColor = (successRate >= 95) ? COLOR_SUCCESS : COLOR_WARNING
-    };
-    drawValueDisplay(successDisplay);
-    
+    drawStatValue(1, "", successVal, "%",
+                  (successRate >= 95) ? COLOR_SUCCESS : COLOR_WARNING);
+
     //  
-    CardConfig uptimeCard = {
-        .x = SPACING_SM,
-        .y = (int16_t)(startY + cardH + SPACING_SM),
-        .w = cardW,
-        .h = cardH,
-        .bgColor = COLOR_BG_CARD
-    };
-    drawCard(uptimeCard);
-    
     uint32_t uptimeHours = stats.uptime / 3600;
-    
     char uptimeVal[16];
     snprintf(uptimeVal, sizeof(uptimeVal), "%lu", uptimeHours);
-    
-    ValueDisplayConfig uptimeDisplay = {
-        .x = (int16_t)(uptimeCard.x + CARD_PADDING),
-        .y = (int16_t)(uptimeCard.y + CARD_PADDING),
-        .label = " ",
-        .value = uptimeVal,
-        .unit = "",
-        .valueColor = COLOR_ACCENT
-    };
-    drawValueDisplay(uptimeDisplay);
-    
+    drawStatValue(2, " ", uptimeVal, "", COLOR_ACCENT);
+
     //  
-    CardConfig errorCard = {
-        .x = (int16_t)(SPACING_SM + cardW + SPACING_SM),
-        .y = (int16_t)(startY + cardH + SPACING_SM),
-        .w = cardW,
-        .h = cardH,
-        .bgColor = COLOR_BG_CARD
-    };
-    drawCard(errorCard);
-    
     char errorVal[16];
     snprintf(errorVal, sizeof(errorVal), "%u", errorHistCnt);
-    
-    ValueDisplayConfig errorDisplay = {
-        .x = (int16_t)(errorCard.x + CARD_PADDING),
-        .y = (int16_t)(errorCard.y + CARD_PADDING),
-        .label = " ",
-        .value = errorVal,
-        .unit = "",
-        .valueColor = (errorHistCnt > 10) ? COLOR_DANGER : COLOR_INFO
-    };
-    drawValueDisplay(errorDisplay);
-    
+    drawStatValue(3, " ", errorVal, "", (errorHistCnt > 10) ? COLOR_DANGER : COLOR_INFO);
+
     //    (Phase 2-3)
-    CardConfig sensorCard = {
-        .x = SPACING_SM,
-        .y = (int16_t)(startY + (cardH + SPACING_SM) * 2),
-        .w = (int16_t)(SCREEN_WIDTH - SPACING_SM * 2),
-        .h = 90,
-        .bgColor = COLOR_BG_CARD
-    };
-    drawCard(sensorCard);
-    
-    tft.setTextSize(TEXT_SIZE_SMALL);
-    tft.setTextColor(COLOR_TEXT_PRIMARY);
-    tft.setCursor(sensorCard.x + CARD_PADDING, sensorCard.y + CARD_PADDING);
-    tft.print("  ( 1)");
-    
+    CardConfig sensorCard = StatsLayout::sensorCard();
     SensorStats sensorStats;
     calculateSensorStats(sensorStats);
     
+    tft.setTextSize(TEXT_SIZE_SMALL);
     tft.setTextColor(COLOR_TEXT_SECONDARY);
     int16_t lineY = sensorCard.y + CARD_PADDING + 20;
     
@@ -153,13 +137,6 @@ void drawStatisticsScreen() {
     
     tft.setCursor(sensorCard.x + CARD_PADDING + 150, lineY + 20);
     tft.printf(": %lu", sensorStats.sampleCount);
-    
-    //    
-    NavButton navButtons[] = {
-        {"", BTN_OUTLINE, true},
-        {"", BTN_DANGER, systemController.getPermissions().canChangeSettings}
-    };
-    drawNavBar(navButtons, 2);
 }
 
 void handleStatisticsTouch(uint16_t x, uint16_t y) {
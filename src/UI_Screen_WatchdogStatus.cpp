@@ -3,6 +3,7 @@
 #include "UIComponents.h"
 #include "Config.h"
 #include "EnhancedWatchdog.h"
+#include "SafetyIsr.h"
 
 using namespace UIComponents;
 using namespace UITheme;
@@ -87,6 +88,26 @@ void drawWatchdogStatusScreen() {
         y += taskCard.h + 4;
     }
     
+    // E-stop reaction (edge -> outputs safe), worst case kept in NVS
+    SafetyLatencyStats safety = getSafetyLatencyStats();
+    CardConfig safetyCard = {
+        .x = SPACING_SM,
+        .y = y,
+        .w = (int16_t)(SCREEN_WIDTH - SPACING_SM * 2),
+        .h = 56,
+        .bgColor = COLOR_BG_CARD
+    };
+    drawCard(safetyCard);
+    
+    tft.setTextSize(TEXT_SIZE_SMALL);
+    tft.setTextColor(COLOR_TEXT_PRIMARY);
+    tft.setCursor(safetyCard.x + CARD_PADDING, safetyCard.y + CARD_PADDING);
+    tft.printf("E-STOP reaction worst %.2f us", safety.worstEverNs / 1000.0f);
+    tft.setTextColor(COLOR_TEXT_SECONDARY);
+    tft.setCursor(safetyCard.x + CARD_PADDING, safetyCard.y + CARD_PADDING + 20);
+    tft.printf("last %.2f us  trips %lu  glitch %lu",
+               safety.lastNs / 1000.0f, safety.tripsTotal, safety.glitches);
+    
     // 
     NavButton navButtons[] = {
         {"", BTN_OUTLINE, true}
@@ -3,6 +3,7 @@
 // String  char[]    
 // ================================================================
 #include "Utils.h"
+#include "SdLogService.h"
 #include <SPIFFS.h>
 #include <esp_system.h>
 #include <rom/rtc.h>
@@ -320,6 +321,7 @@ void getResetReason(char* buffer, size_t bufferSize) {
 
 void softReset() {
     Serial.println("\n  ...\n");
+    sdLogCloseAll();
     vTaskDelay(pdMS_TO_TICKS(100));
     ESP.restart();
 }
@@ -37,6 +37,10 @@
 #include "I2CBusRecovery.h"
 #include "SafeSensor.h"
 #include "SafeSD.h"
+#include "SdLogService.h"
+#include "TsLogger.h"
+#include "AdcStream.h"
+#include "LogRetentionService.h"
 #include "VoiceAlert.h"
 #include "EnhancedWatchdog.h"
 
@@ -428,7 +432,7 @@ static bool adcReadSafe(int pin, int* outRaw) {
         ESP_LOGW(TAG_SENSOR, "ADC mutex timeout");
         return false;
     }
-    *outRaw = analogRead(33);
+    *outRaw = adcOneShotRead(pin);         // -1 if the ADC stream owns the pin's unit
     xSemaphoreGive(g_adcMutex);
     if (*outRaw < 0) {
         ESP_LOGE(TAG_SENSOR, "ADC read error: %d", *outRaw);
@@ -613,24 +617,6 @@ static bool waitForNtpSync(uint32_t timeoutMs) {
     return false;
 }
 
-// [K] NTP    (1970 )
-static bool makeLogFilename(char* outBuf, size_t bufLen) {
-    if (!g_state.ntpSynced) {
-        // NTP :    ms  
-        snprintf(outBuf, bufLen, "/log_boot%lu.csv", (unsigned long)millis());
-        ESP_LOGW(TAG_SD, "NTP ,   : %s", outBuf);
-        return false;
-    }
-    unsigned long epoch = g_ntpClient.getEpochTime();
-    // epoch  tm 
-    time_t t = (time_t)epoch;
-    struct tm* tmInfo = gmtime(&t);
-    snprintf(outBuf, bufLen, "/log_%04d%02d%02d_%02d%02d%02d.csv",
-             tmInfo->tm_year + 1900, tmInfo->tm_mon + 1, tmInfo->tm_mday,
-             tmInfo->tm_hour, tmInfo->tm_min, tmInfo->tm_sec);
-    return true;
-}
-
 // ============================================================
 // [G] OTA  / 
 // ============================================================
@@ -654,6 +640,7 @@ static void suspendAllTasksForOTA() {
     if (g_taskLogger)   vTaskSuspend(g_taskLogger);
     if (g_taskVoice)    vTaskSuspend(g_taskVoice);
     if (g_taskMonitor)  vTaskSuspend(g_taskMonitor);
+    sdLogCloseAll();    // buffered log records out before the flash write
     // WDT  (OTA     )
     esp_task_wdt_delete(NULL);
 }
@@ -750,6 +737,9 @@ static bool initSDWithTimeout(uint32_t timeoutMs) {
     // CLK=9, CMD=10, D0=11
     if (SD_MMC.begin("/sdcard", true)) {  // true = 1-bit mode
         ESP_LOGI(TAG_MAIN, "SD_MMC OK");
+        initSdLogService(SD_MMC, false);
+        initTsLogger();
+        initLogRetention(SD_MMC.totalBytes());
         esp_task_wdt_reset();
         return true;
     }
@@ -1215,18 +1205,8 @@ static void taskLogger(void* pv) {
         ESP_LOGW(TAG_SD, "NTP     (  )");
     }
 
-    char filename[64];
-    makeLogFilename(filename, sizeof(filename));
-    ESP_LOGI(TAG_SD, " : %s", filename);
-
-    // CSV  
-    File logFile = SD.open(filename, FILE_APPEND);
-    if (logFile) {
-        logFile.println("timestamp_ms,pressure_kpa,temperature_c,pump_duty,estop,free_heap");
-        logFile.close();
-    } else {
-        ESP_LOGE(TAG_SD, "   : %s", filename);
-    }
+    // Rows go to /logs/telemetry.csv through the SdLog write-behind
+    // ring; SdLogService rotates it into daily / size segments
 
     uint32_t lastLogMs = 0;
 
@@ -1252,19 +1232,12 @@ static void taskLogger(void* pv) {
             }
             uint32_t heap = esp_get_free_heap_size();
 
-            // [4] SD  ( )
-            logFile = SD.open(filename, FILE_APPEND);
-            if (logFile) {
-                char row[128];
-                snprintf(row, sizeof(row),
-                         "%lu,%.2f,%.2f,%.1f,%d,%u",
-                         (unsigned long)now, p, t, d, e ? 1 : 0, heap);
-                logFile.println(row);
-                logFile.close();
-            } else {
-                ESP_LOGW(TAG_SD, "SD   (  )");
+            if (!sdLogPrintf(SDLOG_TELEMETRY, "%lu,%.2f,%.2f,%.1f,%d,%u",
+                             (unsigned long)now, p, t, d, e ? 1 : 0, heap)) {
+                ESP_LOGW(TAG_SD, "telemetry row dropped (SD log buffer full)");
             }
         }
+        logRetentionStep();
 
         vTaskDelay(pdMS_TO_TICKS(200));
     }
@@ -1631,6 +1604,8 @@ void setup() {
     Serial.println("LCD init start"); Serial.flush();
     if (tft.begin()) {
         Serial.println("LCD OK"); Serial.flush();
+        extern bool initKoreanFont();
+        initKoreanFont();
     } else {
         Serial.println("LCD FAIL"); Serial.flush();
 
@@ -1721,6 +1696,8 @@ void setup() {
                             &g_taskMonitor, 0);
     Serial.println("STEP 18f: Monitor task"); Serial.flush();
     // UI 태스크 추가
+    extern void initTouchInput();
+    initTouchInput();
     extern void uiUpdateTask(void*);
     TaskHandle_t uiTask = nullptr;
     xTaskCreatePinnedToCore(uiUpdateTask, "UIUpdate",
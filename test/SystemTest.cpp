@@ -278,15 +278,15 @@ bool SystemTest::testSensorBuffers() {
     // Test 3: Push/Pop operations
     Serial.println("\n  ??Push/Pop ?숈옉 ?뚯뒪??");
     
-    RingBuffer<float, 10> testBuffer;
+    RingBuffer<float, 16> testBuffer;
     
     // Fill buffer
-    for (int i = 0; i < 15; i++) {
+    for (int i = 0; i < 20; i++) {
         testBuffer.push((float)i);
     }
     
-    bool pushOK = testBuffer.size() == 10; // Should be capped at 10
-    Serial.printf("    Push ?뚯뒪?? %s (?ш린: %zu/10)\n", 
+    bool pushOK = testBuffer.size() == testBuffer.capacity(); // Capped at 15
+    Serial.printf("    Push ?뚯뒪?? %s (?ш린: %zu/15)\n", 
                   pushOK ? "?? : "??, testBuffer.size());
     
     // Pop test
@@ -0,0 +1,169 @@
+// ================================================================
+// Test_AdcDecimator.cpp  -  CIC decimation + calibration
+// ================================================================
+// Feeds synthetic interleaved sample streams through the same
+// AdcFramePipeline the AdcStream task uses; no ADC hardware needed.
+// ================================================================
+
+#ifdef UNIT_TEST_MODE
+
+#include "../include/UnitTest_Framework.h"
+#include "../include/AdcDecimator.h"
+#include <cmath>
+
+namespace {
+
+// Former Sensor.cpp transfer functions (analogRead path)
+float legacyPressure(int raw) {
+    float voltage = (raw / 4095.0f) * 3.3f;
+    return (voltage / 3.3f) * 200.0f;
+}
+
+float legacyCurrent(int raw) {
+    float voltage = (raw / 4095.0f) * 3.3f;
+    float current = (voltage - 1.65f) / 0.066f;
+    return current < 0 ? -current : current;
+}
+
+uint32_t lcg = 2024;
+float noise() {   // uniform in [-1, 1]
+    lcg = lcg * 1664525u + 1013904223u;
+    return (float)((lcg >> 8) & 0xFFFF) / 32767.5f - 1.0f;
+}
+
+uint16_t clampRaw(float v) {
+    if (v < 0.0f) return 0;
+    if (v > ADC_RAW_MAX) return ADC_RAW_MAX;
+    return (uint16_t)lroundf(v);
+}
+
+} // namespace
+
+void Test_AdcDecimator::runTests() {
+    TestFramework::beginModule(getName());
+
+    //  Boxcar (order 1) is an exact block average
+    {
+        CicDecimator<1, 4> box;
+        float out = 0.0f;
+        int outputs = 0;
+        float first = 0.0f, second = 0.0f;
+        for (uint16_t x = 1; x <= 8; x++) {
+            if (box.push(x, out)) {
+                if (outputs++ == 0) first = out; else second = out;
+            }
+        }
+        TestFramework::ASSERT_EQUAL_INT(2, outputs, "Boxcar emits every R samples");
+        TestFramework::ASSERT_EQUAL(2.5f, first, "Boxcar block 1 mean");
+        TestFramework::ASSERT_EQUAL(6.5f, second, "Boxcar block 2 mean");
+    }
+
+    //  CIC gain normalisation and settling
+    {
+        CicDecimator<2, 64> cic;
+        float out = 0.0f;
+        int n = 0;
+        bool settledEarly = false;
+        for (int i = 0; i < 64 * 5; i++) {
+            if (cic.push(ADC_RAW_MAX, out)) {
+                if (++n == 1) settledEarly = cic.settled();
+            }
+        }
+        TestFramework::ASSERT(!settledEarly, "CIC2 first output flagged unsettled");
+        TestFramework::ASSERT_EQUAL((float)ADC_RAW_MAX, out, "CIC2 full-scale DC passes at unity gain");
+    }
+
+    //  Calibration matches the analogRead formulas
+    {
+        bool ok = true;
+        for (int raw = 0; raw <= ADC_RAW_MAX; raw += 35) {
+            if (fabsf(ADC_CAL_PRESSURE.toUnits((float)raw) - legacyPressure(raw)) > 0.01f) ok = false;
+            if (fabsf(ADC_CAL_CURRENT.toUnits((float)raw)  - legacyCurrent(raw))  > 0.01f) ok = false;
+        }
+        TestFramework::ASSERT(ok, "Calibration equals legacy transfer functions");
+    }
+
+    //  Interleaved stream -> frames
+    {
+        constexpr uint32_t R = 64;
+        constexpr uint32_t FS_HZ = 20000;            // both channels
+        constexpr float    P_RAW = 1500.0f;          // ~73 kPa
+        constexpr float    C_RAW = 2500.0f;          // ~5.8 A
+        static AdcFramePipeline<2, R> pipe;
+
+        uint32_t frames = 0, lastSeq = 0, seqErrors = 0, lastTs = 0;
+        float worstP = 0.0f, worstC = 0.0f;
+        double rawVar = 0.0;
+        const uint32_t pairs = R * 200;
+        for (uint32_t i = 0; i < pairs; i++) {
+            uint32_t tUs = i * 2 * 1000000u / FS_HZ;
+            float nP = noise() * 40.0f;
+            rawVar += (double)nP * nP;
+            pipe.push(ADC_STREAM_CH_PRESSURE, clampRaw(P_RAW + nP), tUs);
+            if (pipe.push(ADC_STREAM_CH_CURRENT, clampRaw(C_RAW + noise() * 40.0f), tUs + 50)) {
+                const AdcFrame& f = pipe.frame();
+                if (f.seq != lastSeq + 1) seqErrors++;
+                lastSeq = f.seq;
+                lastTs = f.timestampUs;
+                frames++;
+                worstP = fmaxf(worstP, fabsf(f.pressure - ADC_CAL_PRESSURE.toUnits(P_RAW)));
+                worstC = fmaxf(worstC, fabsf(f.current  - ADC_CAL_CURRENT.toUnits(C_RAW)));
+            }
+        }
+        TestFramework::ASSERT_EQUAL_INT(200 - 1, frames, "One frame per R pairs (after settling)");
+        TestFramework::ASSERT_EQUAL_INT(0, seqErrors, "Frame seq contiguous");
+        TestFramework::ASSERT_EQUAL_INT((pairs - 1) * 2 * 1000000u / FS_HZ + 50, lastTs,
+                                        "Timestamp of last contributing sample");
+        // Raw noise sigma ~23 counts = ~1.1 kPa; decimated must be far tighter
+        float rawSigmaKpa = sqrtf((float)(rawVar / pairs)) * (200.0f / ADC_RAW_MAX);
+        TestFramework::ASSERT(worstP < rawSigmaKpa * 0.5f, "Pressure noise reduced by decimation");
+        TestFramework::ASSERT(worstC < 0.5f, "Current within 0.5 A of DC level");
+        Serial.printf("    raw sigma %.3f kPa, worst decimated error %.3f kPa / %.3f A\n",
+                      rawSigmaKpa, worstP, worstC);
+    }
+
+    //  Tone at the per-channel output rate lands in a CIC null
+    {
+        constexpr uint32_t R = 64;
+        static AdcFramePipeline<2, R> pipe;
+        float worst = 0.0f;
+        for (uint32_t i = 0; i < R * 50; i++) {
+            float tone = 800.0f * sinf(2.0f * 3.14159265f * (float)(i % R) / R + 0.3f);
+            pipe.push(ADC_STREAM_CH_PRESSURE, clampRaw(2048.0f + tone), i);
+            if (pipe.push(ADC_STREAM_CH_CURRENT, 2048, i)) {
+                worst = fmaxf(worst, fabsf(pipe.frame().rawPressure - 2048.0f));
+            }
+        }
+        TestFramework::ASSERT(worst < 2.0f, "Interference at fs/R rejected");
+    }
+
+    //  Step response settles in ORDER outputs
+    {
+        static AdcFramePipeline<2, 16> pipe;
+        for (int i = 0; i < 16 * 4; i++) {
+            pipe.push(ADC_STREAM_CH_PRESSURE, 0, i);
+            pipe.push(ADC_STREAM_CH_CURRENT, 0, i);
+        }
+        float after[3] = {0, 0, 0};
+        int k = 0;
+        for (int i = 0; i < 16 * 3; i++) {
+            pipe.push(ADC_STREAM_CH_PRESSURE, 4000, i);
+            if (pipe.push(ADC_STREAM_CH_CURRENT, 0, i) && k < 3) after[k++] = pipe.frame().rawPressure;
+        }
+        TestFramework::ASSERT(after[0] > 0.0f && after[0] < 4000.0f, "Step: first output in transition");
+        TestFramework::ASSERT_EQUAL(4000.0f, after[1], "Step: settled after ORDER outputs");
+    }
+
+    //  Bad input is counted, not decimated
+    {
+        AdcFramePipeline<1, 4> pipe;
+        pipe.push(ADC_STREAM_CH_COUNT, 100, 0);
+        pipe.push(ADC_STREAM_CH_PRESSURE, 5000, 0);
+        TestFramework::ASSERT_EQUAL_INT(2, pipe.rejectedCount(), "Invalid channel/raw rejected");
+        TestFramework::ASSERT_EQUAL_INT(0, pipe.samplesIn(), "Rejected samples not consumed");
+    }
+
+    TestFramework::endModule();
+}
+
+#endif // UNIT_TEST_MODE
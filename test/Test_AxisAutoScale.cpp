@@ -0,0 +1,86 @@
+// ================================================================
+// Test_AxisAutoScale.cpp  -  trend graph Y-axis hysteresis
+// ================================================================
+// Drives AxisScaler with a noisy signal at the 100 ms graph rate and
+// counts axis changes: noise inside the axis must not move it, a step
+// out must refit at once, a collapse must wait for the hold time.
+// ================================================================
+
+#ifdef UNIT_TEST_MODE
+
+#include "../include/UnitTest_Framework.h"
+#include "../include/AxisAutoScale.h"
+
+namespace {
+
+uint32_t g_seed = 777;
+float noise() {
+    g_seed = g_seed * 1103515245u + 12345u;
+    return ((g_seed >> 8) & 0xFFFF) / 65535.0f - 0.5f;
+}
+
+} // namespace
+
+void Test_AxisAutoScale::runTests() {
+    TestFramework::beginModule(getName());
+
+    //  1-2-5 steps and snapped limits
+    {
+        bool steps = AxisScaler::niceStep(0.7f) == 1.0f && AxisScaler::niceStep(1.3f) == 2.0f
+                  && AxisScaler::niceStep(3.0f) == 5.0f && fabsf(AxisScaler::niceStep(7.0f) - 10.0f) < 1e-4f
+                  && fabsf(AxisScaler::niceStep(0.03f) - 0.05f) < 1e-6f;
+        TestFramework::ASSERT(steps, "1-2-5 grid steps");
+
+        AxisScaler s;
+        s.begin({ 0.1f, 10.0f, NAN }, 3000);
+        s.update(-63.0f, -41.0f, 0);
+        TestFramework::ASSERT(s.lo() <= -63.0f && s.hi() >= -41.0f, "Fit covers the data");
+        TestFramework::ASSERT(fmodf(s.lo(), 5.0f) == 0.0f && fmodf(s.hi(), 5.0f) == 0.0f, "Limits on the grid step");
+    }
+
+    //  Noise inside the axis: no thrash
+    {
+        AxisScaler s;
+        s.begin({ 0.1f, 10.0f, NAN }, 3000);
+        uint32_t changes = 0;
+        for (uint32_t t = 0; t < 600000; t += 100) {          // 10 min
+            float a = -60.0f + noise() * 8.0f, b = -60.0f + noise() * 8.0f;
+            if (s.update(fminf(a, b), fmaxf(a, b), t)) changes++;
+        }
+        TestFramework::ASSERT(changes <= 3, "Jittery data: axis settles");
+    }
+
+    //  Step out grows at once, collapse shrinks after the hold
+    {
+        AxisScaler s;
+        s.begin({ 0.1f, 1.0f, 0.0f }, 3000);
+        s.update(0.5f, 2.0f, 0);
+        bool grew = s.update(0.5f, 4.5f, 100) && s.hi() >= 4.5f;
+        TestFramework::ASSERT(grew, "Data above the axis -> immediate refit");
+
+        float hiBefore = s.hi();
+        bool early = s.update(0.5f, 0.8f, 200) || s.update(0.5f, 0.8f, 2000);
+        bool late = s.update(0.5f, 0.8f, 3300);
+        TestFramework::ASSERT(!early && s.hi() < hiBefore && late, "Shrink only after the hold time");
+
+        bool regrew = s.update(0.5f, 3.0f, 3400);
+        TestFramework::ASSERT(regrew && s.hi() >= 3.0f, "Growth never clips");
+    }
+
+    //  Floor and flat data
+    {
+        AxisScaler s;
+        s.begin({ 0.1f, 1.0f, 0.0f }, 3000);
+        s.update(0.0f, 0.0f, 0);
+        TestFramework::ASSERT(s.lo() == 0.0f && s.hi() >= 1.0f, "Flat current at 0 -> [0, 1]");
+
+        AxisScaler p;
+        p.begin({ 0.1f, 10.0f, NAN }, 3000);
+        p.update(-50.0f, -50.0f, 0);
+        TestFramework::ASSERT(p.lo() <= -55.0f && p.hi() >= -45.0f, "Flat pressure -> +-5 kPa");
+    }
+
+    TestFramework::endModule();
+}
+
+#endif // UNIT_TEST_MODE
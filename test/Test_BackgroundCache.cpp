@@ -0,0 +1,95 @@
+// ================================================================
+// Test_BackgroundCache.cpp  -  per-screen static layer cache
+// ================================================================
+// Miss -> capture -> hit, LRU eviction reusing the evicted buffer,
+// language-change invalidation and a failed PSRAM allocation.
+// ================================================================
+
+#ifdef UNIT_TEST_MODE
+
+#include "../include/UnitTest_Framework.h"
+#include "../include/BackgroundCache.h"
+#include <cstdlib>
+
+namespace {
+
+const uint32_t BYTES = 64;
+uint32_t g_allocs = 0;
+bool     g_failAlloc = false;
+
+void* testAlloc(uint32_t bytes) {
+    if (g_failAlloc) return nullptr;
+    g_allocs++;
+    return malloc(bytes);
+}
+
+// Stand-in for a rendered layer
+void render(uint16_t* px, uint16_t key) {
+    for (uint32_t i = 0; i < BYTES / 2; i++) px[i] = (uint16_t)(key + i);
+}
+
+} // namespace
+
+void Test_BackgroundCache::runTests() {
+    TestFramework::beginModule(getName());
+
+    BackgroundCache<2> c;
+    const uint16_t MAIN = bgKey(0), DIAG0 = bgKey(10, 0), DIAG1 = bgKey(10, 1);
+    TestFramework::ASSERT(DIAG0 != DIAG1 && MAIN != DIAG0, "Variants get their own key");
+
+    //  Miss, capture, hit
+    {
+        bool miss = c.find(MAIN) == nullptr;
+        uint16_t* px = c.claim(MAIN, BYTES, testAlloc);
+        bool uncommitted = c.find(MAIN) == nullptr;
+        render(px, MAIN);
+        c.commit(MAIN);
+        const uint16_t* hit = c.find(MAIN);
+        TestFramework::ASSERT(miss && uncommitted, "First use misses, claimed layer not valid before commit");
+        TestFramework::ASSERT(hit == px && hit[5] == MAIN + 5, "Committed layer is returned");
+    }
+
+    //  LRU eviction reuses the buffer
+    {
+        render(c.claim(DIAG0, BYTES, testAlloc), DIAG0);
+        c.commit(DIAG0);
+        c.find(MAIN);                                        // MAIN newer than DIAG0
+        uint32_t allocsBefore = g_allocs;
+        render(c.claim(DIAG1, BYTES, testAlloc), DIAG1);
+        c.commit(DIAG1);
+        bool evicted = c.find(DIAG0) == nullptr;
+        bool kept = c.find(MAIN) != nullptr && c.find(DIAG1) != nullptr;
+        TestFramework::ASSERT(evicted && kept, "Least recently used layer evicted");
+        TestFramework::ASSERT(g_allocs == allocsBefore && c.used() == 2, "Evicted buffer reused, no new PSRAM");
+        TestFramework::ASSERT_EQUAL_INT(1, (int)c.stats().evictions, "Eviction counted");
+    }
+
+    //  Language change: every layer re-renders once
+    {
+        c.invalidateAll();
+        bool stale = c.find(MAIN) == nullptr && c.find(DIAG1) == nullptr;
+        uint32_t allocsBefore = g_allocs;
+        uint16_t* px = c.claim(MAIN, BYTES, testAlloc);
+        render(px, MAIN);
+        c.commit(MAIN);
+        TestFramework::ASSERT(stale && c.find(MAIN) == px && g_allocs == allocsBefore,
+                              "invalidateAll() -> re-render into the same buffer");
+        c.invalidate(MAIN);
+        TestFramework::ASSERT(c.find(MAIN) == nullptr, "Single layer invalidated");
+    }
+
+    //  No PSRAM: no cache, the screen draws as before
+    {
+        BackgroundCache<1> d;
+        g_failAlloc = true;
+        bool none = d.claim(MAIN, BYTES, testAlloc) == nullptr;
+        d.commit(MAIN);
+        g_failAlloc = false;
+        TestFramework::ASSERT(none && d.find(MAIN) == nullptr && d.stats().allocFails == 1,
+                              "Failed allocation leaves the layer uncached");
+    }
+
+    TestFramework::endModule();
+}
+
+#endif // UNIT_TEST_MODE
@@ -0,0 +1,116 @@
+// ================================================================
+// Test_BuzzerPattern.cpp  -  buzzer bytecode sequencer
+// ================================================================
+// Edge timing of the pattern table, repeat, priority preemption and
+// drift-free stepping when updates arrive late.
+// ================================================================
+
+#ifdef UNIT_TEST_MODE
+
+#include "../include/UnitTest_Framework.h"
+#include "../include/BuzzerPattern.h"
+#include <string>
+
+namespace {
+
+// Output edges as "t+/t-" (ms relative to start), sampled every 1 ms
+std::string edgeTrace(BuzzerSequencer& s, uint32_t t0, uint32_t spanMs) {
+    std::string out;
+    bool last = false;
+    for (uint32_t t = t0; t <= t0 + spanMs; t++) {
+        bool lv = s.update(t);
+        if (lv != last) {
+            out += std::to_string(t - t0);
+            out += lv ? "+ " : "- ";
+            last = lv;
+        }
+    }
+    return out;
+}
+
+} // namespace
+
+void Test_BuzzerPattern::runTests() {
+    TestFramework::beginModule(getName());
+
+    //  Pattern timing
+    {
+        BuzzerSequencer s;
+        s.play(BZ_PAT_TEMP_WARNING, 1000);
+        TestFramework::ASSERT_STRING("0+ 200- 300+ 500- ", edgeTrace(s, 1000, 1000).c_str(),
+                                     "Temperature warning: 200 on / 100 off / 200 on");
+        TestFramework::ASSERT(!s.playing(), "Pattern ends");
+
+        s.play(BZ_PAT_MAINT_URGENT, 0);
+        TestFramework::ASSERT_STRING("0+ 300- 500+ 800- 1000+ 1300- ", edgeTrace(s, 0, 2000).c_str(),
+                                     "Repeat(3): three 300 ms beeps");
+    }
+
+    //  Returns at once, output follows the clock
+    {
+        BuzzerSequencer s;
+        TestFramework::ASSERT(s.play(BZ_PAT_ESTOP, 5000), "play() accepted");
+        TestFramework::ASSERT(s.output(), "Output on immediately");
+        TestFramework::ASSERT_EQUAL_INT(6000, (int)s.nextDeadline(), "Next deadline = end of 1 s tone");
+        TestFramework::ASSERT(s.update(5999), "Still on at 999 ms");
+        TestFramework::ASSERT(!s.update(6000), "Off at 1000 ms");
+    }
+
+    //  Priority: E-stop preempts a warning; a warning cannot cut the E-stop tone
+    {
+        BuzzerSequencer s;
+        s.play(BZ_PAT_TEMP_WARNING, 0);
+        s.update(150);
+        TestFramework::ASSERT(s.play(BZ_PAT_ESTOP, 150), "E-stop preempts warning");
+        TestFramework::ASSERT(!s.play(BZ_PAT_TEMP_WARNING, 300), "Warning refused during E-stop");
+        TestFramework::ASSERT(!s.play(BZ_PAT_SHORT, 300), "Info refused during E-stop");
+        TestFramework::ASSERT_EQUAL_INT(BZ_PAT_ESTOP, s.current(), "E-stop still playing");
+        TestFramework::ASSERT(s.update(1149), "E-stop tone runs its full second");
+        TestFramework::ASSERT(!s.update(1150), "... and ends on time");
+        TestFramework::ASSERT(s.play(BZ_PAT_SHORT, 1200), "Idle again: info accepted");
+        TestFramework::ASSERT(s.play(BZ_PAT_SUCCESS, 1210), "Same priority restarts");
+        TestFramework::ASSERT_EQUAL_INT(BZ_PAT_SUCCESS, s.current(), "Newest same-priority pattern wins");
+    }
+
+    //  Late updates: deadlines accumulate, no drift
+    {
+        BuzzerSequencer s;
+        s.play(BZ_PAT_SUCCESS, 0);          // 80 on, 40 off, 80 on
+        s.update(95);                        // 15 ms late
+        TestFramework::ASSERT(!s.output(), "Late update lands in the gap");
+        TestFramework::ASSERT_EQUAL_INT(120, (int)s.nextDeadline(), "Gap still ends at 120 ms");
+        s.update(250);                       // skips the whole second beep
+        TestFramework::ASSERT(!s.playing(), "Very late update finishes the pattern");
+    }
+
+    //  Clock wrap
+    {
+        BuzzerSequencer s;
+        s.play(BZ_PAT_ERROR, 0xFFFFFF00u);
+        TestFramework::ASSERT(s.update(0xFFFFFFF0u), "On before wrap");
+        TestFramework::ASSERT(s.update(100), "Still on across the wrap");
+        TestFramework::ASSERT(!s.update(244), "Off 500 ms after start");
+    }
+
+    //  Invalid ids, stop
+    {
+        BuzzerSequencer s;
+        TestFramework::ASSERT(!s.play(BZ_PAT_NONE, 0), "NONE refused");
+        TestFramework::ASSERT(!s.play(BZ_PAT_COUNT, 0), "Out of range refused");
+        s.play(BZ_PAT_ERROR, 0);
+        s.stop();
+        TestFramework::ASSERT(!s.playing() && !s.output(), "stop() silences");
+        bool allEnd = true;
+        for (int id = 1; id < BZ_PAT_COUNT; id++) {
+            BuzzerSequencer t;
+            t.play((BuzzerPatternId)id, 0);
+            t.update(20000);
+            if (t.playing()) allEnd = false;
+        }
+        TestFramework::ASSERT(allEnd, "Every pattern terminates");
+    }
+
+    TestFramework::endModule();
+}
+
+#endif // UNIT_TEST_MODE
@@ -0,0 +1,164 @@
+// ================================================================
+// Test_DirtyRegion.cpp  -  TFT_GFX damage tracking / flush bands
+// ================================================================
+// Merging rules, clipping, slot overflow and the row-band coalescing
+// of full-frame flushes and the present job list, checked against a per-pixel damage mask so
+// nothing drawn can be missed by a flush.
+// ================================================================
+
+#ifdef UNIT_TEST_MODE
+
+#include "../include/UnitTest_Framework.h"
+#include "../include/DirtyRegion.h"
+#include <vector>
+
+namespace {
+
+const int16_t W = 320, H = 480;
+
+uint32_t g_seed = 4242;
+uint32_t rnd(uint32_t n) {
+    g_seed = g_seed * 1103515245u + 12345u;
+    return (g_seed >> 8) % n;
+}
+
+template <uint8_t N>
+bool covers(const DirtyRegion<N>& d, const std::vector<bool>& mask) {
+    for (int16_t y = 0; y < H; y++) {
+        for (int16_t x = 0; x < W; x++) {
+            if (!mask[y * W + x]) continue;
+            bool in = false;
+            for (uint8_t i = 0; i < d.count() && !in; i++) in = d.rect(i).contains(x, y);
+            if (!in) return false;
+        }
+    }
+    return true;
+}
+
+void paint(std::vector<bool>& mask, int32_t x, int32_t y, int32_t w, int32_t h) {
+    for (int32_t j = y; j < y + h; j++)
+        for (int32_t i = x; i < x + w; i++)
+            if (i >= 0 && i < W && j >= 0 && j < H) mask[j * W + i] = true;
+}
+
+} // namespace
+
+void Test_DirtyRegion::runTests() {
+    TestFramework::beginModule(getName());
+
+    //  Merge / keep apart / clip
+    {
+        DirtyRegion<8> d;
+        d.add(10, 10, 50, 20);
+        d.add(30, 15, 50, 20);                               // overlaps
+        TestFramework::ASSERT_EQUAL_INT(1, d.count(), "Overlapping boxes merge");
+
+        d.add(62, 10, 20, 20);                               // 2 px gap -> cheaper as one
+        TestFramework::ASSERT_EQUAL_INT(1, d.count(), "Nearby box joins");
+
+        d.add(250, 400, 40, 16);                             // far corner
+        TestFramework::ASSERT_EQUAL_INT(2, d.count(), "Distant box kept separate");
+
+        d.add(-20, -20, 25, 25);                             // partly off screen
+        d.add(400, 10, 10, 10);                              // fully off screen
+        bool clipped = true;
+        for (uint8_t i = 0; i < d.count(); i++) {
+            const DirtyRect& r = d.rect(i);
+            clipped = clipped && r.x >= 0 && r.y >= 0 && r.right() <= W && r.bottom() <= H;
+        }
+        TestFramework::ASSERT(clipped && d.count() <= 3, "Clipped to the screen, off-screen ignored");
+        TestFramework::ASSERT(!d.full() && d.pixels() < (uint32_t)W * H / 10, "Small damage stays small");
+    }
+
+    //  Slot overflow: never lose a pixel, stay within MAX_RECTS
+    {
+        bool allCovered = true, bounded = true;
+        uint32_t fullFrames = 0;
+        uint64_t pushed = 0;
+        for (int frame = 0; frame < 200; frame++) {
+            DirtyRegion<8> d;
+            std::vector<bool> mask(W * H, false);
+            int n = 1 + rnd(30);
+            for (int k = 0; k < n; k++) {
+                int32_t w = 4 + rnd(60), h = 8 + rnd(20);
+                int32_t x = (int32_t)rnd(W + 20) - 10, y = (int32_t)rnd(H + 20) - 10;
+                d.add(x, y, w, h);
+                paint(mask, x, y, w, h);
+            }
+            allCovered = allCovered && covers(d, mask);
+            bounded = bounded && d.count() <= 8;
+            if (d.full()) fullFrames++;
+            pushed += d.pixels();
+        }
+        TestFramework::ASSERT(allCovered, "Every drawn pixel inside a dirty rect");
+        TestFramework::ASSERT(bounded, "Never more than MAX_RECTS");
+        TestFramework::ASSERT(fullFrames < 20, "Scattered widgets rarely promote to full frame");
+        TestFramework::ASSERT(pushed / 200 < (uint64_t)W * H / 2, "Average push under half a frame");
+    }
+
+    //  Typical value refresh: a few text fields -> a few KB, not 300 KB
+    {
+        DirtyRegion<8> d;
+        for (int i = 0; i < 4; i++) d.add(120, 80 + i * 40, 96, 18);   // four numeric labels
+        d.add(10, 440, 300, 30);                                       // status bar
+        uint32_t bytes = d.pixels() * 2;
+        TestFramework::ASSERT(bytes < 40000, "Value refresh under 40 KB");
+    }
+
+    //  Full-frame promotion and fillScreen()
+    {
+        DirtyRegion<8> d;
+        d.add(0, 0, W, H / 2);
+        d.add(0, H / 2, W, H * 4 / 10);                      // 90 %
+        TestFramework::ASSERT(d.full() && d.count() == 1 && d.pixels() == (uint32_t)W * H,
+                              "Large damage becomes one full rect");
+        d.add(5, 5, 5, 5);
+        TestFramework::ASSERT_EQUAL_INT(1, d.count(), "Adds after full are absorbed");
+        d.clear();
+        TestFramework::ASSERT(d.empty() && !d.full(), "Cleared after flush");
+    }
+
+    //  Row hashes and band coalescing for full-frame flushes
+    {
+        static uint16_t fb[W * H];
+        static uint32_t hashes[H];
+        for (int i = 0; i < W * H; i++) fb[i] = 0x1234;
+        for (int y = 0; y < H; y++) hashes[y] = dirty::rowHash(fb + y * W, W);
+
+        // fillScreen + redraw of the same content except two labels
+        for (int x = 100; x < 200; x++) { fb[50 * W + x] = 0xFFFF; fb[52 * W + x] = 0xFFFF; fb[300 * W + x] = 0; }
+        static bool changed[H];
+        for (int y = 0; y < H; y++) changed[y] = dirty::rowHash(fb + y * W, W) != hashes[y];
+
+        std::vector<std::pair<int16_t, int16_t>> bands;
+        dirty::changedRuns(changed, H, W, [&](int16_t y, int16_t h) { bands.push_back({ y, h }); });
+        bool ok = bands.size() == 2 && bands[0].first == 50 && bands[0].second == 3
+               && bands[1].first == 300 && bands[1].second == 1;
+        TestFramework::ASSERT(ok, "Changed rows -> 2 bands, 1-row gap pushed along");
+        TestFramework::ASSERT(dirty::rowHash(fb, 0) != 0, "Hash 0 reserved for unknown");
+    }
+
+    //  Present job list: overflow widens the last entry, nothing dropped
+    {
+        DirtyList<4> job;
+        std::vector<bool> mask(W * H, false);
+        for (int16_t k = 0; k < 9; k++) {
+            DirtyRect r = { (int16_t)(k * 30), (int16_t)(k * 50), 20, 10 };
+            job.add(r);
+            paint(mask, r.x, r.y, r.w, r.h);
+        }
+        bool in = true;
+        for (int16_t y = 0; y < H; y++)
+            for (int16_t x = 0; x < W; x++) {
+                if (!mask[y * W + x]) continue;
+                bool hit = false;
+                for (uint8_t i = 0; i < job.n && !hit; i++) hit = job.r[i].contains(x, y);
+                in = in && hit;
+            }
+        TestFramework::ASSERT(job.n == 4 && in, "Job list overflow keeps every rect covered");
+    }
+
+    TestFramework::endModule();
+}
+
+#endif // UNIT_TEST_MODE
@@ -0,0 +1,190 @@
+// ================================================================
+// Test_GestureRecognizer.cpp  -  touch traces -> gestures
+// ================================================================
+// Recorded AXS15231B sample traces (only changes, as the INT reader
+// queues them) replayed through the recognizer on the UI task's 50 ms
+// tick: tap, contact bounce, long press, slow drag, swipes, drag
+// coalescing, a held finger against the old 50 ms poll, and a lift
+// that finds the reader queue full.
+// ================================================================
+
+#ifdef UNIT_TEST_MODE
+
+#include "../include/UnitTest_Framework.h"
+#include "../include/GestureRecognizer.h"
+#include <deque>
+#include <vector>
+
+namespace {
+
+const uint32_t UI_TICK_MS = 50;
+
+// Replay like handleTouch(): every UI tick drains the samples queued
+// since the last one, ticks the recognizer and collects its gestures
+std::vector<Gesture> replay(GestureRecognizer& r, const std::vector<TouchSample>& trace,
+                            uint32_t endMs, bool drainEachTick = true) {
+    std::vector<Gesture> out;
+    size_t i = 0;
+    for (uint32_t t = UI_TICK_MS; t <= endMs; t += UI_TICK_MS) {
+        while (i < trace.size() && trace[i].ms <= t) r.feed(trace[i++]);
+        r.tick(t);
+        Gesture g;
+        while (drainEachTick && r.next(g)) out.push_back(g);
+    }
+    Gesture g;
+    while (r.next(g)) out.push_back(g);
+    return out;
+}
+
+// Finger moving in a straight line, one report every 16 ms
+void stroke(std::vector<TouchSample>& t, uint32_t ms0, int16_t x0, int16_t y0,
+            int16_t x1, int16_t y1, uint32_t durationMs) {
+    uint32_t steps = durationMs / 16;
+    for (uint32_t k = 0; k <= steps; k++) {
+        t.push_back({ ms0 + k * 16, (int16_t)(x0 + (x1 - x0) * (int32_t)k / (int32_t)steps),
+                      (int16_t)(y0 + (y1 - y0) * (int32_t)k / (int32_t)steps), true });
+    }
+    t.push_back({ ms0 + steps * 16 + 16, 0, 0, false });
+}
+
+// Reader (15 ms follow period) against a 16-deep queue while the UI
+// task stalls from 50 to 450 ms. The finger drags right and lifts at
+// 300 ms, inside the stall. commitDropped: the old reader, which took
+// a change as sent even when the queue refused it.
+std::vector<Gesture> stalledDrag(GestureRecognizer& r, TouchChangeTracker& last,
+                                 uint32_t& drops, bool commitDropped) {
+    const size_t DEPTH = 16;
+    std::deque<TouchSample> q;
+    std::vector<Gesture> out;
+    drops = 0;
+    for (uint32_t t = 0; t <= 1200; t += 5) {
+        if (t % UI_TICK_MS == 0 && (t < 50 || t >= 450)) {
+            while (!q.empty()) { r.feed(q.front()); q.pop_front(); }
+            r.tick(t);
+            Gesture g;
+            while (r.next(g)) out.push_back(g);
+        }
+        if (t % 15) continue;
+        bool down = t < 300;
+        int16_t x = down ? (int16_t)(20 + t / 2) : 0;
+        if (!last.changed(down, x, 100)) { last.pending = false; continue; }
+        TouchSample s = { t, x, 100, down };
+        if (q.size() < DEPTH) {
+            q.push_back(s);
+            last.sent(s);
+        } else {
+            drops++;
+            if (commitDropped) last.sent(s);
+            else               last.dropped();
+        }
+    }
+    return out;
+}
+
+int sumDx(const std::vector<Gesture>& g) {
+    int s = 0;
+    for (const Gesture& e : g) if (e.type == GESTURE_DRAG) s += e.dx;
+    return s;
+}
+
+} // namespace
+
+void Test_GestureRecognizer::runTests() {
+    TestFramework::beginModule(getName());
+
+    //  Tap, with jitter inside the slop
+    {
+        GestureRecognizer r;
+        std::vector<TouchSample> t = {
+            { 10, 100, 200, true }, { 26, 103, 201, true }, { 42, 101, 199, true }, { 95, 0, 0, false },
+        };
+        std::vector<Gesture> g = replay(r, t, 300);
+        TestFramework::ASSERT(g.size() == 1 && g[0].type == GESTURE_TAP && g[0].x == 100 && g[0].y == 200,
+                              "Press and release -> one tap at the press point");
+    }
+
+    //  Contact bounce: a 15 ms lift inside the touch
+    {
+        GestureRecognizer r;
+        std::vector<TouchSample> t = {
+            { 10, 60, 400, true }, { 40, 0, 0, false }, { 55, 61, 400, true }, { 130, 0, 0, false },
+        };
+        std::vector<Gesture> g = replay(r, t, 300);
+        TestFramework::ASSERT(g.size() == 1 && g[0].type == GESTURE_TAP && r.stats().bounces == 1,
+                              "Bounced lift merges into one tap");
+    }
+
+    //  Long press: emitted by tick() while held, nothing on release
+    {
+        GestureRecognizer r;
+        std::vector<TouchSample> t = { { 10, 160, 240, true }, { 200, 162, 241, true }, { 1200, 0, 0, false } };
+        std::vector<Gesture> g = replay(r, t, 1500);
+        TestFramework::ASSERT(g.size() == 1 && g[0].type == GESTURE_LONG_PRESS && g[0].ms <= 10 + 600 + UI_TICK_MS,
+                              "Held finger -> one long press within a UI tick of 600 ms");
+
+        // The old poll called the screen handler on every 50 ms tick while held
+        uint32_t polledCalls = (1200 - 10) / UI_TICK_MS;
+        Serial.printf("    1.2 s hold: polled dispatch %u handler calls, recognizer %u gesture\n",
+                      polledCalls, (unsigned)g.size());
+    }
+
+    //  Slow drag: deltas add up to the finger travel, ends with DRAG_END
+    {
+        GestureRecognizer r;
+        std::vector<TouchSample> t;
+        stroke(t, 10, 200, 300, 80, 310, 800);
+        std::vector<Gesture> g = replay(r, t, 1200);
+        TestFramework::ASSERT(g.size() > 2 && g[0].type == GESTURE_DRAG, "Movement past the slop starts a drag");
+        TestFramework::ASSERT_EQUAL_INT(-120, sumDx(g), "Drag deltas sum to the travel");
+        const Gesture& end = g.back();
+        TestFramework::ASSERT(end.type == GESTURE_DRAG_END && end.dx == -120 && end.dy == 10,
+                              "Slow drag ends with DRAG_END, not a swipe");
+        TestFramework::ASSERT(r.stats().taps == 0 && r.stats().longPresses == 0, "Drag is not a tap or long press");
+    }
+
+    //  Swipes: fast strokes, direction from the dominant axis
+    {
+        GestureRecognizer r;
+        std::vector<TouchSample> t;
+        stroke(t, 10, 260, 200, 120, 212, 160);               // left
+        stroke(t, 600, 150, 380, 148, 250, 200);              // up
+        std::vector<Gesture> g = replay(r, t, 1200);
+        std::vector<Gesture> swipes;
+        for (const Gesture& e : g) if (e.type == GESTURE_SWIPE) swipes.push_back(e);
+        TestFramework::ASSERT(swipes.size() == 2 && swipes[0].dir == SWIPE_LEFT && swipes[1].dir == SWIPE_UP,
+                              "Fast strokes -> swipe left, swipe up");
+        TestFramework::ASSERT(swipes[0].dx == -140 && swipes[0].x == 260, "Swipe carries start point and travel");
+    }
+
+    //  Consumer stalls during a long drag: moves coalesce, nothing dropped
+    {
+        GestureRecognizer r;
+        std::vector<TouchSample> t;
+        stroke(t, 10, 20, 100, 300, 100, 1600);               // 100 reports
+        std::vector<Gesture> g = replay(r, t, 2000, false);
+        TestFramework::ASSERT(r.stats().dropped == 0 && g.size() == 2, "100 moves coalesce into one queued drag");
+        TestFramework::ASSERT_EQUAL_INT(280, sumDx(g), "Coalesced drag keeps the full delta");
+    }
+
+    //  Lift arrives while the queue is full: re-sent, not lost
+    {
+        GestureRecognizer r;
+        TouchChangeTracker last;
+        uint32_t drops = 0;
+        std::vector<Gesture> g = stalledDrag(r, last, drops, false);
+        TestFramework::ASSERT(drops > 0 && !last.down && !last.pending,
+                              "Queue overflowed; the lift got through after the stall");
+        TestFramework::ASSERT(!r.touching() && !g.empty() && g.back().type == GESTURE_DRAG_END &&
+                              r.stats().longPresses == 0,
+                              "Drag ends with DRAG_END, no phantom hold");
+
+        GestureRecognizer old;
+        TouchChangeTracker oldLast;
+        stalledDrag(old, oldLast, drops, true);
+        TestFramework::ASSERT(old.touching(), "Committing a dropped lift leaves the finger held (old reader)");
+    }
+
+    TestFramework::endModule();
+}
+
+#endif // UNIT_TEST_MODE
@@ -0,0 +1,176 @@
+// ================================================================
+// Test_GlyphAtlas.cpp  -  UTF-8 decoder, HGF font, glyph LRU
+// ================================================================
+// Decoder on valid and malformed input, an in-memory HGF file
+// (lookup, table-sum text width), atlas hit/miss, LRU eviction order
+// and glyphs too large for a slot.
+// ================================================================
+
+#ifdef UNIT_TEST_MODE
+
+#include "../include/UnitTest_Framework.h"
+#include "../include/GlyphAtlas.h"
+#include <cstdlib>
+#include <vector>
+
+namespace {
+
+struct TestGlyph { uint32_t cp; uint8_t w, h, advance; };
+
+// ' ', 'A', U+AC00 (ga), U+AC01, U+B300 (too large), U+D55C (han)
+const TestGlyph GLYPHS[] = {
+    { 0x20, 0, 0, 4 }, { 'A', 7, 10, 8 },
+    { 0xAC00, 15, 15, 16 }, { 0xAC01, 15, 15, 16 }, { 0xB300, 24, 16, 16 },
+    { 0xD55C, 15, 15, 16 },
+};
+const uint32_t GLYPH_COUNT = sizeof(GLYPHS) / sizeof(GLYPHS[0]);
+
+std::vector<uint8_t> g_file;
+uint32_t g_reads = 0;
+
+void put32(std::vector<uint8_t>& v, uint32_t x) {
+    for (int i = 0; i < 4; i++) v.push_back((uint8_t)(x >> (i * 8)));
+}
+
+// Same layout as tools/hgf_build.py; every bitmap byte is its code point's low byte
+void buildFont() {
+    g_file.clear();
+    g_file.insert(g_file.end(), { 'H', 'G', 'F', '1', 16, 13, 0, 0 });
+    put32(g_file, GLYPH_COUNT);
+    put32(g_file, HGF_HEADER_BYTES);
+    uint32_t off = HGF_HEADER_BYTES + GLYPH_COUNT * sizeof(GlyphEntry);
+    for (const TestGlyph& g : GLYPHS) {
+        put32(g_file, g.cp);
+        put32(g_file, off);
+        g_file.insert(g_file.end(), { g.w, g.h, 0, 1, g.advance, 0, 0, 0 });
+        off += (g.w + 7) / 8 * g.h;
+    }
+    for (const TestGlyph& g : GLYPHS) g_file.insert(g_file.end(), (g.w + 7) / 8 * g.h, (uint8_t)g.cp);
+}
+
+bool readFile(void*, uint32_t offset, void* dst, uint32_t len) {
+    if (offset + len > g_file.size()) return false;
+    memcpy(dst, g_file.data() + offset, len);
+    g_reads++;
+    return true;
+}
+
+uint32_t decodeOne(const char* s, uint32_t* consumed) {
+    const char* p = s;
+    uint32_t cp = utf8::next(p);
+    *consumed = (uint32_t)(p - s);
+    return cp;
+}
+
+} // namespace
+
+void Test_GlyphAtlas::runTests() {
+    TestFramework::beginModule(getName());
+
+    //  UTF-8 decoder
+    {
+        uint32_t n;
+        bool ascii = decodeOne("A", &n) == 'A' && n == 1;
+        bool two   = decodeOne("\xC3\xA9", &n) == 0xE9 && n == 2;
+        bool ga    = decodeOne("\xEA\xB0\x80", &n) == 0xAC00 && n == 3;
+        bool four  = decodeOne("\xF0\x9F\x98\x80", &n) == 0x1F600 && n == 4;
+        TestFramework::ASSERT(ascii && two && ga && four, "1- to 4-byte sequences decode");
+
+        bool overlong  = decodeOne("\xC0\xAF", &n) == utf8::REPLACEMENT && n == 1;
+        bool surrogate = decodeOne("\xED\xA0\x80", &n) == utf8::REPLACEMENT && n == 1;
+        bool stray     = decodeOne("\x80" "A", &n) == utf8::REPLACEMENT && n == 1;
+        bool truncated = decodeOne("\xEA\xB0", &n) == utf8::REPLACEMENT && n == 1;
+        TestFramework::ASSERT(overlong && surrogate && stray && truncated,
+                              "Malformed input -> U+FFFD, one byte skipped");
+
+        const char* s = "\xEA\xB0" "A";                     // truncated Hangul, then 'A'
+        uint32_t a = utf8::next(s), b = utf8::next(s), c = utf8::next(s), end = utf8::next(s);
+        TestFramework::ASSERT(a == utf8::REPLACEMENT && b == utf8::REPLACEMENT && c == 'A' && end == 0,
+                              "Decoder resynchronises on the next lead byte");
+        TestFramework::ASSERT(utf8::isAscii("STOP 12") && !utf8::isAscii("\xED\x95\x9C"), "ASCII check");
+    }
+
+    //  HGF font: index lookup and advance-table text width
+    GlyphFont font;
+    buildFont();
+    bool opened = font.open(readFile, nullptr, [](uint32_t bytes) { return malloc(bytes); });
+    TestFramework::ASSERT(opened && font.count() == GLYPH_COUNT && font.height() == 16, "Font opens");
+    {
+        const GlyphEntry* ga = font.find(0xAC00);
+        TestFramework::ASSERT(ga && ga->w == 15 && ga->bitmapBytes() == 30, "Hangul glyph found");
+        TestFramework::ASSERT(font.find('A') && !font.find('B') && !font.find(0xAC02), "Missing glyphs not found");
+
+        uint32_t readsBefore = g_reads;
+        // "A ga han" + unknown 'B' (half-em box)
+        int32_t w = font.textWidth("A \xEA\xB0\x80\xED\x95\x9C" "B");
+        TestFramework::ASSERT_EQUAL_INT(8 + 4 + 16 + 16 + 8, (int)w, "Text width is a sum of advances");
+        TestFramework::ASSERT(g_reads == readsBefore, "Measuring reads no bitmaps");
+
+        std::vector<uint8_t> saved = g_file;
+        g_file[16 + 16] = 0x10;                             // second entry below the first
+        GlyphFont bad;
+        TestFramework::ASSERT(!bad.open(readFile, nullptr, [](uint32_t bytes) { return malloc(bytes); }),
+                              "Unsorted index rejected");
+        g_file = saved;
+    }
+
+    //  Atlas: hit, miss, LRU eviction order
+    {
+        GlyphAtlas<3, 32> atlas;
+        static uint8_t mem[GlyphAtlas<3, 32>::BYTES];
+        atlas.begin(mem);
+
+        const uint8_t* ga = atlas.get(font, *font.find(0xAC00));
+        uint32_t readsBefore = g_reads;
+        const uint8_t* again = atlas.get(font, *font.find(0xAC00));
+        TestFramework::ASSERT(ga && ga == again && ga[0] == 0x00 && g_reads == readsBefore,
+                              "Second draw is a hit, no file read");
+
+        atlas.get(font, *font.find('A'));
+        atlas.get(font, *font.find(0xAC01));                // atlas full: ga, A, AC01
+        atlas.get(font, *font.find(0xAC00));                // ga most recent; A is LRU
+        const uint8_t* han = atlas.get(font, *font.find(0xD55C));
+        TestFramework::ASSERT(han && han[0] == 0x5C, "Miss loads the bitmap");
+        TestFramework::ASSERT(!atlas.contains('A') && atlas.contains(0xAC00) && atlas.contains(0xAC01),
+                              "Least recently drawn glyph evicted");
+        atlas.get(font, *font.find('A'));                   // AC01 is LRU now
+        TestFramework::ASSERT(!atlas.contains(0xAC01) && atlas.contains(0xD55C) && atlas.used() == 3,
+                              "Eviction follows draw order");
+        const GlyphAtlasStats& s = atlas.stats();
+        TestFramework::ASSERT(s.hits == 2 && s.misses == 5 && s.evictions == 2,
+                              "Hit / miss / eviction counters");
+
+        TestFramework::ASSERT(!atlas.get(font, *font.find(0xB300)) && atlas.stats().loadFails == 1,
+                              "Glyph larger than a slot fails, atlas untouched");
+        TestFramework::ASSERT(atlas.contains(0xD55C) && atlas.contains('A'), "Failed load evicts nothing");
+    }
+
+    //  Prewarm and churn through a larger atlas
+    {
+        GlyphAtlas<64, 32> atlas;
+        static uint8_t mem[GlyphAtlas<64, 32>::BYTES];
+        atlas.begin(mem);
+        uint32_t n = atlas.prewarm(font, "A \xEA\xB0\x80\xEA\xB0\x81\xED\x95\x9C");
+        atlas.resetStats();
+        atlas.prewarm(font, "\xED\x95\x9C\xEA\xB0\x80 A");
+        TestFramework::ASSERT(n == 5 && atlas.stats().misses == 0 && atlas.stats().hits == 4,
+                              "Prewarmed strings draw without a miss");
+
+        // Many evictions keep the hash consistent (backward-shift delete)
+        GlyphAtlas<2, 32> tiny;
+        static uint8_t tinyMem[GlyphAtlas<2, 32>::BYTES];
+        tiny.begin(tinyMem);
+        const uint32_t cps[] = { 0xAC00, 0xAC01, 0xD55C, 'A' };
+        bool ok = true;
+        for (uint32_t i = 0; i < 200; i++) {
+            const GlyphEntry* e = font.find(cps[(i * 7) % 4]);
+            const uint8_t* px = tiny.get(font, *e);
+            ok = ok && px && px[0] == (uint8_t)e->cp && tiny.contains(e->cp) && tiny.used() <= 2;
+        }
+        TestFramework::ASSERT(ok, "200 draws through a 2-slot atlas stay consistent");
+    }
+
+    TestFramework::endModule();
+}
+
+#endif // UNIT_TEST_MODE
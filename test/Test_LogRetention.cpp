@@ -0,0 +1,196 @@
+// ================================================================
+// Test_LogRetention.cpp  -  rotation policy + incremental pruner
+// ================================================================
+// Runs the pruner against an in-memory directory whose operations
+// advance a fake µs clock (list entry 400 us, delete 3 ms), so the
+// per-tick time slice, budget / age deletion order and protection of
+// the live files are checked without a card.
+// ================================================================
+
+#ifdef UNIT_TEST_MODE
+
+#include "../include/UnitTest_Framework.h"
+#include "../include/LogRetention.h"
+#include <map>
+#include <string>
+
+namespace {
+
+uint32_t g_us = 0;
+uint32_t fakeClock() { return g_us; }
+
+class MemFs : public RetentionFs {
+public:
+    std::map<std::string, uint32_t> files;     // full path -> size
+    std::string dir;
+    std::map<std::string, uint32_t>::iterator it;
+    uint32_t removes = 0;
+
+    bool openDir(const char* d) override {
+        dir = d;
+        it = files.begin();
+        return true;
+    }
+    bool nextEntry(char* name, size_t cap, uint32_t& size, bool& isDir) override {
+        std::string prefix = dir == "/" ? "/" : dir + "/";
+        for (; it != files.end(); ++it) {
+            const std::string& p = it->first;
+            if (p.compare(0, prefix.size(), prefix) != 0 || p.find('/', prefix.size()) != std::string::npos) continue;
+            g_us += 400;
+            snprintf(name, cap, "%s", p.c_str() + prefix.size());
+            size = it->second;
+            isDir = false;
+            ++it;
+            return true;
+        }
+        return false;
+    }
+    void closeDir() override {}
+    bool remove(const char* path) override {
+        g_us += 3000;
+        removes++;
+        return files.erase(path) == 1;
+    }
+
+    uint64_t total() const {
+        uint64_t n = 0;
+        for (auto& f : files) n += f.second;
+        return n;
+    }
+};
+
+const uint32_t DAY0 = 20377;    // 2025-10-16
+
+// Live logs appending for `days`, rotated daily and at 1 MB
+void simulate(MemFs& fs, uint32_t days, uint32_t bytesPerDay) {
+    const char* bases[] = { "/logs/cycle_log.csv", "/logs/error_log.csv" };
+    RotationPolicy rot = { 1u << 20, true };
+    for (const char* b : bases) {
+        uint32_t segDay = DAY0;
+        uint16_t part = 0;
+        fs.files[b] = 0;
+        for (uint32_t d = DAY0; d < DAY0 + days; d++) {
+            for (int h = 0; h < 24; h++) {
+                if (retention::rotateDue(rot, fs.files[b], segDay, d)) {
+                    char seg[64];
+                    retention::segmentPath(b, segDay, part++, seg, sizeof(seg));
+                    fs.files[seg] = fs.files[b];
+                    fs.files[b] = 0;
+                    if (segDay != d) { segDay = d; part = 0; }
+                }
+                fs.files[b] += bytesPerDay / 24;
+            }
+        }
+    }
+}
+
+} // namespace
+
+void Test_LogRetention::runTests() {
+    TestFramework::beginModule(getName());
+
+    //  Names and rotation policy
+    {
+        char p[64];
+        retention::segmentPath("/logs/cycle_log.csv", DAY0, 2, p, sizeof(p));
+        TestFramework::ASSERT_STRING("/logs/cycle_log-20251016-2.csv", p, "Segment path");
+        retention::segmentPath("/logs/trend", 0, 0, p, sizeof(p));
+        TestFramework::ASSERT_STRING("/logs/trend-00000000-0", p, "Undated, no extension");
+
+        uint32_t day = 0;
+        uint16_t part = 0;
+        bool seg = retention::parseSegment("cycle_log-20251016-2.csv", day, part);
+        bool live = !retention::parseSegment("cycle_log.csv", day, part)
+                 && !retention::parseSegment("log_20251016_120000.csv", day, part)
+                 && !retention::parseSegment("trend.tsb", day, part);
+        TestFramework::ASSERT(seg && live, "Segments parsed, live files rejected");
+        retention::parseSegment("cycle_log-20251016-2.csv", day, part);
+        TestFramework::ASSERT(day == DAY0 && part == 2, "Day / part round trip");
+
+        RotationPolicy rot = { 1000, true };
+        bool size = retention::rotateDue(rot, 1000, DAY0, DAY0);
+        bool same = !retention::rotateDue(rot, 999, DAY0, DAY0);
+        bool next = retention::rotateDue(rot, 10, DAY0, DAY0 + 1);
+        bool noClock = !retention::rotateDue(rot, 10, DAY0, 0);
+        TestFramework::ASSERT(size && same && next && noClock, "Rotate on size / day change, not without a clock");
+    }
+
+    //  Budget: oldest segments go first, live files stay, slices bounded
+    {
+        MemFs fs;
+        simulate(fs, 30, 1536 * 1024);                    // 1.5 MB/day per log
+        fs.files["/logs/trend.tsb"] = 5u << 20;           // binary history, not rotated
+        fs.files["/logs/cycle_log-00000000-0.csv"] = 1u << 20;
+
+        LogPruner<64> pr;
+        RetentionPolicy pol = { 40ull << 20, 0 };
+        pr.begin(&fs, pol, fakeClock);
+        pr.addDir("/logs");
+        pr.request();
+
+        const uint32_t slice = 20000;
+        uint32_t ticks = 0, worst = 0;
+        while (ticks < 1000) {
+            uint32_t t0 = g_us;
+            bool more = pr.step(DAY0 + 29, slice);
+            if (g_us - t0 > worst) worst = g_us - t0;
+            ticks++;
+            if (!more && !pr.busy()) break;
+        }
+        PrunerStats st = pr.stats();
+        TestFramework::ASSERT(fs.total() <= pol.budgetBytes, "Total within the budget");
+        TestFramework::ASSERT(worst <= slice + 3000, "No tick over slice + one operation");
+        TestFramework::ASSERT(ticks > 3, "Pass spread over several ticks");
+        TestFramework::ASSERT(fs.files.count("/logs/cycle_log.csv") && fs.files.count("/logs/trend.tsb"),
+                              "Live files never deleted");
+        TestFramework::ASSERT(!fs.files.count("/logs/cycle_log-00000000-0.csv"), "Undated segment deleted first");
+
+        // Whatever is left is newer than whatever was deleted
+        uint32_t oldestLeft = UINT32_MAX;
+        for (auto& f : fs.files) {
+            uint32_t d;
+            uint16_t k;
+            const char* n = f.first.c_str() + f.first.rfind('/') + 1;
+            if (retention::parseSegment(n, d, k) && d < oldestLeft) oldestLeft = d;
+        }
+        TestFramework::ASSERT(oldestLeft > DAY0 + 5, "Oldest days removed");
+        TestFramework::ASSERT(st.deleted > 0 && st.failed == 0 && st.passes >= 2,
+                              "Table overflow -> follow-up pass");
+    }
+
+    //  Age limit and the one-off override (clearOldLogs)
+    {
+        MemFs fs;
+        simulate(fs, 20, 256 * 1024);
+        LogPruner<128> pr;
+        pr.begin(&fs, { 1ull << 40, 14 }, fakeClock);
+        pr.addDir("/logs");
+        pr.request();
+        while (pr.step(DAY0 + 19, 20000) || pr.busy()) {}
+
+        auto oldest = [&]() {
+            uint32_t o = UINT32_MAX;
+            for (auto& f : fs.files) {
+                uint32_t d;
+                uint16_t k;
+                const char* n = f.first.c_str() + f.first.rfind('/') + 1;
+                if (retention::parseSegment(n, d, k) && d < o) o = d;
+            }
+            return o;
+        };
+        TestFramework::ASSERT_EQUAL_INT(DAY0 + 19 - 14, (int)oldest(), "Segments older than 14 days gone");
+
+        pr.request(3);
+        while (pr.step(DAY0 + 19, 20000) || pr.busy()) {}
+        TestFramework::ASSERT_EQUAL_INT(DAY0 + 19 - 3, (int)oldest(), "Override: keep 3 days");
+
+        uint32_t before = fs.removes;
+        pr.request();
+        while (pr.step(0, 20000) || pr.busy()) {}
+        TestFramework::ASSERT_EQUAL_INT((int)before, (int)fs.removes, "No clock -> no age deletes");
+    }
+
+    TestFramework::endModule();
+}
+
+#endif // UNIT_TEST_MODE
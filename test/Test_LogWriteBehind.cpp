@@ -0,0 +1,341 @@
+// ================================================================
+// Test_LogWriteBehind.cpp  -  write-behind SD log stream
+// ================================================================
+// LogStream against a stdio-backed stand-in for the SD File API:
+// block-aligned writes, max-age and sync cadence, ring overflow,
+// write failures with reopen, and concurrent producers. The stand-in
+// advances a fake microsecond clock per call to model card latency.
+// ================================================================
+
+#ifdef UNIT_TEST_MODE
+
+#include "../include/UnitTest_Framework.h"
+#include "../include/LogWriteBehind.h"
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifndef LOG_TEST_DIR
+#define LOG_TEST_DIR "/tmp"
+#endif
+
+namespace {
+
+uint32_t g_fakeUs = 0;
+uint32_t fakeClockUs() { return g_fakeUs; }
+
+// stdio stand-in for fs::File opened with FILE_APPEND
+class StdioSink : public LogSink {
+public:
+    struct Write { uint32_t offset; uint32_t len; };
+
+    std::vector<Write> writes;
+    uint32_t opens = 0, syncs = 0;
+    int      failOpens = 0;           // next N opens fail
+    int      shortWriteAt = -1;       // write index that stops halfway
+    uint32_t usPerCall = 300, usPerKb = 500;
+
+    ~StdioSink() { close(); }
+
+    bool open(const char* path) override {
+        g_fakeUs += usPerCall;
+        if (failOpens > 0) { failOpens--; return false; }
+        fp = fopen(path, "ab");
+        if (fp) opens++;
+        return fp != nullptr;
+    }
+    bool isOpen() const override { return fp != nullptr; }
+    uint32_t size() override {
+        if (!fp) return 0;
+        fseek(fp, 0, SEEK_END);
+        return (uint32_t)ftell(fp);
+    }
+    size_t write(const uint8_t* data, size_t len) override {
+        g_fakeUs += usPerCall + (uint32_t)(len * usPerKb / 1024);
+        uint32_t off = size();
+        if ((int)writes.size() == shortWriteAt) len /= 2;
+        size_t n = fwrite(data, 1, len, fp);
+        writes.push_back({ off, (uint32_t)n });
+        return n;
+    }
+    bool flush() override {
+        g_fakeUs += usPerCall;
+        syncs++;
+        return fflush(fp) == 0;
+    }
+    void close() override {
+        if (fp) fclose(fp);
+        fp = nullptr;
+    }
+
+private:
+    FILE* fp = nullptr;
+};
+
+std::string testPath(const char* name) {
+    std::string p = std::string(LOG_TEST_DIR) + "/" + name;
+    remove(p.c_str());
+    return p;
+}
+
+std::string readFile(const std::string& path) {
+    std::string out;
+    FILE* f = fopen(path.c_str(), "rb");
+    if (!f) return out;
+    char b[512];
+    size_t n;
+    while ((n = fread(b, 1, sizeof(b), f)) > 0) out.append(b, n);
+    fclose(f);
+    return out;
+}
+
+LogWriteParams params(uint32_t block, uint32_t maxPerTick = 0) {
+    LogWriteParams p;
+    p.blockSize = block;
+    p.maxWritePerTick = maxPerTick;
+    p.syncIntervalMs = 5000;
+    p.reopenRetryMs = 2000;
+    p.clockUs = fakeClockUs;
+    return p;
+}
+
+std::string record(uint32_t i) {
+    char b[64];
+    snprintf(b, sizeof(b), "%lu,-61.25,2.40,31.5,HOLD", (unsigned long)i);
+    return b;
+}
+
+struct StdMutexLock {
+    std::mutex m;
+    void lock()   { m.lock(); }
+    void unlock() { m.unlock(); }
+};
+
+} // namespace
+
+void Test_LogWriteBehind::runTests() {
+    TestFramework::beginModule(getName());
+
+    //  Full blocks go out aligned; the tail waits for max age
+    {
+        std::string path = testPath("lwb_align.csv");
+        StdioSink sink;
+        static uint8_t ring[8192];
+        LogStream<> s;
+        s.begin(&sink, ring, sizeof(ring), path.c_str(), "Timestamp,Pressure", 2000, params(512));
+
+        std::string expect = "Timestamp,Pressure\r\n";
+        uint32_t now = 0;
+        for (uint32_t i = 0; i < 100; i++) {
+            std::string r = record(i);
+            s.append(r.c_str(), now);
+            expect += r + "\r\n";
+            s.service(now += 10);
+        }
+        bool aligned = sink.writes.size() > 2;
+        for (size_t i = 2; i < sink.writes.size(); i++) {     // [0],[1] = header
+            const StdioSink::Write& w = sink.writes[i];
+            aligned = aligned && (w.offset + w.len) % 512 == 0;
+        }
+        TestFramework::ASSERT(aligned, "Every data write ends on a block boundary");
+        TestFramework::ASSERT(s.stats().buffered > 0 && s.stats().buffered < 512, "Partial block held back");
+
+        s.service(now + 2000);
+        TestFramework::ASSERT_EQUAL_INT(0, (int)s.stats().buffered, "Max age writes the remainder");
+        TestFramework::ASSERT(sink.isOpen(), "Handle stays open");
+        TestFramework::ASSERT_EQUAL_INT(1, (int)sink.opens, "Opened once");
+        s.close();
+        TestFramework::ASSERT(readFile(path) == expect, "File content = header + records");
+    }
+
+    //  Rotation after a block-aligned write that split a record
+    {
+        std::string path = testPath("lwb_rot.csv"), seg = testPath("lwb_rot-1.csv");
+        StdioSink sink;
+        static uint8_t ring[4096];
+        LogStream<> s;
+        s.begin(&sink, ring, sizeof(ring), path.c_str(), "H", 60000, params(64));
+
+        std::string first = "H\r\n", second = "H\r\n";
+        uint32_t now = 0, i = 0;
+        for (; i < 10; i++) {
+            std::string r = record(i);
+            s.append(r.c_str(), now);
+            first += r + "\r\n";
+        }
+        s.service(now += 10);                                 // aligned run, stops mid-record
+        uint32_t end = sink.writes.back().offset + sink.writes.back().len;
+        bool split = end % 64 == 0 && first.compare(end - 2, 2, "\r\n") != 0;
+
+        bool closed = s.closeAtRecord(now);
+        rename(path.c_str(), seg.c_str());                    // what rotateIfDue() does next
+        for (; i < 14; i++) {
+            std::string r = record(i);
+            s.append(r.c_str(), now);
+            second += r + "\r\n";
+        }
+        s.service(now += 10, true);
+        s.close();
+        TestFramework::ASSERT(split && closed, "Aligned write left a partial record before rotation");
+        TestFramework::ASSERT(readFile(seg) == first, "Closed segment ends with its last whole record");
+        TestFramework::ASSERT(readFile(path) == second, "New live file starts with header + whole record");
+        remove(seg.c_str());
+    }
+
+    //  Sync cadence and header only on an empty file
+    {
+        std::string path = testPath("lwb_sync.csv");
+        StdioSink sink;
+        static uint8_t ring[4096];
+        LogStream<> s;
+        s.begin(&sink, ring, sizeof(ring), path.c_str(), "H", 1000, params(512));
+        uint32_t now = 0;
+        for (; now < 60000; now += 250) {
+            if (now % 1000 == 0) s.append("x", now);
+            s.service(now);
+        }
+        TestFramework::ASSERT_RANGE((float)sink.syncs, 11.0f, 13.0f, "flush() every 5 s while dirty");
+        TestFramework::ASSERT_EQUAL_INT(1, (int)sink.opens, "No reopen per record");
+        s.close();
+
+        LogStream<> s2;
+        s2.begin(&sink, ring, sizeof(ring), path.c_str(), "H", 1000, params(512));
+        s2.append("y", 0);
+        s2.service(0, true);
+        s2.close();
+        std::string txt = readFile(path);
+        TestFramework::ASSERT(txt.compare(0, 6, "H\r\nx\r\n") == 0 && txt.find("H", 1) == std::string::npos,
+                              "Header not repeated on reopen");
+        TestFramework::ASSERT(txt.size() >= 3 && txt.compare(txt.size() - 3, 3, "y\r\n") == 0, "Appended after existing data");
+    }
+
+    //  Ring full: producer drops and counts, never blocks
+    {
+        std::string path = testPath("lwb_drop.csv");
+        StdioSink sink;
+        static uint8_t ring[256];
+        LogStream<> s;
+        s.begin(&sink, ring, sizeof(ring), path.c_str(), nullptr, 1000, params(512));
+        uint32_t ok = 0;
+        for (uint32_t i = 0; i < 50; i++) ok += s.append(record(i).c_str(), 0) ? 1 : 0;
+        LogStreamStats st = s.stats();
+        TestFramework::ASSERT_EQUAL_INT(50, (int)(st.records + st.dropped), "records + dropped = offered");
+        TestFramework::ASSERT_EQUAL_INT((int)ok, (int)st.records, "Accepted count");
+        TestFramework::ASSERT(st.dropped > 0 && st.highWater <= 256, "Overflow dropped, bounded");
+        s.service(1000);
+        s.close();
+        TestFramework::ASSERT_EQUAL_INT((int)st.highWater, (int)readFile(path).size(), "Accepted records written whole");
+    }
+
+    //  Open failure and short write: retry later, nothing lost or doubled
+    {
+        std::string path = testPath("lwb_fail.csv");
+        StdioSink sink;
+        sink.failOpens = 1;
+        static uint8_t ring[4096];
+        LogStream<> s;
+        s.begin(&sink, ring, sizeof(ring), path.c_str(), nullptr, 100, params(512));
+        std::string expect;
+        uint32_t now = 0;
+        for (uint32_t i = 0; i < 40; i++) {
+            std::string r = record(i);
+            s.append(r.c_str(), now);
+            expect += r + "\r\n";
+            if (i == 20) sink.shortWriteAt = (int)sink.writes.size();
+            s.service(now += 50);
+        }
+        for (int k = 0; k < 100; k++) s.service(now += 50);
+        LogStreamStats st = s.stats();
+        TestFramework::ASSERT_EQUAL_INT(2, (int)st.errors, "Open failure + short write counted");
+        TestFramework::ASSERT_EQUAL_INT(2, (int)sink.opens, "Reopened after the short write");
+        s.close();
+        TestFramework::ASSERT(readFile(path) == expect, "Content intact across failures");
+    }
+
+    //  Per-tick cap keeps alignment; latency and rate metrics
+    {
+        std::string path = testPath("lwb_cap.csv");
+        StdioSink sink;
+        static uint8_t ring[65536];
+        LogStream<> s;
+        s.begin(&sink, ring, sizeof(ring), path.c_str(), nullptr, 60000, params(4096, 8192));
+        uint32_t bytes = 0;
+        for (uint32_t i = 0; bytes < 40000; i++) {
+            std::string r = record(i);
+            s.append(r.c_str(), 0);
+            bytes += (uint32_t)r.size() + 2;
+        }
+        g_fakeUs = 0;
+        uint32_t w = s.service(0);
+        TestFramework::ASSERT_EQUAL_INT(8192, (int)w, "Capped at maxWritePerTick");
+        TestFramework::ASSERT_EQUAL_INT(300 + (300 + 4000), (int)s.stats().lastFlushUs, "Latency = open + write (sync not due)");
+        uint32_t firstSecond = w;
+        for (uint32_t t = 250; t < 1000; t += 250) firstSecond += s.service(t);
+        s.service(1000);
+        bool aligned = true;
+        for (const StdioSink::Write& x : sink.writes) aligned = aligned && (x.offset + x.len) % 4096 == 0;
+        TestFramework::ASSERT(aligned, "Capped writes stay aligned");
+        TestFramework::ASSERT_EQUAL_INT((int)firstSecond, (int)s.stats().bytesPerSec, "bytes/s over the last second");
+        s.close();
+    }
+
+    //  Concurrent producers against one writer thread
+    {
+        std::string path = testPath("lwb_mt.csv");
+        StdioSink sink;
+        static uint8_t ring[16384];
+        LogStream<StdMutexLock> s;
+        s.begin(&sink, ring, sizeof(ring), path.c_str(), nullptr, 0, params(512));
+
+        const int PRODUCERS = 4, PER = 2000;
+        bool stop = false;
+        std::mutex stopMx;
+        std::thread writer([&] {
+            for (uint32_t t = 0;; t++) {
+                s.service(t);
+                std::lock_guard<std::mutex> g(stopMx);
+                if (stop) break;
+            }
+        });
+        std::vector<std::thread> prod;
+        for (int p = 0; p < PRODUCERS; p++) {
+            prod.emplace_back([&s, p] {
+                char b[32];
+                for (int i = 0; i < PER; i++) {
+                    snprintf(b, sizeof(b), "%d:%d", p, i);
+                    while (!s.append(b, 0)) std::this_thread::yield();
+                }
+            });
+        }
+        for (std::thread& t : prod) t.join();
+        { std::lock_guard<std::mutex> g(stopMx); stop = true; }
+        writer.join();
+        s.service(0, true);
+        s.close();
+
+        std::string txt = readFile(path);
+        int next[PRODUCERS] = {};
+        bool ordered = true;
+        size_t pos = 0;
+        while (pos < txt.size()) {
+            size_t e = txt.find("\r\n", pos);
+            if (e == std::string::npos) { ordered = false; break; }
+            int p = -1, i = -1;
+            if (sscanf(txt.c_str() + pos, "%d:%d", &p, &i) != 2 || p < 0 || p >= PRODUCERS || i != next[p]) {
+                ordered = false;
+                break;
+            }
+            next[p]++;
+            pos = e + 2;
+        }
+        bool all = true;
+        for (int p = 0; p < PRODUCERS; p++) all = all && next[p] == PER;
+        TestFramework::ASSERT(ordered && all, "Every record once, whole and in per-producer order");
+    }
+
+    TestFramework::endModule();
+}
+
+#endif // UNIT_TEST_MODE
@@ -0,0 +1,50 @@
+// ================================================================
+// Test_LoopHistogram.cpp  -  PID loop timing histogram
+// ================================================================
+
+#ifdef UNIT_TEST_MODE
+
+#include "../include/UnitTest_Framework.h"
+#include "../include/LoopHistogram.h"
+
+void Test_LoopHistogram::runTests() {
+    TestFramework::beginModule(getName());
+
+    {
+        LoopHistogram<8, 10> h;
+        TestFramework::ASSERT_EQUAL_INT(0, h.percentile(0.5f), "Empty percentile is 0");
+        TestFramework::ASSERT_EQUAL_INT(0, h.min(), "Empty min is 0");
+
+        h.record(3);  h.record(12); h.record(14); h.record(55);
+        TestFramework::ASSERT_EQUAL_INT(4, h.count(), "Count");
+        TestFramework::ASSERT_EQUAL_INT(1, h.bin(0), "0-9 us bin");
+        TestFramework::ASSERT_EQUAL_INT(2, h.bin(1), "10-19 us bin");
+        TestFramework::ASSERT_EQUAL_INT(1, h.bin(5), "50-59 us bin");
+        TestFramework::ASSERT_EQUAL(21.0f, h.mean(), "Mean");
+        TestFramework::ASSERT_EQUAL_INT(3, h.min(), "Min");
+        TestFramework::ASSERT_EQUAL_INT(55, h.max(), "Max");
+        TestFramework::ASSERT_EQUAL_INT(19, h.percentile(0.5f), "p50 is upper edge of its bin");
+        TestFramework::ASSERT_EQUAL_INT(55, h.percentile(1.0f), "p100 clamped to max");
+
+        h.record(5000);
+        TestFramework::ASSERT_EQUAL_INT(1, h.bin(7), "Overflow bin");
+        TestFramework::ASSERT_EQUAL_INT(5000, h.percentile(0.99f), "Overflow percentile reports max");
+
+        h.clear();
+        TestFramework::ASSERT_EQUAL_INT(0, h.count(), "Clear");
+    }
+
+    //  1000 samples: 990 on time, 10 late by 200 us
+    {
+        LoopHistogram<64, 10> h;
+        for (int i = 0; i < 990; i++) h.record(i % 7);
+        for (int i = 0; i < 10; i++)  h.record(200);
+        TestFramework::ASSERT_EQUAL_INT(9, h.percentile(0.50f), "Jitter p50");
+        TestFramework::ASSERT_EQUAL_INT(9, h.percentile(0.99f), "Jitter p99 excludes 1% tail");
+        TestFramework::ASSERT_EQUAL_INT(200, h.percentile(0.999f), "Jitter p99.9 sees tail");
+    }
+
+    TestFramework::endModule();
+}
+
+#endif // UNIT_TEST_MODE
@@ -0,0 +1,161 @@
+// ================================================================
+// Test_MetricRollup.cpp  -  1 min / 1 h / 1 day health rollups
+// ================================================================
+// Feeds 40 days of 10 s health samples (slow linear wear, daily ripple,
+// noise) and checks the window stats against a brute-force pass over
+// the raw samples, the bounded bucket count per query, the series
+// helper, and a persist / restore round trip through encoded records.
+// ================================================================
+
+#ifdef UNIT_TEST_MODE
+
+#include "../include/UnitTest_Framework.h"
+#include "../include/MetricRollup.h"
+#include <cstdlib>
+#include <vector>
+
+namespace {
+
+struct Sample { uint32_t t; float v; };
+
+const uint32_t T0   = 1760000000;      // epoch s (not day aligned)
+const uint32_t STEP = 10;
+
+// 98 % falling 0.25 points/day, +-1 daily ripple, +-0.5 noise
+std::vector<Sample> health(uint32_t days) {
+    std::vector<Sample> out;
+    srand(11);
+    for (uint32_t t = T0; t < T0 + days * 86400; t += STEP) {
+        float d = (t - T0) / 86400.0f;
+        float v = 98.0f - 0.25f * d + sinf(d * 6.2831853f) + ((rand() % 101) - 50) * 0.01f;
+        out.push_back({ t, v });
+    }
+    return out;
+}
+
+struct Ref { uint32_t count = 0; double sum = 0, sumSq = 0; float min = 0, max = 0; };
+
+Ref brute(const std::vector<Sample>& s, uint32_t from, uint32_t to) {
+    Ref r;
+    for (const Sample& x : s) {
+        if (x.t < from || x.t > to) continue;
+        if (r.count == 0 || x.v < r.min) r.min = x.v;
+        if (r.count == 0 || x.v > r.max) r.max = x.v;
+        r.count++; r.sum += x.v; r.sumSq += (double)x.v * x.v;
+    }
+    return r;
+}
+
+struct Persisted {
+    std::vector<uint8_t> bytes;
+    uint32_t minutes = 0;
+};
+
+void persist(void* ctx, RollupLevel l, const RollupBucket& b) {
+    Persisted* p = (Persisted*)ctx;
+    if (l == ROLLUP_MINUTE) { p->minutes++; return; }
+    size_t at = p->bytes.size();
+    p->bytes.resize(at + ROLLUP_RECORD_SIZE);
+    rollupEncode(l, b, &p->bytes[at]);
+}
+
+} // namespace
+
+void Test_MetricRollup::runTests() {
+    TestFramework::beginModule(getName());
+
+    std::vector<Sample> src = health(40);
+    uint32_t now = src.back().t;
+
+    MetricRollup* r = new MetricRollup();
+    Persisted store;
+    r->onClose(persist, &store);
+    for (const Sample& s : src) r->add(s.t, s.v);
+
+    //  Windows match the raw samples at bucket granularity
+    {
+        bool ok = true;
+        const uint32_t hours[] = { 1, 24, 24 * 7, 24 * 30 };
+        const RollupLevel want[] = { ROLLUP_MINUTE, ROLLUP_HOUR, ROLLUP_HOUR, ROLLUP_DAY };
+        uint16_t maxPoints = 0;
+        for (int i = 0; i < 4; i++) {
+            uint32_t from = now - hours[i] * 3600;
+            RollupWindow w = r->window(from, now);
+            Ref ref = brute(src, rollup::floorTo(from, w.level), now);
+            double mean = ref.sum / ref.count;
+            double sd = sqrt(ref.sumSq / ref.count - mean * mean);
+            ok = ok && w.level == want[i] && w.count == ref.count
+                    && fabsf(w.mean - (float)mean) < 1e-3f && w.min == ref.min && w.max == ref.max
+                    && fabsf(w.stddev - (float)sd) < 1e-3f;
+            if (w.buckets > maxPoints) maxPoints = w.buckets;
+        }
+        TestFramework::ASSERT(ok, "1 h / 24 h / 7 d / 30 d = brute force, expected level");
+        TestFramework::ASSERT(maxPoints <= 200, "Every query touches <= 200 buckets");
+    }
+
+    //  Slope and prediction from the 30 d day buckets
+    {
+        RollupWindow w = r->window(now - 30 * 86400, now);
+        TestFramework::ASSERT_EQUAL(-0.25f, w.slopePerHour * 24.0f, "30 d slope (points/day)", 0.02f);
+        float expectNow = 98.0f - 0.25f * ((now - T0) / 86400.0f);
+        TestFramework::ASSERT_EQUAL(expectNow, w.fitNow, "Regression at now", 0.3f);
+        RollupWindow d = r->window(now - 86400, now);
+        TestFramework::ASSERT_RANGE(d.stddev, 0.6f, 1.0f, "24 h volatility = ripple + noise");
+    }
+
+    //  Series: last 24 hours, oldest first, current hour included
+    {
+        float v[24];
+        r->series(ROLLUP_HOUR, now, v, 24);
+        Ref last = brute(src, rollup::floorTo(now, ROLLUP_HOUR), now);
+        Ref first = brute(src, rollup::floorTo(now, ROLLUP_HOUR) - 23 * 3600, rollup::floorTo(now, ROLLUP_HOUR) - 23 * 3600 + 3599);
+        bool ok = fabsf(v[23] - (float)(last.sum / last.count)) < 1e-3f
+               && fabsf(v[0] - (float)(first.sum / first.count)) < 1e-3f;
+        for (int i = 0; i < 24; i++) ok = ok && !std::isnan(v[i]);
+        TestFramework::ASSERT(ok, "Hourly series matches, no gaps");
+
+        float g[4];
+        r->series(ROLLUP_DAY, now + 10 * 86400, g, 4);
+        TestFramework::ASSERT(std::isnan(g[0]) && std::isnan(g[3]), "Days without data are NAN");
+    }
+
+    //  Persist / restore: hours + days only, tail of the file
+    {
+        size_t records = store.bytes.size() / ROLLUP_RECORD_SIZE;
+        uint32_t hours = (rollup::floorTo(now, ROLLUP_HOUR) - rollup::floorTo(T0, ROLLUP_HOUR)) / 3600;
+        uint32_t days  = (rollup::floorTo(now, ROLLUP_DAY) - rollup::floorTo(T0, ROLLUP_DAY)) / 86400;
+        TestFramework::ASSERT_EQUAL_INT((int)(hours + days), (int)records, "One record per closed hour / day");
+
+        std::vector<uint8_t> bytes = store.bytes;
+        bytes[bytes.size() - 3 * ROLLUP_RECORD_SIZE + 30] ^= 0x08;   // one damaged record
+        size_t from = records > ROLLUP_REPLAY_RECORDS ? records - ROLLUP_REPLAY_RECORDS : 0;
+
+        MetricRollup* back = new MetricRollup();
+        uint32_t bad = 0;
+        for (size_t i = from; i < records; i++) {
+            RollupLevel l;
+            RollupBucket b;
+            if (rollupDecode(&bytes[i * ROLLUP_RECORD_SIZE], l, b)) back->restore(l, b);
+            else bad++;
+        }
+        back->endRestore();
+        TestFramework::ASSERT_EQUAL_INT(1, (int)bad, "CRC rejects the damaged record");
+
+        // The restored copy has lost the open hour (minutes are not persisted)
+        RollupWindow a = r->window(now - 30 * 86400, rollup::floorTo(now, ROLLUP_HOUR) - 1);
+        RollupWindow b = back->window(now - 30 * 86400, rollup::floorTo(now, ROLLUP_HOUR) - 1);
+        TestFramework::ASSERT_EQUAL(a.mean, b.mean, "Restored 30 d mean", 0.05f);
+        TestFramework::ASSERT_EQUAL(a.slopePerHour * 24, b.slopePerHour * 24, "Restored 30 d slope", 0.02f);
+
+        // Keeps going after the restore; a sample from before it is late
+        bool added = back->add(now + 60, 50.0f);
+        bool late = !back->add(now - 7200, 50.0f);
+        TestFramework::ASSERT(added && late && back->late() == 1, "Continues after restore, late sample dropped");
+        delete back;
+    }
+
+    delete r;
+    TestFramework::endModule();
+}
+
+#endif // UNIT_TEST_MODE
@@ -0,0 +1,184 @@
+// ================================================================
+// Test_MinMaxPyramid.cpp  -  trend graph decimation vs brute force
+// ================================================================
+// Feeds a noisy random walk with sparse spikes (and a NaN gap) and
+// compares every pixel column of the 10 s / 10 min / 1 h / 24 h
+// windows against a rescan of the raw samples.
+// ================================================================
+
+#ifdef UNIT_TEST_MODE
+
+#include "../include/UnitTest_Framework.h"
+#include "../include/MinMaxPyramid.h"
+#include <vector>
+
+namespace {
+
+const uint16_t WIDTH = 380;
+const uint32_t WINDOWS[] = { 100, 6000, 36000, 864000 };   // 100 ms samples
+
+uint32_t g_seed = 12345;
+float noise() {
+    g_seed = g_seed * 1103515245u + 12345u;
+    return ((g_seed >> 8) & 0xFFFF) / 65535.0f - 0.5f;
+}
+
+int64_t floorTo(int64_t i, int64_t span) {
+    int64_t q = i / span;
+    if (i % span != 0 && i < 0) q--;
+    return q * span;
+}
+
+struct Check {
+    uint32_t exactBad = 0;      // column != rescan of the buckets it covers
+    uint32_t rangeBad = 0;      // running range() != rescan of the window
+    uint32_t envelopeBad = 0;   // a raw sample of the column outside [min, max]
+    uint32_t maxVisits = 0;
+};
+
+// Brute force: raw samples of the column's pixel range must lie inside
+// the column, and the column must equal the rescan of the samples of
+// the buckets it touches that are still in the ring.
+void compare(const MinMaxPyramid& p, const std::vector<float>& raw, uint32_t window, Check& r) {
+    static MinMaxColumn cols[WIDTH];
+    uint32_t end = p.count();
+    uint32_t visits = p.columns(end, window, cols, WIDTH);
+    if (visits > r.maxVisits) r.maxVisits = visits;
+
+    uint8_t l = p.levelFor(window);
+    int64_t span = MINMAX_SPAN[l];
+    int64_t newest = (int64_t)(end - 1) / span;
+    int64_t kept = (newest - MINMAX_CAPACITY[l] + 1) * span;
+    int64_t from = (int64_t)end - window;
+
+    for (uint16_t c = 0; c < WIDTH; c++) {
+        int64_t lo = from + (int64_t)window * c / WIDTH;
+        int64_t hi = from + (int64_t)window * (c + 1) / WIDTH;
+        if (hi <= lo) hi = lo + 1;
+
+        for (int64_t i = lo < 0 ? 0 : lo; i < hi; i++) {
+            float v = raw[i];
+            if (std::isnan(v)) continue;
+            if (!cols[c].valid() || v < cols[c].min || v > cols[c].max) r.envelopeBad++;
+        }
+
+        int64_t s0 = floorTo(lo, span);
+        int64_t s1 = floorTo(hi - 1, span) + span;
+        MinMaxBucket ref;
+        ref.clear();
+        for (int64_t i = s0; i < s1; i++) {
+            if (i < 0 || i < kept || i >= (int64_t)end || std::isnan(raw[i])) continue;
+            ref.add(raw[i]);
+        }
+        bool same = ref.valid() == cols[c].valid()
+                 && (!ref.valid() || (ref.min == cols[c].min && ref.max == cols[c].max && ref.last == cols[c].last));
+        if (!same) r.exactBad++;
+    }
+
+    // Running window range (deques) vs rescan from the window's first bucket
+    float lo, hi;
+    bool have = p.range(window, lo, hi);
+    int64_t first = end > window ? (int64_t)(end - window) / span * span : 0;
+    MinMaxBucket ref;
+    ref.clear();
+    for (int64_t i = first; i < (int64_t)end; i++) {
+        if (!std::isnan(raw[i])) ref.add(raw[i]);
+    }
+    if (have != ref.valid() || (have && (lo != ref.min || hi != ref.max))) r.rangeBad++;
+}
+
+} // namespace
+
+void Test_MinMaxPyramid::runTests() {
+    TestFramework::beginModule(getName());
+
+    MinMaxPyramid* p = new MinMaxPyramid();
+    for (uint32_t w : WINDOWS) p->track(w);
+    std::vector<float> raw;
+    raw.reserve(900000);
+
+    //  Empty and partly filled history
+    {
+        static MinMaxColumn cols[WIDTH];
+        p->columns(0, 6000, cols, WIDTH);
+        bool empty = true;
+        for (auto& c : cols) empty = empty && !c.valid();
+        TestFramework::ASSERT(empty && std::isnan(p->last()), "Empty pyramid -> empty columns");
+
+        TestFramework::ASSERT(p->levelFor(100) == 0 && p->levelFor(6000) == 1 &&
+                              p->levelFor(36000) == 2 && p->levelFor(864000) == 3,
+                              "Each window on its own level");
+    }
+
+    //  Random walk, spikes, one NaN gap; checked at several points of a 25 h run
+    Check r;
+    float level = -60.0f;
+    const uint32_t checkpoints[] = { 50, 700, 5000, 40000, 300000, 432200, 900000 };
+    size_t next = 0;
+    uint32_t spikeAt = 432123;          // lone one-sample spike in the middle of the 24 h window
+    for (uint32_t i = 0; i < 900000; i++) {
+        level += noise() * 0.5f;
+        if (level > -10.0f) level = -10.0f;
+        if (level < -95.0f) level = -95.0f;
+        float v = level + noise();
+        if (i % 7919 == 0) v += 30.0f;
+        if (i == spikeAt) v = 250.0f;
+        if (i >= 200000 && i < 200050) v = NAN;
+        p->add(v);
+        raw.push_back(v);
+        if (next < 7 && i + 1 == checkpoints[next]) {
+            for (uint32_t w : WINDOWS) compare(*p, raw, w, r);
+            next++;
+        }
+    }
+    TestFramework::ASSERT_EQUAL_INT(0, (int)r.exactBad, "Columns equal brute-force rescan");
+    TestFramework::ASSERT_EQUAL_INT(0, (int)r.envelopeBad, "No raw sample outside its column");
+    TestFramework::ASSERT(r.maxVisits <= 3u * WIDTH, "Buckets visited <= 3 x width");
+    TestFramework::ASSERT_EQUAL_INT(0, (int)r.rangeBad, "Running range equals window rescan");
+
+    //  track() mid-stream rebuilds the deques from the ring
+    {
+        float lo0, hi0, lo1, hi1;
+        p->range(36000, lo0, hi0);
+        p->track(36000);
+        p->range(36000, lo1, hi1);
+        TestFramework::ASSERT(lo0 == lo1 && hi0 == hi1, "Re-track gives the same range");
+    }
+
+    //  The lone spike survives 2160:1 decimation
+    {
+        static MinMaxColumn cols[WIDTH];
+        p->columns(p->count(), 864000, cols, WIDTH);
+        float top = -INFINITY;
+        for (auto& c : cols) if (c.valid() && c.max > top) top = c.max;
+        TestFramework::ASSERT_EQUAL(250.0f, top, "24 h window keeps a 100 ms spike", 0.001f);
+        TestFramework::ASSERT_EQUAL(raw.back(), cols[WIDTH - 1].last, "Last column ends on the newest sample", 0.001f);
+    }
+
+    //  Expired history and a window past the ring
+    {
+        MinMaxBucket old = p->bucket(3, 0);
+        MinMaxBucket fresh = p->bucket(0, p->count() - 1);
+        TestFramework::ASSERT(!old.valid() && fresh.valid(), "Expired buckets read empty");
+
+        static MinMaxColumn cols[WIDTH];
+        p->columns(p->count(), 2000000, cols, WIDTH);     // 55 h > 24.9 h ring
+        TestFramework::ASSERT(!cols[0].valid() && cols[WIDTH - 1].valid(), "Older than the ring -> empty columns");
+    }
+
+    //  NaN gap in the 10 s window
+    {
+        p->clear();
+        for (int i = 0; i < 100; i++) p->add(i >= 40 && i < 60 ? NAN : (float)i);
+        static MinMaxColumn cols[WIDTH];
+        p->columns(100, 100, cols, WIDTH);
+        bool gap = !cols[WIDTH / 2].valid();
+        bool edges = cols[0].valid() && cols[0].min == 0.0f && cols[WIDTH - 1].last == 99.0f;
+        TestFramework::ASSERT(gap && edges, "NaN samples leave a gap");
+    }
+
+    delete p;
+    TestFramework::endModule();
+}
+
+#endif // UNIT_TEST_MODE
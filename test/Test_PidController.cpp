@@ -0,0 +1,237 @@
+// ================================================================
+// Test_PidController.cpp  -  PidController<T, Options>
+// ================================================================
+// Step-response regression against a simulated first-order-plus-
+// dead-time vacuum plant (vacuum depth in kPa, pump duty in %),
+// anti-windup comparison, float vs Q16.16 agreement, and a step-cost
+// benchmark against the previous hand-written control law.
+// ================================================================
+
+#ifdef UNIT_TEST_MODE
+
+#include "../include/UnitTest_Framework.h"
+#include "../include/PidController.h"
+#include <chrono>
+#include <cmath>
+
+namespace {
+
+constexpr float DT = 0.005f;    // 200 Hz, as PID_LOOP_RATE_HZ
+
+// FOPDT: tau * dy/dt = K * u(t - theta) - y
+struct FopdtPlant {
+    static constexpr float K     = 0.9f;    // kPa per % duty (100 % -> 90 kPa)
+    static constexpr float TAU   = 2.0f;    // s
+    static constexpr int   DELAY = 40;      // samples (0.2 s)
+
+    float y = 0.0f;
+    float queue[DELAY] = {};
+    int   head = 0;
+
+    float step(float u) {
+        float delayed = queue[head];
+        queue[head] = u;
+        head = (head + 1) % DELAY;
+        y += DT / TAU * (K * delayed - y);
+        return y;
+    }
+};
+
+struct StepResult {
+    float overshoot;     // kPa above setpoint
+    float settleSec;     // last time outside +/-2 % band
+    float finalError;
+};
+
+template<typename Pid>
+StepResult runStep(Pid& pid, float setpoint, float seconds) {
+    FopdtPlant plant;
+    StepResult r = { 0.0f, 0.0f, 0.0f };
+    float y = 0.0f;
+    int n = (int)(seconds / DT);
+    for (int i = 0; i < n; i++) {
+        float u = pidToFloat(pid.step(setpoint, y));
+        y = plant.step(u);
+        if (y - setpoint > r.overshoot) r.overshoot = y - setpoint;
+        if (fabsf(y - setpoint) > 0.02f * setpoint) r.settleSec = (i + 1) * DT;
+    }
+    r.finalError = setpoint - y;
+    return r;
+}
+
+// Saturation episode: pump output not reaching the plant for 10 s
+// (vent valve open) while the controller sits at 100 %, then restored
+template<typename Pid>
+float windupOvershoot(Pid& pid) {
+    FopdtPlant plant;
+    float y = 0.0f, peak = 0.0f;
+    for (int i = 0; i < (int)(10.0f / DT); i++) {
+        pid.step(60.0f, y);
+        y = plant.step(0.0f);
+    }
+    for (int i = 0; i < (int)(20.0f / DT); i++) {
+        y = plant.step(pidToFloat(pid.step(60.0f, y)));
+        if (y - 60.0f > peak) peak = y - 60.0f;
+    }
+    return peak;
+}
+
+struct NoWindupOptions : PidDefaultOptions {
+    static constexpr PidAntiWindup antiWindup = PidAntiWindup::None;
+};
+struct ClampOptions : PidDefaultOptions {
+    static constexpr PidAntiWindup antiWindup = PidAntiWindup::Clamp;
+    static constexpr float integralLimit = 100.0f;
+};
+struct OnErrorOptions : PidDefaultOptions {
+    static constexpr PidDerivative derivative = PidDerivative::OnError;
+    static constexpr float derivFilterHz = 0.0f;
+};
+
+// Previous PID_Control.cpp law, inline, for the step-cost comparison
+struct LegacyPid {
+    float integral = 0, measFiltered = 0, output = 0;
+    bool primed = false;
+    float step(float sp, float meas, float kp, float ki, float kd, float dt) {
+        if (!primed) { measFiltered = meas; primed = true; }
+        float error = sp - meas;
+        const float tau = 1.0f / (2.0f * 3.14159265f * 20.0f);
+        const float alpha = dt / (tau + dt);
+        float prev = measFiltered;
+        measFiltered += alpha * (meas - measFiltered);
+        float derivative = -kd * (measFiltered - prev) / dt;
+        float unsat = kp * error + integral + derivative;
+        output = unsat < 0.0f ? 0.0f : (unsat > 100.0f ? 100.0f : unsat);
+        float kt = 0.0f;
+        if (ki > 0.0f) kt = (kd > 0.0f) ? sqrtf(ki / kd) : (kp > 0.0f ? ki / kp : 0.0f);
+        integral += (ki * error + kt * (output - unsat)) * dt;
+        return output;
+    }
+};
+
+constexpr int BENCH_STEPS = 2000000;
+
+template<typename F>
+double nsPerStep(F&& body) {
+    auto t0 = std::chrono::steady_clock::now();
+    for (int i = 0; i < BENCH_STEPS; i++) body(i);
+    auto t1 = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(t1 - t0).count() / BENCH_STEPS;
+}
+
+} // namespace
+
+void Test_PidController::runTests() {
+    TestFramework::beginModule(getName());
+
+    //  Step response, production configuration (Kp 2, Ki 0.5, Kd 1)
+    {
+        PidController<float> pid;
+        pid.setGains(2.0f, 0.5f, 1.0f);
+        pid.setSampleTime(DT);
+        StepResult r = runStep(pid, 60.0f, 30.0f);
+        Serial.printf("    float: overshoot %.2f kPa, settle %.2f s, final error %.3f\n",
+                      r.overshoot, r.settleSec, r.finalError);
+        TestFramework::ASSERT(fabsf(r.finalError) < 0.1f, "Settles on setpoint (no steady-state error)");
+        TestFramework::ASSERT(r.overshoot < 0.15f * 60.0f, "Overshoot < 15 %");
+        TestFramework::ASSERT(r.settleSec < 15.0f, "Settles within 15 s");
+        TestFramework::ASSERT_RANGE(pidToFloat(pid.output()), 60.0f / 0.9f - 1.0f, 60.0f / 0.9f + 1.0f,
+                                    "Steady-state duty matches plant gain");
+    }
+
+    //  Q16.16 tracks float
+    {
+        PidController<float>    pf;
+        PidController<PidFixed> pq;
+        pf.setGains(2.0f, 0.5f, 1.0f); pf.setSampleTime(DT);
+        pq.setGains(2.0f, 0.5f, 1.0f); pq.setSampleTime(DT);
+        StepResult rf = runStep(pf, 60.0f, 30.0f);
+        StepResult rq = runStep(pq, 60.0f, 30.0f);
+        Serial.printf("    Q16  : overshoot %.2f kPa, settle %.2f s, final error %.3f\n",
+                      rq.overshoot, rq.settleSec, rq.finalError);
+        TestFramework::ASSERT_EQUAL(rf.overshoot, rq.overshoot, "Q16 overshoot matches float", 0.1f);
+        TestFramework::ASSERT_EQUAL(rf.settleSec, rq.settleSec, "Q16 settling time matches float", 0.25f);
+        TestFramework::ASSERT(fabsf(rq.finalError) < 0.1f, "Q16 settles on setpoint");
+    }
+
+    //  Anti-windup after a 10 s saturation episode
+    {
+        PidController<float, NoWindupOptions> none;
+        PidController<float, ClampOptions>    clamp;
+        PidController<float>                  back;
+        none.setGains(2.0f, 0.5f, 1.0f);  none.setSampleTime(DT);
+        clamp.setGains(2.0f, 0.5f, 1.0f); clamp.setSampleTime(DT);
+        back.setGains(2.0f, 0.5f, 1.0f);  back.setSampleTime(DT);
+        float oNone  = windupOvershoot(none);
+        float oClamp = windupOvershoot(clamp);
+        float oBack  = windupOvershoot(back);
+        Serial.printf("    windup overshoot: none %.2f, clamp %.2f, back-calc %.2f kPa\n",
+                      oNone, oClamp, oBack);
+        TestFramework::ASSERT(oBack < oNone, "Back-calculation beats plain integrator");
+        TestFramework::ASSERT(oClamp < oNone, "Clamp beats plain integrator");
+        TestFramework::ASSERT(oBack < 0.15f * 60.0f, "Back-calculation overshoot < 15 %");
+        TestFramework::ASSERT(fabsf(clamp.integral()) <= 100.0f, "Clamp bounds the integral");
+    }
+
+    //  Derivative kick: on-error kicks on a setpoint step, on-measurement does not
+    {
+        PidController<float, OnErrorOptions> pe;
+        PidController<float>                 pm;
+        pe.setGains(0.0f, 0.0f, 0.1f); pe.setSampleTime(DT);
+        pm.setGains(0.0f, 0.0f, 0.1f); pm.setSampleTime(DT);
+        pe.step(0.0f, 0.0f); pm.step(0.0f, 0.0f);
+        pe.step(10.0f, 0.0f); pm.step(10.0f, 0.0f);
+        TestFramework::ASSERT_EQUAL(200.0f, pe.derivative(), "On-error derivative kicks");
+        TestFramework::ASSERT_EQUAL(0.0f, pm.derivative(), "On-measurement derivative does not");
+    }
+
+    //  Bumpless gain change and reset
+    {
+        PidController<float> pid, ref;
+        pid.setGains(2.0f, 0.5f, 1.0f); pid.setSampleTime(DT);
+        ref.setGains(2.0f, 0.5f, 1.0f); ref.setSampleTime(DT);
+        runStep(pid, 60.0f, 30.0f);
+        runStep(ref, 60.0f, 30.0f);
+        pid.setGains(2.0f, 1.0f, 1.0f);
+        float changed = pid.step(60.0f, 59.97f);
+        float same    = ref.step(60.0f, 59.97f);
+        TestFramework::ASSERT_EQUAL(same, changed, "Ki change at steady state is bumpless", 0.05f);
+        pid.reset();
+        TestFramework::ASSERT_EQUAL(0.0f, pid.integral(), "Reset clears the integral");
+    }
+
+    //  Variable-dt step (ControlManager path) matches fixed-dt
+    {
+        PidController<float> a, b;
+        a.setGains(2.0f, 0.5f, 1.0f); a.setSampleTime(0.05f);
+        b.setGains(2.0f, 0.5f, 1.0f);
+        bool same = true;
+        for (int i = 0; i < 200; i++) {
+            float m = 30.0f + 10.0f * sinf(i * 0.1f);
+            if (a.step(60.0f, m) != b.step(60.0f, m, 0.05f)) same = false;
+        }
+        TestFramework::ASSERT(same, "step(sp, m, dt) == setSampleTime + step(sp, m)");
+    }
+
+    //  Step cost
+    {
+        PidController<float>    pf;
+        PidController<PidFixed> pq;
+        LegacyPid               legacy;
+        pf.setGains(2.0f, 0.5f, 1.0f); pf.setSampleTime(DT);
+        pq.setGains(2.0f, 0.5f, 1.0f); pq.setSampleTime(DT);
+        volatile float sink = 0.0f;
+        volatile float meas = 30.0f;
+
+        double nsLegacy = nsPerStep([&](int i) { sink = legacy.step(60.0f, meas + (i & 7), 2.0f, 0.5f, 1.0f, DT); });
+        double nsFloat  = nsPerStep([&](int i) { sink = pf.step(60.0f, meas + (i & 7)); });
+        double nsFixed  = nsPerStep([&](int i) { sink = pidToFloat(pq.step(PidFixed(60.0f), PidFixed(meas + (i & 7)))); });
+        Serial.printf("    step cost: legacy %.2f ns, PidController<float> %.2f ns, <PidFixed> %.2f ns\n",
+                      nsLegacy, nsFloat, nsFixed);
+        TestFramework::ASSERT(nsFloat < nsLegacy * 1.5, "Template step no slower than the hand-written law");
+    }
+
+    TestFramework::endModule();
+}
+
+#endif // UNIT_TEST_MODE
@@ -0,0 +1,98 @@
+// ================================================================
+// Test_RampProfile.cpp  -  pump PWM ramp generator
+// ================================================================
+
+#ifdef UNIT_TEST_MODE
+
+#include "../include/UnitTest_Framework.h"
+#include "../include/RampProfile.h"
+
+#include <cmath>
+
+void Test_RampProfile::runTests() {
+    TestFramework::beginModule(getName());
+
+    //  Linear 0 -> 200 over 1000 ms
+    {
+        RampGenerator r;
+        TestFramework::ASSERT(!r.active(), "Idle after construction");
+        r.start(0.0f, 200.0f, 1000, RAMP_LINEAR, 5000);
+        TestFramework::ASSERT(r.active(), "Active after start");
+        TestFramework::ASSERT_EQUAL(0.0f,   r.valueAt(5000), "Linear start value");
+        TestFramework::ASSERT_EQUAL(50.0f,  r.valueAt(5250), "Linear quarter");
+        TestFramework::ASSERT_EQUAL(100.0f, r.valueAt(5500), "Linear midpoint");
+        TestFramework::ASSERT_EQUAL(0.5f,   r.progress(5500), "Progress at midpoint");
+        TestFramework::ASSERT(!r.done(5999), "Not done before duration");
+        TestFramework::ASSERT(r.done(6000), "Done at duration");
+        TestFramework::ASSERT_EQUAL(200.0f, r.valueAt(9000), "Clamped past the end");
+        TestFramework::ASSERT_EQUAL_INT(1000, r.elapsedMs(9000), "Elapsed clamped");
+    }
+
+    //  Ramp down
+    {
+        RampGenerator r;
+        r.start(255.0f, 55.0f, 400, RAMP_LINEAR, 0);
+        TestFramework::ASSERT_EQUAL(155.0f, r.valueAt(200), "Linear ramp down midpoint");
+    }
+
+    //  S-curve: monotonic, symmetric, flat ends, 1.875x peak slope
+    {
+        bool monotonic = true, symmetric = true;
+        float prev = 0.0f, peak = 0.0f;
+        const int N = 1000;
+        for (int i = 1; i <= N; i++) {
+            float t = (float)i / N;
+            float v = rampShapeAt(RAMP_SCURVE, t);
+            if (v < prev) monotonic = false;
+            float slope = (v - prev) * N;
+            if (slope > peak) peak = slope;
+            float mirror = 1.0f - rampShapeAt(RAMP_SCURVE, 1.0f - t);
+            if (fabsf(v - mirror) > 1e-5f) symmetric = false;
+            prev = v;
+        }
+        TestFramework::ASSERT(monotonic, "S-curve monotonic");
+        TestFramework::ASSERT(symmetric, "S-curve point-symmetric about midpoint");
+        TestFramework::ASSERT_EQUAL(0.5f, rampShapeAt(RAMP_SCURVE, 0.5f), "S-curve midpoint");
+        TestFramework::ASSERT(fabsf(peak - 1.875f) < 0.01f, "S-curve peak slope 1.875");
+
+        float startSlope = rampShapeAt(RAMP_SCURVE, 0.01f) / 0.01f;
+        float endSlope   = (1.0f - rampShapeAt(RAMP_SCURVE, 0.99f)) / 0.01f;
+        TestFramework::ASSERT(startSlope < 0.01f, "S-curve flat at start");
+        TestFramework::ASSERT(endSlope < 0.01f, "S-curve flat at end");
+    }
+
+    //  Zero duration / no-op ramps complete immediately
+    {
+        RampGenerator r;
+        r.start(10.0f, 90.0f, 0, RAMP_SCURVE, 100);
+        TestFramework::ASSERT(!r.active(), "Zero duration not active");
+        TestFramework::ASSERT_EQUAL(90.0f, r.valueAt(100), "Zero duration at target");
+        TestFramework::ASSERT_EQUAL(1.0f, r.progress(100), "Zero duration progress 1");
+
+        r.start(90.0f, 90.0f, 500, RAMP_LINEAR, 100);
+        TestFramework::ASSERT(!r.active(), "from == to not active");
+    }
+
+    //  millis() wrap during the ramp
+    {
+        RampGenerator r;
+        uint32_t t0 = 0xFFFFFF00u;   // 256 ms before wrap
+        r.start(0.0f, 100.0f, 1000, RAMP_LINEAR, t0);
+        TestFramework::ASSERT_EQUAL(50.0f, r.valueAt(t0 + 500), "Value across wrap");
+        TestFramework::ASSERT(!r.done(t0 + 999), "Not done across wrap");
+        TestFramework::ASSERT(r.done(t0 + 1000), "Done across wrap");
+    }
+
+    //  stop() abandons the ramp
+    {
+        RampGenerator r;
+        r.start(0.0f, 100.0f, 1000, RAMP_LINEAR, 0);
+        r.stop();
+        TestFramework::ASSERT(!r.active(), "Stopped");
+        TestFramework::ASSERT(r.done(10), "Stopped ramp reports done");
+    }
+
+    TestFramework::endModule();
+}
+
+#endif // UNIT_TEST_MODE
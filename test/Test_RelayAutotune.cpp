@@ -0,0 +1,186 @@
+// ================================================================
+// Test_RelayAutotune.cpp  -  relay-feedback PID auto-tuner
+// ================================================================
+// Identification against a simulated first-order-plus-dead-time
+// vacuum plant, closed-loop check of the proposed gains with
+// PidController, and the failure paths.
+// ================================================================
+
+#ifdef UNIT_TEST_MODE
+
+#include "../include/UnitTest_Framework.h"
+#include "../include/RelayAutotune.h"
+#include "../include/PidController.h"
+#include <cmath>
+
+namespace {
+
+constexpr float    DT    = 0.005f;   // 200 Hz
+constexpr uint32_t DT_MS = 5;
+
+// FOPDT: tau * dy/dt = gain * u(t - theta) - y
+struct Plant {
+    float gain, tau;
+    int   delay;
+    float y = 0.0f;
+    float queue[400] = {};
+    int   head = 0;
+
+    Plant(float k, float t, float thetaSec) : gain(k), tau(t), delay((int)(thetaSec / DT)) {}
+
+    float step(float u) {
+        float delayed = queue[head];
+        queue[head] = u;
+        head = (head + 1) % delay;
+        y += DT / tau * (gain * delayed - y);
+        return y;
+    }
+};
+
+RelayAutotuneConfig tuneConfig() {
+    RelayAutotuneConfig c;
+    c.setpoint      = 60.0f;
+    c.bias          = 60.0f;
+    c.amplitude     = 20.0f;
+    c.hysteresis    = 0.5f;
+    c.maxDeviation  = 70.0f;
+    c.outputMin     = 0.0f;
+    c.outputMax     = 100.0f;
+    c.warmupCycles  = 2;
+    c.measureCycles = 4;
+    c.timeoutMs     = 60000;
+    return c;
+}
+
+// Runs the experiment; returns the final tuner state
+AutotuneState runTune(RelayAutotuner& t, Plant& p, const RelayAutotuneConfig& c, uint32_t maxMs) {
+    uint32_t now = 1000;
+    t.begin(c, now);
+    float y = p.y;
+    for (uint32_t ms = 0; ms < maxMs && t.running(); ms += DT_MS) {
+        now += DT_MS;
+        y = p.step(t.update(y, now));
+    }
+    return t.state();
+}
+
+// Closed-loop 0 -> 60 step with the proposed gains
+float closedLoopOvershoot(const AutotuneGains& g, float& finalError) {
+    Plant p(0.9f, 2.0f, 0.2f);
+    PidController<float> pid;
+    pid.setGains(g.kp, g.ki, g.kd);
+    pid.setSampleTime(DT);
+    float y = 0.0f, peak = 0.0f;
+    for (int i = 0; i < (int)(30.0f / DT); i++) {
+        y = p.step(pid.step(60.0f, y));
+        if (y - 60.0f > peak) peak = y - 60.0f;
+    }
+    finalError = 60.0f - y;
+    return peak;
+}
+
+} // namespace
+
+void Test_RelayAutotune::runTests() {
+    TestFramework::beginModule(getName());
+
+    //  Limit cycle vs the exact relay solution for FOPDT (K 0.9, tau 2 s,
+    //  theta 0.2 s, symmetric relay d = 20 %, no hysteresis):
+    //    period    2*theta + 2*tau*ln(2 - e^(-theta/tau)) = 0.764 s
+    //    amplitude K*d*(1 - e^(-theta/tau))              = 1.713 kPa
+    //  The describing function then gives Ku ~ 14.9; the true ultimate
+    //  gain is ~18 (wu ~ 8.1 rad/s), the usual DF under-estimate.
+    {
+        Plant p(0.9f, 2.0f, 0.2f);
+        for (int i = 0; i < (int)(10.0f / DT); i++) p.step(60.0f / 0.9f);   // pre-evacuate to setpoint
+        RelayAutotuner t;
+        RelayAutotuneConfig c = tuneConfig();
+        c.bias = 60.0f / 0.9f;
+        c.hysteresis = 0.0f;
+        AutotuneState s = runTune(t, p, c, 60000);
+        Serial.printf("    exact: Ku %.2f  Pu %.3f s  a %.3f kPa\n",
+                      t.ultimateGain(), t.ultimatePeriodSec(), t.amplitude());
+        TestFramework::ASSERT_EQUAL_INT(AUTOTUNE_DONE, s, "Relay experiment completes");
+        TestFramework::ASSERT_EQUAL(0.764f, t.ultimatePeriodSec(), "Period matches exact relay solution", 0.015f);
+        TestFramework::ASSERT_EQUAL(1.713f, t.amplitude(), "Amplitude matches exact relay solution", 0.05f);
+        TestFramework::ASSERT_RANGE(t.ultimateGain(), 18.0f * 0.7f, 18.0f * 1.1f, "Ku near the analytic ultimate gain");
+    }
+
+    //  Default experiment (off-centre bias, hysteresis) -> gains -> closed loop
+    {
+        Plant p(0.9f, 2.0f, 0.2f);
+        for (int i = 0; i < (int)(10.0f / DT); i++) p.step(60.0f / 0.9f);
+        RelayAutotuner t;
+        AutotuneState s = runTune(t, p, tuneConfig(), 60000);
+        Serial.printf("    Ku %.2f  Pu %.3f s  a %.2f kPa  cycles %d\n",
+                      t.ultimateGain(), t.ultimatePeriodSec(), t.amplitude(), t.cyclesSeen());
+        TestFramework::ASSERT_EQUAL_INT(AUTOTUNE_DONE, s, "Relay experiment with hysteresis completes");
+
+        AutotuneGains zn = t.gains(AUTOTUNE_RULE_ZIEGLER_NICHOLS);
+        AutotuneGains tl = t.gains(AUTOTUNE_RULE_TYREUS_LUYBEN);
+        Serial.printf("    ZN: Kp %.2f Ki %.2f Kd %.2f   TL: Kp %.2f Ki %.2f Kd %.2f\n",
+                      zn.kp, zn.ki, zn.kd, tl.kp, tl.ki, tl.kd);
+        TestFramework::ASSERT(tl.kp < zn.kp && tl.ki < zn.ki, "Tyreus-Luyben more conservative than ZN");
+
+        float errZn, errTl;
+        float osZn = closedLoopOvershoot(zn, errZn);
+        float osTl = closedLoopOvershoot(tl, errTl);
+        Serial.printf("    closed loop overshoot: ZN %.2f kPa, TL %.2f kPa\n", osZn, osTl);
+        TestFramework::ASSERT(fabsf(errZn) < 0.5f, "ZN gains settle on setpoint");
+        TestFramework::ASSERT(fabsf(errTl) < 0.5f, "TL gains settle on setpoint");
+        TestFramework::ASSERT(osTl <= osZn, "TL overshoot <= ZN overshoot");
+        TestFramework::ASSERT(osTl < 0.15f * 60.0f, "TL overshoot < 15 %");
+    }
+
+    //  Rule arithmetic
+    {
+        AutotuneGains g = RelayAutotuner::gainsFor(AUTOTUNE_RULE_ZIEGLER_NICHOLS, 10.0f, 2.0f);
+        TestFramework::ASSERT_EQUAL(6.0f, g.kp, "ZN Kp = 0.6 Ku");
+        TestFramework::ASSERT_EQUAL(6.0f, g.ki, "ZN Ki = Kp / (Pu/2)");
+        TestFramework::ASSERT_EQUAL(1.5f, g.kd, "ZN Kd = Kp * Pu/8");
+        g = RelayAutotuner::gainsFor(AUTOTUNE_RULE_TYREUS_LUYBEN, 22.0f, 2.2f);
+        TestFramework::ASSERT_EQUAL(10.0f, g.kp, "TL Kp = Ku/2.2");
+        TestFramework::ASSERT_EQUAL(10.0f / 4.84f, g.ki, "TL Ki = Kp / (2.2 Pu)");
+    }
+
+    //  Reverse-acting plant never oscillates -> timeout (relay saturates)
+    {
+        Plant p(-0.9f, 2.0f, 0.2f);
+        RelayAutotuner t;
+        RelayAutotuneConfig c = tuneConfig();
+        c.maxDeviation = 1000.0f;
+        c.timeoutMs = 5000;
+        AutotuneState s = runTune(t, p, c, 10000);
+        TestFramework::ASSERT_EQUAL_INT(AUTOTUNE_FAILED, s, "Reverse-acting plant fails");
+        TestFramework::ASSERT_EQUAL_INT(AUTOTUNE_FAIL_TIMEOUT, t.failure(), "... by timeout");
+    }
+
+    //  Deviation guard
+    {
+        Plant p(-0.9f, 2.0f, 0.2f);
+        RelayAutotuner t;
+        RelayAutotuneConfig c = tuneConfig();
+        c.maxDeviation = 80.0f;
+        runTune(t, p, c, 10000);
+        TestFramework::ASSERT_EQUAL_INT(AUTOTUNE_FAIL_DEVIATION, t.failure(), "Leaving the band fails");
+    }
+
+    //  Abort (safety trip) mid-experiment; output drops to minimum
+    {
+        Plant p(0.9f, 2.0f, 0.2f);
+        RelayAutotuner t;
+        t.begin(tuneConfig(), 0);
+        float y = 0.0f;
+        for (uint32_t ms = 5; ms < 2000; ms += DT_MS) y = p.step(t.update(y, ms));
+        TestFramework::ASSERT(t.running(), "Running before abort");
+        t.abort();
+        TestFramework::ASSERT_EQUAL_INT(AUTOTUNE_FAIL_ABORTED, t.failure(), "Abort recorded");
+        TestFramework::ASSERT_EQUAL(0.0f, t.update(y, 2005), "Output at minimum after abort");
+        t.abort();
+        TestFramework::ASSERT_EQUAL_INT(AUTOTUNE_FAIL_ABORTED, t.failure(), "Second abort is a no-op");
+    }
+
+    TestFramework::endModule();
+}
+
+#endif // UNIT_TEST_MODE
@@ -0,0 +1,186 @@
+// ================================================================
+// Test_RetainedWidget.cpp  -  retained widgets, SCREEN_MAIN frame cost
+// ================================================================
+// Replays one minute of 10 Hz sensor frames through a model of the
+// main screen's widget tree (same rects and keys as UI_Screen_Main)
+// and compares the pixels repainted against the old immediate mode,
+// which redrew the whole screen whenever a value moved past its delta.
+// ================================================================
+
+#ifdef UNIT_TEST_MODE
+
+#include "../include/UnitTest_Framework.h"
+#include "../include/RetainedWidget.h"
+#include <cmath>
+#include <cstdio>
+
+namespace {
+
+const int16_t  W = 320, H = 480;
+const uint32_t FULL_PX = (uint32_t)W * H;
+
+enum : uint8_t {
+    W_HEADER, W_STATUS, W_CLOCK,
+    W_P_CARD, W_P_VALUE, W_P_BAR,
+    W_T_CARD, W_T_VALUE, W_T_CURRENT,
+    W_PUMP_CARD, W_PUMP_DUTY, W_PUMP_BAR,
+    W_BUTTONS, W_EVENT,
+    W_COUNT
+};
+
+// MainLayout / UITheme values
+void defineMain(WidgetTree<W_COUNT>& t) {
+    t.define(W_HEADER,    { 0, 0, W, 30 });
+    t.define(W_STATUS,    { 0, 30, W, 24 });
+    t.define(W_CLOCK,     { 264, 36, 48, 8 }, W_STATUS);
+    t.define(W_P_CARD,    { 8, 62, 148, 80 });
+    t.define(W_P_VALUE,   { 20, 88, 124, 24 }, W_P_CARD);
+    t.define(W_P_BAR,     { 20, 132, 124, 6 }, W_P_CARD);
+    t.define(W_T_CARD,    { 164, 62, 148, 80 });
+    t.define(W_T_VALUE,   { 176, 88, 124, 24 }, W_T_CARD);
+    t.define(W_T_CURRENT, { 252, 74, 48, 8 }, W_T_CARD);
+    t.define(W_PUMP_CARD, { 8, 150, 304, 56 });
+    t.define(W_PUMP_DUTY, { 20, 178, 80, 16 }, W_PUMP_CARD);
+    t.define(W_PUMP_BAR,  { 20, 194, 280, 8 }, W_PUMP_CARD);
+    t.define(W_BUTTONS,   { 0, 214, W, 44 });
+    t.define(W_EVENT,     { 0, 418, W, 20 });
+}
+
+struct Frame {
+    float    pressure, temp, current, duty;
+    uint32_t second;
+};
+
+uint16_t pressureColor(float kpa) { return kpa <= -90.0f ? 0xF800 : kpa <= -80.0f ? 0xFFE0 : 0x07E0; }
+
+// Same keys as drawMainScreen(); returns pixels repainted this frame
+uint32_t drawFrame(WidgetTree<W_COUNT>& t, uint32_t epoch, const Frame& f) {
+    uint64_t before = t.stats().paintedPx;
+    t.sync(epoch);
+    char buf[16];
+
+    t.update(W_HEADER, WidgetKey().add("100").value());
+    snprintf(buf, sizeof(buf), "12:00:%02u", (unsigned)(f.second % 60));
+    t.update(W_STATUS, WidgetKey().add(1).add(1).add(0).value());
+    t.update(W_CLOCK, WidgetKey().add(buf).value());
+
+    uint16_t pc = pressureColor(f.pressure);
+    t.update(W_P_CARD, WidgetKey().add(pc).value());
+    snprintf(buf, sizeof(buf), "%.1f", f.pressure);
+    t.update(W_P_VALUE, WidgetKey().add(buf).add(pc).value());
+    float pct = fminf(fmaxf((f.pressure + 100.0f) / 100.0f * 100.0f, 0.0f), 100.0f);
+    t.update(W_P_BAR, WidgetKey().add((uint32_t)((124 - 4) * pct / 100)).add(pc).value());
+
+    t.update(W_T_CARD, WidgetKey().add(0x07E0).value());
+    snprintf(buf, sizeof(buf), "%.1f", f.temp);
+    t.update(W_T_VALUE, WidgetKey().add(buf).add(0x07E0).value());
+    snprintf(buf, sizeof(buf), "%.2fA", f.current);
+    t.update(W_T_CURRENT, WidgetKey().add(buf).value());
+
+    t.update(W_PUMP_CARD, WidgetKey().add(1).add(5).value());
+    snprintf(buf, sizeof(buf), "%.0f%%", f.duty);
+    t.update(W_PUMP_DUTY, WidgetKey().add(buf).add(0x0E7F).value());
+    t.update(W_PUMP_BAR, WidgetKey().add((uint32_t)((280 - 4) * f.duty / 100)).add(0x0E7F).value());
+
+    t.update(W_BUTTONS, WidgetKey().add(0).add(1).add(0).value());
+    t.update(W_EVENT, WidgetKey().add(0).add("").value());
+    return (uint32_t)(t.stats().paintedPx - before);
+}
+
+uint32_t g_seed = 2024;
+float noise() {
+    g_seed = g_seed * 1103515245u + 12345u;
+    return ((g_seed >> 8) & 0xFFFF) / 65535.0f - 0.5f;
+}
+
+} // namespace
+
+void Test_RetainedWidget::runTests() {
+    TestFramework::beginModule(getName());
+
+    //  Keys, epochs, parents
+    {
+        TestFramework::ASSERT(WidgetKey().add("ab").add("c").value() != WidgetKey().add("a").add("bc").value(),
+                              "Key separates text fields");
+
+        WidgetTree<W_COUNT> t;
+        defineMain(t);
+        Frame f = { -60.0f, 30.0f, 2.5f, 65.0f, 0 };
+        uint32_t first = drawFrame(t, 1, f);
+        TestFramework::ASSERT(t.stats().fullFrames == 1 && t.stats().paints == W_COUNT,
+                              "First frame paints every widget");
+        TestFramework::ASSERT(first > 0 && drawFrame(t, 1, f) == 0, "Unchanged frame paints nothing");
+
+        f.pressure = -59.96f;                                 // same "-60.0", same bar pixel
+        TestFramework::ASSERT_EQUAL_INT(0, (int)drawFrame(t, 1, f), "Change below display resolution is free");
+
+        f.pressure = -59.5f;
+        uint32_t before = t.stats().paints;
+        uint32_t px = drawFrame(t, 1, f);
+        TestFramework::ASSERT(t.stats().paints - before == 1 && px == t.rect(W_P_VALUE).area(),
+                              "Pressure change repaints one label");
+
+        f.pressure = -85.0f;                                  // warning colour: card + its children
+        before = t.stats().paints;
+        drawFrame(t, 1, f);
+        TestFramework::ASSERT_EQUAL_INT(3, (int)(t.stats().paints - before), "Border colour repaints the card and children");
+
+        before = t.stats().paints;
+        drawFrame(t, 2, f);                                   // UIManager redraw request
+        TestFramework::ASSERT(t.stats().paints - before == W_COUNT && t.stats().fullFrames == 2,
+                              "New redraw epoch repaints everything");
+    }
+
+    //  SCREEN_MAIN, 10 Hz sensor frames for one minute, 200 ms UI tick
+    {
+        WidgetTree<W_COUNT> t;
+        defineMain(t);
+        Frame f = { -60.0f, 30.0f, 2.5f, 65.0f, 0 };
+        drawFrame(t, 1, f);
+        t.resetStats();
+
+        // Immediate mode: sensorReadStep() flagged a redraw when a value
+        // moved past its delta; the next UI tick redrew the whole screen
+        Frame last = f;
+        bool flagged = false;
+        uint64_t immediatePx = 0;
+        uint32_t immediateFrames = 0;
+        float level = -60.0f;
+        for (uint32_t i = 0; i < 600; i++) {
+            // decimated sensor noise (AdcStream), slow drift, pump-down steps
+            level += noise() * 0.2f;
+            if (i % 100 == 50) level -= 4.0f;
+            f.pressure = level + noise() * 0.1f;
+            f.temp     = 30.0f + i * 0.002f + noise() * 0.05f;
+            f.current  = 2.5f + noise() * 0.06f;
+            if (i % 20 == 0) f.duty = 65.0f + noise() * 4.0f;
+            f.second   = i / 10;
+
+            if (fabsf(f.pressure - last.pressure) > 0.2f
+                || fabsf(f.temp - last.temp) > 0.3f
+                || fabsf(f.current - last.current) > 0.05f) {
+                last = f;
+                flagged = true;
+            }
+            if (i % 2 == 1) {                                 // UI tick
+                drawFrame(t, 1, f);
+                if (flagged) {
+                    immediatePx += FULL_PX;
+                    immediateFrames++;
+                    flagged = false;
+                }
+            }
+        }
+        uint64_t retainedPx = t.stats().paintedPx;
+        Serial.printf("    300 UI frames: immediate %u full redraws = %llu px, retained %u repaints = %llu px (%.1f %%)\n",
+                      immediateFrames, (unsigned long long)immediatePx, t.stats().paints,
+                      (unsigned long long)retainedPx, immediatePx ? retainedPx * 100.0 / immediatePx : 0.0);
+        TestFramework::ASSERT(immediateFrames > 50, "Sensor noise trips the old delta check");
+        TestFramework::ASSERT(retainedPx * 8 < immediatePx, "Retained repaints under 1/8 of immediate mode");
+        TestFramework::ASSERT(retainedPx / 300 < FULL_PX / 40, "Average frame under 2.5 % of the screen");
+    }
+
+    TestFramework::endModule();
+}
+
+#endif // UNIT_TEST_MODE
@@ -0,0 +1,135 @@
+// ================================================================
+// Test_RingBuffer.cpp  -  Lock-free SPSC RingBuffer tests
+// ================================================================
+// Only depends on RingBuffer.h + <thread>; std::thread is
+// pthread-backed on the ESP32 target.
+// ================================================================
+
+#ifdef UNIT_TEST_MODE
+
+#include "../include/UnitTest_Framework.h"
+#include "../include/RingBuffer.h"
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+namespace {
+
+// Payload larger than one machine word so a torn copy is detectable
+struct StressFrame {
+    uint32_t seq;
+    float    pressure;
+    float    current;
+    uint32_t check;
+};
+
+uint32_t frameCheck(const StressFrame& f) {
+    uint32_t p, c;
+    memcpy(&p, &f.pressure, sizeof(p));
+    memcpy(&c, &f.current, sizeof(c));
+    return (f.seq * 2654435761u) ^ p ^ (c << 1);
+}
+
+constexpr uint32_t STRESS_SAMPLES   = 10000;  // 1 s @ 10 kHz
+constexpr uint32_t PRODUCER_RATE_US = 100;
+
+} // namespace
+
+void Test_RingBuffer::runTests() {
+    TestFramework::beginModule(getName());
+
+    //  Single-thread semantics
+    {
+        RingBuffer<float, 8> rb;
+        TestFramework::ASSERT_EQUAL_INT(7, (int)rb.capacity(), "Capacity is N-1");
+
+        for (int i = 0; i < 5; i++) rb.push((float)i);
+        float batch[8];
+        size_t n = rb.drain(batch, 8);
+        TestFramework::ASSERT_EQUAL_INT(5, (int)n, "Drain returns all pushed");
+        TestFramework::ASSERT_EQUAL(0.0f, batch[0], "Drain is FIFO (first)");
+        TestFramework::ASSERT_EQUAL(4.0f, batch[4], "Drain is FIFO (last)");
+        TestFramework::ASSERT(rb.isEmpty(), "Empty after drain");
+
+        for (int i = 0; i < 12; i++) rb.push((float)i);
+        TestFramework::ASSERT_EQUAL_INT(7, (int)rb.size(), "Window capped at capacity");
+        TestFramework::ASSERT_EQUAL(8.0f, rb.getAverage(), "Average over newest 7");
+        TestFramework::ASSERT_EQUAL(11.0f, rb.getMax(), "Max over window");
+        TestFramework::ASSERT_EQUAL(5.0f, rb.getMin(), "Min over window");
+
+        float v = 0.0f;
+        TestFramework::ASSERT(rb.pop(v) && v == 5.0f, "Pop skips overwritten samples");
+        TestFramework::ASSERT_EQUAL_INT(5, (int)rb.overrunCount(), "Overrun counted");
+
+        // Clear requested from another task: tail moves on the next drain
+        rb.requestClear();
+        TestFramework::ASSERT_EQUAL_INT(6, (int)rb.size(), "requestClear() leaves tail to the consumer");
+        rb.push(20.0f);
+        TestFramework::ASSERT(rb.drain(batch, 8) == 1 && batch[0] == 20.0f,
+                              "Next drain discards the backlog, keeps the sample pushed after the request");
+        rb.push(21.0f);
+        TestFramework::ASSERT(rb.drain(batch, 8) == 1 && batch[0] == 21.0f, "Later samples are kept");
+        rb.requestClear();
+        TestFramework::ASSERT(rb.drain(batch, 8) == 0 && rb.isEmpty(), "Request with nothing unread is a no-op");
+    }
+
+    //  Two-thread stress: 10 kHz producer, batch-draining consumer
+    {
+        static RingBuffer<StressFrame, 256> rb;
+        std::atomic<bool> producerDone{false};
+
+        uint32_t received   = 0;
+        uint32_t seqErrors  = 0;
+        uint32_t tornFrames = 0;
+
+        std::thread producer([&]() {
+            auto next = std::chrono::steady_clock::now();
+            for (uint32_t i = 0; i < STRESS_SAMPLES; i++) {
+                StressFrame f;
+                f.seq      = i;
+                f.pressure = -50.0f + (float)(i % 1000) * 0.05f;
+                f.current  = (float)(i % 97) * 0.1f;
+                f.check    = frameCheck(f);
+                rb.push(f);
+
+                next += std::chrono::microseconds(PRODUCER_RATE_US);
+                std::this_thread::sleep_until(next);
+            }
+            producerDone.store(true, std::memory_order_release);
+        });
+
+        std::thread consumer([&]() {
+            StressFrame batch[64];
+            uint32_t expected = 0;
+            for (;;) {
+                bool done = producerDone.load(std::memory_order_acquire);
+                size_t n = rb.drain(batch, 64);
+                for (size_t i = 0; i < n; i++) {
+                    if (batch[i].check != frameCheck(batch[i])) tornFrames++;
+                    if (batch[i].seq != expected) seqErrors++;
+                    expected = batch[i].seq + 1;
+                }
+                received += n;
+                if (done && n == 0) break;
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        });
+
+        uint32_t t0 = micros();
+        producer.join();
+        consumer.join();
+        uint32_t elapsedUs = micros() - t0;
+
+        TestFramework::ASSERT_EQUAL_INT(STRESS_SAMPLES, received, "Stress: no samples lost");
+        TestFramework::ASSERT_EQUAL_INT(0, seqErrors, "Stress: sequence contiguous");
+        TestFramework::ASSERT_EQUAL_INT(0, tornFrames, "Stress: no torn frames");
+        TestFramework::ASSERT_EQUAL_INT(0, rb.overrunCount(), "Stress: no overruns");
+        Serial.printf("    (%lu samples in %lu us, %.1f kHz)\n",
+                      (unsigned long)received, (unsigned long)elapsedUs,
+                      received * 1000.0f / (elapsedUs ? elapsedUs : 1));
+    }
+
+    TestFramework::endModule();
+}
+
+#endif // UNIT_TEST_MODE
@@ -0,0 +1,100 @@
+// ================================================================
+// Test_SampleWindow.cpp  -  SensorManager window storage
+// ================================================================
+// Averaging helpers and view ordering, plus a before/after
+// microbenchmark of the old vector push_back + erase(begin()).
+// ================================================================
+
+#ifdef UNIT_TEST_MODE
+
+#include "../include/UnitTest_Framework.h"
+#include "../include/SampleWindow.h"
+#include <vector>
+
+namespace {
+
+// Previous SensorManager::addToBuffer()/calculateAverage() behaviour
+void vectorPush(std::vector<float>& buffer, float value, size_t maxSize) {
+    buffer.push_back(value);
+    if (buffer.size() > maxSize) {
+        buffer.erase(buffer.begin());
+    }
+}
+
+float vectorAverage(const std::vector<float>& buffer, size_t samples) {
+    if (buffer.empty()) return 0.0f;
+    size_t count = samples < buffer.size() ? samples : buffer.size();
+    float sum = 0.0f;
+    for (size_t i = buffer.size() - count; i < buffer.size(); i++) sum += buffer[i];
+    return sum / count;
+}
+
+} // namespace
+
+void Test_SampleWindow::runTests() {
+    TestFramework::beginModule(getName());
+
+    //  Averaging helpers
+    SampleWindow<float, 5> w;
+    TestFramework::ASSERT_EQUAL(0.0f, w.average(10), "Empty average is 0");
+
+    w.push(1.0f); w.push(2.0f); w.push(3.0f);
+    TestFramework::ASSERT_EQUAL(2.0f, w.average(10), "Average clamps to size");
+    TestFramework::ASSERT_EQUAL(2.5f, w.average(2), "Average of newest 2");
+    TestFramework::ASSERT_EQUAL(3.0f, w.average(1), "Average of newest 1");
+    TestFramework::ASSERT_EQUAL(0.0f, w.average(0), "Average of 0 samples");
+
+    for (int i = 4; i <= 8; i++) w.push((float)i);   // window = 4..8
+    SampleView<float> v = w.view();
+    bool ordered = v.size() == 5;
+    for (size_t i = 0; ordered && i < v.size(); i++) ordered = (v[i] == 4.0f + i);
+    TestFramework::ASSERT(ordered, "View is contiguous oldest-first after wrap");
+    TestFramework::ASSERT_EQUAL(6.0f, w.average(5), "Average after wrap");
+    TestFramework::ASSERT_EQUAL(7.5f, w.average(2), "Newest 2 after wrap");
+
+    //  Equivalence with the old vector implementation
+    SampleWindow<float, 100> sw;
+    std::vector<float> vec;
+    vec.reserve(101);
+    bool same = true;
+    for (int i = 0; i < 1000; i++) {
+        float x = (float)((i * 37) % 101) - 50.0f;
+        sw.push(x);
+        vectorPush(vec, x, 100);
+        for (size_t k : {1u, 10u, 50u, 100u, 150u}) {
+            if (fabsf(sw.average(k) - vectorAverage(vec, k)) > 1e-3f) same = false;
+        }
+    }
+    TestFramework::ASSERT(same, "Matches vector erase-front averages");
+
+    //  Microbenchmark: per-tick push for 3 channels
+    const uint32_t ITER = 20000;
+    volatile float sink = 0.0f;
+    std::vector<float> p, t, c;
+    p.reserve(101); t.reserve(101); c.reserve(101);
+    uint32_t t0 = micros();
+    for (uint32_t i = 0; i < ITER; i++) {
+        vectorPush(p, (float)i, 100);
+        vectorPush(t, (float)i, 100);
+        vectorPush(c, (float)i, 100);
+        sink = sink + vectorAverage(p, 10);
+    }
+    uint32_t vecUs = micros() - t0;
+
+    SampleWindow<float, 100> ps, ts, cs;
+    t0 = micros();
+    for (uint32_t i = 0; i < ITER; i++) {
+        ps.push((float)i);
+        ts.push((float)i);
+        cs.push((float)i);
+        sink = sink + ps.average(10);
+    }
+    uint32_t winUs = micros() - t0;
+
+    Serial.printf("    vector erase-front: %.3f us/tick  SampleWindow: %.3f us/tick\n",
+                  (float)vecUs / ITER, (float)winUs / ITER);
+
+    TestFramework::endModule();
+}
+
+#endif // UNIT_TEST_MODE
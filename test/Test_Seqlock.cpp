@@ -0,0 +1,175 @@
+// ================================================================
+// Test_Seqlock.cpp  -  lock-free snapshot publication
+// ================================================================
+// Torture test: one writer publishing as fast as it can, several
+// readers validating every copy. Then read latency under the same
+// contention for Seqlock vs the previous mutex-copy scheme.
+// ================================================================
+
+#ifdef UNIT_TEST_MODE
+
+#include "../include/UnitTest_Framework.h"
+#include "../include/Seqlock.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// SensorData + Statistics sized payload with a self-check word
+struct Snapshot {
+    uint32_t seq;
+    float    pressure;
+    float    current;
+    float    temperature;
+    uint32_t totalCycles;
+    uint32_t failedCycles;
+    float    avgCycleTime;
+    uint32_t check;
+};
+
+uint32_t snapCheck(const Snapshot& s) {
+    uint32_t p, c, t;
+    memcpy(&p, &s.pressure, sizeof(p));
+    memcpy(&c, &s.current, sizeof(c));
+    memcpy(&t, &s.temperature, sizeof(t));
+    return (s.seq * 2654435761u) ^ p ^ (c << 1) ^ (t << 2) ^ s.totalCycles ^ (s.failedCycles << 3);
+}
+
+Snapshot makeSnap(uint32_t i) {
+    Snapshot s;
+    s.seq          = i;
+    s.pressure     = -60.0f + (float)(i % 500) * 0.1f;
+    s.current      = (float)(i % 73) * 0.05f;
+    s.temperature  = 25.0f + (float)(i % 31);
+    s.totalCycles  = i / 3;
+    s.failedCycles = i / 17;
+    s.avgCycleTime = (float)i;
+    s.check        = snapCheck(s);
+    return s;
+}
+
+// The previous scheme (mutex around a struct copy)
+struct MutexCell {
+    std::mutex m;
+    Snapshot   v{};
+    void write(const Snapshot& s) { std::lock_guard<std::mutex> g(m); v = s; }
+    Snapshot read() { std::lock_guard<std::mutex> g(m); return v; }
+};
+
+constexpr int      READERS      = 3;
+constexpr uint32_t TORTURE_MS   = 300;
+constexpr uint32_t LATENCY_READS = 200000;
+
+struct LatencyResult { double meanNs; uint64_t p99Ns; uint64_t maxNs; };
+
+template<typename Cell>
+LatencyResult measureLatency(Cell& cell) {
+    std::atomic<bool> stop{false};
+    std::thread writer([&]() {
+        uint32_t i = 1;
+        while (!stop.load(std::memory_order_relaxed)) cell.write(makeSnap(i++));
+    });
+    std::thread noise([&]() {      // second reader competing for the cell
+        volatile uint32_t sink = 0;
+        while (!stop.load(std::memory_order_relaxed)) sink = sink + cell.read().seq;
+    });
+
+    std::vector<uint32_t> ns(LATENCY_READS);
+    volatile uint32_t sink = 0;
+    for (uint32_t i = 0; i < LATENCY_READS; i++) {
+        auto t0 = std::chrono::steady_clock::now();
+        Snapshot s = cell.read();
+        auto t1 = std::chrono::steady_clock::now();
+        sink = sink + s.seq;
+        ns[i] = (uint32_t)std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count();
+    }
+    stop.store(true);
+    writer.join();
+    noise.join();
+
+    double sum = 0;
+    for (uint32_t v : ns) sum += v;
+    std::sort(ns.begin(), ns.end());
+    return LatencyResult{ sum / ns.size(), ns[ns.size() * 99 / 100], ns.back() };
+}
+
+} // namespace
+
+void Test_Seqlock::runTests() {
+    TestFramework::beginModule(getName());
+
+    //  Single-thread semantics
+    {
+        Seqlock<Snapshot> cell;
+        TestFramework::ASSERT_EQUAL_INT(0, cell.version(), "Fresh cell has version 0");
+        TestFramework::ASSERT(cell.read().seq == 0 && cell.read().pressure == 0.0f,
+                              "Fresh cell reads zero-initialised (never garbage)");
+        cell.write(makeSnap(7));
+        cell.write(makeSnap(8));
+        Snapshot s;
+        TestFramework::ASSERT(cell.tryRead(s) && s.seq == 8, "Read returns latest write");
+        TestFramework::ASSERT_EQUAL_INT(2, cell.version(), "Version counts writes");
+    }
+
+    //  Torture: unthrottled writer, READERS validating readers
+    {
+        static Seqlock<Snapshot> cell;
+        std::atomic<bool> stop{false};
+        std::atomic<uint32_t> torn{0}, regress{0};
+        std::atomic<uint64_t> reads{0};
+        uint32_t writes = 0;
+
+        std::thread writer([&]() {
+            uint32_t i = 1;
+            while (!stop.load(std::memory_order_relaxed)) cell.write(makeSnap(i++));
+            writes = i - 1;
+        });
+        std::vector<std::thread> readers;
+        for (int r = 0; r < READERS; r++) {
+            readers.emplace_back([&]() {
+                uint32_t last = 0;
+                uint64_t n = 0;
+                while (!stop.load(std::memory_order_relaxed)) {
+                    Snapshot s = cell.read();
+                    if (s.check != snapCheck(s)) torn++;
+                    if (s.seq < last) regress++;
+                    last = s.seq;
+                    n++;
+                }
+                reads += n;
+            });
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(TORTURE_MS));
+        stop.store(true);
+        writer.join();
+        for (auto& t : readers) t.join();
+
+        TestFramework::ASSERT_EQUAL_INT(0, torn.load(), "Torture: no torn snapshots");
+        TestFramework::ASSERT_EQUAL_INT(0, regress.load(), "Torture: per-reader seq monotonic");
+        TestFramework::ASSERT_EQUAL_INT(writes, cell.version(), "Torture: every write published");
+        Serial.printf("    %lu writes, %llu validated reads in %lu ms\n",
+                      (unsigned long)writes, (unsigned long long)reads.load(),
+                      (unsigned long)TORTURE_MS);
+    }
+
+    //  Read latency under contention (writer + competing reader)
+    {
+        static MutexCell mtx;
+        static Seqlock<Snapshot> seq;
+        LatencyResult m = measureLatency(mtx);
+        LatencyResult s = measureLatency(seq);
+        Serial.println("    Read latency with a busy writer and a competing reader:");
+        Serial.printf("      mutex  : mean %7.1f ns  p99 %6llu ns  max %8llu ns\n",
+                      m.meanNs, (unsigned long long)m.p99Ns, (unsigned long long)m.maxNs);
+        Serial.printf("      seqlock: mean %7.1f ns  p99 %6llu ns  max %8llu ns\n",
+                      s.meanNs, (unsigned long long)s.p99Ns, (unsigned long long)s.maxNs);
+    }
+
+    TestFramework::endModule();
+}
+
+#endif // UNIT_TEST_MODE
@@ -0,0 +1,296 @@
+// ================================================================
+// Test_StateTable.cpp  -  event-driven vacuum state machine
+// ================================================================
+// Replays sensor-frame and command sequences through SM_TABLE and
+// SmEdgeDetector the way StateMachine.cpp wires them (edges re-armed
+// on every state change, one-shot state timers, hold extensions) and
+// compares the resulting state traces.
+// ================================================================
+
+#ifdef UNIT_TEST_MODE
+
+#include "../include/UnitTest_Framework.h"
+#include "../include/VacuumStateTable.h"
+#include <string>
+
+namespace {
+
+const char* shortName(uint8_t s) {
+    static const char* names[] = { "IDLE", "ON", "HOLD", "BREAK", "WAIT", "DONE", "ERROR", "ESTOP", "STANDBY" };
+    return s <= STATE_STANDBY ? names[s] : "?";
+}
+
+// Model of StateMachine.cpp around the table
+struct Replay {
+    // Config (defaults as the production SystemConfig)
+    uint32_t onMs = 3000, holdMs = 5000, breakMs = 2000, waitMs = 5000;
+    uint8_t  maxExtensions = 2;
+    bool     extensionsEnabled = true;
+    SmThresholds th = { 10.0f, 50.0f, 60.0f, 70.0f, -58.0f, true };
+
+    SystemState state = STATE_IDLE;
+    ControlMode mode  = MODE_AUTO;
+    bool        overheatError = false;
+    bool        tuning = false;
+    uint8_t     extensions = 0;
+    uint32_t    warnings = 0;
+
+    uint32_t    now = 0;
+    uint32_t    timerDue = 0;      // 0 = not armed
+    SensorFrame frame = {};
+    SmEdgeDetector edges;
+    bool        rearm = true;
+    std::string trace = "IDLE";
+
+    Replay() {
+        frame.pressure = 0.0f; frame.current = 1.0f; frame.temperature = 25.0f;
+        frame.photoSensor = true;
+    }
+
+    uint32_t timeoutFor(SystemState s) const {
+        switch (s) {
+            case STATE_VACUUM_ON:    return mode == MODE_AUTO ? onMs : 0;
+            case STATE_VACUUM_HOLD:  return holdMs;
+            case STATE_VACUUM_BREAK: return breakMs;
+            case STATE_WAIT_REMOVAL: return waitMs;
+            case STATE_COMPLETE:     return 1000;
+            default:                 return 0;
+        }
+    }
+
+    void arm(uint32_t ms) { timerDue = ms ? now + ms : 0; }
+
+    void enter(SystemState s) {
+        if (s == state) return;
+        state = s;
+        trace += ">";
+        trace += shortName(s);
+        if (s == STATE_WAIT_REMOVAL) extensions = 0;
+        arm(timeoutFor(s));
+        rearm = true;
+    }
+
+    void dispatch(SmEvent ev) {
+        SmContext c;
+        c.mode = mode;
+        c.estopActive = frame.emergencyStop;
+        c.errorIsOverheat = overheatError;
+        c.holdExtensionAvailable = extensionsEnabled && extensions < maxExtensions;
+        c.autotuneRunning = tuning;
+        c.temperature = frame.temperature;
+        c.tempShutdown = th.tempShutdown;
+
+        const SmTransition* t = smDispatch(state, ev, c);
+        if (!t) return;
+        switch (t->action) {
+            case SM_ACT_ERR_OVERHEAT_SHUTDOWN:
+            case SM_ACT_ERR_OVERHEAT_CRITICAL: overheatError = true; break;
+            case SM_ACT_TEMP_WARNING:          warnings++; break;
+            case SM_ACT_EXTEND_HOLD:           extensions++; arm(waitMs); trace += "+"; break;
+            case SM_ACT_ERR_PHOTO_TIMEOUT:
+            case SM_ACT_PART_REMOVED:          extensions = 0; break;
+            case SM_ACT_CLEAR_ERROR:           overheatError = false; break;
+            default: break;
+        }
+        if (t->to != SM_STAY) enter((SystemState)t->to);
+    }
+
+    // One SensorRead tick: edges of the current frame
+    void tick() {
+        if (rearm) { rearm = false; edges.rearm(); }
+        uint32_t ev = edges.poll(smSensorLevels(frame, th), now);
+        for (uint8_t i = 0; ev; i++, ev >>= 1) {
+            if (ev & 1u) dispatch((SmEvent)i);
+        }
+    }
+
+    // Advance time in 100 ms sensor ticks, firing the state timer
+    void run(uint32_t ms) {
+        for (uint32_t end = now + ms; now < end; ) {
+            now += 100;
+            if (timerDue && now >= timerDue) { timerDue = 0; dispatch(SM_EV_TIMEOUT); }
+            tick();
+        }
+    }
+};
+
+} // namespace
+
+void Test_StateTable::runTests() {
+    TestFramework::beginModule(getName());
+
+    TestFramework::ASSERT(smTableValid(), "Table valid, SM_ANY rows first");
+
+    //  AUTO cycle: part placed -> timed phases -> part removed -> IDLE
+    {
+        Replay r;
+        r.run(500);
+        r.frame.limitSwitch = true;
+        r.run(200);
+        r.frame.limitSwitch = false;
+        r.run(3000 + 5000 + 2000 + 500);
+        r.frame.photoSensor = false;
+        r.run(1500);
+        TestFramework::ASSERT_STRING("IDLE>ON>HOLD>BREAK>WAIT>DONE>IDLE", r.trace.c_str(), "AUTO cycle trace");
+    }
+
+    //  PID mode: HOLD on pressure, not on time
+    {
+        Replay r;
+        r.mode = MODE_PID;
+        r.frame.limitSwitch = true;
+        r.run(200);
+        r.frame.limitSwitch = false;
+        r.run(10000);
+        TestFramework::ASSERT_STRING("IDLE>ON", r.trace.c_str(), "PID mode ignores the ON timer");
+        r.frame.pressure = -60.0f;
+        r.run(100);
+        TestFramework::ASSERT_EQUAL_INT(STATE_VACUUM_HOLD, r.state, "PID mode: HOLD on target pressure");
+    }
+
+    //  Part not removed: two extensions then ERROR
+    {
+        Replay r;
+        r.frame.limitSwitch = true;
+        r.run(100);
+        r.frame.limitSwitch = false;
+        r.run(3000 + 5000 + 2000 + 3 * 5000 + 100);
+        TestFramework::ASSERT_STRING("IDLE>ON>HOLD>BREAK>WAIT++>ERROR", r.trace.c_str(), "Hold extensions then ERROR");
+        TestFramework::ASSERT_EQUAL_INT(0, r.extensions, "Extension count reset");
+    }
+
+    //  E-stop preempts everything; overcurrent ignored while held; release -> IDLE
+    {
+        Replay r;
+        r.frame.limitSwitch = true;
+        r.run(100);
+        r.frame.emergencyStop = true;
+        r.frame.current = 20.0f;
+        r.run(300);
+        TestFramework::ASSERT_STRING("IDLE>ON>ESTOP", r.trace.c_str(), "E-stop wins over overcurrent");
+        r.frame.current = 1.0f;
+        r.frame.limitSwitch = false;
+        r.frame.emergencyStop = false;
+        r.run(100);
+        TestFramework::ASSERT_EQUAL_INT(STATE_IDLE, r.state, "Release -> IDLE");
+    }
+
+    //  Level still active on state entry is re-posted (edges re-armed)
+    {
+        Replay r;
+        r.frame.current = 20.0f;
+        r.run(100);
+        TestFramework::ASSERT_EQUAL_INT(STATE_ERROR, r.state, "Overcurrent -> ERROR");
+        r.enter(STATE_IDLE);    // ErrorHandler recovery
+        r.run(100);
+        TestFramework::ASSERT_EQUAL_INT(STATE_ERROR, r.state, "Still over current -> ERROR again");
+    }
+
+    //  Overheat: critical -> ERROR -> recovered; shutdown -> ESTOP -> critical band -> ERROR
+    {
+        Replay r;
+        r.frame.temperature = 62.0f;
+        r.run(100);
+        r.frame.temperature = 57.0f;     // hysteresis band: stays in ERROR
+        r.run(1000);
+        TestFramework::ASSERT_EQUAL_INT(STATE_ERROR, r.state, "No recovery inside hysteresis");
+        r.frame.temperature = 54.0f;
+        r.run(100);
+        r.frame.temperature = 72.0f;
+        r.run(100);
+        r.frame.temperature = 65.0f;
+        r.run(1000);
+        r.frame.temperature = 54.0f;
+        r.run(100);
+        TestFramework::ASSERT_STRING("IDLE>ERROR>IDLE>ESTOP>ERROR>IDLE", r.trace.c_str(), "Overheat trace");
+    }
+
+    //  Overheat E-stop latched until below shutdown - 10
+    {
+        Replay r;
+        r.th.tempCritical = 80.0f;       // no critical band in between
+        r.th.tempWarning  = 80.0f;
+        r.frame.temperature = 72.0f;
+        r.run(100);
+        r.frame.temperature = 61.0f;
+        r.run(1000);
+        TestFramework::ASSERT_EQUAL_INT(STATE_EMERGENCY_STOP, r.state, "Latched above shutdown - 10");
+        r.frame.temperature = 59.0f;
+        r.run(100);
+        TestFramework::ASSERT_STRING("IDLE>ESTOP>IDLE", r.trace.c_str(), "Cooled -> IDLE");
+    }
+
+    //  Overheat E-stop with the button also pressed: recover only after release
+    {
+        Replay r;
+        r.frame.temperature = 72.0f;
+        r.run(100);
+        r.frame.emergencyStop = true;
+        r.frame.temperature = 40.0f;
+        r.run(500);
+        TestFramework::ASSERT_EQUAL_INT(STATE_EMERGENCY_STOP, r.state, "Held button keeps ESTOP after cooling");
+        r.frame.emergencyStop = false;
+        r.run(100);
+        TestFramework::ASSERT_EQUAL_INT(STATE_IDLE, r.state, "Release after cooling -> IDLE");
+        TestFramework::ASSERT(!r.overheatError, "Overheat error cleared");
+    }
+
+    //  Temperature warning: once per 10 s while in band, no transition
+    {
+        Replay r;
+        r.frame.temperature = 52.0f;
+        r.run(25000);
+        TestFramework::ASSERT_EQUAL_INT(3, (int)r.warnings, "Warning at 0, 10, 20 s");
+        TestFramework::ASSERT_EQUAL_INT(STATE_IDLE, r.state, "Warning keeps state");
+        r.frame.limitSwitch = true;
+        r.run(100);
+        TestFramework::ASSERT_EQUAL_INT(3, (int)r.warnings, "State change does not re-trigger warning");
+    }
+
+    //  Auto-tune blocks the limit switch; re-arm after the run starts the cycle
+    {
+        Replay r;
+        r.tuning = true;
+        r.frame.limitSwitch = true;
+        r.run(1000);
+        TestFramework::ASSERT_EQUAL_INT(STATE_IDLE, r.state, "Limit switch ignored while tuning");
+        r.tuning = false;
+        r.run(1000);
+        TestFramework::ASSERT_EQUAL_INT(STATE_IDLE, r.state, "Edge already consumed");
+        r.rearm = true;             // rearmStateEvents()
+        r.run(100);
+        TestFramework::ASSERT_EQUAL_INT(STATE_VACUUM_ON, r.state, "Re-armed level starts the cycle");
+    }
+
+    //  Commands
+    {
+        Replay r;
+        r.dispatch(SM_EV_CMD_START);
+        r.dispatch(SM_EV_CMD_START);
+        r.dispatch(SM_EV_CMD_STOP);
+        r.dispatch(SM_EV_CMD_ESTOP);
+        TestFramework::ASSERT_STRING("IDLE>ON>IDLE>ERROR", r.trace.c_str(), "START/STOP/ESTOP commands");
+        r.frame.emergencyStop = true;
+        r.run(100);
+        r.dispatch(SM_EV_CMD_STOP);
+        TestFramework::ASSERT_EQUAL_INT(STATE_EMERGENCY_STOP, r.state, "STOP yields to a held E-stop");
+    }
+
+    //  Nothing posted while levels are steady
+    {
+        SmEdgeDetector e;
+        SensorFrame f = {};
+        f.photoSensor = true;
+        SmThresholds th = { 10.0f, 50.0f, 60.0f, 70.0f, -58.0f, true };
+        uint32_t lv = smSensorLevels(f, th);
+        uint32_t first = e.poll(lv, 0);
+        uint32_t quiet = 0;
+        for (uint32_t t = 100; t < 60000; t += 100) quiet |= e.poll(lv, t);
+        TestFramework::ASSERT(first != 0, "Initial levels posted once");
+        TestFramework::ASSERT_EQUAL_INT(0, (int)quiet, "Steady levels post nothing");
+    }
+
+    TestFramework::endModule();
+}
+
+#endif // UNIT_TEST_MODE
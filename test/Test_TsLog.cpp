@@ -0,0 +1,264 @@
+// ================================================================
+// Test_TsLog.cpp  -  binary columnar trend log
+// ================================================================
+// Encodes a synthetic 10 Hz vacuum trace (cycles, noise, slow thermal
+// drift) into blocks, then checks round trip, block stats, CRC
+// rejection, index range queries against a brute-force scan and the
+// CSV converter. Bytes per sample is reported through ASSERT_RANGE.
+// ================================================================
+
+#ifdef UNIT_TEST_MODE
+
+#include "../include/UnitTest_Framework.h"
+#include "../include/TsLog.h"
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct Store {
+    std::vector<std::vector<uint8_t>> blocks;
+    std::vector<std::vector<uint8_t>> index;
+    uint32_t fetches = 0;
+
+    void seal(TsBlockWriter& w) {
+        if (w.empty()) return;
+        std::vector<uint8_t> b(TS_BLOCK_SIZE);
+        TsBlockInfo info;
+        w.seal(b.data(), &info);
+        blocks.push_back(b);
+        std::vector<uint8_t> e(TS_INDEX_SIZE);
+        tsEncodeIndex(info, e.data());
+        index.push_back(e);
+    }
+    bool entry(size_t i, TsBlockInfo& e) const { return tsDecodeIndex(index[i].data(), e); }
+    bool fetch(uint32_t seq, uint8_t* out) {
+        fetches++;
+        if (seq >= blocks.size()) return false;
+        memcpy(out, blocks[seq].data(), TS_BLOCK_SIZE);
+        return true;
+    }
+};
+
+// 10 Hz frames: 12 s vacuum cycles, sensor noise, slow temperature rise
+std::vector<TsSample> trace(size_t n, uint64_t t0) {
+    std::vector<TsSample> out(n);
+    srand(7);
+    for (size_t i = 0; i < n; i++) {
+        uint32_t phase = (uint32_t)(i % 120);
+        float p = phase < 30 ? -2.0f * phase : phase < 80 ? -60.0f : phase < 100 ? -60.0f + 3.0f * (phase - 80) : 0.0f;
+        float noise = ((rand() % 21) - 10) * 0.01f;
+        out[i].tMs = t0 + i * 100 + (rand() % 3);
+        out[i].v[TS_CH_PRESSURE]    = tslog::quantize(p + noise, TS_CH_PRESSURE);
+        out[i].v[TS_CH_CURRENT]     = tslog::quantize(phase < 100 ? 2.4f + noise : 0.05f, TS_CH_CURRENT);
+        out[i].v[TS_CH_TEMPERATURE] = tslog::quantize(25.0f + i * 0.0005f + noise * 0.1f, TS_CH_TEMPERATURE);
+    }
+    return out;
+}
+
+bool same(const TsSample& a, const TsSample& b) {
+    return a.tMs == b.tMs && memcmp(a.v, b.v, sizeof(a.v)) == 0;
+}
+
+TsAggregate bruteForce(const std::vector<TsSample>& src, uint64_t from, uint64_t to) {
+    TsAggregate ref = {};
+    for (const TsSample& s : src) {
+        if (s.tMs < from || s.tMs > to) continue;
+        TsChannelStats one[TS_CHANNELS];
+        for (uint8_t c = 0; c < TS_CHANNELS; c++) one[c] = { s.v[c], s.v[c], s.v[c] };
+        tslog::merge(ref, one, 1);
+    }
+    return ref;
+}
+
+bool sameStats(const TsAggregate& a, const TsAggregate& b) {
+    bool equal = a.count == b.count;
+    for (uint8_t c = 0; c < TS_CHANNELS; c++) {
+        equal = equal && a.ch[c].min == b.ch[c].min && a.ch[c].max == b.ch[c].max && a.ch[c].sum == b.ch[c].sum;
+    }
+    return equal;
+}
+
+void append(Store& st, TsBlockWriter& w, const std::vector<TsSample>& src) {
+    for (const TsSample& s : src) {
+        if (!w.add(s)) { st.seal(w); w.add(s); }
+    }
+}
+
+} // namespace
+
+void Test_TsLog::runTests() {
+    TestFramework::beginModule(getName());
+
+    const size_t N = 36000;                       // 1 h at 10 Hz
+    const uint64_t T0 = 1760000000000ULL;         // epoch ms
+    std::vector<TsSample> src = trace(N, T0);
+
+    Store st;
+    TsBlockWriter* w = new TsBlockWriter(0);
+    append(st, *w, src);
+    st.seal(*w);
+    delete w;
+
+    //  Size
+    float bytesPerSample = (float)(st.blocks.size() * (TS_BLOCK_SIZE + TS_INDEX_SIZE)) / N;
+    TestFramework::ASSERT_RANGE(bytesPerSample, 0.0f, 8.0f, "Bytes/sample incl. padding + index (CSV ~40)");
+
+    //  Round trip and block stats
+    {
+        std::vector<TsSample> dec(TS_MAX_SAMPLES);
+        size_t k = 0;
+        bool roundTrip = true, statsOk = true, seqOk = true;
+        for (size_t b = 0; b < st.blocks.size(); b++) {
+            TsBlockInfo info;
+            size_t n = tsDecodeBlock(st.blocks[b].data(), dec.data(), dec.size());
+            tsParseBlock(st.blocks[b].data(), info);
+            seqOk = seqOk && info.seq == b && n == info.count;
+            TsChannelStats ch[TS_CHANNELS] = {};
+            for (size_t j = 0; j < n; j++, k++) {
+                roundTrip = roundTrip && k < N && same(dec[j], src[k]);
+                for (uint8_t c = 0; c < TS_CHANNELS; c++) {
+                    if (j == 0 || dec[j].v[c] < ch[c].min) ch[c].min = dec[j].v[c];
+                    if (j == 0 || dec[j].v[c] > ch[c].max) ch[c].max = dec[j].v[c];
+                    ch[c].sum += dec[j].v[c];
+                }
+            }
+            for (uint8_t c = 0; c < TS_CHANNELS; c++) {
+                statsOk = statsOk && ch[c].min == info.ch[c].min && ch[c].max == info.ch[c].max && ch[c].sum == info.ch[c].sum;
+            }
+            statsOk = statsOk && info.tFirst == dec[0].tMs && info.tLast() == dec[n - 1].tMs;
+        }
+        TestFramework::ASSERT(roundTrip && k == N, "Every sample decodes exactly");
+        TestFramework::ASSERT(statsOk, "Header time range + min/max/sum match the samples");
+        TestFramework::ASSERT(seqOk, "Block seq = position, count matches");
+    }
+
+    //  CRC rejects damage anywhere in the block
+    {
+        std::vector<uint8_t> b = st.blocks[3];
+        TsBlockInfo info;
+        TsSample tmp[4];
+        b[TS_BLOCK_SIZE - 1] ^= 0x01;            // padding byte
+        bool padding = !tsParseBlock(b.data(), info);
+        b = st.blocks[3];
+        b[TS_HEADER_SIZE + 100] ^= 0x40;         // column data
+        bool body = tsDecodeBlock(b.data(), tmp, 4) == 0;
+        b = st.blocks[3];
+        b[14] ^= 0x01;                           // tFirst
+        bool header = !tsParseBlock(b.data(), info);
+        std::vector<uint8_t> zero(TS_BLOCK_SIZE, 0);
+        bool pad = !tsParseBlock(zero.data(), info);
+        TestFramework::ASSERT(padding && body && header && pad, "Corrupt / zero-padded blocks rejected");
+
+        std::vector<uint8_t> e = st.index[3];
+        e[9] ^= 0x10;
+        TestFramework::ASSERT(!tsDecodeIndex(e.data(), info), "Corrupt index entry rejected");
+    }
+
+    //  Time going backwards starts a new block
+    {
+        TsBlockWriter* bw = new TsBlockWriter(5);
+        TsSample a = { 5000, { 1, 2, 3 } }, b = { 4000, { 1, 2, 3 } };
+        bool first = bw->add(a);
+        bool back = bw->add(b);
+        TestFramework::ASSERT(first && !back, "Backwards time refused");
+        delete bw;
+    }
+
+    //  Range query: index for inner blocks, decode only the edges
+    {
+        auto get = [&](size_t i, TsBlockInfo& e) { return st.entry(i, e); };
+        auto fetch = [&](uint32_t seq, uint8_t* out) { return st.fetch(seq, out); };
+        std::vector<uint8_t> buf(TS_BLOCK_SIZE);
+        std::vector<TsSample> scratch(TS_MAX_SAMPLES);
+
+        TsRuns runs = tsScanRuns(st.index.size(), get);
+        TestFramework::ASSERT(runs.count == 1 && runs.entries == st.index.size(), "Monotonic log is one run");
+
+        uint64_t from = T0 + 600123, to = T0 + 2400456;    // minute 10 .. 40
+        st.fetches = 0;
+        TsAggregate a = tsQueryRange(runs, st.index.size(), from, to, get, fetch,
+                                     buf.data(), scratch.data(), scratch.size());
+        TestFramework::ASSERT(sameStats(a, bruteForce(src, from, to)), "Aggregate = brute-force scan");
+        TestFramework::ASSERT_EQUAL_INT(2, (int)st.fetches, "Only the two edge blocks read");
+        TestFramework::ASSERT(a.blocksFromIndex > 10, "Inner blocks answered from the index");
+        TestFramework::ASSERT_EQUAL(-35.0f, a.mean(TS_CH_PRESSURE), "Mean pressure over the cycles", 3.0f);
+
+        TsAggregate none = tsQueryRange(runs, st.index.size(), T0 + 10000000, T0 + 20000000, get, fetch,
+                                        buf.data(), scratch.data(), scratch.size());
+        TestFramework::ASSERT_EQUAL_INT(0, (int)none.count, "Range after the data is empty");
+
+        size_t lb = tsIndexLowerBound(st.index.size(), T0, get);
+        TestFramework::ASSERT_EQUAL_INT(0, (int)lb, "Lower bound at the start");
+    }
+
+    //  Reboot before NTP sync: wall clock, millis() since boot, then NTP
+    {
+        std::vector<TsSample> before = trace(6000, T0);           // 10 min, wall clock
+        std::vector<TsSample> boot   = trace(3000, 2000);         // 5 min, millis()
+        std::vector<TsSample> synced = trace(3000, T0 + 3600000); // after sync
+        std::vector<TsSample> all = before;
+        all.insert(all.end(), boot.begin(), boot.end());
+        all.insert(all.end(), synced.begin(), synced.end());
+
+        Store rs;
+        TsBlockWriter* rw = new TsBlockWriter(0);
+        append(rs, *rw, before);
+        append(rs, *rw, boot);
+        append(rs, *rw, synced);
+        rs.seal(*rw);
+        delete rw;
+
+        auto get = [&](size_t i, TsBlockInfo& e) { return rs.entry(i, e); };
+        auto fetch = [&](uint32_t seq, uint8_t* out) { return rs.fetch(seq, out); };
+        std::vector<uint8_t> buf(TS_BLOCK_SIZE);
+        std::vector<TsSample> scratch(TS_MAX_SAMPLES);
+        size_t n = rs.index.size();
+
+        TsRuns runs = tsScanRuns(n, get);
+        TestFramework::ASSERT(runs.count == 2 && !runs.overflow, "Clock step back starts a second run");
+
+        auto query = [&](const TsRuns& r, uint64_t from, uint64_t to) {
+            return tsQueryRange(r, n, from, to, get, fetch, buf.data(), scratch.data(), scratch.size());
+        };
+        TsAggregate wall = query(runs, T0, T0 + 7200000);
+        TestFramework::ASSERT(sameStats(wall, bruteForce(all, T0, T0 + 7200000)) && wall.count == 9000,
+                              "Wall-clock range finds both sides of the reboot");
+        TsAggregate uptime = query(runs, 0, 1000000);
+        TestFramework::ASSERT(sameStats(uptime, bruteForce(all, 0, 1000000)) && uptime.count == 3000,
+                              "Range in the millis() run");
+        TsAggregate edges = query(runs, 2000 + 60000, T0 + 300000);
+        TestFramework::ASSERT(sameStats(edges, bruteForce(all, 2000 + 60000, T0 + 300000)),
+                              "Range spanning the step decodes the edges of every run");
+
+        // What the single sorted search returned before the runs
+        TsRuns one;
+        one.start[0] = 0;
+        one.count = 1;
+        one.entries = (uint32_t)n;
+        TestFramework::ASSERT(query(one, 0, 1000000).count == 0, "One-run search misses the millis() run");
+
+        TsRuns overflow = runs;
+        overflow.overflow = true;
+        TsRuns stale = tsScanRuns(n - 3, get);
+        TestFramework::ASSERT(sameStats(query(overflow, 0, T0 + 7200000), bruteForce(all, 0, T0 + 7200000)) &&
+                              sameStats(query(stale, 0, T0 + 7200000), bruteForce(all, 0, T0 + 7200000)),
+                              "Linear fallback (too many runs, entries not scanned yet)");
+    }
+
+    //  CSV converter
+    {
+        char row[64];
+        TsSample s = { 1234, { -6125, 2400, 2550 } };
+        std::string a(row, tsSampleToCsv(s, row));
+        TsSample z = { 0, { -5, 7, 0 } };
+        std::string b(row, tsSampleToCsv(z, row));
+        TestFramework::ASSERT_STRING("1234,-61.25,2.400,25.50\r\n", a.c_str(), "CSV row, fixed point");
+        TestFramework::ASSERT_STRING("0,-0.05,0.007,0.00\r\n", b.c_str(), "CSV row, small values");
+    }
+
+    TestFramework::endModule();
+}
+
+#endif // UNIT_TEST_MODE
@@ -0,0 +1,178 @@
+// ================================================================
+// Test_WindowStats.cpp  -  O(1) sliding-window statistics
+// ================================================================
+// Checks WindowStats against a brute-force window and benchmarks the
+// per-sample cost (push + full stats query) against the previous
+// four-pass scan (avg / max / min / stddev-with-avg) at 60/600/6000.
+// Readers on other threads must only ever see whole snapshots.
+// ================================================================
+
+#ifdef UNIT_TEST_MODE
+
+#include "../include/UnitTest_Framework.h"
+#include "../include/WindowStats.h"
+#include <atomic>
+#include <memory>
+#include <thread>
+
+namespace {
+
+// Reference: the pre-WindowStats full-scan implementation
+template<size_t N>
+struct ScanWindow {
+    float    buf[N];
+    size_t   head  = 0;
+    size_t   count = 0;
+
+    void push(float x) {
+        buf[head] = x;
+        head = (head + 1) % N;
+        if (count < N) count++;
+    }
+    size_t first() const { return (head + N - count) % N; }
+    float avg() const {
+        float s = 0.0f; size_t i = first();
+        for (size_t k = 0; k < count; k++) { s += buf[i]; i = (i + 1) % N; }
+        return count ? s / count : 0.0f;
+    }
+    float max() const {
+        size_t i = first(); float m = buf[i];
+        for (size_t k = 0; k < count; k++) { if (buf[i] > m) m = buf[i]; i = (i + 1) % N; }
+        return m;
+    }
+    float min() const {
+        size_t i = first(); float m = buf[i];
+        for (size_t k = 0; k < count; k++) { if (buf[i] < m) m = buf[i]; i = (i + 1) % N; }
+        return m;
+    }
+    float stdDev() const {
+        float a = avg(), s = 0.0f; size_t i = first();
+        for (size_t k = 0; k < count; k++) { float d = buf[i] - a; s += d * d; i = (i + 1) % N; }
+        return count > 1 ? sqrtf(s / count) : 0.0f;
+    }
+};
+
+// Deterministic pressure-like signal with spikes
+uint32_t lcg = 12345;
+float nextSample() {
+    lcg = lcg * 1664525u + 1013904223u;
+    float noise = (float)((lcg >> 8) & 0xFFFF) / 65535.0f - 0.5f;
+    float v = -60.0f + noise * 4.0f;
+    if ((lcg >> 28) == 0) v -= 25.0f;   // ~6% spikes
+    return v;
+}
+
+template<size_t N>
+void checkAgainstScan(const char* name, uint32_t samples) {
+    std::unique_ptr<WindowStats<N>> ws(new WindowStats<N>());
+    std::unique_ptr<ScanWindow<N>>  ref(new ScanWindow<N>());
+
+    float worstMean = 0.0f, worstStd = 0.0f;
+    bool minMaxOK = true;
+    for (uint32_t i = 0; i < samples; i++) {
+        float x = nextSample();
+        ws->push(x);
+        ref->push(x);
+        if (i % 7 == 0 || i + 1 == samples) {
+            WindowSummary s = ws->summary();
+            worstMean = fmaxf(worstMean, fabsf(s.mean - ref->avg()));
+            worstStd  = fmaxf(worstStd,  fabsf(s.stdDev - ref->stdDev()));
+            if (s.min != ref->min() || s.max != ref->max()) minMaxOK = false;
+        }
+    }
+    char label[64];
+    snprintf(label, sizeof(label), "%s mean matches scan", name);
+    TestFramework::ASSERT(worstMean < 0.01f, label);
+    snprintf(label, sizeof(label), "%s stddev matches scan", name);
+    TestFramework::ASSERT(worstStd < 0.01f, label);
+    snprintf(label, sizeof(label), "%s min/max exact", name);
+    TestFramework::ASSERT(minMaxOK, label);
+}
+
+template<size_t N>
+void benchmark(uint32_t samples) {
+    std::unique_ptr<WindowStats<N>> ws(new WindowStats<N>());
+    std::unique_ptr<ScanWindow<N>>  ref(new ScanWindow<N>());
+    for (size_t i = 0; i < N; i++) { float x = nextSample(); ws->push(x); ref->push(x); }
+
+    volatile float sink = 0.0f;
+    uint32_t t0 = micros();
+    for (uint32_t i = 0; i < samples; i++) {
+        ref->push(nextSample());
+        sink = sink + ref->avg() + ref->max() + ref->min() + ref->stdDev();
+    }
+    uint32_t scanUs = micros() - t0;
+
+    t0 = micros();
+    for (uint32_t i = 0; i < samples; i++) {
+        ws->push(nextSample());
+        WindowSummary s = ws->summary();
+        sink = sink + s.mean + s.max + s.min + s.stdDev;
+    }
+    uint32_t incUs = micros() - t0;
+
+    Serial.printf("    N=%-5u scan: %8.3f us/sample  incremental: %6.3f us/sample  (x%.1f)\n",
+                  (unsigned)N, (float)scanUs / samples, (float)incUs / samples,
+                  incUs ? (float)scanUs / incUs : 0.0f);
+}
+
+} // namespace
+
+void Test_WindowStats::runTests() {
+    TestFramework::beginModule(getName());
+
+    {
+        WindowStats<4> ws;
+        TestFramework::ASSERT(ws.isEmpty() && ws.getAverage() == 0.0f, "Empty window is zero");
+        ws.push(1.0f); ws.push(2.0f); ws.push(3.0f); ws.push(4.0f);
+        TestFramework::ASSERT_EQUAL(2.5f, ws.getAverage(), "Mean (filling)");
+        TestFramework::ASSERT_EQUAL(1.118f, ws.getStdDev(), "Population stddev");
+        ws.push(10.0f);   // evicts 1
+        TestFramework::ASSERT_EQUAL(4.75f, ws.getAverage(), "Mean after eviction");
+        TestFramework::ASSERT_EQUAL(2.0f, ws.getMin(), "Min after eviction");
+        TestFramework::ASSERT_EQUAL(10.0f, ws.getMax(), "Max after push");
+        ws.clear();
+        TestFramework::ASSERT_EQUAL_INT(0, (int)ws.size(), "Clear resets window");
+
+        ws.push(1.0f); ws.push(2.0f);
+        ws.requestClear();
+        TestFramework::ASSERT_EQUAL_INT(2, (int)ws.size(), "requestClear() leaves the window to the writer");
+        ws.push(7.0f);
+        TestFramework::ASSERT(ws.size() == 1 && ws.getAverage() == 7.0f, "Next push starts a fresh window");
+    }
+
+    //  Readers racing the writer: pushing 1, 2, 3, ... into a full
+    //  window of 8 keeps max - min = 7 and mean = max - 3.5 exactly
+    {
+        WindowStats<8> ws;
+        for (int i = 1; i <= 8; i++) ws.push((float)i);
+        std::atomic<bool> stop{false};
+        std::atomic<uint32_t> reads{0}, torn{0};
+        auto reader = [&]() {
+            while (!stop.load(std::memory_order_relaxed)) {
+                WindowSummary s = ws.summary();
+                if (s.count != 8 || s.max - s.min != 7.0f || s.mean != s.max - 3.5f) torn++;
+                reads++;
+            }
+        };
+        std::thread r1(reader), r2(reader);
+        for (int i = 9; i <= 200000; i++) ws.push((float)i);
+        stop = true;
+        r1.join();
+        r2.join();
+        TestFramework::ASSERT(reads.load() > 0 && torn.load() == 0, "Concurrent summary() is never torn");
+    }
+
+    checkAgainstScan<60>("N=60", 5000);
+    checkAgainstScan<600>("N=600", 20000);
+    checkAgainstScan<6000>("N=6000", 60000);
+
+    Serial.println("    Per-sample cost (push + mean/std/min/max query):");
+    benchmark<60>(20000);
+    benchmark<600>(5000);
+    benchmark<6000>(1000);
+
+    TestFramework::endModule();
+}
+
+#endif // UNIT_TEST_MODE
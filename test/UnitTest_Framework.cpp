@@ -142,6 +142,28 @@ void runAllTests() {
     Test_Sensor().runTests();
     Test_Error().runTests();
     Test_Memory().runTests();
+    Test_RingBuffer().runTests();
+    Test_WindowStats().runTests();
+    Test_SampleWindow().runTests();
+    Test_AdcDecimator().runTests();
+    Test_Seqlock().runTests();
+    Test_LoopHistogram().runTests();
+    Test_RampProfile().runTests();
+    Test_PidController().runTests();
+    Test_RelayAutotune().runTests();
+    Test_StateTable().runTests();
+    Test_BuzzerPattern().runTests();
+    Test_LogWriteBehind().runTests();
+    Test_TsLog().runTests();
+    Test_MetricRollup().runTests();
+    Test_LogRetention().runTests();
+    Test_MinMaxPyramid().runTests();
+    Test_AxisAutoScale().runTests();
+    Test_DirtyRegion().runTests();
+    Test_RetainedWidget().runTests();
+    Test_BackgroundCache().runTests();
+    Test_GlyphAtlas().runTests();
+    Test_GestureRecognizer().runTests();
     
     // v3.6+ ?뚯뒪??
     #ifdef ENABLE_PREDICTIVE_MAINTENANCE
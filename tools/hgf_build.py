@@ -0,0 +1,146 @@
+#!/usr/bin/env python3
+"""Build the HGF glyph font (include/GlyphAtlas.h) from a BDF or TTF.
+
+    python tools/hgf_build.py NanumGothic.ttf --size 16 -o data/hangul16.hgf
+    python tools/hgf_build.py unifont.bdf -o data/hangul16.hgf
+
+Charset: printable ASCII, the 2350 KS X 1001 Hangul syllables, every
+non-ASCII character of src/Lang.cpp and --chars. Upload with
+`pio run -t uploadfs`; the firmware loads /hangul16.hgf at boot.
+TTF input needs Pillow; BDF is parsed here.
+"""
+import argparse
+import os
+import struct
+import sys
+
+ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+HEADER = struct.Struct("<4sBBHII")
+ENTRY = struct.Struct("<IIBBbbB3x")
+MAX_W = MAX_H = 24                       # GLYPH_SLOT_BYTES = 72 = 3 B x 24 rows
+
+
+def ksx1001_hangul():
+    out = []
+    for hi in range(0xB0, 0xC9):
+        for lo in range(0xA1, 0xFF):
+            try:
+                out.append(bytes([hi, lo]).decode("euc-kr"))
+            except UnicodeDecodeError:
+                pass
+    return out
+
+
+def charset(extra):
+    chars = {chr(c) for c in range(0x20, 0x7F)}
+    chars.update(ksx1001_hangul())
+    with open(os.path.join(ROOT, "src", "Lang.cpp"), encoding="utf-8", errors="ignore") as f:
+        chars.update(c for c in f.read() if ord(c) >= 0x80 and c.isprintable())
+    chars.update(extra)
+    return sorted(chars, key=ord)
+
+
+class Glyph:
+    def __init__(self, w, h, x_off, y_off, advance, rows):
+        self.w, self.h, self.x_off, self.y_off, self.advance = w, h, x_off, y_off, advance
+        self.rows = rows                 # one int per row, padded to whole bytes, MSB = leftmost pixel
+
+    def bitmap(self):
+        stride = (self.w + 7) // 8
+        return b"".join(r.to_bytes(stride, "big") for r in self.rows)
+
+
+def load_bdf(path, wanted):
+    glyphs, ascent, height = {}, 0, 0
+    with open(path, encoding="latin-1") as f:
+        lines = iter(f.read().splitlines())
+    for line in lines:
+        key, _, val = line.partition(" ")
+        if key == "FONT_ASCENT":
+            ascent = int(val)
+        elif key == "FONT_DESCENT":
+            height = ascent + int(val)
+        elif key == "STARTCHAR":
+            cp = adv = None
+            for line in lines:
+                key, _, val = line.partition(" ")
+                if key == "ENCODING":
+                    cp = int(val.split()[0])
+                elif key == "DWIDTH":
+                    adv = int(val.split()[0])
+                elif key == "BBX":
+                    w, h, bx, by = (int(v) for v in val.split())
+                elif key == "BITMAP":
+                    stride = (w + 7) // 8
+                    rows = []
+                    for _ in range(h):
+                        hx = next(lines).strip()
+                        rows.append(int(hx, 16) >> max(0, len(hx) * 4 - stride * 8))
+                    next(lines)          # ENDCHAR
+                    break
+            if cp is not None and chr(cp) in wanted:
+                glyphs[cp] = Glyph(w, h, bx, ascent - by - h, adv, rows)
+    return glyphs, height, ascent
+
+
+def load_ttf(path, size, wanted):
+    from PIL import Image, ImageDraw, ImageFont
+    font = ImageFont.truetype(path, size)
+    ascent, descent = font.getmetrics()
+    glyphs = {}
+    for ch in wanted:
+        l, t, r, b = font.getbbox(ch)
+        adv = int(round(font.getlength(ch)))
+        if r <= l or b <= t:
+            glyphs[ord(ch)] = Glyph(0, 0, 0, 0, adv, [])
+            continue
+        img = Image.new("1", (r - l, b - t), 0)
+        ImageDraw.Draw(img).text((-l, -t), ch, font=font, fill=1)
+        px = img.load()
+        rows = []
+        for y in range(img.height):
+            v = 0
+            for x in range(img.width):
+                v = v << 1 | (1 if px[x, y] else 0)
+            rows.append(v << ((img.width + 7) // 8 * 8 - img.width))
+        glyphs[ord(ch)] = Glyph(img.width, img.height, l, t, adv, rows)
+    return glyphs, ascent + descent, ascent
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    ap.add_argument("font", help="BDF or TTF/OTF source")
+    ap.add_argument("-o", "--out", default=os.path.join(ROOT, "data", "hangul16.hgf"))
+    ap.add_argument("--size", type=int, default=16, help="pixel size for TTF input")
+    ap.add_argument("--chars", default="", help="extra characters to include")
+    args = ap.parse_args()
+
+    wanted = charset(args.chars)
+    if args.font.lower().endswith(".bdf"):
+        glyphs, height, ascent = load_bdf(args.font, set(wanted))
+    else:
+        glyphs, height, ascent = load_ttf(args.font, args.size, wanted)
+
+    missing = [c for c in wanted if ord(c) not in glyphs]
+    for cp, g in glyphs.items():
+        if g.w > MAX_W or g.h > MAX_H:
+            sys.exit("U+%04X is %dx%d, atlas slots hold %dx%d" % (cp, g.w, g.h, MAX_W, MAX_H))
+
+    cps = sorted(glyphs)
+    index_off = HEADER.size
+    bitmap_off = index_off + ENTRY.size * len(cps)
+    index, bitmaps = b"", b""
+    for cp in cps:
+        g = glyphs[cp]
+        index += ENTRY.pack(cp, bitmap_off + len(bitmaps), g.w, g.h, g.x_off, g.y_off, g.advance)
+        bitmaps += g.bitmap()
+
+    os.makedirs(os.path.dirname(os.path.abspath(args.out)), exist_ok=True)
+    with open(args.out, "wb") as f:
+        f.write(HEADER.pack(b"HGF1", height, ascent, 0, len(cps), index_off) + index + bitmaps)
+    print("%s: %d glyphs, %d px line, %d bytes, %d missing"
+          % (args.out, len(cps), height, bitmap_off + len(bitmaps), len(missing)))
+
+
+if __name__ == "__main__":
+    main()